@@ -35,6 +35,7 @@ LOCAL_SRC_FILES := \
     source/resampler/polyphase/polyphase_resampler_utils.cpp \
     source/resampler/smart/smart_resampler_params_factory.cpp \
     source/utils/utils.cpp \
+    source/utils/mirrored_memory.cpp \
     source/filter/biquad/biquad_filter_coeffs.cpp \
     source/filter/tsvf/tsvf_coeffs.cpp \
     source/window/window_functions.cpp
@@ -44,6 +45,7 @@ SHARED_C_INCLUDES := $(CXXDASP_TOP_DIR)/include
 SHARED_CFLAGS := \
     -DCXXDASP_ENABLE_POLYPHASE_RESAMPLER_FACTORY_LOW_QUALITY=$(CXXDASP_ENABLE_POLYPHASE_RESAMPLER_FACTORY_LOW_QUALITY) \
     -DCXXDASP_ENABLE_POLYPHASE_RESAMPLER_FACTORY_HIGH_QUALITY=$(CXXDASP_ENABLE_POLYPHASE_RESAMPLER_FACTORY_HIGH_QUALITY) \
+    -DCXXDASP_USE_FFT_BACKEND_MIXED_RADIX=1 \
     $(CXXPH_CFLAGS_$(TARGET_ARCH_ABI))
 
 LOCAL_C_INCLUDES := \
@@ -89,11 +91,14 @@ HAVE_SPECIALIZED_LIBCXXDASP_ARCH_ABI := 1
 
 LOCAL_SRC_FILES := \
     source/utils/utils_impl_neon_optimized.cpp \
+    source/fft/mixed_radix_fft_impl_neon_optimized.cpp \
     source/filter/biquad/f32_mono_neon_biquad_df1_core_operator.cpp \
     source/filter/biquad/f32_stereo_neon_biquad_df1_core_operator.cpp \
     source/filter/biquad/f32_mono_neon_biquad_tdf2_core_operator.cpp \
     source/filter/biquad/f32_stereo_neon_biquad_tdf2_core_operator.cpp \
     source/filter/cascaded_biquad/f32_stereo_neon_cascaded_2_biquad_tdf2_core_operator.cpp \
+    source/filter/cascaded_biquad/f32_mono_neon_cascaded_biquad_block_tdf2_core_operator.cpp \
+    source/filter/multichannel_biquad/f32_neon_multichannel_biquad_core_operator.cpp \
     source/filter/tsvf/f32_mono_neon_tsvf_core_operator.cpp \
     source/filter/tsvf/f32_stereo_neon_tsvf_core_operator.cpp \
     source/converter/s16_to_f32_mono_neon_sample_format_converter_core_operator.cpp \
@@ -136,6 +141,17 @@ HAVE_SPECIALIZED_LIBCXXDASP_ARCH_ABI := 1
 
 LOCAL_SRC_FILES := \
     source/utils/utils_impl_sse_optimized.cpp \
+    source/utils/x86_platform_info.cpp \
+    source/fft/mixed_radix_fft_impl_sse_optimized.cpp \
+    source/filter/biquad/f32_mono_sse_biquad_df1_core_operator.cpp \
+    source/filter/biquad/f32_stereo_sse_biquad_df1_core_operator.cpp \
+    source/filter/biquad/f32_stereo_avx_biquad_df1_core_operator.cpp \
+    source/filter/biquad/f32_stereo_sse_biquad_tdf2_core_operator.cpp \
+    source/filter/biquad/f32_stereo_avx_biquad_tdf2_core_operator.cpp \
+    source/filter/cascaded_biquad/f32_mono_sse_cascaded_biquad_block_tdf2_core_operator.cpp \
+    source/filter/multichannel_biquad/f32_sse_multichannel_biquad_core_operator.cpp \
+    source/filter/multichannel_biquad/f32_avx_multichannel_biquad_core_operator.cpp \
+    source/filter/multichannel_biquad/f32_avx512_multichannel_biquad_core_operator.cpp \
     source/converter/s16_to_f32_mono_sse_sample_format_converter_core_operator.cpp \
     source/converter/s16_to_f32_stereo_sse_sample_format_converter_core_operator.cpp \
     source/converter/s16_mono_to_f32_stereo_sse_sample_format_converter_core_operator.cpp \
@@ -0,0 +1,994 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+//
+// cxxdasp_bench: in-process benchmark of the resampler core operators, resampler configurations
+// and biquad filter core operators.
+//
+// Every case processes a synthetic signal (1 kHz sine, -6 dB) several times and reports
+// ns/sample, samples/s, percentiles and cycles per output frame in JSON format.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/biquad/biquad_filter.hpp>
+#include <cxxdasp/filter/biquad/biquad_filter_core_operators.hpp>
+#include <cxxdasp/filter/multichannel_biquad/multichannel_biquad_filter.hpp>
+#include <cxxdasp/filter/multichannel_biquad/multichannel_biquad_filter_core_operators.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_decimator.hpp>
+#include <cxxdasp/resampler/halfband/halfband_cascade_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_core_operators.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
+#include <cxxdasp/resampler/polyphase/variable_ratio_polyphase_resampler.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler_params_factory.hpp>
+#include <cxxdasp/utils/stopwatch.hpp>
+#include <cxxdasp/window/window_functions.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#if CXXPH_COMPILER_IS_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAVE_CYCLE_COUNTER 1
+#else
+#define BENCH_HAVE_CYCLE_COUNTER 0
+#endif
+
+using namespace cxxdasp;
+
+//
+// FFT backends (same selection as simple-resampler)
+//
+
+// app_fft_backend_f
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix app_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+// app_fft_backend_d
+#if CXXDASP_USE_FFT_BACKEND_GP_FFT
+typedef fft::backend::d::gp_fft app_fft_backend_d;
+#elif CXXDASP_USE_FFT_BACKEND_FFTW
+typedef fft::backend::d::fftw app_fft_backend_d;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_D
+typedef fft::backend::d::kfr app_fft_backend_d;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::d::mixed_radix app_fft_backend_d;
+#else
+typedef app_fft_backend_f app_fft_backend_d; // fall-back  use single-precision
+#endif
+
+//
+// Fastest available core operators (same selection as simple-resampler)
+//
+// NOTE: AVX2 polyphase core operators are selected at run time, see make_bench_cases()
+//
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE3
+typedef resampler::f32_mono_sse3_polyphase_core_operator f32_mono_fast_polyphase_core_operator;
+#elif CXXPH_COMPILER_SUPPORTS_X86_SSE
+typedef resampler::f32_mono_sse_polyphase_core_operator f32_mono_fast_polyphase_core_operator;
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON
+typedef resampler::f32_mono_neon_polyphase_core_operator f32_mono_fast_polyphase_core_operator;
+#else
+typedef resampler::f32_mono_basic_polyphase_core_operator f32_mono_fast_polyphase_core_operator;
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+typedef resampler::f32_stereo_sse_polyphase_core_operator f32_stereo_fast_polyphase_core_operator;
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON
+typedef resampler::f32_stereo_neon_polyphase_core_operator f32_stereo_fast_polyphase_core_operator;
+#else
+typedef resampler::f32_stereo_basic_polyphase_core_operator f32_stereo_fast_polyphase_core_operator;
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+typedef resampler::f32_mono_sse_halfband_x2_resampler_core_operator f32_mono_fast_halfband_core_operator;
+typedef resampler::f32_stereo_sse_halfband_x2_resampler_core_operator f32_stereo_fast_halfband_core_operator;
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON
+typedef resampler::f32_mono_neon_halfband_x2_resampler_core_operator f32_mono_fast_halfband_core_operator;
+typedef resampler::f32_stereo_neon_halfband_x2_resampler_core_operator f32_stereo_fast_halfband_core_operator;
+#else
+typedef resampler::f32_mono_basic_halfband_x2_resampler_core_operator f32_mono_fast_halfband_core_operator;
+typedef resampler::f32_stereo_basic_halfband_x2_resampler_core_operator f32_stereo_fast_halfband_core_operator;
+#endif
+
+//
+// Measurement
+//
+
+static inline uint64_t read_cycle_counter()
+{
+#if BENCH_HAVE_CYCLE_COUNTER
+    return static_cast<uint64_t>(__rdtsc());
+#else
+    return 0;
+#endif
+}
+
+struct bench_options {
+    int iterations;
+    int warmup;
+    double duration;
+    std::string filter;
+    std::string output;
+    bool list_only;
+
+    bench_options() : iterations(20), warmup(2), duration(1.0), filter(), output(), list_only(false) {}
+};
+
+class bench_runner {
+public:
+    virtual ~bench_runner() {}
+
+    /**
+     * Process the whole source signal once.
+     * @returns number of output frames
+     */
+    virtual int run() = 0;
+
+    virtual int num_input_frames() const = 0;
+};
+
+template <class TResampler>
+class resampler_bench_runner : public bench_runner {
+public:
+    typedef typename TResampler::src_frame_t src_frame_t;
+    typedef typename TResampler::dest_frame_t dest_frame_t;
+
+    resampler_bench_runner(std::unique_ptr<TResampler> &&r, std::shared_ptr<void> &&owner, int num_src_frames,
+                           double ratio)
+        : r_(std::move(r)), owner_(std::move(owner)), src_(num_src_frames),
+          dest_(static_cast<size_t>(num_src_frames * ratio) + 65536)
+    {
+        for (int i = 0; i < num_src_frames; ++i) {
+            for (int ch = 0; ch < src_frame_t::num_channels; ++ch) {
+                // 1 kHz sine (-6 dB) at 48 kHz; the actual frequency does not affect the processing time
+                src_[i].c(ch) = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 1000.0 * i / 48000.0 + ch));
+            }
+        }
+    }
+
+    virtual int run()
+    {
+        TResampler &r = *r_;
+        const int n_src = static_cast<int>(src_.size());
+        const int n_dest = static_cast<int>(dest_.size());
+        int src_index = 0;
+        int dest_index = 0;
+
+        r.reset();
+
+        while (src_index < n_src) {
+            const int n_put = (std::min)(r.num_can_put(), (n_src - src_index));
+            r.put_n(&src_[src_index], n_put);
+            src_index += n_put;
+
+            const int n_get = (std::min)(r.num_can_get(), (n_dest - dest_index));
+            r.get_n(&dest_[dest_index], n_get);
+            dest_index += n_get;
+        }
+
+        r.flush();
+
+        while (true) {
+            const int n_get = (std::min)(r.num_can_get(), (n_dest - dest_index));
+
+            if (n_get == 0) {
+                break;
+            }
+
+            r.get_n(&dest_[dest_index], n_get);
+            dest_index += n_get;
+        }
+
+        return dest_index;
+    }
+
+    virtual int num_input_frames() const { return static_cast<int>(src_.size()); }
+
+private:
+    std::unique_ptr<TResampler> r_;
+    std::shared_ptr<void> owner_; // keeps the coefficients tables alive
+    std::vector<src_frame_t> src_;
+    std::vector<dest_frame_t> dest_;
+};
+
+template <typename TFrame, class TCoreOperator>
+static void perform_filter(filter::biquad_filter<TFrame, TCoreOperator> &f, const float *src, float *dest,
+                           int n) CXXPH_NOEXCEPT
+{
+    f.perform(reinterpret_cast<const TFrame *>(src), reinterpret_cast<TFrame *>(dest), n);
+}
+
+template <class TCoreOperator>
+static void perform_filter(filter::multichannel_biquad_filter<TCoreOperator> &f, const float *src, float *dest,
+                           int n) CXXPH_NOEXCEPT
+{
+    f.perform(src, dest, n);
+}
+
+template <class TFilter>
+class filter_bench_runner : public bench_runner {
+public:
+    // same block size as the halfband/polyphase runners feed at once in typical audio callbacks
+    enum { block_size = 512 };
+
+    filter_bench_runner(std::unique_ptr<TFilter> &&f, int num_channels, int num_src_frames)
+        : f_(std::move(f)), num_channels_(num_channels), num_frames_(num_src_frames),
+          src_(static_cast<size_t>(num_src_frames) * num_channels),
+          dest_(static_cast<size_t>(num_src_frames) * num_channels)
+    {
+        for (int i = 0; i < num_src_frames; ++i) {
+            for (int ch = 0; ch < num_channels; ++ch) {
+                src_[static_cast<size_t>(i) * num_channels + ch] =
+                    static_cast<float>(0.5 * std::sin(2.0 * M_PI * 1000.0 * i / 48000.0 + ch));
+            }
+        }
+    }
+
+    virtual int run()
+    {
+        TFilter &f = *f_;
+
+        f.reset();
+
+        for (int i = 0; i < num_frames_; i += block_size) {
+            const int n = (std::min)(static_cast<int>(block_size), (num_frames_ - i));
+            const size_t offset = static_cast<size_t>(i) * num_channels_;
+
+            perform_filter(f, &src_[offset], &dest_[offset], n);
+        }
+
+        return num_frames_;
+    }
+
+    virtual int num_input_frames() const { return num_frames_; }
+
+private:
+    std::unique_ptr<TFilter> f_;
+    int num_channels_;
+    int num_frames_;
+    std::vector<float> src_;
+    std::vector<float> dest_;
+};
+
+struct bench_case {
+    std::string name;
+    std::string kind;
+    std::string core_operator;
+    int channels;
+    int src_freq;
+    int dest_freq;
+    int quality;
+    bool supported;
+    std::function<std::unique_ptr<bench_runner>(int num_src_frames)> create;
+};
+
+struct bench_stats {
+    double min;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
+static bench_stats calc_stats(std::vector<double> values)
+{
+    bench_stats s;
+
+    std::sort(values.begin(), values.end());
+
+    // nearest-rank percentile
+    auto percentile = [&values](double p) {
+        const int n = static_cast<int>(values.size());
+        int rank = static_cast<int>(std::ceil((p / 100.0) * n)) - 1;
+        rank = (std::max)(0, (std::min)(rank, n - 1));
+        return values[rank];
+    };
+
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+
+    s.min = values.front();
+    s.mean = sum / values.size();
+    s.p50 = percentile(50.0);
+    s.p90 = percentile(90.0);
+    s.p99 = percentile(99.0);
+    s.max = values.back();
+
+    return s;
+}
+
+//
+// Benchmark cases
+//
+
+static resampler::smart_resampler_params_factory::quality_spec_t conv_to_smart_resampler_quality(int q)
+{
+    switch (q) {
+    case 1:
+        return resampler::smart_resampler_params_factory::LowQuality;
+    case 2:
+        return resampler::smart_resampler_params_factory::MidQuality;
+    default:
+        return resampler::smart_resampler_params_factory::HighQuality;
+    }
+}
+
+static std::string format_rate_pair(int src_freq, int dest_freq)
+{
+    std::ostringstream ss;
+    ss << src_freq << "-" << dest_freq;
+    return ss.str();
+}
+
+// halfband_x2_resampler / halfband_x2_decimator  (stage 1 kernel of smart_resampler)
+template <class TCoreOperator>
+static void add_halfband_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef typename TCoreOperator::src_frame_t frame_t;
+    typedef resampler::halfband_x2_resampler<frame_t, frame_t, float, TCoreOperator> upsampler_t;
+    typedef resampler::halfband_x2_decimator<frame_t, frame_t, float, TCoreOperator> decimator_t;
+    typedef resampler::smart_resampler_params_factory factory_t;
+
+    for (int q = 1; q <= 2; ++q) {
+        for (int down = 0; down < 2; ++down) {
+            bench_case c;
+            const int src_freq = (down) ? 96000 : 48000;
+            const int dest_freq = (down) ? 48000 : 96000;
+
+            c.kind = (down) ? "halfband_x2_decimator" : "halfband_x2_resampler";
+            c.core_operator = op_name;
+            c.channels = frame_t::num_channels;
+            c.src_freq = src_freq;
+            c.dest_freq = dest_freq;
+            c.quality = q;
+            c.supported = supported;
+            c.name = c.kind + "/" + op_name + "/q" + std::to_string(q);
+            c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+                std::shared_ptr<factory_t> factory(
+                    new factory_t(src_freq, dest_freq, conv_to_smart_resampler_quality(q)));
+                const resampler::smart_resampler_params::stage1_x2_fir_info &s1 = factory->params().stage1;
+
+                if (down) {
+                    std::unique_ptr<decimator_t> r(new decimator_t(s1.coeffs, s1.n_coeffs, 2));
+                    return std::unique_ptr<bench_runner>(
+                        new resampler_bench_runner<decimator_t>(std::move(r), factory, num_src_frames, 0.5));
+                } else {
+                    std::unique_ptr<upsampler_t> r(new upsampler_t(s1.coeffs, s1.n_coeffs, 2));
+                    return std::unique_ptr<bench_runner>(
+                        new resampler_bench_runner<upsampler_t>(std::move(r), factory, num_src_frames, 2.0));
+                }
+            };
+
+            cases.push_back(c);
+        }
+    }
+}
+
+// halfband_cascade_resampler  (x4 / 1/4, long kernel at the low sample rate)
+template <class TCoreOperator>
+static void add_halfband_cascade_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef typename TCoreOperator::src_frame_t frame_t;
+    typedef resampler::halfband_cascade_resampler<frame_t, frame_t, float, TCoreOperator> cascade_t;
+    typedef resampler::smart_resampler_params_factory factory_t;
+
+    for (int down = 0; down < 2; ++down) {
+        bench_case c;
+        const int src_freq = (down) ? 192000 : 48000;
+        const int dest_freq = (down) ? 48000 : 192000;
+
+        c.kind = "halfband_cascade_resampler";
+        c.core_operator = op_name;
+        c.channels = frame_t::num_channels;
+        c.src_freq = src_freq;
+        c.dest_freq = dest_freq;
+        c.quality = 2;
+        c.supported = supported;
+        c.name = c.kind + "/" + op_name + "/" + format_rate_pair(src_freq, dest_freq);
+        c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+            std::shared_ptr<std::pair<factory_t, factory_t>> factories(new std::pair<factory_t, factory_t>(
+                std::piecewise_construct, std::forward_as_tuple(48000, 96000, factory_t::MidQuality),
+                std::forward_as_tuple(48000, 96000, factory_t::LowQuality)));
+            const resampler::smart_resampler_params::stage1_x2_fir_info &long_s1 = factories->first.params().stage1;
+            const resampler::smart_resampler_params::stage1_x2_fir_info &short_s1 = factories->second.params().stage1;
+            const float *kernels[2];
+            int lengths[2];
+
+            kernels[(down) ? 1 : 0] = long_s1.coeffs;
+            lengths[(down) ? 1 : 0] = long_s1.n_coeffs;
+            kernels[(down) ? 0 : 1] = short_s1.coeffs;
+            lengths[(down) ? 0 : 1] = short_s1.n_coeffs;
+
+            std::unique_ptr<cascade_t> r(new cascade_t((down) ? cascade_t::Downsampling : cascade_t::Upsampling, 2,
+                                                       kernels, lengths, 2));
+            return std::unique_ptr<bench_runner>(
+                new resampler_bench_runner<cascade_t>(std::move(r), factories, num_src_frames, (down) ? 0.25 : 4.0));
+        };
+
+        cases.push_back(c);
+    }
+}
+
+// polyphase_resampler  (stage 2 kernel of smart_resampler)
+template <class TCoreOperator>
+static void add_polyphase_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef typename TCoreOperator::src_frame_t frame_t;
+    typedef resampler::polyphase_resampler<frame_t, frame_t, float, TCoreOperator> resampler_t;
+    typedef resampler::smart_resampler_params_factory factory_t;
+
+    static const int rate_pairs[][2] = { { 44100, 48000 }, { 48000, 44100 } };
+
+    for (const auto &rate_pair : rate_pairs) {
+        for (int q = 1; q <= 2; ++q) {
+            std::shared_ptr<factory_t> factory(
+                new factory_t(rate_pair[0], rate_pair[1], conv_to_smart_resampler_quality(q)));
+            const resampler::smart_resampler_params &params = factory->params();
+            bench_case c;
+
+            // stage 2 converts (stage 1 output rate) -> (destination rate)
+            const int src_freq = (params.have_stage1) ? (rate_pair[0] * 2) : rate_pair[0];
+            const int dest_freq = rate_pair[1];
+
+            c.kind = "polyphase_resampler";
+            c.core_operator = op_name;
+            c.channels = frame_t::num_channels;
+            c.src_freq = src_freq;
+            c.dest_freq = dest_freq;
+            c.quality = q;
+            c.supported = supported;
+            c.name = c.kind + "/" + op_name + "/" + format_rate_pair(src_freq, dest_freq) + "/q" + std::to_string(q);
+            c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+                const resampler::smart_resampler_params::stage2_poly_fir_info &s2 = factory->params().stage2;
+
+                std::unique_ptr<resampler_t> r(
+                    new resampler_t(s2.coeffs, s2.n_coeffs, !(s2.is_static), s2.m, s2.l, 4096));
+                return std::unique_ptr<bench_runner>(new resampler_bench_runner<resampler_t>(
+                    std::move(r), factory, num_src_frames, static_cast<double>(s2.m) / s2.l));
+            };
+
+            cases.push_back(c);
+        }
+    }
+}
+
+// variable_ratio_polyphase_resampler  (Kaiser windowed sinc prototype, 64 phases)
+template <class TCoreOperator>
+static void add_variable_ratio_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef typename TCoreOperator::src_frame_t frame_t;
+    typedef resampler::variable_ratio_polyphase_resampler<frame_t, frame_t, float, TCoreOperator> resampler_t;
+
+    // 44101 Hz -> 48000 Hz: (nearly) coprime pair which the fixed ratio polyphase resampler does not design
+    static const int rate_pairs[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 44101, 48000 } };
+    static const int num_phases = 64;
+
+    for (const auto &rate_pair : rate_pairs) {
+        for (int q = 1; q <= 2; ++q) {
+            bench_case c;
+            const int src_freq = rate_pair[0];
+            const int dest_freq = rate_pair[1];
+
+            c.kind = "variable_ratio_polyphase_resampler";
+            c.core_operator = op_name;
+            c.channels = frame_t::num_channels;
+            c.src_freq = src_freq;
+            c.dest_freq = dest_freq;
+            c.quality = q;
+            c.supported = supported;
+            c.name = c.kind + "/" + op_name + "/" + format_rate_pair(src_freq, dest_freq) + "/q" + std::to_string(q);
+            c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+                const double ratio = static_cast<double>(dest_freq) / src_freq;
+                const int num_taps = (q == 1) ? 16 : 32;
+                const int n = num_phases * num_taps - 1;
+                const double fc = 0.45 * (std::min)(1.0, ratio) / num_phases;
+                std::vector<float> coeffs(n);
+
+                window::generate_kaiser_window(&coeffs[0], n, 8.0);
+
+                for (int i = 0; i < n; ++i) {
+                    const double x = (i - (n - 1) * 0.5) * 2.0 * fc;
+                    const double sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    coeffs[i] = static_cast<float>(2.0 * fc * sinc * coeffs[i]);
+                }
+
+                // the resampler makes its own copy of the coefficients
+                std::unique_ptr<resampler_t> r(new resampler_t(&coeffs[0], n, num_phases, ratio, 4096));
+                return std::unique_ptr<bench_runner>(new resampler_bench_runner<resampler_t>(
+                    std::move(r), std::shared_ptr<void>(), num_src_frames, ratio));
+            };
+
+            cases.push_back(c);
+        }
+    }
+}
+
+// smart_resampler  (same rate pairs as utils/benchmark_resampler_speed.sh)
+template <class TFrame, class THalfbandOperator, class TPolyphaseOperator>
+static void add_smart_resampler_cases(std::vector<bench_case> &cases, const char *op_name)
+{
+    typedef resampler::smart_resampler_params_factory factory_t;
+
+    static const int src_freq_list[] = { 8000,  11025, 12000, 16000, 22050,  24000, 32000,
+                                         44100, 48000, 88200, 96000, 176400, 192000 };
+    static const int dest_freq_list[] = { 44100, 48000 };
+    static const int quality_list[] = { 1, 2, 4, 5 };
+
+    for (int dest_freq : dest_freq_list) {
+        for (int q : quality_list) {
+            for (int src_freq : src_freq_list) {
+                bench_case c;
+
+                c.kind = "smart_resampler";
+                c.core_operator = op_name;
+                c.channels = TFrame::num_channels;
+                c.src_freq = src_freq;
+                c.dest_freq = dest_freq;
+                c.quality = q;
+                c.supported = THalfbandOperator::is_supported() && TPolyphaseOperator::is_supported();
+                c.name = c.kind + "/" + op_name + "/" + format_rate_pair(src_freq, dest_freq) + "/q" +
+                         std::to_string(q);
+                c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+                    std::shared_ptr<factory_t> factory(
+                        new factory_t(src_freq, dest_freq, conv_to_smart_resampler_quality(q)));
+
+                    if (!(*factory)) {
+                        return std::unique_ptr<bench_runner>();
+                    }
+
+                    const double ratio = static_cast<double>(dest_freq) / src_freq;
+
+                    if (q == 5) {
+                        // NOTE: Quality 5 requires double precision FFT
+                        typedef resampler::smart_resampler<TFrame, TFrame, THalfbandOperator, app_fft_backend_d,
+                                                           TPolyphaseOperator> resampler_t;
+                        std::unique_ptr<resampler_t> r(new resampler_t(factory->params()));
+                        return std::unique_ptr<bench_runner>(
+                            new resampler_bench_runner<resampler_t>(std::move(r), factory, num_src_frames, ratio));
+                    } else {
+                        typedef resampler::smart_resampler<TFrame, TFrame, THalfbandOperator, app_fft_backend_f,
+                                                           TPolyphaseOperator> resampler_t;
+                        std::unique_ptr<resampler_t> r(new resampler_t(factory->params()));
+                        return std::unique_ptr<bench_runner>(
+                            new resampler_bench_runner<resampler_t>(std::move(r), factory, num_src_frames, ratio));
+                    }
+                };
+
+                cases.push_back(c);
+            }
+        }
+    }
+}
+
+// biquad_filter  (peaking EQ, 48 kHz)
+template <class TCoreOperator>
+static void add_biquad_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef typename TCoreOperator::frame_type frame_t;
+    typedef filter::biquad_filter<frame_t, TCoreOperator> filter_t;
+
+    bench_case c;
+
+    c.kind = "biquad_filter";
+    c.core_operator = op_name;
+    c.channels = frame_t::num_channels;
+    c.src_freq = 48000;
+    c.dest_freq = 48000;
+    c.quality = 0;
+    c.supported = supported;
+    c.name = c.kind + "/" + op_name;
+    c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+        std::unique_ptr<filter_t> f(new filter_t());
+
+        if (!f->init(filter::filter_params_t(filter::types::Peak, 48000, 1000, 6.0, 0.7))) {
+            return std::unique_ptr<bench_runner>();
+        }
+
+        return std::unique_ptr<bench_runner>(
+            new filter_bench_runner<filter_t>(std::move(f), frame_t::num_channels, num_src_frames));
+    };
+
+    cases.push_back(c);
+}
+
+// multichannel_biquad_filter  (peaking EQ, 48 kHz)
+template <class TCoreOperator>
+static void add_multichannel_biquad_cases(std::vector<bench_case> &cases, const char *op_name, bool supported)
+{
+    typedef filter::multichannel_biquad_filter<TCoreOperator> filter_t;
+
+    static const int channels_list[] = { 2, 8, 32 };
+
+    for (int num_channels : channels_list) {
+        bench_case c;
+
+        c.kind = "multichannel_biquad_filter";
+        c.core_operator = op_name;
+        c.channels = num_channels;
+        c.src_freq = 48000;
+        c.dest_freq = 48000;
+        c.quality = 0;
+        c.supported = supported;
+        c.name = c.kind + "/" + op_name + "/" + std::to_string(num_channels) + "ch";
+        c.create = [=](int num_src_frames) -> std::unique_ptr<bench_runner> {
+            std::unique_ptr<filter_t> f(new filter_t());
+
+            if (!f->init(num_channels, filter::filter_params_t(filter::types::Peak, 48000, 1000, 6.0, 0.7))) {
+                return std::unique_ptr<bench_runner>();
+            }
+
+            return std::unique_ptr<bench_runner>(
+                new filter_bench_runner<filter_t>(std::move(f), num_channels, num_src_frames));
+        };
+
+        cases.push_back(c);
+    }
+}
+
+#define ADD_HALFBAND_CASES(cases, op_type, op_name)                                                                    \
+    add_halfband_cases<resampler::op_type>(cases, op_name, resampler::op_type::is_supported());                        \
+    add_halfband_cascade_cases<resampler::op_type>(cases, op_name, resampler::op_type::is_supported())
+
+#define ADD_POLYPHASE_CASES(cases, op_type, op_name)                                                                   \
+    add_polyphase_cases<resampler::op_type>(cases, op_name, resampler::op_type::is_supported());                      \
+    add_variable_ratio_cases<resampler::op_type>(cases, op_name, resampler::op_type::is_supported())
+
+#define ADD_BIQUAD_CASES(cases, op_type, op_name)                                                                      \
+    add_biquad_cases<filter::op_type>(cases, op_name, filter::op_type::is_supported())
+
+#define ADD_MULTICHANNEL_BIQUAD_CASES(cases, op_type, op_name)                                                         \
+    add_multichannel_biquad_cases<filter::op_type>(cases, op_name, filter::op_type::is_supported())
+
+static std::vector<bench_case> make_bench_cases()
+{
+    std::vector<bench_case> cases;
+
+    // halfband core operators
+    ADD_HALFBAND_CASES(cases, f32_mono_basic_halfband_x2_resampler_core_operator, "f32_mono_basic");
+    ADD_HALFBAND_CASES(cases, f32_stereo_basic_halfband_x2_resampler_core_operator, "f32_stereo_basic");
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    ADD_HALFBAND_CASES(cases, f32_mono_sse_halfband_x2_resampler_core_operator, "f32_mono_sse");
+    ADD_HALFBAND_CASES(cases, f32_stereo_sse_halfband_x2_resampler_core_operator, "f32_stereo_sse");
+#endif
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    ADD_HALFBAND_CASES(cases, f32_mono_neon_halfband_x2_resampler_core_operator, "f32_mono_neon");
+    ADD_HALFBAND_CASES(cases, f32_stereo_neon_halfband_x2_resampler_core_operator, "f32_stereo_neon");
+#endif
+
+    // polyphase core operators
+    ADD_POLYPHASE_CASES(cases, f32_mono_basic_polyphase_core_operator, "f32_mono_basic");
+    ADD_POLYPHASE_CASES(cases, f32_stereo_basic_polyphase_core_operator, "f32_stereo_basic");
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    ADD_POLYPHASE_CASES(cases, f32_mono_sse_polyphase_core_operator, "f32_mono_sse");
+    ADD_POLYPHASE_CASES(cases, f32_stereo_sse_polyphase_core_operator, "f32_stereo_sse");
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    ADD_POLYPHASE_CASES(cases, f32_mono_sse3_polyphase_core_operator, "f32_mono_sse3");
+#endif
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+    ADD_POLYPHASE_CASES(cases, f32_mono_avx2_polyphase_core_operator, "f32_mono_avx2");
+    ADD_POLYPHASE_CASES(cases, f32_stereo_avx2_polyphase_core_operator, "f32_stereo_avx2");
+#endif
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    ADD_POLYPHASE_CASES(cases, f32_mono_neon_polyphase_core_operator, "f32_mono_neon");
+    ADD_POLYPHASE_CASES(cases, f32_stereo_neon_polyphase_core_operator, "f32_stereo_neon");
+#endif
+
+    // smart_resampler (fastest available core operators)
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+    if (resampler::f32_mono_avx2_polyphase_core_operator::is_supported()) {
+        add_smart_resampler_cases<datatype::f32_mono_frame_t, f32_mono_fast_halfband_core_operator,
+                                  resampler::f32_mono_avx2_polyphase_core_operator>(cases, "f32_mono_fast");
+    } else
+#endif
+    {
+        add_smart_resampler_cases<datatype::f32_mono_frame_t, f32_mono_fast_halfband_core_operator,
+                                  f32_mono_fast_polyphase_core_operator>(cases, "f32_mono_fast");
+    }
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+    if (resampler::f32_stereo_avx2_polyphase_core_operator::is_supported()) {
+        add_smart_resampler_cases<datatype::f32_stereo_frame_t, f32_stereo_fast_halfband_core_operator,
+                                  resampler::f32_stereo_avx2_polyphase_core_operator>(cases, "f32_stereo_fast");
+    } else
+#endif
+    {
+        add_smart_resampler_cases<datatype::f32_stereo_frame_t, f32_stereo_fast_halfband_core_operator,
+                                  f32_stereo_fast_polyphase_core_operator>(cases, "f32_stereo_fast");
+    }
+
+    // biquad filter core operators
+    typedef filter::general_biquad_direct_form_1_core_operator<datatype::f32_mono_frame_t> f32_mono_general_df1_t;
+    typedef filter::general_biquad_direct_form_1_core_operator<datatype::f32_stereo_frame_t> f32_stereo_general_df1_t;
+    typedef filter::general_biquad_transposed_direct_form_2_core_operator<datatype::f32_mono_frame_t>
+        f32_mono_general_tdf2_t;
+    typedef filter::general_biquad_transposed_direct_form_2_core_operator<datatype::f32_stereo_frame_t>
+        f32_stereo_general_tdf2_t;
+
+    add_biquad_cases<f32_mono_general_df1_t>(cases, "f32_mono_general_df1", true);
+    add_biquad_cases<f32_stereo_general_df1_t>(cases, "f32_stereo_general_df1", true);
+    add_biquad_cases<f32_mono_general_tdf2_t>(cases, "f32_mono_general_tdf2", true);
+    add_biquad_cases<f32_stereo_general_tdf2_t>(cases, "f32_stereo_general_tdf2", true);
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    ADD_BIQUAD_CASES(cases, f32_mono_sse_biquad_direct_form_1_core_operator, "f32_mono_sse_df1");
+    ADD_BIQUAD_CASES(cases, f32_stereo_sse_biquad_direct_form_1_core_operator, "f32_stereo_sse_df1");
+    ADD_BIQUAD_CASES(cases, f32_mono_sse_biquad_transposed_direct_form_2_core_operator, "f32_mono_sse_tdf2");
+    ADD_BIQUAD_CASES(cases, f32_stereo_sse_biquad_transposed_direct_form_2_core_operator, "f32_stereo_sse_tdf2");
+#endif
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    ADD_BIQUAD_CASES(cases, f32_stereo_avx_biquad_direct_form_1_core_operator, "f32_stereo_avx_df1");
+    ADD_BIQUAD_CASES(cases, f32_stereo_avx_biquad_transposed_direct_form_2_core_operator, "f32_stereo_avx_tdf2");
+#endif
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    ADD_BIQUAD_CASES(cases, f32_mono_neon_biquad_direct_form_1_core_operator, "f32_mono_neon_df1");
+    ADD_BIQUAD_CASES(cases, f32_stereo_neon_biquad_direct_form_1_core_operator, "f32_stereo_neon_df1");
+    ADD_BIQUAD_CASES(cases, f32_mono_neon_biquad_transposed_direct_form_2_core_operator, "f32_mono_neon_tdf2");
+    ADD_BIQUAD_CASES(cases, f32_stereo_neon_biquad_transposed_direct_form_2_core_operator, "f32_stereo_neon_tdf2");
+#endif
+
+    // multichannel biquad filter core operators
+    typedef filter::general_multichannel_biquad_core_operator<float, 4> f32_general_multichannel_t;
+
+    add_multichannel_biquad_cases<f32_general_multichannel_t>(cases, "f32_general", true);
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    ADD_MULTICHANNEL_BIQUAD_CASES(cases, f32_sse_multichannel_biquad_core_operator, "f32_sse");
+#endif
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    ADD_MULTICHANNEL_BIQUAD_CASES(cases, f32_avx_multichannel_biquad_core_operator, "f32_avx");
+#endif
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX512F
+    ADD_MULTICHANNEL_BIQUAD_CASES(cases, f32_avx512_multichannel_biquad_core_operator, "f32_avx512");
+#endif
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    ADD_MULTICHANNEL_BIQUAD_CASES(cases, f32_neon_multichannel_biquad_core_operator, "f32_neon");
+#endif
+
+    return cases;
+}
+
+//
+// JSON output
+//
+
+static void write_json_stats(std::ostream &os, const char *key, const bench_stats &s)
+{
+    os << "\"" << key << "\": {"
+       << "\"min\": " << s.min << ", "
+       << "\"mean\": " << s.mean << ", "
+       << "\"p50\": " << s.p50 << ", "
+       << "\"p90\": " << s.p90 << ", "
+       << "\"p99\": " << s.p99 << ", "
+       << "\"max\": " << s.max << "}";
+}
+
+static bool run_bench_case(const bench_case &c, const bench_options &opts, std::ostream &os, bool first)
+{
+    const int num_src_frames = static_cast<int>(opts.duration * c.src_freq);
+    std::unique_ptr<bench_runner> runner(c.create(num_src_frames));
+
+    if (!runner) {
+        return false;
+    }
+
+    std::vector<double> ns_per_output_frame;
+    std::vector<double> cycles_per_frame;
+    int num_output_frames = 0;
+
+    for (int i = 0; i < opts.warmup; ++i) {
+        runner->run();
+    }
+
+    for (int i = 0; i < opts.iterations; ++i) {
+        utils::stopwatch sw;
+
+        sw.start();
+        const uint64_t c_start = read_cycle_counter();
+        num_output_frames = runner->run();
+        const uint64_t c_end = read_cycle_counter();
+        sw.stop();
+
+        const double n = (std::max)(1, num_output_frames);
+        ns_per_output_frame.push_back(sw.get_elapsed_time_ns() / n);
+        cycles_per_frame.push_back((c_end - c_start) / n);
+    }
+
+    const bench_stats ns_stats = calc_stats(ns_per_output_frame);
+
+    os << ((first) ? "\n" : ",\n");
+    os << "    {"
+       << "\"name\": \"" << c.name << "\", "
+       << "\"kind\": \"" << c.kind << "\", "
+       << "\"core_operator\": \"" << c.core_operator << "\", "
+       << "\"channels\": " << c.channels << ", "
+       << "\"src_freq\": " << c.src_freq << ", "
+       << "\"dest_freq\": " << c.dest_freq << ", "
+       << "\"quality\": " << c.quality << ", "
+       << "\"input_frames\": " << runner->num_input_frames() << ", "
+       << "\"output_frames\": " << num_output_frames << ", ";
+    write_json_stats(os, "ns_per_output_frame", ns_stats);
+    os << ", \"output_frames_per_sec\": " << ((ns_stats.p50 > 0.0) ? (1.0e9 / ns_stats.p50) : 0.0) << ", ";
+#if BENCH_HAVE_CYCLE_COUNTER
+    write_json_stats(os, "cycles_per_output_frame", calc_stats(cycles_per_frame));
+#else
+    os << "\"cycles_per_output_frame\": null";
+#endif
+    os << "}";
+
+    return true;
+}
+
+static void print_usage(const char *exe_name)
+{
+    std::cout << "Usage:" << std::endl;
+    std::cout << "    " << exe_name
+              << " [--iterations N] [--warmup N] [--duration SEC] [--filter SUBSTRING] [--output FILE] [--list]"
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "    --iterations N     number of measured runs per case (default: 20)" << std::endl;
+    std::cout << "    --warmup N         number of unmeasured runs per case (default: 2)" << std::endl;
+    std::cout << "    --duration SEC     length of the synthetic source signal (default: 1.0)" << std::endl;
+    std::cout << "    --filter SUBSTRING run only the cases whose name contains SUBSTRING" << std::endl;
+    std::cout << "    --output FILE      write the JSON report to FILE instead of stdout" << std::endl;
+    std::cout << "    --list             list the case names and exit" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Example (all polyphase core operators, 50 runs each):" << std::endl;
+    std::cout << "    " << exe_name << " --filter polyphase_resampler/ --iterations 50" << std::endl;
+    std::cout << std::endl;
+}
+
+static bool parse_options(int argc, char const *argv[], bench_options &opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1) < argc;
+
+        if (arg == "--iterations" && has_value) {
+            opts.iterations = (std::max)(1, atoi(argv[++i]));
+        } else if (arg == "--warmup" && has_value) {
+            opts.warmup = (std::max)(0, atoi(argv[++i]));
+        } else if (arg == "--duration" && has_value) {
+            opts.duration = atof(argv[++i]);
+        } else if (arg == "--filter" && has_value) {
+            opts.filter = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            opts.output = argv[++i];
+        } else if (arg == "--list") {
+            opts.list_only = true;
+        } else {
+            return false;
+        }
+    }
+
+    return (opts.duration > 0.0);
+}
+
+int main(int argc, char const *argv[])
+{
+    bench_options opts;
+
+    if (!parse_options(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // initialize
+    cxxdasp_init();
+
+    const std::vector<bench_case> cases = make_bench_cases();
+
+    if (opts.list_only) {
+        for (const bench_case &c : cases) {
+            std::cout << c.name << ((c.supported) ? "" : "  (not supported)") << std::endl;
+        }
+        return 0;
+    }
+
+    std::ofstream ofs;
+    if (!opts.output.empty()) {
+        ofs.open(opts.output.c_str());
+        if (!ofs) {
+            std::cerr << "Failed to open " << opts.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &os = (ofs.is_open()) ? static_cast<std::ostream &>(ofs) : std::cout;
+
+    os << std::setprecision(6);
+    os << "{" << std::endl;
+    os << "  \"library\": \"cxxdasp\"," << std::endl;
+    os << "  \"iterations\": " << opts.iterations << "," << std::endl;
+    os << "  \"warmup\": " << opts.warmup << "," << std::endl;
+    os << "  \"duration_sec\": " << opts.duration << "," << std::endl;
+#if BENCH_HAVE_CYCLE_COUNTER
+    os << "  \"cycle_counter\": \"rdtsc\"," << std::endl;
+#else
+    os << "  \"cycle_counter\": null," << std::endl;
+#endif
+    os << "  \"results\": [";
+
+    std::vector<std::string> skipped;
+    bool first = true;
+
+    for (const bench_case &c : cases) {
+        if (!opts.filter.empty() && c.name.find(opts.filter) == std::string::npos) {
+            continue;
+        }
+
+        if (!c.supported || !run_bench_case(c, opts, os, first)) {
+            skipped.push_back(c.name);
+            continue;
+        }
+
+        first = false;
+        os.flush();
+    }
+
+    os << "\n  ]," << std::endl;
+    os << "  \"skipped\": [";
+    for (size_t i = 0; i < skipped.size(); ++i) {
+        os << ((i == 0) ? "" : ", ") << "\"" << skipped[i] << "\"";
+    }
+    os << "]" << std::endl;
+    os << "}" << std::endl;
+
+    return 0;
+}
@@ -16,6 +16,12 @@ option(CXXDASP_CONFIG_USE_FFT_BACKEND_GP_FFT    "Use General Purpose FFT package
 option(CXXDASP_CONFIG_USE_FFT_BACKEND_FFTW      "Use FFTW library for double-precision FFT backend  (not compatible with MSVC)"           NO)
 option(CXXDASP_CONFIG_USE_FFT_BACKEND_KFR_D     "Use KFR library for double-precision FFT backend  (compatible with all platforms)"       NO)
 
+### built-in FFT (single and double precision)
+option(CXXDASP_CONFIG_USE_FFT_BACKEND_MIXED_RADIX "Use built-in mixed-radix FFT for single and double-precision FFT backend  (no external library required)" YES)
+
+### misc.
+option(CXXDASP_CONFIG_USE_MIRRORED_DELAY_LINE   "Use mirror-mapped delay line for polyphase resampler  (Linux and Android only)"         NO)
+
 #
 # Build targets
 #
@@ -31,14 +37,20 @@ option(CXXDASP_BUILD_EXAMPLE_X2_RESAMPLER           "Build x2-resampler example
 option(CXXDASP_BUILD_EXAMPLE_SAMPLE_FORMAT_CONVERTER "Build sample-format-converter example app"        YES)
 option(CXXDASP_BUILD_EXAMPLE_WINDOW_FUNCTION        "Build window-function example app"                 YES)
 
+option(CXXDASP_BUILD_BENCHMARK_CXXDASP_BENCH      "Build cxxdasp_bench benchmark app"                 YES)
+
 option(CXXDASP_BUILD_TEST_UTILS_UTILS               "Build utils_utils test tartet"                     YES)
 option(CXXDASP_BUILD_TEST_FFT                       "Build fft test target"                             YES)
+option(CXXDASP_BUILD_TEST_RESAMPLER_HALFBAND        "Build resampler_halfband test target"              YES)
 option(CXXDASP_BUILD_TEST_RESAMPLER_POLYPHASE       "Build resampler_polyphase test target"             YES)
+option(CXXDASP_BUILD_TEST_RESAMPLER_SMART           "Build resampler_smart test target"                 YES)
 option(CXXDASP_BUILD_TEST_FILTER_BIQUAD_DF1         "Build filter_biquad_df1 test target"               YES)
 option(CXXDASP_BUILD_TEST_FILTER_BIQUAD_TDF2        "Build filter_biquad_tdf2 test target"              YES)
 option(CXXDASP_BUILD_TEST_FILTER_CASCADED_BIQUAD_DF1 "Build filter_cascaded_biquad_df1 test target"     YES)
 option(CXXDASP_BUILD_TEST_FILTER_CASCADED_BIQUAD_TDF2 "Build filter_cascaded_biquad_tdf2 test target"   YES)
+option(CXXDASP_BUILD_TEST_FILTER_MULTICHANNEL_BIQUAD "Build filter_multichannel_biquad test target"   YES)
 option(CXXDASP_BUILD_TEST_FILTER_TSVF               "Build filter_tsvf test target"                     YES)
 option(CXXDASP_BUILD_TEST_FILTER_CASCADED_TSVF      "Build filter_cascaded_tsvf test target"            YES)
+option(CXXDASP_BUILD_TEST_FILTER_FFT_CONVOLVER     "Build filter_fft_convolver test target"            YES)
 option(CXXDASP_BUILD_TEST_SAMPLE_FORMAT_CONVERTER   "Build sample_format_converter test target"         YES)
 option(CXXDASP_BUILD_TEST_MIXER                     "Build mixer test target"                           YES)
@@ -100,6 +100,9 @@ int main(int argc, char const *argv[])
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
     typedef filter::f32_mono_neon_biquad_direct_form_1_core_operator app_fast_mono_filter_operator_t;
     typedef filter::f32_stereo_neon_biquad_direct_form_1_core_operator app_fast_stereo_filter_operator_t;
+#elif(CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    typedef app_fallback_mono_filter_operator_t app_fast_mono_filter_operator_t;
+    typedef filter::f32_stereo_sse_biquad_direct_form_1_core_operator app_fast_stereo_filter_operator_t;
 #else
     typedef app_fallback_mono_filter_operator_t app_fast_mono_filter_operator_t;
     typedef app_fallback_stereo_filter_operator_t app_fast_stereo_filter_operator_t;
@@ -114,6 +117,9 @@ int main(int argc, char const *argv[])
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
     typedef filter::f32_mono_neon_biquad_transposed_direct_form_2_core_operator app_fast_mono_filter_operator_t;
     typedef filter::f32_stereo_neon_biquad_transposed_direct_form_2_core_operator app_fast_stereo_filter_operator_t;
+#elif(CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    typedef app_fallback_mono_filter_operator_t app_fast_mono_filter_operator_t;
+    typedef filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator app_fast_stereo_filter_operator_t;
 #else
     typedef app_fallback_mono_filter_operator_t app_fast_mono_filter_operator_t;
     typedef app_fallback_stereo_filter_operator_t app_fast_stereo_filter_operator_t;
@@ -109,12 +109,17 @@ int main(int argc, char const *argv[])
     app_fallback_cascaded_stereo_filter_operator_t;
 
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
-    typedef filter::f32_mono_neon_biquad_transposed_direct_form_2_core_operator app_fast_mono_filter_operator_t;
     typedef filter::f32_stereo_neon_biquad_transposed_direct_form_2_core_operator app_fast_stereo_filter_operator_t;
-    typedef filter::general_cascaded_biquad_core_operator<app_fast_mono_filter_operator_t, 2>
+    typedef filter::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
     app_fast_cascaded_mono_filter_operator_t;
     typedef filter::f32_stereo_neon_cascaded_2_biquad_transposed_direct_form_2_core_operator
     app_fast_cascaded_stereo_filter_operator_t;
+#elif(CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    typedef filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator app_fast_stereo_filter_operator_t;
+    typedef filter::f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+    app_fast_cascaded_mono_filter_operator_t;
+    typedef filter::general_cascaded_biquad_core_operator<app_fast_stereo_filter_operator_t, 2>
+    app_fast_cascaded_stereo_filter_operator_t;
 #else
     typedef app_fallback_mono_filter_operator_t app_fast_mono_filter_operator_t;
     typedef app_fallback_stereo_filter_operator_t app_fast_stereo_filter_operator_t;
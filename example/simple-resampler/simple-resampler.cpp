@@ -267,6 +267,8 @@ int main(int argc, char const *argv[])
     typedef fft::backend::f::mufft app_fft_backend_f;
 #elif CXXDASP_USE_FFT_BACKEND_KFR_F
     typedef fft::backend::f::kfr app_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+    typedef fft::backend::f::mixed_radix app_fft_backend_f;
 #else
 #error No FFT library available
 #endif
@@ -278,6 +280,8 @@ int main(int argc, char const *argv[])
     typedef fft::backend::d::fftw app_fft_backend_d;
 #elif CXXDASP_USE_FFT_BACKEND_KFR_D
     typedef fft::backend::d::kfr app_fft_backend_d;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+    typedef fft::backend::d::mixed_radix app_fft_backend_d;
 #else
 #if CXXPH_COMPILER_IS_MSVC
 #pragma message("Double - precision FFT library is not available.")
@@ -27,6 +27,11 @@
 #define CXXDASP_ENABLE_POLYPHASE_RESAMPLER_FACTORY_HIGH_QUALITY 1
 #endif
 
+// mirror-mapped delay line (polyphase resampler)
+#ifndef CXXDASP_USE_MIRRORED_DELAY_LINE
+#define CXXDASP_USE_MIRRORED_DELAY_LINE 0
+#endif
+
 // FFT backend - PFFFT
 #ifndef CXXDASP_USE_FFT_BACKEND_PFFFT
 #define CXXDASP_USE_FFT_BACKEND_PFFFT 0
@@ -67,4 +72,9 @@
 #define CXXDASP_USE_FFT_BACKEND_FFTW 0
 #endif
 
+// FFT backend - built-in mixed-radix FFT
+#ifndef CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+#define CXXDASP_USE_FFT_BACKEND_MIXED_RADIX 0
+#endif
+
 #endif // CXXDASP_CXXDASP_CONFIG_HPP_
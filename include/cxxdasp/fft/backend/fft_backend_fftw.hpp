@@ -21,7 +21,13 @@
 
 #if CXXDASP_USE_FFT_BACKEND_FFTW || CXXDASP_USE_FFT_BACKEND_FFTWF
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
 #include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
 
 #include <fftw3.h>
 
@@ -29,6 +35,67 @@ namespace cxxdasp {
 namespace fft {
 namespace backend {
 
+/**
+ * FFTW planning rigor
+ */
+enum fftw_planning_rigor_t {
+    FFTWPlanEstimate,   ///< FFTW_ESTIMATE (default)
+    FFTWPlanMeasure,    ///< FFTW_MEASURE
+    FFTWPlanPatient,    ///< FFTW_PATIENT
+    FFTWPlanExhaustive, ///< FFTW_EXHAUSTIVE
+};
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+inline std::atomic<int> &fftw_planning_rigor_storage() CXXPH_NOEXCEPT
+{
+    static std::atomic<int> rigor(FFTWPlanEstimate);
+    return rigor;
+}
+
+inline unsigned int fftw_planner_flags(fftw_planning_rigor_t rigor) CXXPH_NOEXCEPT
+{
+    switch (rigor) {
+    case FFTWPlanMeasure:
+        return FFTW_MEASURE;
+    case FFTWPlanPatient:
+        return FFTW_PATIENT;
+    case FFTWPlanExhaustive:
+        return FFTW_EXHAUSTIVE;
+    case FFTWPlanEstimate:
+    default:
+        return FFTW_ESTIMATE;
+    }
+}
+
+} // namespace impl
+/// @endcond
+
+/**
+ * Set the planning rigor of FFTW backends.
+ *
+ * @param rigor [in] planning rigor
+ *
+ * @note The rigor is applied to the plans created after this call.
+ *       Planning with FFTWPlanMeasure or higher rigor takes a while for each new transform size,
+ *       so import wisdom at startup (see fftw::import_wisdom_from_file()) to skip it.
+ */
+inline void set_fftw_planning_rigor(fftw_planning_rigor_t rigor) CXXPH_NOEXCEPT
+{
+    impl::fftw_planning_rigor_storage().store(static_cast<int>(rigor));
+}
+
+/**
+ * Get the planning rigor of FFTW backends.
+ *
+ * @returns planning rigor
+ */
+inline fftw_planning_rigor_t get_fftw_planning_rigor() CXXPH_NOEXCEPT
+{
+    return static_cast<fftw_planning_rigor_t>(impl::fftw_planning_rigor_storage().load());
+}
+
 #if CXXDASP_USE_FFT_BACKEND_FFTWF
 namespace f {
 
@@ -47,8 +114,109 @@ struct fftw {
      */
     typedef fftf_complex_t fft_complex_t;
 
+    /**
+     * Import FFTW wisdom from a file.
+     *
+     * @param filename [in] wisdom file path
+     * @returns whether the wisdom is imported successfully
+     *
+     * @note Call this after cxxdasp_init() and before creating FFT instances.
+     *       Wisdom files of single-precision and double-precision FFTW are not interchangeable.
+     */
+    static bool import_wisdom_from_file(const char *filename)
+    {
+        std::lock_guard<std::recursive_mutex> lock(::cxxdasp::fft::impl::plan_cache_mutex());
+        return ::fftwf_import_wisdom_from_filename(filename) != 0;
+    }
+
+    /**
+     * Export FFTW wisdom to a file.
+     *
+     * @param filename [in] wisdom file path
+     * @returns whether the wisdom is exported successfully
+     *
+     * @note The wisdom contains every plan made so far in this process.
+     */
+    static bool export_wisdom_to_file(const char *filename)
+    {
+        std::lock_guard<std::recursive_mutex> lock(::cxxdasp::fft::impl::plan_cache_mutex());
+        return ::fftwf_export_wisdom_to_filename(filename) != 0;
+    }
+
     /// @cond INTERNAL_FIELD
     fftw() = delete;
+
+    // NOTE:
+    // A plan can be executed on other buffers by the new-array execute functions, as long as they have
+    // the same alignment and the same in-place/out-of-place layout as the planned ones.
+    // So the plans are shared among instances which have the same transform type, size, buffer layout
+    // and planning rigor.
+    enum { plan_forward = 0, plan_inverse, plan_forward_real, plan_inverse_real };
+
+    struct plan_cache_tag {
+    };
+    typedef shared_plan_cache<plan_cache_tag, std::remove_pointer<::fftwf_plan>::type> plan_cache;
+
+    static int alignment_of(const void *p) CXXPH_NOEXCEPT
+    {
+        return ::fftwf_alignment_of(static_cast<float *>(const_cast<void *>(p)));
+    }
+
+    static int plan_variant(int kind, fftw_planning_rigor_t rigor, const void *in, const void *out) CXXPH_NOEXCEPT
+    {
+        const int in_place = (in == out) ? 1 : 0;
+        return kind | (in_place << 4) | (static_cast<int>(rigor) << 5) | (alignment_of(in) << 8) |
+               (alignment_of(out) << 16);
+    }
+
+    static void destroy_plan(::fftwf_plan plan) CXXPH_NOEXCEPT { ::fftwf_destroy_plan(plan); }
+
+    template <typename TIn, typename TOut, typename TPlanner>
+    static ::fftwf_plan make_plan(fftw_planning_rigor_t rigor, TIn *in, int in_count, TOut *out, int out_count,
+                                 TPlanner planner)
+    {
+        const unsigned int flags = impl::fftw_planner_flags(rigor) | FFTW_PRESERVE_INPUT;
+
+        if (rigor == FFTWPlanEstimate) {
+            // FFTW_ESTIMATE does not touch the arrays
+            return planner(in, out, flags);
+        }
+
+        // NOTE:
+        // Other rigors overwrite the arrays while planning, so the plan is made on scratch buffers
+        // which have the same alignment and the same in-place/out-of-place layout as the given ones.
+        const bool in_place = (static_cast<const void *>(in) == static_cast<const void *>(out));
+        const size_t in_offset = static_cast<size_t>(alignment_of(in));
+        const size_t out_offset = static_cast<size_t>(alignment_of(out));
+        const size_t in_size = sizeof(TIn) * in_count + in_offset;
+        const size_t out_size = sizeof(TOut) * out_count + out_offset;
+
+        char *scratch_in = static_cast<char *>(::fftwf_malloc((in_place) ? (std::max)(in_size, out_size) : in_size));
+        char *scratch_out = (in_place) ? scratch_in : static_cast<char *>(::fftwf_malloc(out_size));
+
+        ::fftwf_plan plan = nullptr;
+        if (scratch_in && scratch_out) {
+            plan = planner(reinterpret_cast<TIn *>(scratch_in + in_offset),
+                           reinterpret_cast<TOut *>(scratch_out + out_offset), flags);
+        }
+
+        if (!in_place) {
+            ::fftwf_free(scratch_out);
+        }
+        ::fftwf_free(scratch_in);
+
+        return plan;
+    }
+
+    template <typename TIn, typename TOut, typename TPlanner>
+    static plan_cache::plan_ptr acquire_plan(int kind, int n, TIn *in, int in_count, TOut *out, int out_count,
+                                             TPlanner planner)
+    {
+        const fftw_planning_rigor_t rigor = get_fftw_planning_rigor();
+        return plan_cache::acquire(n, plan_variant(kind, rigor, in, out),
+                                   [=]() { return make_plan(rigor, in, in_count, out, out_count, planner); },
+                                   destroy_plan);
+    }
     /// @endcond
 
     /**
@@ -65,29 +233,33 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_(0)
+        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_()
         {
-            plan_ = ::fftwf_plan_dft_1d(n, reinterpret_cast<::fftwf_complex *>(in),
-                                        reinterpret_cast<::fftwf_complex *>(out), FFTW_FORWARD,
-                                        FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftwf_plan_dft_1d(n, reinterpret_cast<::fftwf_complex *>(pin),
+                                           reinterpret_cast<::fftwf_complex *>(pout), FFTW_FORWARD, flags);
+            };
+            plan_ = acquire_plan(plan_forward, n, in, n, out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward()
-        {
-            ::fftwf_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~forward() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftwf_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftwf_execute_dft(plan_.get(), reinterpret_cast<::fftwf_complex *>(in_),
+                                reinterpret_cast<::fftwf_complex *>(out_));
+        }
 
     private:
-        ::fftwf_plan plan_;
+        /// @cond INTERNAL_FIELD
+        plan_cache::plan_ptr plan_;
+        /// @endcond
     };
 
     /**
@@ -104,30 +276,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), plan_(0)
+        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), plan_()
         {
-            plan_ = ::fftwf_plan_dft_1d(n, reinterpret_cast<::fftwf_complex *>(in),
-                                        reinterpret_cast<::fftwf_complex *>(out), FFTW_BACKWARD,
-                                        FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftwf_plan_dft_1d(n, reinterpret_cast<::fftwf_complex *>(pin),
+                                           reinterpret_cast<::fftwf_complex *>(pout), FFTW_BACKWARD, flags);
+            };
+            plan_ = acquire_plan(plan_inverse, n, in, n, out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse()
-        {
-            ::fftwf_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~inverse() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftwf_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftwf_execute_dft(plan_.get(), reinterpret_cast<::fftwf_complex *>(in_),
+                                reinterpret_cast<::fftwf_complex *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftwf_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 
@@ -145,29 +319,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_(0)
+        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_()
         {
-            plan_ = ::fftwf_plan_dft_r2c_1d(n, reinterpret_cast<float *>(in), reinterpret_cast<::fftwf_complex *>(out),
-                                            FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_real_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftwf_plan_dft_r2c_1d(n, reinterpret_cast<float *>(pin),
+                                               reinterpret_cast<::fftwf_complex *>(pout), flags);
+            };
+            plan_ = acquire_plan(plan_forward_real, n, in, n, out, (n / 2 + 1), planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward_real()
-        {
-            ::fftwf_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~forward_real() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftwf_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftwf_execute_dft_r2c(plan_.get(), reinterpret_cast<float *>(in_),
+                                    reinterpret_cast<::fftwf_complex *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftwf_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 
@@ -185,29 +362,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), plan_(0)
+        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), plan_()
         {
-            plan_ = ::fftwf_plan_dft_c2r_1d(n, reinterpret_cast<::fftwf_complex *>(in), reinterpret_cast<float *>(out),
-                                            FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_real_t *pout, unsigned int flags) {
+                return ::fftwf_plan_dft_c2r_1d(n, reinterpret_cast<::fftwf_complex *>(pin),
+                                               reinterpret_cast<float *>(pout), flags);
+            };
+            plan_ = acquire_plan(plan_inverse_real, n, in, (n / 2 + 1), out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse_real()
-        {
-            ::fftwf_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~inverse_real() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftwf_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftwf_execute_dft_c2r(plan_.get(), reinterpret_cast<::fftwf_complex *>(in_),
+                                    reinterpret_cast<float *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftwf_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 };
@@ -234,8 +414,109 @@ struct fftw {
      */
     typedef fftd_complex_t fft_complex_t;
 
+    /**
+     * Import FFTW wisdom from a file.
+     *
+     * @param filename [in] wisdom file path
+     * @returns whether the wisdom is imported successfully
+     *
+     * @note Call this after cxxdasp_init() and before creating FFT instances.
+     *       Wisdom files of single-precision and double-precision FFTW are not interchangeable.
+     */
+    static bool import_wisdom_from_file(const char *filename)
+    {
+        std::lock_guard<std::recursive_mutex> lock(::cxxdasp::fft::impl::plan_cache_mutex());
+        return ::fftw_import_wisdom_from_filename(filename) != 0;
+    }
+
+    /**
+     * Export FFTW wisdom to a file.
+     *
+     * @param filename [in] wisdom file path
+     * @returns whether the wisdom is exported successfully
+     *
+     * @note The wisdom contains every plan made so far in this process.
+     */
+    static bool export_wisdom_to_file(const char *filename)
+    {
+        std::lock_guard<std::recursive_mutex> lock(::cxxdasp::fft::impl::plan_cache_mutex());
+        return ::fftw_export_wisdom_to_filename(filename) != 0;
+    }
+
     /// @cond INTERNAL_FIELD
     fftw() = delete;
+
+    // NOTE:
+    // A plan can be executed on other buffers by the new-array execute functions, as long as they have
+    // the same alignment and the same in-place/out-of-place layout as the planned ones.
+    // So the plans are shared among instances which have the same transform type, size, buffer layout
+    // and planning rigor.
+    enum { plan_forward = 0, plan_inverse, plan_forward_real, plan_inverse_real };
+
+    struct plan_cache_tag {
+    };
+    typedef shared_plan_cache<plan_cache_tag, std::remove_pointer<::fftw_plan>::type> plan_cache;
+
+    static int alignment_of(const void *p) CXXPH_NOEXCEPT
+    {
+        return ::fftw_alignment_of(static_cast<double *>(const_cast<void *>(p)));
+    }
+
+    static int plan_variant(int kind, fftw_planning_rigor_t rigor, const void *in, const void *out) CXXPH_NOEXCEPT
+    {
+        const int in_place = (in == out) ? 1 : 0;
+        return kind | (in_place << 4) | (static_cast<int>(rigor) << 5) | (alignment_of(in) << 8) |
+               (alignment_of(out) << 16);
+    }
+
+    static void destroy_plan(::fftw_plan plan) CXXPH_NOEXCEPT { ::fftw_destroy_plan(plan); }
+
+    template <typename TIn, typename TOut, typename TPlanner>
+    static ::fftw_plan make_plan(fftw_planning_rigor_t rigor, TIn *in, int in_count, TOut *out, int out_count,
+                                 TPlanner planner)
+    {
+        const unsigned int flags = impl::fftw_planner_flags(rigor) | FFTW_PRESERVE_INPUT;
+
+        if (rigor == FFTWPlanEstimate) {
+            // FFTW_ESTIMATE does not touch the arrays
+            return planner(in, out, flags);
+        }
+
+        // NOTE:
+        // Other rigors overwrite the arrays while planning, so the plan is made on scratch buffers
+        // which have the same alignment and the same in-place/out-of-place layout as the given ones.
+        const bool in_place = (static_cast<const void *>(in) == static_cast<const void *>(out));
+        const size_t in_offset = static_cast<size_t>(alignment_of(in));
+        const size_t out_offset = static_cast<size_t>(alignment_of(out));
+        const size_t in_size = sizeof(TIn) * in_count + in_offset;
+        const size_t out_size = sizeof(TOut) * out_count + out_offset;
+
+        char *scratch_in = static_cast<char *>(::fftw_malloc((in_place) ? (std::max)(in_size, out_size) : in_size));
+        char *scratch_out = (in_place) ? scratch_in : static_cast<char *>(::fftw_malloc(out_size));
+
+        ::fftw_plan plan = nullptr;
+        if (scratch_in && scratch_out) {
+            plan = planner(reinterpret_cast<TIn *>(scratch_in + in_offset),
+                           reinterpret_cast<TOut *>(scratch_out + out_offset), flags);
+        }
+
+        if (!in_place) {
+            ::fftw_free(scratch_out);
+        }
+        ::fftw_free(scratch_in);
+
+        return plan;
+    }
+
+    template <typename TIn, typename TOut, typename TPlanner>
+    static plan_cache::plan_ptr acquire_plan(int kind, int n, TIn *in, int in_count, TOut *out, int out_count,
+                                             TPlanner planner)
+    {
+        const fftw_planning_rigor_t rigor = get_fftw_planning_rigor();
+        return plan_cache::acquire(n, plan_variant(kind, rigor, in, out),
+                                   [=]() { return make_plan(rigor, in, in_count, out, out_count, planner); },
+                                   destroy_plan);
+    }
     /// @endcond
 
     /**
@@ -252,30 +533,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_(0)
+        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_()
         {
-            plan_ =
-                ::fftw_plan_dft_1d(n, reinterpret_cast<::fftw_complex *>(in), reinterpret_cast<::fftw_complex *>(out),
-                                   FFTW_FORWARD, FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftw_plan_dft_1d(n, reinterpret_cast<::fftw_complex *>(pin),
+                                          reinterpret_cast<::fftw_complex *>(pout), FFTW_FORWARD, flags);
+            };
+            plan_ = acquire_plan(plan_forward, n, in, n, out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward()
-        {
-            ::fftw_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~forward() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftw_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftw_execute_dft(plan_.get(), reinterpret_cast<::fftw_complex *>(in_),
+                               reinterpret_cast<::fftw_complex *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftw_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 
@@ -293,30 +576,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), plan_(0)
+        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), plan_()
         {
-            plan_ =
-                ::fftw_plan_dft_1d(n, reinterpret_cast<::fftw_complex *>(in), reinterpret_cast<::fftw_complex *>(out),
-                                   FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftw_plan_dft_1d(n, reinterpret_cast<::fftw_complex *>(pin),
+                                          reinterpret_cast<::fftw_complex *>(pout), FFTW_BACKWARD, flags);
+            };
+            plan_ = acquire_plan(plan_inverse, n, in, n, out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse()
-        {
-            ::fftw_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~inverse() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftw_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftw_execute_dft(plan_.get(), reinterpret_cast<::fftw_complex *>(in_),
+                               reinterpret_cast<::fftw_complex *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftw_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 
@@ -334,29 +619,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_(0)
+        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), plan_()
         {
-            plan_ = ::fftw_plan_dft_r2c_1d(n, reinterpret_cast<double *>(in), reinterpret_cast<::fftw_complex *>(out),
-                                           FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_real_t *pin, fft_complex_t *pout, unsigned int flags) {
+                return ::fftw_plan_dft_r2c_1d(n, reinterpret_cast<double *>(pin),
+                                              reinterpret_cast<::fftw_complex *>(pout), flags);
+            };
+            plan_ = acquire_plan(plan_forward_real, n, in, n, out, (n / 2 + 1), planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward_real()
-        {
-            ::fftw_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~forward_real() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftw_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftw_execute_dft_r2c(plan_.get(), reinterpret_cast<double *>(in_),
+                                   reinterpret_cast<::fftw_complex *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftw_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 
@@ -374,29 +662,32 @@ struct fftw {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), plan_(0)
+        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), plan_()
         {
-            plan_ = ::fftw_plan_dft_c2r_1d(n, reinterpret_cast<::fftw_complex *>(in), reinterpret_cast<double *>(out),
-                                           FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
+            auto planner = [n](fft_complex_t *pin, fft_real_t *pout, unsigned int flags) {
+                return ::fftw_plan_dft_c2r_1d(n, reinterpret_cast<::fftw_complex *>(pin),
+                                              reinterpret_cast<double *>(pout), flags);
+            };
+            plan_ = acquire_plan(plan_inverse_real, n, in, (n / 2 + 1), out, n, planner);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse_real()
-        {
-            ::fftw_destroy_plan(plan_);
-            plan_ = 0;
-        }
+        virtual ~inverse_real() {}
 
         /**
          * Execute FFT.
          */
-        void execute() CXXPH_NOEXCEPT { ::fftw_execute(plan_); }
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::fftw_execute_dft_c2r(plan_.get(), reinterpret_cast<::fftw_complex *>(in_),
+                                   reinterpret_cast<double *>(out_));
+        }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::fftw_plan plan_;
+        plan_cache::plan_ptr plan_;
         /// @endcond
     };
 };
@@ -22,6 +22,7 @@
 #if CXXDASP_USE_FFT_BACKEND_KFR_D || CXXDASP_USE_FFT_BACKEND_KFR_F
 
 #include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
 
 
 #include <kfr/base.hpp>
@@ -51,6 +52,28 @@ struct kfr {
 
     /// @cond INTERNAL_FIELD
     kfr() = delete;
+
+    // NOTE:
+    // KFR plans are read-only while executing (a temporary buffer is passed to every execute() call),
+    // so instances of the same size share them regardless of the direction.
+    struct plan_cache_tag {
+    };
+    struct real_plan_cache_tag {
+    };
+    typedef shared_plan_cache<plan_cache_tag, ::kfr::dft_plan<fft_real_t>> plan_cache;
+    typedef shared_plan_cache<real_plan_cache_tag, ::kfr::dft_plan_real<fft_real_t>> real_plan_cache;
+
+    static plan_cache::plan_ptr acquire_plan(int n)
+    {
+        return plan_cache::acquire(n, 0, [n]() { return new ::kfr::dft_plan<fft_real_t>(n); },
+                                   [](::kfr::dft_plan<fft_real_t> *plan) { delete plan; });
+    }
+
+    static real_plan_cache::plan_ptr acquire_real_plan(int n)
+    {
+        return real_plan_cache::acquire(n, 0, [n]() { return new ::kfr::dft_plan_real<fft_real_t>(n); },
+                                        [](::kfr::dft_plan_real<fft_real_t> *plan) { delete plan; });
+    }
     /// @endcond
 
     /**
@@ -68,7 +91,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         forward(int n, fft_complex_t *in, fft_complex_t *out)
-         : base(n, in, out, 1), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, 1), plan_(acquire_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -81,14 +104,14 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(in()),
                 temp_.data(), false);
         }
 
     private:
-        ::kfr::dft_plan<fft_real_t> plan_;
+        plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
     };
 
@@ -107,7 +130,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         inverse(int n, fft_complex_t *in, fft_complex_t *out)
-         : base(n, in, out, n), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, n), plan_(acquire_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -120,7 +143,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(in()),
                 temp_.data(), true);
@@ -128,7 +151,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan<fft_real_t> plan_;
+        plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
@@ -148,7 +171,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         forward_real(int n, fft_real_t *in, fft_complex_t *out)
-         : base(n, in, out, 1), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, 1), plan_(acquire_real_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -161,7 +184,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<fft_real_t *>(in()),
                 temp_.data(), ::kfr::dft_pack_format::CCs);
@@ -169,7 +192,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan_real<fft_real_t> plan_;
+        real_plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
@@ -189,7 +212,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         inverse_real(int n, fft_complex_t *in, fft_real_t *out)
-         : base(n, in, out, n), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, n), plan_(acquire_real_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -202,7 +225,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<fft_real_t *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(in()),
                 temp_.data(), ::kfr::dft_pack_format::CCs);
@@ -210,7 +233,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan_real<fft_real_t> plan_;
+        real_plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
@@ -240,6 +263,28 @@ struct kfr {
 
     /// @cond INTERNAL_FIELD
     kfr() = delete;
+
+    // NOTE:
+    // KFR plans are read-only while executing (a temporary buffer is passed to every execute() call),
+    // so instances of the same size share them regardless of the direction.
+    struct plan_cache_tag {
+    };
+    struct real_plan_cache_tag {
+    };
+    typedef shared_plan_cache<plan_cache_tag, ::kfr::dft_plan<fft_real_t>> plan_cache;
+    typedef shared_plan_cache<real_plan_cache_tag, ::kfr::dft_plan_real<fft_real_t>> real_plan_cache;
+
+    static plan_cache::plan_ptr acquire_plan(int n)
+    {
+        return plan_cache::acquire(n, 0, [n]() { return new ::kfr::dft_plan<fft_real_t>(n); },
+                                   [](::kfr::dft_plan<fft_real_t> *plan) { delete plan; });
+    }
+
+    static real_plan_cache::plan_ptr acquire_real_plan(int n)
+    {
+        return real_plan_cache::acquire(n, 0, [n]() { return new ::kfr::dft_plan_real<fft_real_t>(n); },
+                                        [](::kfr::dft_plan_real<fft_real_t> *plan) { delete plan; });
+    }
     /// @endcond
 
     /**
@@ -257,7 +302,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         forward(int n, fft_complex_t *in, fft_complex_t *out)
-         : base(n, in, out, 1), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, 1), plan_(acquire_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -270,14 +315,14 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(in()),
                 temp_.data(), false);
         }
 
     private:
-        ::kfr::dft_plan<fft_real_t> plan_;
+        plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
     };
 
@@ -296,7 +341,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         inverse(int n, fft_complex_t *in, fft_complex_t *out)
-         : base(n, in, out, n), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, n), plan_(acquire_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -309,7 +354,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(in()),
                 temp_.data(), true);
@@ -317,7 +362,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan<fft_real_t> plan_;
+        plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
@@ -337,7 +382,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         forward_real(int n, fft_real_t *in, fft_complex_t *out)
-         : base(n, in, out, 1), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, 1), plan_(acquire_real_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -350,7 +395,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<::kfr::complex<fft_real_t> *>(out()), 
                 reinterpret_cast<fft_real_t *>(in()),
                 temp_.data(), ::kfr::dft_pack_format::CCs);
@@ -358,7 +403,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan_real<fft_real_t> plan_;
+        real_plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
@@ -378,7 +423,7 @@ struct kfr {
          * @param out [in] Output buffer
          */
         inverse_real(int n, fft_complex_t *in, fft_real_t *out)
-         : base(n, in, out, n), plan_(n), temp_(plan_.temp_size)
+         : base(n, in, out, n), plan_(acquire_real_plan(n)), temp_(plan_->temp_size)
         {
         }
 
@@ -391,7 +436,7 @@ struct kfr {
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT {
-            plan_.execute(
+            plan_->execute(
                 reinterpret_cast<fft_real_t *>(out()), 
                 reinterpret_cast<::kfr::complex<fft_real_t>*>(in()),
                 temp_.data(), ::kfr::dft_pack_format::CCs);
@@ -399,7 +444,7 @@ struct kfr {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kfr::dft_plan_real<fft_real_t> plan_;
+        real_plan_cache::plan_ptr plan_;
         ::kfr::univector<::kfr::u8> temp_;
         /// @endcond
     };
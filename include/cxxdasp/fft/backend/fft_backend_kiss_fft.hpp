@@ -21,7 +21,10 @@
 
 #if CXXDASP_USE_FFT_BACKEND_KISS_FFT
 
+#include <type_traits>
+
 #include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
 
 #include <kiss_fft.h>
 #include <tools/kiss_fftr.h>
@@ -49,6 +52,20 @@ struct kiss_fft {
 
     /// @cond INTERNAL_FIELD
     kiss_fft() = delete;
+
+    // NOTE:
+    // kiss_fft_cfg is not modified by kiss_fft(), so instances of the same size and direction share it.
+    // (kiss_fftr_cfg contains a scratch buffer, so it can't be shared.)
+    struct cfg_cache_tag {
+    };
+    typedef shared_plan_cache<cfg_cache_tag, std::remove_pointer<::kiss_fft_cfg>::type> cfg_cache;
+
+    static cfg_cache::plan_ptr acquire_cfg(int n, int inverse_fft)
+    {
+        return cfg_cache::acquire(n, inverse_fft,
+                                  [n, inverse_fft]() { return ::kiss_fft_alloc(n, inverse_fft, nullptr, nullptr); },
+                                  [](::kiss_fft_cfg cfg) { ::kiss_fft_free(cfg); });
+    }
     /// @endcond
 
     /**
@@ -65,31 +82,26 @@ struct kiss_fft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), cfg_(0)
+        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), cfg_(acquire_cfg(n, 0))
         {
-            cfg_ = ::kiss_fft_alloc(n, 0, nullptr, nullptr);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward()
-        {
-            ::kiss_fft_free(cfg_);
-            cfg_ = 0;
-        }
+        virtual ~forward() {}
 
         /**
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT
         {
-            ::kiss_fft(cfg_, reinterpret_cast<const kiss_fft_cpx *>(in_), reinterpret_cast<kiss_fft_cpx *>(out_));
+            ::kiss_fft(cfg_.get(), reinterpret_cast<const kiss_fft_cpx *>(in_), reinterpret_cast<kiss_fft_cpx *>(out_));
         }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kiss_fft_cfg cfg_;
+        cfg_cache::plan_ptr cfg_;
         /// @endcond
     };
 
@@ -107,31 +119,26 @@ struct kiss_fft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), cfg_(0)
+        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), cfg_(acquire_cfg(n, 1))
         {
-            cfg_ = ::kiss_fft_alloc(n, 1, nullptr, nullptr);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse()
-        {
-            ::kiss_fft_free(cfg_);
-            cfg_ = 0;
-        }
+        virtual ~inverse() {}
 
         /**
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT
         {
-            ::kiss_fft(cfg_, reinterpret_cast<const kiss_fft_cpx *>(in_), reinterpret_cast<kiss_fft_cpx *>(out_));
+            ::kiss_fft(cfg_.get(), reinterpret_cast<const kiss_fft_cpx *>(in_), reinterpret_cast<kiss_fft_cpx *>(out_));
         }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::kiss_fft_cfg cfg_;
+        cfg_cache::plan_ptr cfg_;
         /// @endcond
     };
 
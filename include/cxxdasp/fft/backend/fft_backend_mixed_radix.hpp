@@ -0,0 +1,302 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FFT_FFT_BACKEND_MIXED_RADIX_HPP_
+#define CXXDASP_FFT_FFT_BACKEND_MIXED_RADIX_HPP_
+
+#include <cxxdasp/cxxdasp_config.hpp>
+
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+
+#include <cassert>
+
+#include <cxxporthelper/utility>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
+#include <cxxdasp/fft/impl/mixed_radix_fft_core.hpp>
+
+namespace cxxdasp {
+namespace fft {
+namespace backend {
+
+/**
+ * Built-in mixed-radix FFT backend class
+ *
+ * Supports the FFT sizes which have no prime factors other than 2, 3 and 5
+ * (real transforms: even sizes whose halves satisfy the condition).
+ * Radix-2 and radix-4 passes are SIMD optimized (SSE / AVX / NEON).
+ *
+ * @tparam TReal real value type (float or double)
+ */
+template <typename TReal>
+struct mixed_radix_backend {
+    /**
+     * Real value type
+     */
+    typedef TReal fft_real_t;
+
+    /**
+     * Complex value type
+     */
+    typedef std::complex<TReal> fft_complex_t;
+
+    /// @cond INTERNAL_FIELD
+    mixed_radix_backend() = delete;
+
+    typedef ::cxxdasp::fft::impl::mixed_radix_fft_setup<fft_real_t> setup_type;
+
+    // NOTE:
+    // The setup object holds the factorization and the twiddle factors only (read-only after creation),
+    // so instances of the same size and transform type share it.
+    struct setup_cache_tag {
+    };
+    typedef shared_plan_cache<setup_cache_tag, setup_type> setup_cache;
+
+    enum setup_variant_t {
+        SetupForward,
+        SetupInverse,
+        SetupForwardReal,
+        SetupInverseReal,
+    };
+
+    static typename setup_cache::plan_ptr acquire_setup(int n, setup_variant_t variant)
+    {
+        const bool inverse = (variant == SetupInverse || variant == SetupInverseReal);
+        const bool real = (variant == SetupForwardReal || variant == SetupInverseReal);
+
+        return setup_cache::acquire(n, static_cast<int>(variant),
+                                    [n, inverse, real]() { return new setup_type(n, inverse, real); },
+                                    [](setup_type *setup) { delete setup; });
+    }
+    /// @endcond
+
+    /**
+     * Check the FFT size is supported.
+     *
+     * @param n [in] FFT size
+     * @param real [in] check for real transforms
+     * @returns whether the FFT size is supported
+     */
+    static bool is_supported_size(int n, bool real) CXXPH_NOEXCEPT
+    {
+        if (real) {
+            return ((n % 2) == 0) && ::cxxdasp::fft::impl::mixed_radix_fft_is_supported_size(n / 2);
+        } else {
+            return ::cxxdasp::fft::impl::mixed_radix_fft_is_supported_size(n);
+        }
+    }
+
+    /**
+     * Forward (Complex) FFT
+     */
+    class forward : public fft_backend_base<fft_complex_t, fft_complex_t> {
+        typedef fft_backend_base<fft_complex_t, fft_complex_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(), work_()
+        {
+            // verify parameters
+            assert(is_supported_size(n, false));
+
+            cxxporthelper::aligned_memory<fft_complex_t> work(n, FFT_MEMORY_ALIGNMENT);
+            setup_ = acquire_setup(n, SetupForward);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~forward() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT { setup_->execute(base::in_, base::out_, &work_[0]); }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        typename setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_complex_t> work_;
+        /// @endcond
+    };
+
+    /**
+     * Inverse (Complex) FFT
+     */
+    class inverse : public fft_backend_base<fft_complex_t, fft_complex_t> {
+        typedef fft_backend_base<fft_complex_t, fft_complex_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), setup_(), work_()
+        {
+            // verify parameters
+            assert(is_supported_size(n, false));
+
+            cxxporthelper::aligned_memory<fft_complex_t> work(n, FFT_MEMORY_ALIGNMENT);
+            setup_ = acquire_setup(n, SetupInverse);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~inverse() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT { setup_->execute(base::in_, base::out_, &work_[0]); }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        typename setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_complex_t> work_;
+        /// @endcond
+    };
+
+    /**
+     * Forward (Real) FFT
+     */
+    class forward_real : public fft_backend_base<fft_real_t, fft_complex_t> {
+        typedef fft_backend_base<fft_real_t, fft_complex_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(), work_()
+        {
+            // verify parameters
+            assert(is_supported_size(n, true));
+
+            cxxporthelper::aligned_memory<fft_complex_t> work(n / 2, FFT_MEMORY_ALIGNMENT);
+            setup_ = acquire_setup(n / 2, SetupForwardReal);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~forward_real() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT
+        {
+            // transform the even / odd samples as the real / imaginary parts of N/2 complex values
+            setup_->execute(reinterpret_cast<const fft_complex_t *>(base::in_), base::out_, &work_[0]);
+            setup_->forward_real_postprocess(base::out_);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        typename setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_complex_t> work_;
+        /// @endcond
+    };
+
+    /**
+     * Inverse (Real) FFT
+     */
+    class inverse_real : public fft_backend_base<fft_complex_t, fft_real_t> {
+        typedef fft_backend_base<fft_complex_t, fft_real_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), setup_(), work_()
+        {
+            // verify parameters
+            assert(is_supported_size(n, true));
+
+            // NOTE: [0, N/2): packed spectrum, [N/2, N): work area of the complex transform
+            cxxporthelper::aligned_memory<fft_complex_t> work(n, FFT_MEMORY_ALIGNMENT);
+            setup_ = acquire_setup(n / 2, SetupInverseReal);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~inverse_real() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT
+        {
+            const int h = base::n_ / 2;
+
+            setup_->inverse_real_preprocess(base::in_, &work_[0]);
+            setup_->execute(&work_[0], reinterpret_cast<fft_complex_t *>(base::out_), &work_[h]);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        typename setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_complex_t> work_;
+        /// @endcond
+    };
+};
+
+namespace f {
+/**
+ * Single-precision FFT backend class
+ * (using built-in mixed-radix FFT)
+ */
+typedef mixed_radix_backend<fftf_real_t> mixed_radix;
+} // namespace f
+
+namespace d {
+/**
+ * Double-precision FFT backend class
+ * (using built-in mixed-radix FFT)
+ */
+typedef mixed_radix_backend<fftd_real_t> mixed_radix;
+} // namespace d
+
+} // namespace backend
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+#endif // CXXDASP_FFT_FFT_BACKEND_MIXED_RADIX_HPP_
@@ -25,6 +25,7 @@
 #include <cxxporthelper/aligned_memory.hpp>
 
 #include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
 
 #include <pffft.h>
 
@@ -51,6 +52,20 @@ struct pffft {
 
     /// @cond INTERNAL_FIELD
     pffft() = delete;
+
+    // NOTE:
+    // PFFFT_Setup is read-only after creation (the work buffer is passed to every transform call),
+    // so instances of the same size and transform type share it regardless of the direction.
+    struct setup_cache_tag {
+    };
+    typedef shared_plan_cache<setup_cache_tag, ::PFFFT_Setup> setup_cache;
+
+    static setup_cache::plan_ptr acquire_setup(int n, ::pffft_transform_t transform)
+    {
+        return setup_cache::acquire(n, static_cast<int>(transform),
+                                    [n, transform]() { return ::pffft_new_setup(n, transform); },
+                                    [](::PFFFT_Setup *setup) { ::pffft_destroy_setup(setup); });
+    }
     /// @endcond
 
     /**
@@ -67,34 +82,31 @@ struct pffft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(0), work_()
+        forward(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(), work_()
         {
             cxxporthelper::aligned_memory<fft_complex_t> work(n);
-            setup_ = ::pffft_new_setup(n, PFFFT_COMPLEX);
+            setup_ = acquire_setup(n, PFFFT_COMPLEX);
             work_ = std::move(work);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward()
-        {
-            ::pffft_destroy_setup(setup_);
-            setup_ = 0;
-        }
+        virtual ~forward() {}
 
         /**
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT
         {
-            ::pffft_transform_ordered(setup_, reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
-                                      reinterpret_cast<float *>(&work_[0]), PFFFT_FORWARD);
+            ::pffft_transform_ordered(setup_.get(), reinterpret_cast<const float *>(in_),
+                                      reinterpret_cast<float *>(out_), reinterpret_cast<float *>(&work_[0]),
+                                      PFFFT_FORWARD);
         }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::PFFFT_Setup *setup_;
+        setup_cache::plan_ptr setup_;
         cxxporthelper::aligned_memory<fft_complex_t> work_;
         /// @endcond
     };
@@ -113,34 +125,31 @@ struct pffft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), setup_(0), work_()
+        inverse(int n, fft_complex_t *in, fft_complex_t *out) : base(n, in, out, n), setup_(), work_()
         {
             cxxporthelper::aligned_memory<fft_complex_t> work(n);
-            setup_ = ::pffft_new_setup(n, PFFFT_COMPLEX);
+            setup_ = acquire_setup(n, PFFFT_COMPLEX);
             work_ = std::move(work);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse()
-        {
-            ::pffft_destroy_setup(setup_);
-            setup_ = 0;
-        }
+        virtual ~inverse() {}
 
         /**
          * Execute FFT.
          */
         void execute() CXXPH_NOEXCEPT
         {
-            ::pffft_transform_ordered(setup_, reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
-                                      reinterpret_cast<float *>(&work_[0]), PFFFT_BACKWARD);
+            ::pffft_transform_ordered(setup_.get(), reinterpret_cast<const float *>(in_),
+                                      reinterpret_cast<float *>(out_), reinterpret_cast<float *>(&work_[0]),
+                                      PFFFT_BACKWARD);
         }
 
     private:
         /// @cond INTERNAL_FIELD
-        ::PFFFT_Setup *setup_;
+        setup_cache::plan_ptr setup_;
         cxxporthelper::aligned_memory<fft_complex_t> work_;
         /// @endcond
     };
@@ -159,21 +168,17 @@ struct pffft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(0), work_()
+        forward_real(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(), work_()
         {
             cxxporthelper::aligned_memory<fft_real_t> work(n);
-            setup_ = ::pffft_new_setup(n, PFFFT_REAL);
+            setup_ = acquire_setup(n, PFFFT_REAL);
             work_ = std::move(work);
         }
 
         /**
          * Destructor.
          */
-        virtual ~forward_real()
-        {
-            ::pffft_destroy_setup(setup_);
-            setup_ = 0;
-        }
+        virtual ~forward_real() {}
 
         /**
          * Execute FFT.
@@ -182,8 +187,9 @@ struct pffft {
         {
             namespace compat = cxxporthelper::complex;
 
-            ::pffft_transform_ordered(setup_, reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
-                                      reinterpret_cast<float *>(&work_[0]), PFFFT_FORWARD);
+            ::pffft_transform_ordered(setup_.get(), reinterpret_cast<const float *>(in_),
+                                      reinterpret_cast<float *>(out_), reinterpret_cast<float *>(&work_[0]),
+                                      PFFFT_FORWARD);
 
             // correct 0 th and (N/2-1) th element
             compat::set_real(out_[n_ / 2], out_[0].imag());
@@ -193,7 +199,7 @@ struct pffft {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::PFFFT_Setup *setup_;
+        setup_cache::plan_ptr setup_;
         cxxporthelper::aligned_memory<fft_real_t> work_;
         /// @endcond
     };
@@ -212,21 +218,17 @@ struct pffft {
          * @param in [in] Input buffer
          * @param out [in] Output buffer
          */
-        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), setup_(0), work_()
+        inverse_real(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), setup_(), work_()
         {
             cxxporthelper::aligned_memory<fft_real_t> work(n);
-            setup_ = ::pffft_new_setup(n, PFFFT_REAL);
+            setup_ = acquire_setup(n, PFFFT_REAL);
             work_ = std::move(work);
         }
 
         /**
          * Destructor.
          */
-        virtual ~inverse_real()
-        {
-            ::pffft_destroy_setup(setup_);
-            setup_ = 0;
-        }
+        virtual ~inverse_real() {}
 
         /**
          * Execute FFT.
@@ -240,8 +242,9 @@ struct pffft {
             // pack to 0 th element
             compat::set_imag(in_[0], in_[n_ / 2].real());
 
-            ::pffft_transform_ordered(setup_, reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
-                                      reinterpret_cast<float *>(&work_[0]), PFFFT_BACKWARD);
+            ::pffft_transform_ordered(setup_.get(), reinterpret_cast<const float *>(in_),
+                                      reinterpret_cast<float *>(out_), reinterpret_cast<float *>(&work_[0]),
+                                      PFFFT_BACKWARD);
 
             // restore 0 th element
             compat::set_imag(in_[0], orig_in_0_imag);
@@ -249,7 +252,96 @@ struct pffft {
 
     private:
         /// @cond INTERNAL_FIELD
-        ::PFFFT_Setup *setup_;
+        setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_real_t> work_;
+        /// @endcond
+    };
+
+    /**
+     * Forward (Real) FFT (unordered)
+     *
+     * @note The output spectrum is stored in the PFFFT's internal order (N / 2 complex slots).
+     *       It can be multiplied only by the spectra in the same order (see fft::convolution_backend).
+     */
+    class forward_real_unordered : public fft_backend_base<fft_real_t, fft_complex_t> {
+        typedef fft_backend_base<fft_real_t, fft_complex_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        forward_real_unordered(int n, fft_real_t *in, fft_complex_t *out) : base(n, in, out, 1), setup_(), work_()
+        {
+            cxxporthelper::aligned_memory<fft_real_t> work(n);
+            setup_ = acquire_setup(n, PFFFT_REAL);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~forward_real_unordered() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::pffft_transform(setup_.get(), reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
+                              reinterpret_cast<float *>(&work_[0]), PFFFT_FORWARD);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        setup_cache::plan_ptr setup_;
+        cxxporthelper::aligned_memory<fft_real_t> work_;
+        /// @endcond
+    };
+
+    /**
+     * Inverse (Real) FFT (unordered)
+     *
+     * @note The input spectrum has to be stored in the PFFFT's internal order (N / 2 complex slots).
+     */
+    class inverse_real_unordered : public fft_backend_base<fft_complex_t, fft_real_t> {
+        typedef fft_backend_base<fft_complex_t, fft_real_t> base;
+
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         */
+        inverse_real_unordered(int n, fft_complex_t *in, fft_real_t *out) : base(n, in, out, n), setup_(), work_()
+        {
+            cxxporthelper::aligned_memory<fft_real_t> work(n);
+            setup_ = acquire_setup(n, PFFFT_REAL);
+            work_ = std::move(work);
+        }
+
+        /**
+         * Destructor.
+         */
+        virtual ~inverse_real_unordered() {}
+
+        /**
+         * Execute FFT.
+         */
+        void execute() CXXPH_NOEXCEPT
+        {
+            ::pffft_transform(setup_.get(), reinterpret_cast<const float *>(in_), reinterpret_cast<float *>(out_),
+                              reinterpret_cast<float *>(&work_[0]), PFFFT_BACKWARD);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        setup_cache::plan_ptr setup_;
         cxxporthelper::aligned_memory<fft_real_t> work_;
         /// @endcond
     };
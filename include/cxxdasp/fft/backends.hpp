@@ -26,5 +26,6 @@
 #include <cxxdasp/fft/backend/fft_backend_mufft.hpp>
 #include <cxxdasp/fft/backend/fft_backend_gp_fft.hpp>
 #include <cxxdasp/fft/backend/fft_backend_kfr.hpp>
+#include <cxxdasp/fft/backend/fft_backend_mixed_radix.hpp>
 
 #endif // CXXDASP_FFT_BACKENDS_HPP_
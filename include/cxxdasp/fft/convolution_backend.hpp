@@ -0,0 +1,228 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FFT_CONVOLUTION_BACKEND_HPP_
+#define CXXDASP_FFT_CONVOLUTION_BACKEND_HPP_
+
+#include <cstring>
+
+#include <cxxporthelper/compiler.hpp>
+
+#include <cxxdasp/cxxdasp_config.hpp>
+#include <cxxdasp/fft/fft.hpp>
+#include <cxxdasp/utils/utils.hpp>
+
+namespace cxxdasp {
+namespace fft {
+
+/**
+ * Convolution-only FFT operations.
+ *
+ * Fast convolution only multiplies spectra and transforms them back, so the bin order of the spectra
+ * does not matter as long as all of them are in the same order. This template provides the real FFT
+ * classes and the spectrum multiplier used for that purpose. The generic implementation uses the
+ * canonical order (N / 2 + 1 bins); backends which have a cheaper native order specialize it.
+ *
+ * @tparam TFFTBackend FFT backend class
+ *
+ * @note Spectra made by these classes must not be passed to the canonical-order operations
+ *       (e.g. utils::mirror_conj_aligned()).
+ */
+template <class TFFTBackend>
+struct convolution_backend {
+    /**
+     * Real value type
+     */
+    typedef typename TFFTBackend::fft_real_t fft_real_t;
+
+    /**
+     * Complex value type
+     */
+    typedef typename TFFTBackend::fft_complex_t fft_complex_t;
+
+    /**
+     * Forward (Real) FFT backend class
+     */
+    typedef typename TFFTBackend::forward_real forward_real;
+
+    /**
+     * Inverse (Real) FFT backend class
+     */
+    typedef typename TFFTBackend::inverse_real inverse_real;
+
+    /**
+     * Get the number of spectrum elements.
+     *
+     * @param n [in] FFT size
+     * @returns number of fft_complex_t elements of a spectrum
+     */
+    static int num_spectrum_elements(int n) CXXPH_NOEXCEPT { return (n / 2) + 1; }
+
+    /**
+     * Spectrum multiplier
+     */
+    class multiplier {
+    public:
+        /**
+         * Constructor.
+         */
+        multiplier() CXXPH_NOEXCEPT : num_elements_(0) {}
+
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         */
+        explicit multiplier(int n) : num_elements_(num_spectrum_elements(n)) {}
+
+        /**
+         * Multiply.
+         *
+         * dest = x * y
+         *
+         * @param dest [out] destination spectrum
+         * @param x [in] source spectrum 1
+         * @param y [in] source spectrum 2
+         */
+        void multiply(fft_complex_t *CXXPH_RESTRICT dest, const fft_complex_t *CXXPH_RESTRICT x,
+                      const fft_complex_t *CXXPH_RESTRICT y) const CXXPH_NOEXCEPT
+        {
+            utils::multiply_aligned(dest, x, y, num_elements_);
+        }
+
+        /**
+         * Multiply and accumulate.
+         *
+         * dest += x * y
+         *
+         * @param dest [in/out] destination spectrum
+         * @param x [in] source spectrum 1
+         * @param y [in] source spectrum 2
+         */
+        void multiply_accumulate(fft_complex_t *CXXPH_RESTRICT dest, const fft_complex_t *CXXPH_RESTRICT x,
+                                 const fft_complex_t *CXXPH_RESTRICT y) const CXXPH_NOEXCEPT
+        {
+            utils::multiply_accumulate_aligned(dest, x, y, num_elements_);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        int num_elements_;
+        /// @endcond
+    };
+};
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+/**
+ * Convolution-only FFT operations (PFFFT specialization)
+ *
+ * Spectra are kept in the PFFFT's internal order, so the reordering passes of
+ * pffft_transform_ordered() and the DC / Nyquist bins fix-up are skipped.
+ */
+template <>
+struct convolution_backend<backend::f::pffft> {
+    /**
+     * Real value type
+     */
+    typedef backend::f::pffft::fft_real_t fft_real_t;
+
+    /**
+     * Complex value type
+     */
+    typedef backend::f::pffft::fft_complex_t fft_complex_t;
+
+    /**
+     * Forward (Real) FFT backend class
+     */
+    typedef backend::f::pffft::forward_real_unordered forward_real;
+
+    /**
+     * Inverse (Real) FFT backend class
+     */
+    typedef backend::f::pffft::inverse_real_unordered inverse_real;
+
+    /**
+     * Get the number of spectrum elements.
+     *
+     * @param n [in] FFT size
+     * @returns number of fft_complex_t elements of a spectrum
+     */
+    static int num_spectrum_elements(int n) CXXPH_NOEXCEPT { return (n / 2); }
+
+    /**
+     * Spectrum multiplier
+     */
+    class multiplier {
+    public:
+        /**
+         * Constructor.
+         */
+        multiplier() CXXPH_NOEXCEPT : num_elements_(0), setup_() {}
+
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         */
+        explicit multiplier(int n)
+            : num_elements_(num_spectrum_elements(n)), setup_(backend::f::pffft::acquire_setup(n, PFFFT_REAL))
+        {
+        }
+
+        /**
+         * Multiply.
+         *
+         * dest = x * y
+         *
+         * @param dest [out] destination spectrum
+         * @param x [in] source spectrum 1
+         * @param y [in] source spectrum 2
+         */
+        void multiply(fft_complex_t *CXXPH_RESTRICT dest, const fft_complex_t *CXXPH_RESTRICT x,
+                      const fft_complex_t *CXXPH_RESTRICT y) const CXXPH_NOEXCEPT
+        {
+            ::memset(dest, 0, sizeof(fft_complex_t) * num_elements_);
+            multiply_accumulate(dest, x, y);
+        }
+
+        /**
+         * Multiply and accumulate.
+         *
+         * dest += x * y
+         *
+         * @param dest [in/out] destination spectrum
+         * @param x [in] source spectrum 1
+         * @param y [in] source spectrum 2
+         */
+        void multiply_accumulate(fft_complex_t *CXXPH_RESTRICT dest, const fft_complex_t *CXXPH_RESTRICT x,
+                                 const fft_complex_t *CXXPH_RESTRICT y) const CXXPH_NOEXCEPT
+        {
+            ::pffft_zconvolve_accumulate(setup_.get(), reinterpret_cast<const float *>(x),
+                                         reinterpret_cast<const float *>(y), reinterpret_cast<float *>(dest), 1.0f);
+        }
+
+    private:
+        /// @cond INTERNAL_FIELD
+        int num_elements_;
+        backend::f::pffft::setup_cache::plan_ptr setup_;
+        /// @endcond
+    };
+};
+#endif // CXXDASP_USE_FFT_BACKEND_PFFFT
+
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_FFT_CONVOLUTION_BACKEND_HPP_
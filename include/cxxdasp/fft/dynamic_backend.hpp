@@ -0,0 +1,632 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FFT_DYNAMIC_BACKEND_HPP_
+#define CXXDASP_FFT_DYNAMIC_BACKEND_HPP_
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/cxxdasp_config.hpp>
+#include <cxxdasp/fft/fft.hpp>
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/utils/stopwatch.hpp>
+
+namespace cxxdasp {
+namespace fft {
+
+/**
+ * Transform type of dynamic_backend
+ */
+enum dynamic_backend_transform_t {
+    DynamicBackendForward,     ///< Forward (Complex) FFT
+    DynamicBackendInverse,     ///< Inverse (Complex) FFT
+    DynamicBackendForwardReal, ///< Forward (Real) FFT
+    DynamicBackendInverseReal, ///< Inverse (Real) FFT
+};
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+// type-erased FFT backend instance
+class dynamic_transform {
+public:
+    virtual ~dynamic_transform() {}
+    virtual void execute() CXXPH_NOEXCEPT = 0;
+    virtual int scale() const CXXPH_NOEXCEPT = 0;
+};
+
+template <class TBackendImpl>
+class dynamic_transform_impl : public dynamic_transform {
+public:
+    dynamic_transform_impl(int n, typename TBackendImpl::in_type *in, typename TBackendImpl::out_type *out)
+        : impl_(n, in, out)
+    {
+    }
+    virtual ~dynamic_transform_impl() {}
+    virtual void execute() CXXPH_NOEXCEPT { impl_.execute(); }
+    virtual int scale() const CXXPH_NOEXCEPT { return impl_.scale(); }
+
+private:
+    TBackendImpl impl_;
+};
+
+template <class TBackendImpl>
+inline dynamic_transform *create_dynamic_transform(int n, typename TBackendImpl::in_type *in,
+                                                   typename TBackendImpl::out_type *out)
+{
+    return new dynamic_transform_impl<TBackendImpl>(n, in, out);
+}
+
+template <typename TReal>
+struct dynamic_backend_candidate {
+    typedef std::complex<TReal> complex_t;
+
+    const char *name;
+    bool (*supports)(int transform, int n);
+    dynamic_transform *(*create_forward)(int n, complex_t *in, complex_t *out);
+    dynamic_transform *(*create_inverse)(int n, complex_t *in, complex_t *out);
+    dynamic_transform *(*create_forward_real)(int n, TReal *in, complex_t *out);
+    dynamic_transform *(*create_inverse_real)(int n, complex_t *in, TReal *out);
+};
+
+template <class TBackend>
+inline dynamic_backend_candidate<typename TBackend::fft_real_t>
+make_dynamic_backend_candidate(const char *name, bool (*supports)(int transform, int n))
+{
+    dynamic_backend_candidate<typename TBackend::fft_real_t> c;
+
+    c.name = name;
+    c.supports = supports;
+    c.create_forward = &create_dynamic_transform<typename TBackend::forward>;
+    c.create_inverse = &create_dynamic_transform<typename TBackend::inverse>;
+    c.create_forward_real = &create_dynamic_transform<typename TBackend::forward_real>;
+    c.create_inverse_real = &create_dynamic_transform<typename TBackend::inverse_real>;
+
+    return c;
+}
+
+inline bool is_real_dynamic_backend_transform(int transform) CXXPH_NOEXCEPT
+{
+    return (transform == DynamicBackendForwardReal) || (transform == DynamicBackendInverseReal);
+}
+
+// NOTE:
+// These predicates reflect the FFT size requirements of the libraries; the backends do not check
+// the size (some of them only assert), so unsupported sizes must not reach the constructors.
+inline bool dynamic_backend_supports_any_size(int transform, int n) CXXPH_NOEXCEPT
+{
+    return (is_real_dynamic_backend_transform(transform)) ? (n >= 2 && (n % 2) == 0) : (n >= 1);
+}
+
+inline bool dynamic_backend_supports_pow_of_two(int transform, int n) CXXPH_NOEXCEPT
+{
+    return dynamic_backend_supports_any_size(transform, n) && utils::is_pow_of_two(n);
+}
+
+inline bool dynamic_backend_supports_pffft(int transform, int n) CXXPH_NOEXCEPT
+{
+    return (n > 0) && ((n % ((is_real_dynamic_backend_transform(transform)) ? 32 : 16)) == 0);
+}
+
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+template <typename TReal>
+inline bool dynamic_backend_supports_mixed_radix(int transform, int n) CXXPH_NOEXCEPT
+{
+    return backend::mixed_radix_backend<TReal>::is_supported_size(n, is_real_dynamic_backend_transform(transform));
+}
+#endif
+
+inline void collect_dynamic_backend_candidates(std::vector<dynamic_backend_candidate<fftf_real_t>> &candidates)
+{
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+    candidates.push_back(make_dynamic_backend_candidate<backend::f::pffft>("pffft", &dynamic_backend_supports_pffft));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_FFTS
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::ffts>("ffts", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_KISS_FFT
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::kiss_fft>("kiss_fft", &dynamic_backend_supports_any_size));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_NE10
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::ne10>("ne10", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_FFTWF
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::fftw>("fftwf", &dynamic_backend_supports_any_size));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_CKFFT
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::ckfft>("ckfft", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_MUFFT
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::mufft>("mufft", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_KFR_F
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::f::kfr>("kfr_f", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+    candidates.push_back(make_dynamic_backend_candidate<backend::f::mixed_radix>(
+        "mixed_radix_f", &dynamic_backend_supports_mixed_radix<fftf_real_t>));
+#endif
+    (void)candidates;
+}
+
+inline void collect_dynamic_backend_candidates(std::vector<dynamic_backend_candidate<fftd_real_t>> &candidates)
+{
+#if CXXDASP_USE_FFT_BACKEND_FFTW
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::d::fftw>("fftw", &dynamic_backend_supports_any_size));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_GP_FFT
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::d::gp_fft>("gp_fft", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_KFR_D
+    candidates.push_back(
+        make_dynamic_backend_candidate<backend::d::kfr>("kfr_d", &dynamic_backend_supports_pow_of_two));
+#endif
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+    candidates.push_back(make_dynamic_backend_candidate<backend::d::mixed_radix>(
+        "mixed_radix_d", &dynamic_backend_supports_mixed_radix<fftd_real_t>));
+#endif
+    (void)candidates;
+}
+
+} // namespace impl
+/// @endcond
+
+/**
+ * FFT backend class which selects the fastest compiled-in backend at run time.
+ *
+ * On the first use of a transform type and FFT size, all of the compiled-in backends which support
+ * the size are timed on scratch buffers, and the fastest one is used for every instance of that
+ * transform type and size afterwards. The selections are kept in memory, and can be saved to / loaded
+ * from a file with export_selections() / import_selections() to skip the measurement on the next run.
+ *
+ * @tparam TReal real value type (float or double)
+ *
+ * @note The measurement takes some milliseconds for each new transform type and size, so it is
+ *       recommended to create the instances (or call select_backend()) in the initialization phase.
+ * @note The output scale (scale()) depends on the selected backend.
+ */
+template <typename TReal>
+struct dynamic_backend {
+    /**
+     * Real value type
+     */
+    typedef TReal fft_real_t;
+
+    /**
+     * Complex value type
+     */
+    typedef std::complex<TReal> fft_complex_t;
+
+    /// @cond INTERNAL_FIELD
+    dynamic_backend() = delete;
+
+    typedef impl::dynamic_backend_candidate<fft_real_t> candidate;
+    typedef std::unique_ptr<impl::dynamic_transform> transform_ptr;
+
+    enum {
+        measurement_rounds = 3,
+        min_measurement_time_ns = 100000, // 100 us
+        max_measurement_iterations = (1 << 16),
+    };
+
+    struct state {
+        std::mutex mutex;
+        std::vector<candidate> candidates;
+        std::map<std::pair<int, int>, std::string> selections; // key: (transform, n)
+    };
+
+    // NOTE: intentionally leaked to keep it alive while static objects are destructed
+    static state &get_state()
+    {
+        static state *s = []() {
+            state *p = new state();
+            impl::collect_dynamic_backend_candidates(p->candidates);
+            return p;
+        }();
+        return *s;
+    }
+
+    static int find_candidate(const state &s, const std::string &name) CXXPH_NOEXCEPT
+    {
+        for (size_t i = 0; i < s.candidates.size(); ++i) {
+            if (name == s.candidates[i].name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    static impl::dynamic_transform *create_transform(const candidate &c, int transform, int n, fft_complex_t *a,
+                                                     fft_complex_t *b)
+    {
+        switch (transform) {
+        case DynamicBackendForward:
+            return c.create_forward(n, a, b);
+        case DynamicBackendInverse:
+            return c.create_inverse(n, a, b);
+        case DynamicBackendForwardReal:
+            return c.create_forward_real(n, reinterpret_cast<fft_real_t *>(a), b);
+        case DynamicBackendInverseReal:
+            return c.create_inverse_real(n, a, reinterpret_cast<fft_real_t *>(b));
+        default:
+            return nullptr;
+        }
+    }
+
+    // returns the execution time [ns] per transform, or a negative value if the backend is not usable
+    static double measure(const candidate &c, int transform, int n)
+    {
+        cxxporthelper::aligned_memory<fft_complex_t> a(n, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_complex_t> b(n, FFT_MEMORY_ALIGNMENT);
+
+        for (int i = 0; i < n; ++i) {
+            a[i] = fft_complex_t(static_cast<fft_real_t>((i % 7) - 3), static_cast<fft_real_t>((i % 5) - 2));
+        }
+        std::fill(&b[0], &b[0] + n, fft_complex_t(0));
+
+        transform_ptr t;
+        try
+        {
+            t.reset(create_transform(c, transform, n, &a[0], &b[0]));
+        }
+        catch (...)
+        {
+            return -1.0;
+        }
+
+        if (!t) {
+            return -1.0;
+        }
+
+        // warm up
+        t->execute();
+
+        utils::stopwatch sw;
+        int iterations = 1;
+        long long best_time = 0;
+
+        for (int round = 0; round < measurement_rounds; ++round) {
+            for (;;) {
+                sw.start();
+                for (int i = 0; i < iterations; ++i) {
+                    t->execute();
+                }
+                sw.stop();
+
+                const long long elapsed = sw.get_elapsed_time_ns();
+
+                if (round == 0 && elapsed < min_measurement_time_ns && iterations < max_measurement_iterations) {
+                    // determine the number of iterations in the first round
+                    iterations *= 2;
+                    continue;
+                }
+
+                if (round == 0 || elapsed < best_time) {
+                    best_time = elapsed;
+                }
+                break;
+            }
+        }
+
+        return static_cast<double>(best_time) / iterations;
+    }
+
+    static int select_candidate(int transform, int n)
+    {
+        state &s = get_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        const std::pair<int, int> key(transform, n);
+
+        typename std::map<std::pair<int, int>, std::string>::const_iterator it = s.selections.find(key);
+        if (it != s.selections.end()) {
+            const int index = find_candidate(s, (*it).second);
+            if (index >= 0 && s.candidates[index].supports(transform, n)) {
+                return index;
+            }
+        }
+
+        int best_index = -1;
+        double best_time = 0.0;
+
+        for (size_t i = 0; i < s.candidates.size(); ++i) {
+            const candidate &c = s.candidates[i];
+
+            if (!c.supports(transform, n)) {
+                continue;
+            }
+
+            const double t = measure(c, transform, n);
+
+            if (t >= 0.0 && (best_index < 0 || t < best_time)) {
+                best_index = static_cast<int>(i);
+                best_time = t;
+            }
+        }
+
+        if (best_index < 0) {
+            throw std::runtime_error("dynamic_backend: no FFT backend is available for the requested transform");
+        }
+
+        s.selections[key] = s.candidates[best_index].name;
+
+        return best_index;
+    }
+
+    static int precision_tag() CXXPH_NOEXCEPT { return static_cast<int>(sizeof(fft_real_t) * 8); }
+
+    template <typename Tin, typename Tout>
+    class transform_base : public fft_backend_base<Tin, Tout> {
+        typedef fft_backend_base<Tin, Tout> base;
+
+    public:
+        virtual ~transform_base() {}
+
+        void execute() CXXPH_NOEXCEPT { impl_->execute(); }
+
+        const char *backend_name() const CXXPH_NOEXCEPT { return backend_name_; }
+
+    protected:
+        transform_base(int n, Tin *in, Tout *out, int transform)
+            : transform_base(n, in, out, select_candidate(transform, n), transform)
+        {
+        }
+
+    private:
+        transform_base(int n, Tin *in, Tout *out, int index, int transform)
+            : transform_base(n, in, out, get_state().candidates[index], transform)
+        {
+        }
+
+        transform_base(int n, Tin *in, Tout *out, const candidate &c, int transform)
+            : transform_base(n, in, out, c.name,
+                             transform_ptr(create_transform(c, transform, n, reinterpret_cast<fft_complex_t *>(in),
+                                                            reinterpret_cast<fft_complex_t *>(out))))
+        {
+        }
+
+        transform_base(int n, Tin *in, Tout *out, const char *name, transform_ptr impl)
+            : base(n, in, out, impl->scale()), impl_(std::move(impl)), backend_name_(name)
+        {
+        }
+
+        transform_ptr impl_;
+        const char *backend_name_;
+    };
+    /// @endcond
+
+    /**
+     * Forward (Complex) FFT
+     */
+    class forward : public transform_base<fft_complex_t, fft_complex_t> {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         * @throws std::runtime_error  no backend supports the FFT size
+         */
+        forward(int n, fft_complex_t *in, fft_complex_t *out)
+            : transform_base<fft_complex_t, fft_complex_t>(n, in, out, DynamicBackendForward)
+        {
+        }
+    };
+
+    /**
+     * Inverse (Complex) FFT
+     */
+    class inverse : public transform_base<fft_complex_t, fft_complex_t> {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         * @throws std::runtime_error  no backend supports the FFT size
+         */
+        inverse(int n, fft_complex_t *in, fft_complex_t *out)
+            : transform_base<fft_complex_t, fft_complex_t>(n, in, out, DynamicBackendInverse)
+        {
+        }
+    };
+
+    /**
+     * Forward (Real) FFT
+     */
+    class forward_real : public transform_base<fft_real_t, fft_complex_t> {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         * @throws std::runtime_error  no backend supports the FFT size
+         */
+        forward_real(int n, fft_real_t *in, fft_complex_t *out)
+            : transform_base<fft_real_t, fft_complex_t>(n, in, out, DynamicBackendForwardReal)
+        {
+        }
+    };
+
+    /**
+     * Inverse (Real) FFT
+     */
+    class inverse_real : public transform_base<fft_complex_t, fft_real_t> {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param n [in] FFT size
+         * @param in [in] Input buffer
+         * @param out [in] Output buffer
+         * @throws std::runtime_error  no backend supports the FFT size
+         */
+        inverse_real(int n, fft_complex_t *in, fft_real_t *out)
+            : transform_base<fft_complex_t, fft_real_t>(n, in, out, DynamicBackendInverseReal)
+        {
+        }
+    };
+
+    /**
+     * Get the number of compiled-in backends.
+     * @returns number of the candidate backends
+     */
+    static int num_candidates() { return static_cast<int>(get_state().candidates.size()); }
+
+    /**
+     * Get the name of a compiled-in backend.
+     * @param index [in] candidate index (0 .. num_candidates() - 1)
+     * @returns backend name
+     */
+    static const char *candidate_name(int index) { return get_state().candidates[index].name; }
+
+    /**
+     * Select the backend for a transform type and FFT size.
+     *
+     * @param transform [in] transform type
+     * @param n [in] FFT size
+     * @returns name of the selected backend
+     * @throws std::runtime_error  no backend supports the FFT size
+     *
+     * @note The backends are measured only if no selection is cached for the transform type and size.
+     */
+    static const char *select_backend(dynamic_backend_transform_t transform, int n)
+    {
+        return get_state().candidates[select_candidate(transform, n)].name;
+    }
+
+    /**
+     * Forget all of the cached selections.
+     */
+    static void clear_selections()
+    {
+        state &s = get_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.selections.clear();
+    }
+
+    /**
+     * Import the selections from a file.
+     *
+     * @param filename [in] file path
+     * @returns whether the file is read successfully
+     *
+     * @note Entries of the other precision and entries naming backends which are not compiled in
+     *       are ignored (the latter ones are measured again on use).
+     */
+    static bool import_selections(const char *filename)
+    {
+        std::ifstream ifs(filename);
+
+        if (!ifs) {
+            return false;
+        }
+
+        state &s = get_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        int precision = 0;
+        int transform = 0;
+        int n = 0;
+        std::string name;
+
+        while (ifs >> precision >> transform >> n >> name) {
+            if (precision != precision_tag() || transform < DynamicBackendForward ||
+                transform > DynamicBackendInverseReal || n <= 0) {
+                continue;
+            }
+            s.selections[std::pair<int, int>(transform, n)] = name;
+        }
+
+        return ifs.eof();
+    }
+
+    /**
+     * Export the selections to a file.
+     *
+     * @param filename [in] file path
+     * @returns whether the file is written successfully
+     *
+     * @note The file is overwritten; use separate files for float and double backends.
+     */
+    static bool export_selections(const char *filename)
+    {
+        std::ofstream ofs(filename);
+
+        if (!ofs) {
+            return false;
+        }
+
+        state &s = get_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+
+        typedef std::map<std::pair<int, int>, std::string>::const_iterator iterator;
+        for (iterator it = s.selections.begin(); it != s.selections.end(); ++it) {
+            ofs << precision_tag() << ' ' << (*it).first.first << ' ' << (*it).first.second << ' ' << (*it).second
+                << '\n';
+        }
+
+        ofs.flush();
+
+        return static_cast<bool>(ofs);
+    }
+};
+
+namespace backend {
+
+namespace f {
+/**
+ * Single-precision FFT backend class (selected at run time)
+ */
+typedef dynamic_backend<fftf_real_t> dynamic;
+} // namespace f
+
+namespace d {
+/**
+ * Double-precision FFT backend class (selected at run time)
+ */
+typedef dynamic_backend<fftd_real_t> dynamic;
+} // namespace d
+
+} // namespace backend
+
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_FFT_DYNAMIC_BACKEND_HPP_
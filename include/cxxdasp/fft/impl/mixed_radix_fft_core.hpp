@@ -0,0 +1,352 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_CORE_HPP_
+#define CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_CORE_HPP_
+
+#include <algorithm>
+#include <cassert>
+
+#include <cxxporthelper/cmath>
+#include <cxxporthelper/complex>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/platform_info.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/fft/types.hpp>
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_general.hpp>
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_sse_optimized.hpp>
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_neon_optimized.hpp>
+
+namespace cxxdasp {
+namespace fft {
+namespace impl {
+
+/**
+ * Check the FFT size is supported by the mixed-radix FFT.
+ *
+ * @param n [in] FFT size
+ * @returns whether n is a positive integer which has no prime factors other than 2, 3 and 5
+ */
+inline bool mixed_radix_fft_is_supported_size(int n) CXXPH_NOEXCEPT
+{
+    if (n < 1) {
+        return false;
+    }
+
+    static const int factors[] = { 2, 3, 5 };
+    for (int i = 0; i < 3; ++i) {
+        while ((n % factors[i]) == 0) {
+            n /= factors[i];
+        }
+    }
+
+    return (n == 1);
+}
+
+/// @cond INTERNAL_FIELD
+inline void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                        std::complex<float> *CXXPH_RESTRICT y,
+                                        const std::complex<float> *CXXPH_RESTRICT tw, bool inverse) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#else
+    impl_general::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#endif
+}
+
+inline void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                        std::complex<double> *CXXPH_RESTRICT y,
+                                        const std::complex<double> *CXXPH_RESTRICT tw, bool inverse) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+    impl_neon::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#else
+    impl_general::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+#endif
+}
+
+inline void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                        std::complex<float> *CXXPH_RESTRICT y,
+                                        const std::complex<float> *CXXPH_RESTRICT tw, bool inverse) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#else
+    impl_general::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#endif
+}
+
+inline void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                        std::complex<double> *CXXPH_RESTRICT y,
+                                        const std::complex<double> *CXXPH_RESTRICT tw, bool inverse) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+    impl_neon::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#else
+    impl_general::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+#endif
+}
+/// @endcond
+
+/**
+ * Read-only setup data of the mixed-radix FFT (factorization and twiddle factors).
+ *
+ * The complex transform is performed with the Stockham auto-sort algorithm; radix-4 passes
+ * are used as much as possible, followed by at most one radix-2 pass and then radix-3 / radix-5 passes.
+ * Keeping the power-of-two part first, the radix-2 / radix-4 passes always have power-of-two strides
+ * so the SIMD kernels can be used for all of them.
+ *
+ * The real transform of the size (2 * n) is performed as a complex transform of the size n
+ * and a twiddling step which splits (or merges) the spectra of the even and odd samples.
+ *
+ * @tparam T  real value type (float or double)
+ */
+template <typename T>
+class mixed_radix_fft_setup {
+
+    /// @cond INTERNAL_FIELD
+    mixed_radix_fft_setup(const mixed_radix_fft_setup &) = delete;
+    mixed_radix_fft_setup &operator=(const mixed_radix_fft_setup &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Complex value type
+     */
+    typedef std::complex<T> complex_type;
+
+    /**
+     * Constructor.
+     *
+     * @param n [in] complex FFT size (half of the real FFT size for real transforms)
+     * @param inverse [in] setup for inverse transform
+     * @param real [in] setup for real transforms
+     * @throws std::bad_alloc
+     */
+    mixed_radix_fft_setup(int n, bool inverse, bool real)
+        : n_(n), inverse_(inverse), num_passes_(0), radices_(), offsets_(), twiddles_(), real_twiddles_()
+    {
+        // verify parameters
+        assert(mixed_radix_fft_is_supported_size(n));
+
+        const double sign = (inverse) ? 1.0 : -1.0;
+        const double two_pi = 6.283185307179586476925286766559;
+
+        // factorize
+        int rest = n;
+        while ((rest % 4) == 0) {
+            radices_[num_passes_++] = 4;
+            rest /= 4;
+        }
+        if ((rest % 2) == 0) {
+            radices_[num_passes_++] = 2;
+            rest /= 2;
+        }
+        while ((rest % 3) == 0) {
+            radices_[num_passes_++] = 3;
+            rest /= 3;
+        }
+        while ((rest % 5) == 0) {
+            radices_[num_passes_++] = 5;
+            rest /= 5;
+        }
+
+        // twiddle factors of each pass
+        int num_twiddles = 0;
+        for (int i = 0, l = n; i < num_passes_; l /= radices_[i], ++i) {
+            offsets_[i] = num_twiddles;
+            num_twiddles += (radices_[i] - 1) * (l / radices_[i]);
+        }
+
+        cxxporthelper::aligned_memory<complex_type> twiddles(std::max(num_twiddles, 1), FFT_MEMORY_ALIGNMENT);
+
+        for (int i = 0, l = n; i < num_passes_; l /= radices_[i], ++i) {
+            const int r = radices_[i];
+            const int m = l / r;
+
+            for (int j = 1; j < r; ++j) {
+                for (int p = 0; p < m; ++p) {
+                    const double theta = sign * two_pi * ((j * p) % l) / l;
+                    twiddles[offsets_[i] + (j - 1) * m + p] =
+                        complex_type(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+                }
+            }
+        }
+
+        twiddles_ = std::move(twiddles);
+
+        // twiddle factors of the real transform
+        if (real) {
+            cxxporthelper::aligned_memory<complex_type> real_twiddles((n / 2) + 1, FFT_MEMORY_ALIGNMENT);
+
+            for (int k = 0; k <= (n / 2); ++k) {
+                const double theta = sign * two_pi * k / (2 * n);
+                real_twiddles[k] = complex_type(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+            }
+
+            real_twiddles_ = std::move(real_twiddles);
+        }
+    }
+
+    /**
+     * Get complex FFT size.
+     * @returns complex FFT size
+     */
+    int size() const CXXPH_NOEXCEPT { return n_; }
+
+    /**
+     * Perform the complex transform.
+     *
+     * @param in [in] input buffer (n elements)
+     * @param out [out] output buffer (n elements); may be same as in
+     * @param work [in] work buffer (n elements); must not overlap with in and out
+     */
+    void execute(const complex_type *in, complex_type *out, complex_type *work) const CXXPH_NOEXCEPT
+    {
+        if (num_passes_ == 0) {
+            if (in != out) {
+                out[0] = in[0];
+            }
+            return;
+        }
+
+        // NOTE:
+        // The destination buffers are alternated so that the last pass writes to out.
+        // In-place transforms with an odd number of passes need one more buffer, so the input is moved
+        // to the work buffer first.
+        if ((in == out) && (num_passes_ & 1)) {
+            std::copy(in, in + n_, work);
+            in = work;
+        }
+
+        const complex_type *src = in;
+        int m = n_;
+        int s = 1;
+
+        for (int i = 0; i < num_passes_; ++i) {
+            const int r = radices_[i];
+            complex_type *dest = (((num_passes_ - 1 - i) & 1) == 0) ? out : work;
+            const complex_type *tw = &twiddles_[offsets_[i]];
+
+            m /= r;
+
+            switch (r) {
+            case 2:
+                mixed_radix_fft_radix2_pass(m, s, src, dest, tw, inverse_);
+                break;
+            case 3:
+                impl_general::mixed_radix_fft_radix3_pass(m, s, src, dest, tw, inverse_);
+                break;
+            case 4:
+                mixed_radix_fft_radix4_pass(m, s, src, dest, tw, inverse_);
+                break;
+            case 5:
+                impl_general::mixed_radix_fft_radix5_pass(m, s, src, dest, tw, inverse_);
+                break;
+            default:
+                assert(false);
+                break;
+            }
+
+            src = dest;
+            s *= r;
+        }
+    }
+
+    /**
+     * Convert the complex spectrum of the packed even/odd samples to the real FFT spectrum (in-place).
+     *
+     * @param data [in/out] spectrum buffer; (n) elements input, (n + 1) elements output
+     */
+    void forward_real_postprocess(complex_type *data) const CXXPH_NOEXCEPT
+    {
+        const int h = n_;
+        const T half = static_cast<T>(0.5);
+
+        for (int k = 0; k <= (h / 2); ++k) {
+            const int nk = h - k;
+            const complex_type zk = data[k];
+            const complex_type zc = std::conj(data[(k == 0) ? 0 : nk]);
+
+            // a: spectrum of even samples, b: spectrum of odd samples * twiddle
+            const complex_type a = half * (zk + zc);
+            const complex_type d = half * (zk - zc);
+            const complex_type b = impl_general::mixed_radix_fft_mul(complex_type(d.imag(), -d.real()),
+                                                                       real_twiddles_[k]);
+
+            data[k] = a + b;
+            if (k != nk) {
+                data[nk] = std::conj(a - b);
+            }
+        }
+    }
+
+    /**
+     * Convert the real FFT spectrum to the complex spectrum of the packed even/odd samples.
+     *
+     * @param in [in] spectrum buffer (n + 1 elements)
+     * @param out [out] packed spectrum buffer (n elements); must not overlap with in
+     */
+    void inverse_real_preprocess(const complex_type *CXXPH_RESTRICT in, complex_type *CXXPH_RESTRICT out) const
+        CXXPH_NOEXCEPT
+    {
+        const int h = n_;
+
+        for (int k = 0; k <= (h / 2); ++k) {
+            const int nk = h - k;
+            const complex_type xk = in[k];
+            const complex_type xc = std::conj(in[nk]);
+
+            // a: spectrum of even samples, b: spectrum of odd samples (both scaled by 2)
+            const complex_type a = xk + xc;
+            const complex_type b = impl_general::mixed_radix_fft_mul(xk - xc, real_twiddles_[k]);
+
+            out[k] = complex_type(a.real() - b.imag(), a.imag() + b.real());
+            if (k != 0 && k != nk) {
+                out[nk] = complex_type(a.real() + b.imag(), b.real() - a.imag());
+            }
+        }
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    int n_;
+    bool inverse_;
+    int num_passes_;
+    int radices_[32];
+    int offsets_[32];
+    cxxporthelper::aligned_memory<complex_type> twiddles_;
+    cxxporthelper::aligned_memory<complex_type> real_twiddles_;
+    /// @endcond
+};
+
+} // namespace impl
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_CORE_HPP_
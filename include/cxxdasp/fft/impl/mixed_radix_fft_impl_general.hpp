@@ -0,0 +1,271 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_GENERAL_HPP_
+#define CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_GENERAL_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/complex>
+
+namespace cxxdasp {
+namespace fft {
+namespace impl_general {
+
+//
+// Stockham auto-sort passes
+//
+// Each pass performs radix-r butterflies on the sequence x[] of the length (r * m * s) and
+// writes the twiddled results to y[] in the order which the next pass expects:
+//
+//   y[q + s * (r * p + j)] = W^(j * p) * sum_k { x[q + s * (p + k * m)] * w_r^(j * k) }
+//
+//   (0 <= p < m, 0 <= q < s, W = exp(-+2*pi*i / (r * m)), w_r = exp(-+2*pi*i / r))
+//
+// The twiddle factor W^(j * p) is stored in tw[(j - 1) * m + p].
+// x[] and y[] must not overlap.
+//
+
+/// @cond INTERNAL_FIELD
+template <typename T>
+inline std::complex<T> mixed_radix_fft_mul(const std::complex<T> &a, const std::complex<T> &b) CXXPH_NOEXCEPT
+{
+    return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// multiply by -i (forward) or +i (inverse)
+template <typename T, bool Inverse>
+inline std::complex<T> mixed_radix_fft_rotate(const std::complex<T> &a) CXXPH_NOEXCEPT
+{
+    return (Inverse) ? std::complex<T>(-a.imag(), a.real()) : std::complex<T>(a.imag(), -a.real());
+}
+
+template <typename T, bool Inverse>
+inline void radix2_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x, std::complex<T> *CXXPH_RESTRICT y,
+                        const std::complex<T> *CXXPH_RESTRICT tw) CXXPH_NOEXCEPT
+{
+    for (int p = 0; p < m; ++p) {
+        const std::complex<T> w1 = tw[p];
+        const std::complex<T> *CXXPH_RESTRICT x0 = &x[s * (p + 0 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x1 = &x[s * (p + 1 * m)];
+        std::complex<T> *CXXPH_RESTRICT y0 = &y[s * (2 * p + 0)];
+        std::complex<T> *CXXPH_RESTRICT y1 = &y[s * (2 * p + 1)];
+
+        for (int q = 0; q < s; ++q) {
+            const std::complex<T> a0 = x0[q];
+            const std::complex<T> a1 = x1[q];
+
+            y0[q] = a0 + a1;
+            y1[q] = mixed_radix_fft_mul(a0 - a1, w1);
+        }
+    }
+}
+
+template <typename T, bool Inverse>
+inline void radix3_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x, std::complex<T> *CXXPH_RESTRICT y,
+                        const std::complex<T> *CXXPH_RESTRICT tw) CXXPH_NOEXCEPT
+{
+    const T c1 = static_cast<T>(-0.5);
+    const T s1 = static_cast<T>(0.86602540378443864676); // sin(2 * pi / 3)
+
+    for (int p = 0; p < m; ++p) {
+        const std::complex<T> w1 = tw[0 * m + p];
+        const std::complex<T> w2 = tw[1 * m + p];
+        const std::complex<T> *CXXPH_RESTRICT x0 = &x[s * (p + 0 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x1 = &x[s * (p + 1 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x2 = &x[s * (p + 2 * m)];
+        std::complex<T> *CXXPH_RESTRICT y0 = &y[s * (3 * p + 0)];
+        std::complex<T> *CXXPH_RESTRICT y1 = &y[s * (3 * p + 1)];
+        std::complex<T> *CXXPH_RESTRICT y2 = &y[s * (3 * p + 2)];
+
+        for (int q = 0; q < s; ++q) {
+            const std::complex<T> a0 = x0[q];
+            const std::complex<T> a1 = x1[q];
+            const std::complex<T> a2 = x2[q];
+
+            const std::complex<T> t1 = a1 + a2;
+            const std::complex<T> t2 = a0 + c1 * t1;
+            const std::complex<T> t3 = mixed_radix_fft_rotate<T, Inverse>(s1 * (a1 - a2));
+
+            y0[q] = a0 + t1;
+            y1[q] = mixed_radix_fft_mul(t2 + t3, w1);
+            y2[q] = mixed_radix_fft_mul(t2 - t3, w2);
+        }
+    }
+}
+
+template <typename T, bool Inverse>
+inline void radix4_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x, std::complex<T> *CXXPH_RESTRICT y,
+                        const std::complex<T> *CXXPH_RESTRICT tw) CXXPH_NOEXCEPT
+{
+    for (int p = 0; p < m; ++p) {
+        const std::complex<T> w1 = tw[0 * m + p];
+        const std::complex<T> w2 = tw[1 * m + p];
+        const std::complex<T> w3 = tw[2 * m + p];
+        const std::complex<T> *CXXPH_RESTRICT x0 = &x[s * (p + 0 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x1 = &x[s * (p + 1 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x2 = &x[s * (p + 2 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x3 = &x[s * (p + 3 * m)];
+        std::complex<T> *CXXPH_RESTRICT y0 = &y[s * (4 * p + 0)];
+        std::complex<T> *CXXPH_RESTRICT y1 = &y[s * (4 * p + 1)];
+        std::complex<T> *CXXPH_RESTRICT y2 = &y[s * (4 * p + 2)];
+        std::complex<T> *CXXPH_RESTRICT y3 = &y[s * (4 * p + 3)];
+
+        for (int q = 0; q < s; ++q) {
+            const std::complex<T> a0 = x0[q];
+            const std::complex<T> a1 = x1[q];
+            const std::complex<T> a2 = x2[q];
+            const std::complex<T> a3 = x3[q];
+
+            const std::complex<T> t0 = a0 + a2;
+            const std::complex<T> t1 = a0 - a2;
+            const std::complex<T> t2 = a1 + a3;
+            const std::complex<T> t3 = mixed_radix_fft_rotate<T, Inverse>(a1 - a3);
+
+            y0[q] = t0 + t2;
+            y1[q] = mixed_radix_fft_mul(t1 + t3, w1);
+            y2[q] = mixed_radix_fft_mul(t0 - t2, w2);
+            y3[q] = mixed_radix_fft_mul(t1 - t3, w3);
+        }
+    }
+}
+
+template <typename T, bool Inverse>
+inline void radix5_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x, std::complex<T> *CXXPH_RESTRICT y,
+                        const std::complex<T> *CXXPH_RESTRICT tw) CXXPH_NOEXCEPT
+{
+    const T c1 = static_cast<T>(0.30901699437494742410);  // cos(2 * pi / 5)
+    const T c2 = static_cast<T>(-0.80901699437494742410); // cos(4 * pi / 5)
+    const T s1 = static_cast<T>(0.95105651629515357212);  // sin(2 * pi / 5)
+    const T s2 = static_cast<T>(0.58778525229247312917);  // sin(4 * pi / 5)
+
+    for (int p = 0; p < m; ++p) {
+        const std::complex<T> w1 = tw[0 * m + p];
+        const std::complex<T> w2 = tw[1 * m + p];
+        const std::complex<T> w3 = tw[2 * m + p];
+        const std::complex<T> w4 = tw[3 * m + p];
+        const std::complex<T> *CXXPH_RESTRICT x0 = &x[s * (p + 0 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x1 = &x[s * (p + 1 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x2 = &x[s * (p + 2 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x3 = &x[s * (p + 3 * m)];
+        const std::complex<T> *CXXPH_RESTRICT x4 = &x[s * (p + 4 * m)];
+        std::complex<T> *CXXPH_RESTRICT y0 = &y[s * (5 * p + 0)];
+        std::complex<T> *CXXPH_RESTRICT y1 = &y[s * (5 * p + 1)];
+        std::complex<T> *CXXPH_RESTRICT y2 = &y[s * (5 * p + 2)];
+        std::complex<T> *CXXPH_RESTRICT y3 = &y[s * (5 * p + 3)];
+        std::complex<T> *CXXPH_RESTRICT y4 = &y[s * (5 * p + 4)];
+
+        for (int q = 0; q < s; ++q) {
+            const std::complex<T> a0 = x0[q];
+            const std::complex<T> a1 = x1[q];
+            const std::complex<T> a2 = x2[q];
+            const std::complex<T> a3 = x3[q];
+            const std::complex<T> a4 = x4[q];
+
+            const std::complex<T> t1 = a1 + a4;
+            const std::complex<T> t2 = a2 + a3;
+            const std::complex<T> t3 = a1 - a4;
+            const std::complex<T> t4 = a2 - a3;
+
+            const std::complex<T> r1 = a0 + c1 * t1 + c2 * t2;
+            const std::complex<T> r2 = a0 + c2 * t1 + c1 * t2;
+            const std::complex<T> i1 = mixed_radix_fft_rotate<T, Inverse>(s1 * t3 + s2 * t4);
+            const std::complex<T> i2 = mixed_radix_fft_rotate<T, Inverse>(s2 * t3 - s1 * t4);
+
+            y0[q] = a0 + t1 + t2;
+            y1[q] = mixed_radix_fft_mul(r1 + i1, w1);
+            y2[q] = mixed_radix_fft_mul(r2 + i2, w2);
+            y3[q] = mixed_radix_fft_mul(r2 - i2, w3);
+            y4[q] = mixed_radix_fft_mul(r1 - i1, w4);
+        }
+    }
+}
+/// @endcond
+
+/**
+ * Perform a radix-2 Stockham pass.
+ *
+ * @param m [in] number of butterfly groups
+ * @param s [in] stride (product of the radices of the preceding passes)
+ * @param x [in] source sequence (r * m * s elements)
+ * @param y [out] destination sequence (r * m * s elements)
+ * @param tw [in] twiddle factors of this pass
+ * @param inverse [in] perform inverse transform
+ */
+template <typename T>
+inline void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x,
+                                        std::complex<T> *CXXPH_RESTRICT y, const std::complex<T> *CXXPH_RESTRICT tw,
+                                        bool inverse) CXXPH_NOEXCEPT
+{
+    if (inverse) {
+        radix2_pass<T, true>(m, s, x, y, tw);
+    } else {
+        radix2_pass<T, false>(m, s, x, y, tw);
+    }
+}
+
+/**
+ * Perform a radix-3 Stockham pass.
+ * @sa mixed_radix_fft_radix2_pass()
+ */
+template <typename T>
+inline void mixed_radix_fft_radix3_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x,
+                                        std::complex<T> *CXXPH_RESTRICT y, const std::complex<T> *CXXPH_RESTRICT tw,
+                                        bool inverse) CXXPH_NOEXCEPT
+{
+    if (inverse) {
+        radix3_pass<T, true>(m, s, x, y, tw);
+    } else {
+        radix3_pass<T, false>(m, s, x, y, tw);
+    }
+}
+
+/**
+ * Perform a radix-4 Stockham pass.
+ * @sa mixed_radix_fft_radix2_pass()
+ */
+template <typename T>
+inline void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x,
+                                        std::complex<T> *CXXPH_RESTRICT y, const std::complex<T> *CXXPH_RESTRICT tw,
+                                        bool inverse) CXXPH_NOEXCEPT
+{
+    if (inverse) {
+        radix4_pass<T, true>(m, s, x, y, tw);
+    } else {
+        radix4_pass<T, false>(m, s, x, y, tw);
+    }
+}
+
+/**
+ * Perform a radix-5 Stockham pass.
+ * @sa mixed_radix_fft_radix2_pass()
+ */
+template <typename T>
+inline void mixed_radix_fft_radix5_pass(int m, int s, const std::complex<T> *CXXPH_RESTRICT x,
+                                        std::complex<T> *CXXPH_RESTRICT y, const std::complex<T> *CXXPH_RESTRICT tw,
+                                        bool inverse) CXXPH_NOEXCEPT
+{
+    if (inverse) {
+        radix5_pass<T, true>(m, s, x, y, tw);
+    } else {
+        radix5_pass<T, false>(m, s, x, y, tw);
+    }
+}
+
+} // namespace impl_general
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_GENERAL_HPP_
@@ -0,0 +1,55 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_NEON_OPTIMIZED_HPP_
+#define CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_NEON_OPTIMIZED_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/complex>
+#include <cxxporthelper/platform_info.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                                \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+
+namespace cxxdasp {
+namespace fft {
+namespace impl_neon {
+
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT;
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT;
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT;
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT;
+#endif
+
+} // namespace impl_neon
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON && ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH ==
+       // CXXPH_ARCH_ARM64))
+#endif // CXXDASP_FFT_IMPL_MIXED_RADIX_FFT_IMPL_NEON_OPTIMIZED_HPP_
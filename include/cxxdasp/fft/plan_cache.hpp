@@ -0,0 +1,168 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FFT_PLAN_CACHE_HPP_
+#define CXXDASP_FFT_PLAN_CACHE_HPP_
+
+#include <map>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxdasp {
+namespace fft {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+// NOTE:
+// All plan caches share one mutex; some FFT libraries (e.g. FFTW) have a global planner
+// which must not be called from multiple threads at the same time.
+// The mutex is intentionally leaked to keep it alive while static objects are destructed.
+inline std::recursive_mutex &plan_cache_mutex()
+{
+    static std::recursive_mutex *mutex = new std::recursive_mutex();
+    return *mutex;
+}
+
+} // namespace impl
+/// @endcond
+
+/**
+ * Process-wide cache of read-only FFT setup data (plans, twiddle tables, ...).
+ *
+ * FFT instances which perform the same transform share one setup object and
+ * keep only their own work buffers. A setup object is destroyed when the last
+ * instance which refers to it is released.
+ *
+ * @tparam TTag  tag type which identifies the backend and the kind of the setup
+ * @tparam TPlan  setup object type (pointee type of the library's plan handle)
+ *
+ * @note The setup object must not be modified while executing a transform.
+ */
+template <typename TTag, typename TPlan>
+class shared_plan_cache {
+public:
+    /**
+     * Shared setup object pointer type
+     */
+    typedef std::shared_ptr<TPlan> plan_ptr;
+
+    /// @cond INTERNAL_FIELD
+    shared_plan_cache() = delete;
+    /// @endcond
+
+    /**
+     * Acquire a shared setup object.
+     *
+     * @param n [in] FFT size
+     * @param variant [in] additional key (direction, buffer layout, ...)
+     * @param create [in] function object which creates a new setup object; called with no arguments
+     * @param destroy [in] function object which destroys the setup object; called with the setup object
+     * @returns shared setup object
+     * @throws std::bad_alloc  create() returned nullptr
+     */
+    template <typename TCreate, typename TDestroy>
+    static plan_ptr acquire(int n, int variant, TCreate create, TDestroy destroy)
+    {
+        std::lock_guard<std::recursive_mutex> lock(impl::plan_cache_mutex());
+
+        plan_map &plans = get_plan_map();
+        const key_type key(n, variant);
+
+        typename plan_map::iterator it = plans.find(key);
+        if (it != plans.end()) {
+            plan_ptr plan = (*it).second.lock();
+            if (plan) {
+                return plan;
+            }
+        }
+
+        TPlan *raw_plan = create();
+        if (!raw_plan) {
+            throw std::bad_alloc();
+        }
+
+        plan_ptr plan(raw_plan, deleter<TDestroy>(key, destroy));
+        plans[key] = plan;
+
+        return plan;
+    }
+
+    /**
+     * Get the number of alive setup objects.
+     * @returns the number of setup objects currently in use
+     */
+    static int num_cached_plans()
+    {
+        std::lock_guard<std::recursive_mutex> lock(impl::plan_cache_mutex());
+
+        const plan_map &plans = get_plan_map();
+        int count = 0;
+
+        for (typename plan_map::const_iterator it = plans.begin(); it != plans.end(); ++it) {
+            if (!(*it).second.expired()) {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef std::pair<int, int> key_type;
+    typedef std::map<key_type, std::weak_ptr<TPlan>> plan_map;
+
+    template <typename TDestroy>
+    struct deleter {
+        deleter(const key_type &key, TDestroy destroy) : key_(key), destroy_(destroy) {}
+
+        void operator()(TPlan *plan)
+        {
+            std::lock_guard<std::recursive_mutex> lock(impl::plan_cache_mutex());
+
+            plan_map &plans = get_plan_map();
+            typename plan_map::iterator it = plans.find(key_);
+
+            // NOTE: the entry may have been replaced by a new setup object already
+            if (it != plans.end() && (*it).second.expired()) {
+                plans.erase(it);
+            }
+
+            destroy_(plan);
+        }
+
+        key_type key_;
+        TDestroy destroy_;
+    };
+
+    static plan_map &get_plan_map()
+    {
+        // NOTE: intentionally leaked (see impl::plan_cache_mutex())
+        static plan_map *plans = new plan_map();
+        return *plans;
+    }
+    /// @endcond
+};
+
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXDASP_FFT_PLAN_CACHE_HPP_
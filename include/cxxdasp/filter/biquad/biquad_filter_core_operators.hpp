@@ -22,6 +22,12 @@
 // direct form 1
 #include <cxxdasp/filter/biquad/general_biquad_df1_core_operator.hpp>
 
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#include <cxxdasp/filter/biquad/f32_mono_sse_biquad_df1_core_operator.hpp>
+#include <cxxdasp/filter/biquad/f32_stereo_sse_biquad_df1_core_operator.hpp>
+#include <cxxdasp/filter/biquad/f32_stereo_avx_biquad_df1_core_operator.hpp>
+#endif
+
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
 #include <cxxdasp/filter/biquad/f32_mono_neon_biquad_df1_core_operator.hpp>
 #include <cxxdasp/filter/biquad/f32_stereo_neon_biquad_df1_core_operator.hpp>
@@ -30,6 +36,12 @@
 // transposed direct form 2
 #include <cxxdasp/filter/biquad/general_biquad_tdf2_core_operator.hpp>
 
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#include <cxxdasp/filter/biquad/f32_mono_sse_biquad_tdf2_core_operator.hpp>
+#include <cxxdasp/filter/biquad/f32_stereo_sse_biquad_tdf2_core_operator.hpp>
+#include <cxxdasp/filter/biquad/f32_stereo_avx_biquad_tdf2_core_operator.hpp>
+#endif
+
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
 #include <cxxdasp/filter/biquad/f32_mono_neon_biquad_tdf2_core_operator.hpp>
 #include <cxxdasp/filter/biquad/f32_stereo_neon_biquad_tdf2_core_operator.hpp>
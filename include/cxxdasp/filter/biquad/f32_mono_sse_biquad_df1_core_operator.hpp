@@ -0,0 +1,165 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_BIQUAD_F32_MONO_SSE_BIQUAD_DF1_CORE_OPERATOR_HPP_
+#define CXXDASP_FILTER_BIQUAD_F32_MONO_SSE_BIQUAD_DF1_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/platform_info.hpp>
+
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/cascaded_biquad/biquad_block_state_space_coeffs.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+class f32_mono_sse_biquad_direct_form_1_core_operator_impl {
+public:
+    static void perform(const float *src, float *dest, int n, const float *CXXPH_RESTRICT coeffs,
+                        float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT;
+};
+
+} // namespace impl
+/// @endcond
+
+/**
+ * SSE optimized biquad filter core operator (monaural, Direct Form 1)
+ *
+ * Processes 4 samples per vector step using the block state-space formulation
+ * (see impl::biquad_df1_block_state_space_coeffs).
+ */
+class f32_mono_sse_biquad_direct_form_1_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    f32_mono_sse_biquad_direct_form_1_core_operator(const f32_mono_sse_biquad_direct_form_1_core_operator &) = delete;
+    f32_mono_sse_biquad_direct_form_1_core_operator &
+    operator=(const f32_mono_sse_biquad_direct_form_1_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Audio frame type.
+     */
+    typedef datatype::audio_frame<float, 1> frame_type;
+
+    /**
+     * Value type.
+     */
+    typedef float value_type;
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static bool is_supported() { return cxxporthelper::platform_info::support_sse(); }
+
+    /**
+     * Constructor.
+     */
+    f32_mono_sse_biquad_direct_form_1_core_operator();
+
+    /**
+     * Destructor.
+     */
+    ~f32_mono_sse_biquad_direct_form_1_core_operator();
+
+    /**
+     * Set parameters.
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     */
+    void set_params(double b0, double b1, double b2, double a1, double a2) CXXPH_NOEXCEPT;
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src_dest [in/out] data buffer (overwrite)
+     * @param n [in] count of samples
+     */
+    void perform(frame_type *src_dest, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src [in] source data buffer
+     * @param dest [out] destination data buffer
+     * @param n [in] count of samples
+     */
+    void perform(const frame_type *CXXPH_RESTRICT src, frame_type *CXXPH_RESTRICT dest, int n) CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef impl::f32_mono_sse_biquad_direct_form_1_core_operator_impl impl_class;
+    typedef impl::biquad_df1_block_state_space_coeffs block_coeffs_type;
+
+    float coeffs_[block_coeffs_type::size];
+
+    // x[n-1], x[n-2], y[n-1], y[n-2]
+    float state_[4];
+    /// @endcond
+};
+
+inline f32_mono_sse_biquad_direct_form_1_core_operator::f32_mono_sse_biquad_direct_form_1_core_operator()
+{
+    block_coeffs_type::make(0.0, 0.0, 0.0, 0.0, 0.0, coeffs_);
+    reset();
+}
+
+inline f32_mono_sse_biquad_direct_form_1_core_operator::~f32_mono_sse_biquad_direct_form_1_core_operator() {}
+
+inline void f32_mono_sse_biquad_direct_form_1_core_operator::set_params(double b0, double b1, double b2, double a1,
+                                                                        double a2) CXXPH_NOEXCEPT
+{
+    block_coeffs_type::make(b0, b1, b2, a1, a2, coeffs_);
+}
+
+inline void f32_mono_sse_biquad_direct_form_1_core_operator::reset() CXXPH_NOEXCEPT
+{
+    for (auto &r : state_) {
+        r = 0;
+    }
+}
+
+inline void f32_mono_sse_biquad_direct_form_1_core_operator::perform(frame_type *src_dest, int n) CXXPH_NOEXCEPT
+{
+    impl_class::perform(reinterpret_cast<const float *>(src_dest), reinterpret_cast<float *>(src_dest), n, coeffs_,
+                        state_);
+}
+
+inline void f32_mono_sse_biquad_direct_form_1_core_operator::perform(const frame_type *CXXPH_RESTRICT src,
+                                                                     frame_type *CXXPH_RESTRICT dest, int n)
+    CXXPH_NOEXCEPT
+{
+    impl_class::perform(reinterpret_cast<const float *>(src), reinterpret_cast<float *>(dest), n, coeffs_, state_);
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#endif // CXXDASP_FILTER_BIQUAD_F32_MONO_SSE_BIQUAD_DF1_CORE_OPERATOR_HPP_
@@ -0,0 +1,179 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_CASCADED_BIQUAD_BIQUAD_BLOCK_STATE_SPACE_COEFFS_HPP_
+#define CXXDASP_FILTER_CASCADED_BIQUAD_BIQUAD_BLOCK_STATE_SPACE_COEFFS_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+/**
+ * Block state-space coefficients of a biquad filter (Transposed Direct Form 2, 4 samples per block)
+ *
+ * A block of 4 samples is processed at once as:
+ *
+ *     y[0..3] = D * x[0..3] + C * s
+ *     s'      = B * x[0..3] + A * s
+ *
+ * where s = (s1, s2) is the TDF2 state. Every term is independent of the other outputs in the block,
+ * so y[0..3] can be computed with 4-wide SIMD operations and the only serial dependency left is the
+ * 2-element state, once per block instead of once per sample.
+ *
+ * Coefficients layout (each column is 4 floats):
+ *   [ 0..15] D columns (x0, x1, x2, x3)
+ *   [16..23] C columns (s1, s2)
+ *   [24..39] B columns (x0, x1, x2, x3)  (lane 0: s1', lane 1: s2', lane 2-3: zero)
+ *   [40..47] A columns (s1, s2)          (lane 0: s1', lane 1: s2', lane 2-3: zero)
+ *   [48..55] b0, b1, b2, -a1, -a2, 0, 0, 0 (used for the remaining samples)
+ */
+class biquad_tdf2_block_state_space_coeffs {
+public:
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int block_size = 4;
+    static constexpr int size = 56;
+#else
+    enum { block_size = 4 };
+    enum { size = 56 };
+#endif
+
+    /**
+     * Make coefficients.
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     * @param coeffs [out] coefficients (size: 56)
+     */
+    static void make(double b0, double b1, double b2, double a1, double a2, float *coeffs) CXXPH_NOEXCEPT
+    {
+        // columns 0-3: response to a unit input sample, columns 4-5: response to a unit initial state
+        for (int col = 0; col < (block_size + 2); ++col) {
+            double s1 = (col == block_size) ? 1.0 : 0.0;
+            double s2 = (col == (block_size + 1)) ? 1.0 : 0.0;
+
+            for (int i = 0; i < block_size; ++i) {
+                const double x0 = (i == col) ? 1.0 : 0.0;
+                const double y0 = b0 * x0 + s1;
+
+                s1 = b1 * x0 - a1 * y0 + s2;
+                s2 = b2 * x0 - a2 * y0;
+
+                coeffs[block_size * col + i] = static_cast<float>(y0);
+            }
+
+            float *state_col = &coeffs[block_size * (block_size + 2) + block_size * col];
+
+            state_col[0] = static_cast<float>(s1);
+            state_col[1] = static_cast<float>(s2);
+            state_col[2] = 0.0f;
+            state_col[3] = 0.0f;
+        }
+
+        float *scalar_coeffs = &coeffs[2 * block_size * (block_size + 2)];
+
+        scalar_coeffs[0] = static_cast<float>(b0);
+        scalar_coeffs[1] = static_cast<float>(b1);
+        scalar_coeffs[2] = static_cast<float>(b2);
+        scalar_coeffs[3] = static_cast<float>(-a1);
+        scalar_coeffs[4] = static_cast<float>(-a2);
+        scalar_coeffs[5] = 0.0f;
+        scalar_coeffs[6] = 0.0f;
+        scalar_coeffs[7] = 0.0f;
+    }
+};
+
+/**
+ * Block state-space coefficients of a biquad filter (Direct Form 1, 4 samples per block)
+ *
+ * A block of 4 samples is processed at once as:
+ *
+ *     y[0..3] = D * x[0..3] + C * (x[-1], x[-2], y[-1], y[-2])
+ *
+ * The next state is taken from the last two input and output samples of the block, so the only
+ * serial dependency is the (y[-1], y[-2]) term, once per block instead of once per sample.
+ *
+ * Coefficients layout (each column is 4 floats):
+ *   [ 0..15] D columns (x0, x1, x2, x3)
+ *   [16..31] C columns (x[-1], x[-2], y[-1], y[-2])
+ *   [32..39] b0, b1, b2, -a1, -a2, 0, 0, 0 (used for the remaining samples)
+ */
+class biquad_df1_block_state_space_coeffs {
+public:
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int block_size = 4;
+    static constexpr int size = 40;
+#else
+    enum { block_size = 4 };
+    enum { size = 40 };
+#endif
+
+    /**
+     * Make coefficients.
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     * @param coeffs [out] coefficients (size: 40)
+     */
+    static void make(double b0, double b1, double b2, double a1, double a2, float *coeffs) CXXPH_NOEXCEPT
+    {
+        // columns 0-3: response to a unit input sample, columns 4-7: response to a unit initial state
+        for (int col = 0; col < (block_size + 4); ++col) {
+            double x1 = (col == (block_size + 0)) ? 1.0 : 0.0;
+            double x2 = (col == (block_size + 1)) ? 1.0 : 0.0;
+            double y1 = (col == (block_size + 2)) ? 1.0 : 0.0;
+            double y2 = (col == (block_size + 3)) ? 1.0 : 0.0;
+
+            for (int i = 0; i < block_size; ++i) {
+                const double x0 = (i == col) ? 1.0 : 0.0;
+                const double y0 = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+
+                x2 = x1;
+                x1 = x0;
+                y2 = y1;
+                y1 = y0;
+
+                coeffs[block_size * col + i] = static_cast<float>(y0);
+            }
+        }
+
+        float *scalar_coeffs = &coeffs[block_size * (block_size + 4)];
+
+        scalar_coeffs[0] = static_cast<float>(b0);
+        scalar_coeffs[1] = static_cast<float>(b1);
+        scalar_coeffs[2] = static_cast<float>(b2);
+        scalar_coeffs[3] = static_cast<float>(-a1);
+        scalar_coeffs[4] = static_cast<float>(-a2);
+        scalar_coeffs[5] = 0.0f;
+        scalar_coeffs[6] = 0.0f;
+        scalar_coeffs[7] = 0.0f;
+    }
+};
+
+} // namespace impl
+/// @endcond
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_CASCADED_BIQUAD_BIQUAD_BLOCK_STATE_SPACE_COEFFS_HPP_
@@ -24,6 +24,11 @@
 // transposed direct form 2
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
 #include <cxxdasp/filter/cascaded_biquad/f32_stereo_neon_cascaded_2_biquad_tdf2_core_operator.hpp>
+#include <cxxdasp/filter/cascaded_biquad/f32_mono_neon_cascaded_biquad_block_tdf2_core_operator.hpp>
+#endif
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#include <cxxdasp/filter/cascaded_biquad/f32_mono_sse_cascaded_biquad_block_tdf2_core_operator.hpp>
 #endif
 
 #endif // CXXDASP_FILTER_CASCADED_BIQUAD_CASCADED_BIQUAD_FILTER_CORE_OPERATORS_HPP_
@@ -0,0 +1,195 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_CASCADED_BIQUAD_F32_MONO_NEON_CASCADED_BIQUAD_BLOCK_TDF2_CORE_OPERATOR_HPP_
+#define CXXDASP_FILTER_CASCADED_BIQUAD_F32_MONO_NEON_CASCADED_BIQUAD_BLOCK_TDF2_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+
+#include <cxxporthelper/arm_neon.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/cascaded_biquad/biquad_block_state_space_coeffs.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+class f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator_impl {
+public:
+    static void perform(const float *src, float *dest, int n, int num_cascaded, const float *CXXPH_RESTRICT coeffs,
+                        float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT;
+};
+
+} // namespace impl
+/// @endcond
+
+/**
+ * NEON optimized cascaded biquad filter core operator (mono, Transposed Direct Form 2, block state-space)
+ *
+ * Each biquad section processes 4 samples per vector step using the block state-space
+ * formulation (see impl::biquad_tdf2_block_state_space_coeffs), so the sample-to-sample
+ * recursion of a mono signal does not serialize the SIMD unit.
+ *
+ * @tparam NCascaded number of cascaded filters
+ */
+template <int NCascaded>
+class f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator(
+        const f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator &) = delete;
+    f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator &
+    operator=(const f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Audio frame type.
+     */
+    typedef datatype::audio_frame<float, 1> frame_type;
+
+    /**
+     * Value type.
+     */
+    typedef float value_type;
+
+/**
+     * Number of cascaded filters.
+     */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int num_cascaded = NCascaded;
+#else
+    enum { num_cascaded = NCascaded };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static bool is_supported() CXXPH_NOEXCEPT { return cxxporthelper::platform_info::support_arm_neon(); }
+
+    /**
+     * Constructor.
+     */
+    f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator();
+
+    /**
+     * Destructor.
+     */
+    ~f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator();
+
+    /**
+     * Set parameters.
+     * @param filter_no [in] filter no.
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     */
+    void set_params(int filter_no, double b0, double b1, double b2, double a1, double a2) CXXPH_NOEXCEPT;
+
+    /**
+     * Reset state.
+     * @param filter_no [in] filter no.
+     */
+    void reset(int filter_no) CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src_dest [in/out] data buffer (overwrite)
+     * @param n [in] count of samples
+     */
+    void perform(frame_type *src_dest, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src [in] source data buffer
+     * @param dest [out] destination data buffer
+     * @param n [in] count of samples
+     */
+    void perform(const frame_type *CXXPH_RESTRICT src, frame_type *CXXPH_RESTRICT dest, int n) CXXPH_NOEXCEPT;
+
+private:
+    static_assert((num_cascaded >= 1), "NCascaded must be grater than or equals to 1");
+
+    /// @cond INTERNAL_FIELD
+    typedef impl::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator_impl impl_class;
+    typedef impl::biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    float coeffs_[NCascaded][block_coeffs_type::size];
+    float state_[NCascaded][2];
+    /// @endcond
+};
+
+template <int NCascaded>
+inline f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::
+    f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator()
+{
+    for (int no = 0; no < NCascaded; ++no) {
+        block_coeffs_type::make(0.0, 0.0, 0.0, 0.0, 0.0, &coeffs_[no][0]);
+        reset(no);
+    }
+}
+
+template <int NCascaded>
+inline f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::
+    ~f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator()
+{
+}
+
+template <int NCascaded>
+inline void f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::set_params(
+    int filter_no, double b0, double b1, double b2, double a1, double a2) CXXPH_NOEXCEPT
+{
+    block_coeffs_type::make(b0, b1, b2, a1, a2, &coeffs_[filter_no][0]);
+}
+
+template <int NCascaded>
+inline void f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::reset(
+    int filter_no) CXXPH_NOEXCEPT
+{
+    state_[filter_no][0] = static_cast<value_type>(0);
+    state_[filter_no][1] = static_cast<value_type>(0);
+}
+
+template <int NCascaded>
+inline void f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::perform(
+    frame_type *src_dest, int n) CXXPH_NOEXCEPT
+{
+    impl_class::perform(reinterpret_cast<const float *>(src_dest), reinterpret_cast<float *>(src_dest), n,
+                        num_cascaded, &coeffs_[0][0], &state_[0][0]);
+}
+
+template <int NCascaded>
+inline void f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<NCascaded>::perform(
+    const frame_type *CXXPH_RESTRICT src, frame_type *CXXPH_RESTRICT dest, int n) CXXPH_NOEXCEPT
+{
+    impl_class::perform(reinterpret_cast<const float *>(src), reinterpret_cast<float *>(dest), n, num_cascaded,
+                        &coeffs_[0][0], &state_[0][0]);
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON
+#endif // CXXDASP_FILTER_CASCADED_BIQUAD_F32_MONO_NEON_CASCADED_BIQUAD_BLOCK_TDF2_CORE_OPERATOR_HPP_
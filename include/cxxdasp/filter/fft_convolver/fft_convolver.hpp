@@ -0,0 +1,235 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FILTER_FFT_CONVOLVER_FFT_CONVOLVER_HPP_
+#define CXXDASP_FILTER_FFT_CONVOLVER_FFT_CONVOLVER_HPP_
+
+#include <cxxporthelper/utility>
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/fft_convolver/single_channel_fft_convolver.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/**
+ * FFT convolver (multi channel)
+ *
+ * Applies the same (arbitrary long) FIR filter to every channel using the uniformly partitioned overlap-save method.
+ *
+ * @tparam TSrc source audio frame type
+ * @tparam TDest destination audio frame type
+ * @tparam TCoeffs FIR coefficients type
+ * @tparam TFFTBackend FFT backend class
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class fft_convolver {
+
+    /// @cond INTERNAL_FIELD
+    fft_convolver(const fft_convolver &) = delete;
+    fft_convolver &operator=(const fft_convolver &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source audio frame type.
+     */
+    typedef TSrc src_frame_t;
+
+    /**
+     * Destination audio frame type.
+     */
+    typedef TDest dest_frame_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef TCoeffs coeffs_t;
+
+    /**
+     * FFT backend class.
+     */
+    typedef TFFTBackend fft_backend_type;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] block_size processing block size (power of two, 0: auto)
+     *
+     * @note When block_size is 0, the block size which minimizes the processing cost per sample is used.
+     *       (see single_channel_fft_convolver_shared_context::calc_optimal_block_size())
+     *       The latency of this filter equals to the block size.
+     */
+    fft_convolver(const coeffs_t *filter_kernel, int filter_length, int block_size = 0);
+
+    /**
+     * Destructor.
+     */
+    ~fft_convolver();
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush buffered data.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Put input data
+     *
+     * @param s [in] source data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_put())
+     */
+    void put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get output (filtered) data
+     *
+     * @param d [in] destination data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_get())
+     */
+    void get_n(dest_frame_t *d, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get free size of internal buffer.
+     * @returns count of free size of internal buffer [frames]
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get count of available filtered data.
+     * @returns count of available filtered data [frames]
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get processing block size.
+     * @returns processing block size (= latency) [frames]
+     */
+    int block_size() const CXXPH_NOEXCEPT { return shared_context_.block_size(); }
+
+    /**
+     * Get count of the filter partitions.
+     * @returns count of the filter partitions
+     */
+    int num_partitions() const CXXPH_NOEXCEPT { return shared_context_.num_partitions(); }
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef typename src_frame_t::data_type src_data_type;
+    typedef typename dest_frame_t::data_type dest_data_type;
+
+    typedef single_channel_fft_convolver_shared_context<src_data_type, dest_data_type, coeffs_t, fft_backend_type>
+    shared_context_type;
+    typedef typename shared_context_type::convolver_class single_channel_convolver_type;
+
+    enum { num_channels = src_frame_t::num_channels, };
+
+    // fields
+    const shared_context_type shared_context_;
+    std::unique_ptr<single_channel_convolver_type> channel_convolvers_[num_channels];
+
+    // verify template parameters
+    static_assert(static_cast<int>(src_frame_t::num_channels) == static_cast<int>(dest_frame_t::num_channels),
+                  "channel count requirements");
+
+    /// @endcond
+};
+
+//
+// fft_convolver
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::fft_convolver(const coeffs_t *filter_kernel,
+                                                                       int filter_length, int block_size)
+    : shared_context_(filter_kernel, filter_length, block_size)
+{
+    std::unique_ptr<single_channel_convolver_type> channel_convolvers[num_channels];
+
+    for (auto &p : channel_convolvers) {
+        p.reset(new single_channel_convolver_type(&shared_context_));
+    }
+
+    // update fields
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i] = std::move(channel_convolvers[i]);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::~fft_convolver()
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::reset() CXXPH_NOEXCEPT
+{
+    for (auto &p : channel_convolvers_) {
+        p->reset();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::flush() CXXPH_NOEXCEPT
+{
+    for (auto &p : channel_convolvers_) {
+        p->flush();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT
+{
+    const src_data_type *s_buff = reinterpret_cast<const src_data_type *>(s);
+
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i]->put_n(&s_buff[i], n, num_channels);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::get_n(dest_frame_t *d, int n) CXXPH_NOEXCEPT
+{
+    dest_data_type *d_buff = reinterpret_cast<dest_data_type *>(d);
+
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i]->get_n(&d_buff[i], n, num_channels);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_put() const CXXPH_NOEXCEPT
+{
+    return channel_convolvers_[0]->num_can_put();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_get() const CXXPH_NOEXCEPT
+{
+    return channel_convolvers_[0]->num_can_get();
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_FFT_CONVOLVER_FFT_CONVOLVER_HPP_
@@ -0,0 +1,270 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FILTER_FFT_CONVOLVER_NONUNIFORM_FFT_CONVOLVER_HPP_
+#define CXXDASP_FILTER_FFT_CONVOLVER_NONUNIFORM_FFT_CONVOLVER_HPP_
+
+#include <cxxporthelper/utility>
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/fft_convolver/single_channel_nonuniform_fft_convolver.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/**
+ * Non-uniformly partitioned FFT convolver (multi channel)
+ *
+ * Applies the same (arbitrary long) FIR filter to every channel with low latency.
+ *
+ * @tparam TSrc source audio frame type
+ * @tparam TDest destination audio frame type
+ * @tparam TCoeffs FIR coefficients type
+ * @tparam TFFTBackend FFT backend class
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class nonuniform_fft_convolver {
+
+    /// @cond INTERNAL_FIELD
+    nonuniform_fft_convolver(const nonuniform_fft_convolver &) = delete;
+    nonuniform_fft_convolver &operator=(const nonuniform_fft_convolver &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source audio frame type.
+     */
+    typedef TSrc src_frame_t;
+
+    /**
+     * Destination audio frame type.
+     */
+    typedef TDest dest_frame_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef TCoeffs coeffs_t;
+
+    /**
+     * FFT backend class.
+     */
+    typedef TFFTBackend fft_backend_type;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] latency latency (= block size of the head segment, power of two, >= 32)
+     * @param [in] max_block_size maximum block size of the tail segment (power of two, 0: auto)
+     * @param [in] use_worker_thread process large segments on worker threads (one thread per channel)
+     *
+     * @note Small latency increases count of the segments and the processing cost.
+     */
+    nonuniform_fft_convolver(const coeffs_t *filter_kernel, int filter_length, int latency = 64,
+                             int max_block_size = 0, bool use_worker_thread = false);
+
+    /**
+     * Destructor.
+     */
+    ~nonuniform_fft_convolver();
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush buffered data.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Put input data
+     *
+     * @param s [in] source data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_put())
+     */
+    void put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get output (filtered) data
+     *
+     * @param d [in] destination data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_get())
+     */
+    void get_n(dest_frame_t *d, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get free size of internal buffer.
+     * @returns count of free size of internal buffer [frames]
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get count of available filtered data.
+     * @returns count of available filtered data [frames]
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get latency.
+     * @returns latency [frames]
+     */
+    int latency() const CXXPH_NOEXCEPT { return shared_context_.latency(); }
+
+    /**
+     * Get count of segments.
+     * @returns count of segments
+     */
+    int num_segments() const CXXPH_NOEXCEPT { return shared_context_.num_segments(); }
+
+    /**
+     * Check whether the large segments are processed on worker threads.
+     * @returns whether the worker threads are active
+     */
+    bool uses_worker_thread() const CXXPH_NOEXCEPT { return channel_convolvers_[0]->uses_worker_thread(); }
+
+    /**
+     * Set whether to wait for the worker threads when a job has not been finished by its deadline.
+     *
+     * @param wait [in] true: wait for the worker threads (offline processing),
+     *                  false: never block, count it as a deadline miss (real-time processing, default)
+     */
+    void set_wait_for_worker(bool wait) CXXPH_NOEXCEPT
+    {
+        for (auto &p : channel_convolvers_) {
+            p->set_wait_for_worker(wait);
+        }
+    }
+
+    /**
+     * Get count of deadline misses since the last reset().
+     * @returns count of the jobs which have not been finished by their deadline on the worker threads (all channels)
+     */
+    int num_deadline_misses() const CXXPH_NOEXCEPT
+    {
+        int n = 0;
+        for (auto &p : channel_convolvers_) {
+            n += p->num_deadline_misses();
+        }
+        return n;
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef typename src_frame_t::data_type src_data_type;
+    typedef typename dest_frame_t::data_type dest_data_type;
+
+    typedef single_channel_nonuniform_fft_convolver_shared_context<src_data_type, dest_data_type, coeffs_t,
+                                                                   fft_backend_type> shared_context_type;
+    typedef typename shared_context_type::convolver_class single_channel_convolver_type;
+
+    enum { num_channels = src_frame_t::num_channels, };
+
+    // fields
+    const shared_context_type shared_context_;
+    std::unique_ptr<single_channel_convolver_type> channel_convolvers_[num_channels];
+
+    // verify template parameters
+    static_assert(static_cast<int>(src_frame_t::num_channels) == static_cast<int>(dest_frame_t::num_channels),
+                  "channel count requirements");
+
+    /// @endcond
+};
+
+//
+// nonuniform_fft_convolver
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::nonuniform_fft_convolver(
+    const coeffs_t *filter_kernel, int filter_length, int latency, int max_block_size, bool use_worker_thread)
+    : shared_context_(filter_kernel, filter_length, latency, max_block_size)
+{
+    std::unique_ptr<single_channel_convolver_type> channel_convolvers[num_channels];
+
+    for (auto &p : channel_convolvers) {
+        p.reset(new single_channel_convolver_type(&shared_context_, use_worker_thread));
+    }
+
+    // update fields
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i] = std::move(channel_convolvers[i]);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::~nonuniform_fft_convolver()
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::reset() CXXPH_NOEXCEPT
+{
+    for (auto &p : channel_convolvers_) {
+        p->reset();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::flush() CXXPH_NOEXCEPT
+{
+    for (auto &p : channel_convolvers_) {
+        p->flush();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::put_n(const src_frame_t *s, int n)
+    CXXPH_NOEXCEPT
+{
+    const src_data_type *s_buff = reinterpret_cast<const src_data_type *>(s);
+
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i]->put_n(&s_buff[i], n, num_channels);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::get_n(dest_frame_t *d, int n)
+    CXXPH_NOEXCEPT
+{
+    dest_data_type *d_buff = reinterpret_cast<dest_data_type *>(d);
+
+    for (int i = 0; i < num_channels; ++i) {
+        channel_convolvers_[i]->get_n(&d_buff[i], n, num_channels);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_put() const CXXPH_NOEXCEPT
+{
+    return channel_convolvers_[0]->num_can_put();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_get() const CXXPH_NOEXCEPT
+{
+    return channel_convolvers_[0]->num_can_get();
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_FFT_CONVOLVER_NONUNIFORM_FFT_CONVOLVER_HPP_
@@ -0,0 +1,720 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_FFT_CONVOLVER_HPP_
+#define CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_FFT_CONVOLVER_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include <cxxporthelper/type_traits>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/fft/fft.hpp>
+#include <cxxdasp/fft/convolution_backend.hpp>
+#include <cxxdasp/utils/utils.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/*
+ * Signal flow (uniformly partitioned overlap-save):
+ *
+ *   {x[B] (previous block) | x[B] (new block)} -- <FFT> --> FDL[0]
+ *
+ *   Y = FDL[0] * H[0] + FDL[1] * H[1] + ... + FDL[P-1] * H[P-1]
+ *
+ *   Y -- <IFFT> --> {(aliased)[B] | y[B]}
+ *
+ *   B    : block size (FFT size N = 2B)
+ *   FDL  : frequency-domain delay line (spectra of the last P input blocks)
+ *   H[p] : frequency response of the p-th partition of the filter kernel (h[p*B .. p*B+B-1], zero padded)
+ *
+ * References:
+ *
+ *   - Overlap-save method
+ *     http://en.wikipedia.org/wiki/Overlap%E2%80%93save_method
+ */
+
+//
+// forward declarations
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_fft_convolver;
+
+/**
+ * Shared context of single_channel_fft_convolver (frequency response of the partitioned filter kernel)
+ *
+ * @tparam TSrc source data type
+ * @tparam TDest destination data type
+ * @tparam TCoeffs FIR coefficients type
+ * @tparam TFFTBackend FFT backend class
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_fft_convolver_shared_context {
+    friend class single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>;
+
+    /// @cond INTERNAL_FIELD
+    single_channel_fft_convolver_shared_context(const single_channel_fft_convolver_shared_context &) = delete;
+    single_channel_fft_convolver_shared_context &
+    operator=(const single_channel_fft_convolver_shared_context &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source data type.
+     */
+    typedef TSrc source_data_t;
+
+    /**
+     * Destination data type.
+     */
+    typedef TDest dest_data_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef TCoeffs coeffs_t;
+
+    /**
+     * FFT backend class.
+     */
+    typedef TFFTBackend fft_backend_type;
+
+    /**
+     * FFT real value type.
+     */
+    typedef typename TFFTBackend::fft_real_t fft_real_t;
+
+    /**
+     * FFT complex value type.
+     */
+    typedef typename TFFTBackend::fft_complex_t fft_complex_t;
+
+    /**
+     * Self type.
+     */
+    typedef single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend> convolver_class;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] block_size processing block size (power of two, 0: calc_optimal_block_size(filter_length))
+     *
+     * @note The latency of the convolver equals to the block size.
+     */
+    single_channel_fft_convolver_shared_context(const coeffs_t *filter_kernel, int filter_length, int block_size = 0);
+
+    /**
+     * Destructor.
+     */
+    ~single_channel_fft_convolver_shared_context();
+
+    /**
+     * Get filter length.
+     * @returns number of FIR coefficients
+     */
+    int filter_length() const CXXPH_NOEXCEPT { return filter_length_; }
+
+    /**
+     * Get processing block size.
+     * @returns processing block size
+     */
+    int block_size() const CXXPH_NOEXCEPT { return block_size_; }
+
+    /**
+     * Get count of the filter partitions.
+     * @returns count of the filter partitions
+     */
+    int num_partitions() const CXXPH_NOEXCEPT { return num_partitions_; }
+
+    /**
+     * Calculate the block size which minimizes the processing cost per sample.
+     *
+     * @param [in] filter_length number of FIR coefficients
+     * @returns block size (power of two)
+     */
+    static int calc_optimal_block_size(int filter_length) CXXPH_NOEXCEPT;
+
+private:
+    static_assert(std::is_floating_point<source_data_t>::value, "source_data_t requires floating point type");
+    static_assert(std::is_floating_point<dest_data_t>::value, "dest_data_t requires floating point type");
+
+    /// @cond INTERNAL_FIELD
+    typedef fft::convolution_backend<TFFTBackend> convolution_backend_type;
+    typedef fft::fft<fft_real_t, fft_complex_t, typename convolution_backend_type::forward_real> fft_forward_real;
+    typedef fft::fft<fft_complex_t, fft_real_t, typename convolution_backend_type::inverse_real> fft_inverse_real;
+    typedef typename convolution_backend_type::multiplier spectrum_multiplier;
+
+    enum { min_block_size = 32, };
+
+    int N() const CXXPH_NOEXCEPT { return n_; }
+
+    int N2() const CXXPH_NOEXCEPT { return n2_; }
+
+    int spectrum_stride() const CXXPH_NOEXCEPT { return spectrum_stride_; }
+
+    const spectrum_multiplier &multiplier() const CXXPH_NOEXCEPT { return multiplier_; }
+
+    const fft_complex_t *partition(int p) const CXXPH_NOEXCEPT
+    {
+        return &mem_f_partitions_[static_cast<size_t>(p) * spectrum_stride_];
+    }
+    /// @endcond
+
+private:
+    /// @cond INTERNAL_FIELD
+    int filter_length_;
+    int block_size_;
+    int num_partitions_;
+    int n_;
+    int n2_;
+    int spectrum_stride_;
+    cxxporthelper::aligned_memory<fft_complex_t> mem_f_partitions_; // Frequency response of the partitions
+    spectrum_multiplier multiplier_;
+    /// @endcond
+};
+
+/**
+ * FFT convolver (uniformly partitioned overlap-save method)
+ *
+ * @tparam TSrc source data type
+ * @tparam TDest destination data type
+ * @tparam TCoeffs FIR coefficient data type
+ * @tparam TFFTBackend FFT implementation class type
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_fft_convolver {
+
+    /// @cond INTERNAL_FIELD
+    single_channel_fft_convolver(const single_channel_fft_convolver &) = delete;
+    single_channel_fft_convolver &operator=(const single_channel_fft_convolver &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Shared context type.
+     */
+    typedef single_channel_fft_convolver_shared_context<TSrc, TDest, TCoeffs, TFFTBackend> shared_context;
+
+    /**
+     * Source data type.
+     */
+    typedef typename shared_context::source_data_t source_data_t;
+
+    /**
+     * Destination data type.
+     */
+    typedef typename shared_context::dest_data_t dest_data_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef typename shared_context::coeffs_t coeffs_t;
+
+    /**
+     * FFT real value type.
+     */
+    typedef typename shared_context::fft_real_t fft_real_t;
+
+    /**
+     * FFT complex value type.
+     */
+    typedef typename shared_context::fft_complex_t fft_complex_t;
+
+    /**
+     * Constructor (with normal FIR coefficients array).
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] block_size processing block size (power of two, 0: auto)
+     */
+    single_channel_fft_convolver(const coeffs_t *filter_kernel, int filter_length, int block_size = 0);
+
+    /**
+     * Constructor (with shared context object).
+     *
+     * @param [in] p_shared_context shared context object
+     */
+    single_channel_fft_convolver(const shared_context *p_shared_context);
+
+    /**
+     * Destructor.
+     */
+    ~single_channel_fft_convolver();
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush buffered data.
+     *
+     * @note The count of output data equals to the count of input data. Put zeros before calling this function
+     *       to get the tail of the impulse response.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Put input data
+     *
+     * @param s [in] source data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_put())
+     * @param stride [in] buffer stride (>= 1)
+     */
+    void put_n(const source_data_t *s, int n, int stride = 1) CXXPH_NOEXCEPT;
+
+    /**
+     * Get output (filtered) data
+     *
+     * @param d [in] destination data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_get())
+     * @param stride [in] buffer stride (>= 1)
+     */
+    void get_n(dest_data_t *d, int n, int stride = 1) CXXPH_NOEXCEPT;
+
+    /**
+     * Get free size of internal buffer.
+     * @returns count of free size of internal buffer [frames]
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get count of available filtered data.
+     * @returns count of available filtered data [frames]
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get processing block size.
+     * @returns processing block size (= latency) [frames]
+     */
+    int block_size() const CXXPH_NOEXCEPT { return shared_context_->block_size(); }
+
+    //
+    // Advanced APIs
+    //
+
+    /**
+     * Directly refer the internal output buffer.
+     * @param d [out] buffer pointer
+     * @param n [out] size of available filtered data [frames]
+     */
+    void refer_direct_output_buffer(const fft_real_t **d, int *n) CXXPH_NOEXCEPT;
+
+    /**
+     * Notify directly consumed data count.
+     * @param n [in] count of consumed data [frames]
+     */
+    void notify_direct_consumed_output_buffer_items(int n) CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef typename shared_context::fft_forward_real fft_forward_real;
+    typedef typename shared_context::fft_inverse_real fft_inverse_real;
+    typedef typename shared_context::spectrum_multiplier spectrum_multiplier;
+
+    single_channel_fft_convolver(const shared_context *p_shared_context, bool shared_context_is_private);
+
+    void fill_output_buffer() CXXPH_NOEXCEPT;
+    /// @endcond
+
+private:
+    /// @cond INTERNAL_FIELD
+    const shared_context *shared_context_;
+    bool shared_context_is_private_;
+
+    int num_pooled_input_data_;
+    int num_pooled_output_data_;
+    int output_data_read_position_;
+    int fdl_position_;
+    bool flushed_;
+
+    cxxporthelper::aligned_memory<fft_real_t> mem_fft_f_in_;
+    cxxporthelper::aligned_memory<fft_complex_t> mem_fft_f_out_;
+    cxxporthelper::aligned_memory<fft_complex_t> mem_fdl_;
+    cxxporthelper::aligned_memory<fft_complex_t> mem_fft_i_in_;
+    cxxporthelper::aligned_memory<fft_real_t> mem_fft_i_out_;
+
+    fft_forward_real fftr_f_;
+    fft_inverse_real fftr_i_;
+    /// @endcond
+};
+
+//
+// single_channel_fft_convolver_shared_context
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver_shared_context<TSrc, TDest, TCoeffs, TFFTBackend>::
+    single_channel_fft_convolver_shared_context(const coeffs_t *filter_kernel, int filter_length, int block_size)
+    : filter_length_(0), block_size_(0), num_partitions_(0), n_(0), n2_(0), spectrum_stride_(0), mem_f_partitions_(),
+      multiplier_()
+{
+    assert(filter_length > 0);
+
+    if (block_size <= 0) {
+        block_size = calc_optimal_block_size(filter_length);
+    }
+
+    assert(utils::is_pow_of_two(block_size));
+
+    const int B = block_size;
+    const int N = 2 * B;
+    const int N2 = convolution_backend_type::num_spectrum_elements(N); // == N/2+1 (canonical order), N/2 (PFFFT)
+    const int P = (filter_length + (B - 1)) / B;
+
+    // keep each partition aligned for SIMD operations
+    const int align = (std::max)(1, static_cast<int>(FFT_MEMORY_ALIGNMENT / sizeof(fft_complex_t)));
+    const int stride = ((N2 + (align - 1)) / align) * align;
+
+    cxxporthelper::aligned_memory<fft_real_t> mem_filter_kernel(N, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<fft_complex_t> mem_f_filter_kernel(N2, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<fft_real_t> mem_i_out(N, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<fft_complex_t> mem_f_partitions(static_cast<size_t>(stride) * P,
+                                                                  FFT_MEMORY_ALIGNMENT);
+
+    spectrum_multiplier multiplier(N);
+
+    // calculate frequency response of the partitions
+    // (the spectra are kept in the FFT backend's native order; see fft::convolution_backend)
+    fft_forward_real fftr_f_filter(N, &mem_filter_kernel[0], &mem_f_filter_kernel[0]);
+    fft_inverse_real fftr_i_dummy(N, &mem_f_filter_kernel[0], &mem_i_out[0]);
+
+    // the scale factors of both FFTs (input signal & filter) and IFFT are applied here
+    const fft_real_t f_scale = static_cast<fft_real_t>(fftr_f_filter.scale());
+    const fft_real_t i_scale = static_cast<fft_real_t>(fftr_i_dummy.scale());
+    const fft_real_t post_scale = fft_real_t(1) / (f_scale * f_scale * i_scale);
+
+    std::fill(&mem_f_partitions[0], &mem_f_partitions[0] + mem_f_partitions.size(), fft_complex_t(0));
+
+    for (int p = 0; p < P; ++p) {
+        const int offset = p * B;
+        const int n = (std::min)(B, (filter_length - offset));
+
+        for (int i = 0; i < n; ++i) {
+            mem_filter_kernel[i] = static_cast<fft_real_t>(filter_kernel[offset + i]);
+        }
+        ::memset(&mem_filter_kernel[n], 0, sizeof(fft_real_t) * (N - n));
+
+        fftr_f_filter.execute();
+
+        fft_complex_t *dest = &mem_f_partitions[static_cast<size_t>(p) * stride];
+        ::memcpy(&dest[0], &mem_f_filter_kernel[0], sizeof(fft_complex_t) * N2);
+
+        if (post_scale != fft_real_t(1)) {
+            utils::multiply_scaler_aligned(&dest[0], post_scale, N2);
+        }
+    }
+
+    // update fields
+    filter_length_ = filter_length;
+    block_size_ = B;
+    num_partitions_ = P;
+    n_ = N;
+    n2_ = N2;
+    spectrum_stride_ = stride;
+    mem_f_partitions_ = std::move(mem_f_partitions);
+    multiplier_ = multiplier;
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver_shared_context<TSrc, TDest, TCoeffs,
+                                                   TFFTBackend>::~single_channel_fft_convolver_shared_context()
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_fft_convolver_shared_context<TSrc, TDest, TCoeffs, TFFTBackend>::calc_optimal_block_size(
+    int filter_length) CXXPH_NOEXCEPT
+{
+    // cost model (per output sample):
+    //   2 x real FFT (N = 2B)      : 2 * (2.5 * N * log2(N))
+    //   P x complex MAC (N/2 + 1)  : P * 8 * (N/2 + 1)
+    const int max_block_size = (std::max)(static_cast<int>(min_block_size), utils::next_pow_of_two(filter_length));
+
+    int best_block_size = min_block_size;
+    double best_cost = 0.0;
+
+    for (int B = min_block_size; B <= max_block_size; B *= 2) {
+        const int N = 2 * B;
+        const int P = (filter_length + (B - 1)) / B;
+        const double log2_n = std::log(static_cast<double>(N)) / std::log(2.0);
+        const double fft_cost = 2.0 * (2.5 * N * log2_n);
+        const double mac_cost = 8.0 * P * ((N / 2) + 1);
+        const double cost = (fft_cost + mac_cost) / B;
+
+        if (B == min_block_size || cost < best_cost) {
+            best_block_size = B;
+            best_cost = cost;
+        }
+    }
+
+    return best_block_size;
+}
+
+//
+// single_channel_fft_convolver
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::single_channel_fft_convolver(
+    const coeffs_t *filter_kernel, int filter_length, int block_size)
+    : single_channel_fft_convolver(new shared_context(filter_kernel, filter_length, block_size), true)
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::single_channel_fft_convolver(
+    const shared_context *p_shared_context)
+    : single_channel_fft_convolver(p_shared_context, false)
+{
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::single_channel_fft_convolver(
+    const shared_context *p_shared_context, bool shared_context_is_private)
+    : shared_context_(nullptr), shared_context_is_private_(false), num_pooled_input_data_(0),
+      num_pooled_output_data_(0), output_data_read_position_(0), fdl_position_(0), flushed_(false), mem_fft_f_in_(),
+      mem_fft_f_out_(), mem_fdl_(), mem_fft_i_in_(), mem_fft_i_out_(), fftr_f_(), fftr_i_()
+{
+    const int N = p_shared_context->N();
+    const int N2 = p_shared_context->N2();
+    const int P = p_shared_context->num_partitions();
+    const int stride = p_shared_context->spectrum_stride();
+
+    try
+    {
+        // allocate memory blocks
+        cxxporthelper::aligned_memory<fft_real_t> mem_fft_f_in(N, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_complex_t> mem_fft_f_out(N2, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_complex_t> mem_fdl(static_cast<size_t>(stride) * P, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_complex_t> mem_fft_i_in(N2, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_real_t> mem_fft_i_out(N, FFT_MEMORY_ALIGNMENT);
+
+        // create fft objects
+        fft_forward_real fftr_f(N, &mem_fft_f_in[0], &mem_fft_f_out[0]);
+        fft_inverse_real fftr_i(N, &mem_fft_i_in[0], &mem_fft_i_out[0]);
+
+        // update fields
+        shared_context_ = p_shared_context;
+        shared_context_is_private_ = shared_context_is_private;
+
+        mem_fft_f_in_ = std::move(mem_fft_f_in);
+        mem_fft_f_out_ = std::move(mem_fft_f_out);
+        mem_fdl_ = std::move(mem_fdl);
+        mem_fft_i_in_ = std::move(mem_fft_i_in);
+        mem_fft_i_out_ = std::move(mem_fft_i_out);
+
+        fftr_f_ = std::move(fftr_f);
+        fftr_i_ = std::move(fftr_i);
+    }
+    catch (...)
+    {
+        if (shared_context_is_private) {
+            delete p_shared_context;
+        }
+        throw;
+    }
+
+    // reset
+    reset();
+}
+/// @endcond
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::~single_channel_fft_convolver()
+{
+    if (shared_context_is_private_) {
+        delete shared_context_;
+        shared_context_ = nullptr;
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::reset() CXXPH_NOEXCEPT
+{
+    num_pooled_input_data_ = 0;
+    num_pooled_output_data_ = 0;
+    output_data_read_position_ = 0;
+    fdl_position_ = 0;
+    flushed_ = false;
+
+    // clear input buffer & frequency-domain delay line
+    ::memset(&mem_fft_f_in_[0], 0, sizeof(fft_real_t) * mem_fft_f_in_.size());
+    std::fill(&mem_fdl_[0], &mem_fdl_[0] + mem_fdl_.size(), fft_complex_t(0));
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::flush() CXXPH_NOEXCEPT
+{
+    if (CXXPH_UNLIKELY(flushed_)) {
+        return;
+    }
+    flushed_ = true;
+    fill_output_buffer();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::put_n(const source_data_t *s, int n,
+                                                                                  int stride) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+
+    const int B = shared_context_->block_size();
+    fft_real_t *CXXPH_RESTRICT in_data = fftr_f_.in();
+
+    utils::stride_pod_copy(&in_data[B + num_pooled_input_data_], 1, &s[0], stride, n);
+
+    num_pooled_input_data_ += n;
+
+    fill_output_buffer();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::get_n(dest_data_t *d, int n, int stride)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_get());
+
+    const fft_real_t *out_data = nullptr;
+    int n_available = 0;
+
+    refer_direct_output_buffer(&out_data, &n_available);
+
+    const int n_copy = (std::min)(n, n_available);
+
+    utils::stride_pod_copy(&d[0], stride, &out_data[0], 1, n_copy);
+
+    notify_direct_consumed_output_buffer_items(n_copy);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_put() const CXXPH_NOEXCEPT
+{
+    if (CXXPH_LIKELY(!flushed_)) {
+        return (shared_context_->block_size() - num_pooled_input_data_);
+    } else {
+        return 0;
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_get() const CXXPH_NOEXCEPT
+{
+    return (num_pooled_output_data_ - output_data_read_position_);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::refer_direct_output_buffer(
+    const fft_real_t **d, int *n) CXXPH_NOEXCEPT
+{
+    assert(d);
+    assert(n);
+
+    fill_output_buffer();
+
+    const int B = shared_context_->block_size();
+    const fft_real_t *CXXPH_RESTRICT out_data = fftr_i_.out();
+
+    (*d) = &out_data[B + output_data_read_position_];
+    (*n) = (num_pooled_output_data_ - output_data_read_position_);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void
+single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::notify_direct_consumed_output_buffer_items(int n)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= (num_pooled_output_data_ - output_data_read_position_));
+
+    output_data_read_position_ += n;
+
+    fill_output_buffer();
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::fill_output_buffer() CXXPH_NOEXCEPT
+{
+    const int B = shared_context_->block_size();
+    const int N2 = shared_context_->N2();
+    const int P = shared_context_->num_partitions();
+    const int stride = shared_context_->spectrum_stride();
+
+    if (CXXPH_LIKELY(output_data_read_position_ < num_pooled_output_data_)) {
+        // output buffer is not empty
+        return;
+    }
+
+    fft_real_t *CXXPH_RESTRICT in_data = fftr_f_.in();
+
+    if (CXXPH_LIKELY(!flushed_)) {
+        if (num_pooled_input_data_ < B) {
+            // input buffer is not filled
+            return;
+        }
+    } else {
+        if (num_pooled_input_data_ == 0) {
+            // input buffer is empty
+            return;
+        }
+
+        // pad zeros
+        ::memset(&in_data[B + num_pooled_input_data_], 0, sizeof(fft_real_t) * (B - num_pooled_input_data_));
+    }
+
+    // forward FFT
+    fftr_f_.execute();
+
+    // push the spectrum to the frequency-domain delay line
+    fdl_position_ = (fdl_position_ == 0) ? (P - 1) : (fdl_position_ - 1);
+    ::memcpy(&mem_fdl_[static_cast<size_t>(fdl_position_) * stride], fftr_f_.out(), sizeof(fft_complex_t) * N2);
+
+    // multiply & accumulate
+    const spectrum_multiplier &multiplier = shared_context_->multiplier();
+    fft_complex_t *CXXPH_RESTRICT acc = fftr_i_.in();
+
+    multiplier.multiply(&acc[0], &mem_fdl_[static_cast<size_t>(fdl_position_) * stride], shared_context_->partition(0));
+
+    for (int p = 1; p < P; ++p) {
+        const int k = (fdl_position_ + p < P) ? (fdl_position_ + p) : (fdl_position_ + p - P);
+        multiplier.multiply_accumulate(&acc[0], &mem_fdl_[static_cast<size_t>(k) * stride],
+                                       shared_context_->partition(p));
+    }
+
+    // inverse FFT
+    fftr_i_.execute();
+
+    num_pooled_output_data_ = num_pooled_input_data_;
+    num_pooled_input_data_ = 0;
+    output_data_read_position_ = 0;
+
+    // copy the new block to the head (overlap)
+    utils::fast_pod_copy(&in_data[0], &in_data[B], B);
+}
+/// @endcond
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_FFT_CONVOLVER_HPP_
@@ -0,0 +1,1085 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_NONUNIFORM_FFT_CONVOLVER_HPP_
+#define CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_NONUNIFORM_FFT_CONVOLVER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cxxporthelper/type_traits>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/filter/fft_convolver/single_channel_fft_convolver.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/*
+ * Non-uniformly partitioned convolution:
+ *
+ *   The filter kernel is split into segments. Each segment is processed by a uniformly partitioned
+ *   convolver (single_channel_fft_convolver) and the block size is doubled every two partitions,
+ *   until it reaches the maximum block size.
+ *
+ *   h: |B0|B0|2B0 |2B0 |4B0     |4B0     | ... |Bmax        |Bmax        | ... |
+ *      |seg 0|seg 1    |seg 2             | ... |seg M-1 (uniform tail)         |
+ *
+ *   Every segment is fed with the same input blocks (B0 samples), and the result of the k-th segment is
+ *   accumulated into the output delay line at its own tap offset. The k-th segment (block size Bk, tap offset Ok)
+ *   delivers its output in time as long as (Ok >= Bk - B0), so the latency of the whole filter equals to B0.
+ *
+ * Worker thread mode:
+ *
+ *   A block of the k-th segment which is completed at T (end of the input block) is needed before emitting
+ *   [T - Bk + Ok, T - Bk + Ok + B0), so it has a slack of (Ok - Bk + B0) samples. Segments which have a slack of
+ *   one or more input blocks are handed off to a worker thread, which always processes the pending job with the
+ *   earliest deadline first. The real-time thread only processes the head segments, and it takes over a job only
+ *   when the deadline has come before the worker thread starts it.
+ *
+ *   The real-time thread never locks the mutex nor waits for the worker thread. It wakes the worker thread up only
+ *   when the worker thread is sleeping (atomic flag), and a job which is still running on the worker thread at its
+ *   deadline is counted as a deadline miss: the already emitted part of its output is dropped. If the previous job
+ *   of a segment is still running when the next input block of the segment is completed, the block is dropped
+ *   and the segment is restarted from silence. Use set_wait_for_worker(true) for offline processing, where the
+ *   caller runs ahead of the real time and has to wait for the worker thread instead.
+ */
+
+//
+// forward declarations
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_nonuniform_fft_convolver;
+
+/**
+ * Shared context of single_channel_nonuniform_fft_convolver (partitioning plan and frequency response of segments)
+ *
+ * @tparam TSrc source data type
+ * @tparam TDest destination data type
+ * @tparam TCoeffs FIR coefficients type
+ * @tparam TFFTBackend FFT backend class
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_nonuniform_fft_convolver_shared_context {
+    friend class single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>;
+
+    /// @cond INTERNAL_FIELD
+    single_channel_nonuniform_fft_convolver_shared_context(
+        const single_channel_nonuniform_fft_convolver_shared_context &) = delete;
+    single_channel_nonuniform_fft_convolver_shared_context &
+    operator=(const single_channel_nonuniform_fft_convolver_shared_context &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source data type.
+     */
+    typedef TSrc source_data_t;
+
+    /**
+     * Destination data type.
+     */
+    typedef TDest dest_data_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef TCoeffs coeffs_t;
+
+    /**
+     * FFT backend class.
+     */
+    typedef TFFTBackend fft_backend_type;
+
+    /**
+     * FFT real value type.
+     */
+    typedef typename TFFTBackend::fft_real_t fft_real_t;
+
+    /**
+     * Self type.
+     */
+    typedef single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend> convolver_class;
+
+    /**
+     * Shared context type of segments.
+     */
+    typedef single_channel_fft_convolver_shared_context<fft_real_t, fft_real_t, TCoeffs, TFFTBackend>
+        segment_context_type;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] latency latency (= block size of the head segment, power of two, >= 32)
+     * @param [in] max_block_size maximum block size of the tail segment
+     *                            (power of two, 0: segment_context_type::calc_optimal_block_size(filter_length))
+     */
+    single_channel_nonuniform_fft_convolver_shared_context(const coeffs_t *filter_kernel, int filter_length,
+                                                           int latency = 64, int max_block_size = 0);
+
+    /**
+     * Destructor.
+     */
+    ~single_channel_nonuniform_fft_convolver_shared_context();
+
+    /**
+     * Get filter length.
+     * @returns number of FIR coefficients
+     */
+    int filter_length() const CXXPH_NOEXCEPT { return filter_length_; }
+
+    /**
+     * Get latency.
+     * @returns latency [frames]
+     */
+    int latency() const CXXPH_NOEXCEPT { return latency_; }
+
+    /**
+     * Get count of segments.
+     * @returns count of segments
+     */
+    int num_segments() const CXXPH_NOEXCEPT { return static_cast<int>(segments_.size()); }
+
+    /**
+     * Get the shared context of the segment.
+     * @param [in] index segment index (0 .. num_segments() - 1)
+     * @returns shared context of the segment
+     */
+    const segment_context_type &segment(int index) const CXXPH_NOEXCEPT { return *(segments_[index]); }
+
+    /**
+     * Get the tap offset of the segment.
+     * @param [in] index segment index (0 .. num_segments() - 1)
+     * @returns tap offset of the segment
+     */
+    int segment_offset(int index) const CXXPH_NOEXCEPT { return segment_offsets_[index]; }
+
+private:
+    static_assert(std::is_floating_point<source_data_t>::value, "source_data_t requires floating point type");
+    static_assert(std::is_floating_point<dest_data_t>::value, "dest_data_t requires floating point type");
+
+    /// @cond INTERNAL_FIELD
+    enum { min_latency = 32, };
+
+    int delay_line_size() const CXXPH_NOEXCEPT { return delay_line_size_; }
+    /// @endcond
+
+private:
+    /// @cond INTERNAL_FIELD
+    int filter_length_;
+    int latency_;
+    int delay_line_size_;
+    std::vector<std::unique_ptr<segment_context_type>> segments_;
+    std::vector<int> segment_offsets_;
+    /// @endcond
+};
+
+/**
+ * Non-uniformly partitioned FFT convolver (low latency)
+ *
+ * @tparam TSrc source data type
+ * @tparam TDest destination data type
+ * @tparam TCoeffs FIR coefficient data type
+ * @tparam TFFTBackend FFT implementation class type
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+class single_channel_nonuniform_fft_convolver {
+
+    /// @cond INTERNAL_FIELD
+    single_channel_nonuniform_fft_convolver(const single_channel_nonuniform_fft_convolver &) = delete;
+    single_channel_nonuniform_fft_convolver &operator=(const single_channel_nonuniform_fft_convolver &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Shared context type.
+     */
+    typedef single_channel_nonuniform_fft_convolver_shared_context<TSrc, TDest, TCoeffs, TFFTBackend> shared_context;
+
+    /**
+     * Source data type.
+     */
+    typedef typename shared_context::source_data_t source_data_t;
+
+    /**
+     * Destination data type.
+     */
+    typedef typename shared_context::dest_data_t dest_data_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef typename shared_context::coeffs_t coeffs_t;
+
+    /**
+     * FFT real value type.
+     */
+    typedef typename shared_context::fft_real_t fft_real_t;
+
+    /**
+     * Constructor (with normal FIR coefficients array).
+     *
+     * @param [in] filter_kernel FIR coefficients
+     * @param [in] filter_length number of FIR coefficients
+     * @param [in] latency latency (power of two, >= 32)
+     * @param [in] max_block_size maximum block size of the tail segment (power of two, 0: auto)
+     * @param [in] use_worker_thread process large segments on a worker thread
+     */
+    single_channel_nonuniform_fft_convolver(const coeffs_t *filter_kernel, int filter_length, int latency = 64,
+                                            int max_block_size = 0, bool use_worker_thread = false);
+
+    /**
+     * Constructor (with shared context object).
+     *
+     * @param [in] p_shared_context shared context object
+     * @param [in] use_worker_thread process large segments on a worker thread
+     */
+    single_channel_nonuniform_fft_convolver(const shared_context *p_shared_context, bool use_worker_thread = false);
+
+    /**
+     * Destructor.
+     */
+    ~single_channel_nonuniform_fft_convolver();
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush buffered data.
+     *
+     * @note The count of output data equals to the count of input data.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Put input data
+     *
+     * @param s [in] source data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_put())
+     * @param stride [in] buffer stride (>= 1)
+     */
+    void put_n(const source_data_t *s, int n, int stride = 1) CXXPH_NOEXCEPT;
+
+    /**
+     * Get output (filtered) data
+     *
+     * @param d [in] destination data buffer
+     * @param n [in] count of data  (n >= 0 && n <= num_can_get())
+     * @param stride [in] buffer stride (>= 1)
+     */
+    void get_n(dest_data_t *d, int n, int stride = 1) CXXPH_NOEXCEPT;
+
+    /**
+     * Get free size of internal buffer.
+     * @returns count of free size of internal buffer [frames]
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get count of available filtered data.
+     * @returns count of available filtered data [frames]
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get latency.
+     * @returns latency [frames]
+     */
+    int latency() const CXXPH_NOEXCEPT { return shared_context_->latency(); }
+
+    /**
+     * Check whether the large segments are processed on a worker thread.
+     * @returns whether the worker thread is active
+     */
+    bool uses_worker_thread() const CXXPH_NOEXCEPT { return static_cast<bool>(worker_); }
+
+    /**
+     * Set whether to wait for the worker thread when a job has not been finished by its deadline.
+     *
+     * @param wait [in] true: wait for the worker thread (offline processing),
+     *                  false: never block, count it as a deadline miss (real-time processing, default)
+     */
+    void set_wait_for_worker(bool wait) CXXPH_NOEXCEPT { wait_for_worker_ = wait; }
+
+    /**
+     * Get count of deadline misses since the last reset().
+     * @returns count of the jobs which have not been finished by their deadline on the worker thread
+     */
+    int num_deadline_misses() const CXXPH_NOEXCEPT { return num_deadline_misses_; }
+
+    //
+    // Advanced APIs
+    //
+
+    /**
+     * Directly refer the internal output buffer.
+     * @param d [out] buffer pointer
+     * @param n [out] size of available filtered data [frames]
+     */
+    void refer_direct_output_buffer(const fft_real_t **d, int *n) CXXPH_NOEXCEPT;
+
+    /**
+     * Notify directly consumed data count.
+     * @param n [in] count of consumed data [frames]
+     */
+    void notify_direct_consumed_output_buffer_items(int n) CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef typename shared_context::segment_context_type segment_context_type;
+    typedef typename segment_context_type::convolver_class segment_convolver_type;
+
+    enum job_state { job_idle, job_queued, job_running, job_done, };
+
+    struct async_segment {
+        std::atomic<int> state;
+        std::atomic<long long> deadline; // [frames] the job has to be collected until the input reaches here
+        std::atomic<bool> restart;       // reset the segment convolver before the next job (input has been dropped)
+        long long target_time;           // [frames] output time of the first sample of the job
+        int num_filled;
+        int fill_index;
+        bool missed;
+        cxxporthelper::aligned_memory<fft_real_t> staging[2];
+
+        async_segment()
+            : state(job_idle), deadline(0), restart(false), target_time(0), num_filled(0), fill_index(0), missed(false),
+              staging()
+        {
+        }
+    };
+
+    struct worker_context {
+        std::atomic<bool> quit;
+        std::atomic<bool> sleeping;       // the worker thread is (going to be) blocked in the condition variable
+        std::atomic<bool> caller_waiting; // the caller thread is blocked in the condition variable
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::thread thread;
+
+        worker_context() : quit(false), sleeping(false), caller_waiting(false), mutex(), cv(), thread() {}
+    };
+
+    single_channel_nonuniform_fft_convolver(const shared_context *p_shared_context, bool shared_context_is_private,
+                                            bool use_worker_thread);
+
+    void fill_output_buffer() CXXPH_NOEXCEPT;
+
+    void accumulate_to_delay_line(int position, const fft_real_t *src, int n) CXXPH_NOEXCEPT;
+
+    void process_async_segment(int index, long long t) CXXPH_NOEXCEPT;
+    void run_job(int index) CXXPH_NOEXCEPT;
+    bool complete_job(int index, bool wait) CXXPH_NOEXCEPT;
+    void collect_job(int index) CXXPH_NOEXCEPT;
+    void wait_all_jobs() CXXPH_NOEXCEPT;
+
+    void start_worker();
+    void stop_worker() CXXPH_NOEXCEPT;
+    void wake_worker() CXXPH_NOEXCEPT;
+    void wait_job(int index) CXXPH_NOEXCEPT;
+    int find_queued_job() const CXXPH_NOEXCEPT;
+    void worker_thread_main() CXXPH_NOEXCEPT;
+    /// @endcond
+
+private:
+    /// @cond INTERNAL_FIELD
+    const shared_context *shared_context_;
+    bool shared_context_is_private_;
+
+    int num_pooled_input_data_;
+    int num_pooled_output_data_;
+    int output_data_read_position_;
+    int delay_line_position_;
+    long long time_;
+    bool flushed_;
+    bool wait_for_worker_;
+    int num_deadline_misses_;
+
+    std::vector<std::unique_ptr<segment_convolver_type>> segment_convolvers_;
+    std::vector<std::unique_ptr<async_segment>> async_segments_; // nullptr: processed on the caller thread
+    std::unique_ptr<worker_context> worker_;
+
+    cxxporthelper::aligned_memory<fft_real_t> mem_in_;
+    cxxporthelper::aligned_memory<fft_real_t> mem_out_;
+    cxxporthelper::aligned_memory<fft_real_t> mem_delay_line_;
+    /// @endcond
+};
+
+//
+// single_channel_nonuniform_fft_convolver_shared_context
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver_shared_context<TSrc, TDest, TCoeffs, TFFTBackend>::
+    single_channel_nonuniform_fft_convolver_shared_context(const coeffs_t *filter_kernel, int filter_length,
+                                                           int latency, int max_block_size)
+    : filter_length_(0), latency_(0), delay_line_size_(0), segments_(), segment_offsets_()
+{
+    assert(filter_length > 0);
+    assert(latency >= min_latency);
+    assert(utils::is_pow_of_two(latency));
+
+    if (max_block_size <= 0) {
+        max_block_size = segment_context_type::calc_optimal_block_size(filter_length);
+    }
+    max_block_size = (std::max)(max_block_size, latency);
+
+    assert(utils::is_pow_of_two(max_block_size));
+
+    std::vector<std::unique_ptr<segment_context_type>> segments;
+    std::vector<int> segment_offsets;
+
+    // make partitioning plan
+    int offset = 0;
+    int block_size = latency;
+    while (offset < filter_length) {
+        int n;
+
+        if (block_size < max_block_size) {
+            // two partitions per block size
+            n = (std::min)((2 * block_size), (filter_length - offset));
+        } else {
+            // uniform tail
+            n = (filter_length - offset);
+        }
+
+        // NOTE: (offset >= block_size - latency) is required to deliver the result in time
+        assert(offset >= (block_size - latency));
+
+        segments.emplace_back(new segment_context_type(&filter_kernel[offset], n, block_size));
+        segment_offsets.push_back(offset);
+
+        offset += n;
+        block_size = (std::min)((2 * block_size), max_block_size);
+    }
+
+    // the delay line holds results from (emitting position) to (emitting position + latency + last offset)
+    const int delay_line_size = utils::next_pow_of_two(latency + segment_offsets.back() + latency);
+
+    // update fields
+    filter_length_ = filter_length;
+    latency_ = latency;
+    delay_line_size_ = delay_line_size;
+    segments_ = std::move(segments);
+    segment_offsets_ = std::move(segment_offsets);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver_shared_context<
+    TSrc, TDest, TCoeffs, TFFTBackend>::~single_channel_nonuniform_fft_convolver_shared_context()
+{
+}
+
+//
+// single_channel_nonuniform_fft_convolver
+//
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::
+    single_channel_nonuniform_fft_convolver(const coeffs_t *filter_kernel, int filter_length, int latency,
+                                            int max_block_size, bool use_worker_thread)
+    : single_channel_nonuniform_fft_convolver(
+          new shared_context(filter_kernel, filter_length, latency, max_block_size), true, use_worker_thread)
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::
+    single_channel_nonuniform_fft_convolver(const shared_context *p_shared_context, bool use_worker_thread)
+    : single_channel_nonuniform_fft_convolver(p_shared_context, false, use_worker_thread)
+{
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::
+    single_channel_nonuniform_fft_convolver(const shared_context *p_shared_context, bool shared_context_is_private,
+                                            bool use_worker_thread)
+    : shared_context_(nullptr), shared_context_is_private_(false), num_pooled_input_data_(0),
+      num_pooled_output_data_(0), output_data_read_position_(0), delay_line_position_(0), time_(0), flushed_(false),
+      wait_for_worker_(false), num_deadline_misses_(0), segment_convolvers_(), async_segments_(), worker_(), mem_in_(),
+      mem_out_(), mem_delay_line_()
+{
+    const int latency = p_shared_context->latency();
+
+    try
+    {
+        // create segment convolvers
+        std::vector<std::unique_ptr<segment_convolver_type>> segment_convolvers;
+
+        std::vector<std::unique_ptr<async_segment>> async_segments;
+        std::unique_ptr<worker_context> worker;
+
+        for (int i = 0; i < p_shared_context->num_segments(); ++i) {
+            const int block_size = p_shared_context->segment(i).block_size();
+            const int slack = p_shared_context->segment_offset(i) - block_size + latency;
+
+            segment_convolvers.emplace_back(new segment_convolver_type(&(p_shared_context->segment(i))));
+
+            if (use_worker_thread && slack >= latency) {
+                std::unique_ptr<async_segment> as(new async_segment());
+
+                as->staging[0].allocate(block_size, FFT_MEMORY_ALIGNMENT);
+                as->staging[1].allocate(block_size, FFT_MEMORY_ALIGNMENT);
+
+                if (!(as->staging[0]) || !(as->staging[1])) {
+                    throw std::bad_alloc();
+                }
+
+                async_segments.push_back(std::move(as));
+            } else {
+                async_segments.emplace_back(nullptr);
+            }
+        }
+
+        if (std::any_of(async_segments.begin(), async_segments.end(),
+                        [](const std::unique_ptr<async_segment> &p) { return static_cast<bool>(p); })) {
+            worker.reset(new worker_context());
+        }
+
+        // allocate memory blocks
+        cxxporthelper::aligned_memory<fft_real_t> mem_in(latency, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_real_t> mem_out(latency, FFT_MEMORY_ALIGNMENT);
+        cxxporthelper::aligned_memory<fft_real_t> mem_delay_line(p_shared_context->delay_line_size(),
+                                                                 FFT_MEMORY_ALIGNMENT);
+
+        // update fields
+        shared_context_ = p_shared_context;
+        shared_context_is_private_ = shared_context_is_private;
+
+        segment_convolvers_ = std::move(segment_convolvers);
+        async_segments_ = std::move(async_segments);
+        worker_ = std::move(worker);
+
+        mem_in_ = std::move(mem_in);
+        mem_out_ = std::move(mem_out);
+        mem_delay_line_ = std::move(mem_delay_line);
+    }
+    catch (...)
+    {
+        if (shared_context_is_private) {
+            delete p_shared_context;
+        }
+        throw;
+    }
+
+    // reset
+    reset();
+
+    if (worker_) {
+        start_worker();
+    }
+}
+/// @endcond
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs,
+                                               TFFTBackend>::~single_channel_nonuniform_fft_convolver()
+{
+    stop_worker();
+
+    // NOTE: segment convolvers refer the shared context
+    segment_convolvers_.clear();
+
+    if (shared_context_is_private_) {
+        delete shared_context_;
+        shared_context_ = nullptr;
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::reset() CXXPH_NOEXCEPT
+{
+    num_pooled_input_data_ = 0;
+    num_pooled_output_data_ = 0;
+    output_data_read_position_ = 0;
+    delay_line_position_ = 0;
+    time_ = 0;
+    flushed_ = false;
+    num_deadline_misses_ = 0;
+
+    wait_all_jobs();
+
+    for (auto &p : segment_convolvers_) {
+        p->reset();
+    }
+
+    for (auto &p : async_segments_) {
+        if (p) {
+            p->restart.store(false, std::memory_order_relaxed);
+            p->num_filled = 0;
+            p->fill_index = 0;
+            p->missed = false;
+        }
+    }
+
+    ::memset(&mem_delay_line_[0], 0, sizeof(fft_real_t) * mem_delay_line_.size());
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::flush() CXXPH_NOEXCEPT
+{
+    if (CXXPH_UNLIKELY(flushed_)) {
+        return;
+    }
+    flushed_ = true;
+    fill_output_buffer();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::put_n(const source_data_t *s,
+                                                                                             int n, int stride)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+
+    utils::stride_pod_copy(&mem_in_[num_pooled_input_data_], 1, &s[0], stride, n);
+
+    num_pooled_input_data_ += n;
+
+    fill_output_buffer();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::get_n(dest_data_t *d, int n,
+                                                                                             int stride)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_get());
+
+    const fft_real_t *out_data = nullptr;
+    int n_available = 0;
+
+    refer_direct_output_buffer(&out_data, &n_available);
+
+    const int n_copy = (std::min)(n, n_available);
+
+    utils::stride_pod_copy(&d[0], stride, &out_data[0], 1, n_copy);
+
+    notify_direct_consumed_output_buffer_items(n_copy);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_put() const
+    CXXPH_NOEXCEPT
+{
+    if (CXXPH_LIKELY(!flushed_)) {
+        return (shared_context_->latency() - num_pooled_input_data_);
+    } else {
+        return 0;
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::num_can_get() const
+    CXXPH_NOEXCEPT
+{
+    return (num_pooled_output_data_ - output_data_read_position_);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::refer_direct_output_buffer(
+    const fft_real_t **d, int *n) CXXPH_NOEXCEPT
+{
+    assert(d);
+    assert(n);
+
+    fill_output_buffer();
+
+    (*d) = &mem_out_[output_data_read_position_];
+    (*n) = (num_pooled_output_data_ - output_data_read_position_);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<
+    TSrc, TDest, TCoeffs, TFFTBackend>::notify_direct_consumed_output_buffer_items(int n) CXXPH_NOEXCEPT
+{
+    assert(n <= (num_pooled_output_data_ - output_data_read_position_));
+
+    output_data_read_position_ += n;
+
+    fill_output_buffer();
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::fill_output_buffer()
+    CXXPH_NOEXCEPT
+{
+    const int B0 = shared_context_->latency();
+    const int mask = shared_context_->delay_line_size() - 1;
+
+    if (CXXPH_LIKELY(output_data_read_position_ < num_pooled_output_data_)) {
+        // output buffer is not empty
+        return;
+    }
+
+    if (CXXPH_LIKELY(!flushed_)) {
+        if (num_pooled_input_data_ < B0) {
+            // input buffer is not filled
+            return;
+        }
+    } else {
+        if (num_pooled_input_data_ == 0) {
+            // input buffer is empty
+            return;
+        }
+
+        // pad zeros
+        ::memset(&mem_in_[num_pooled_input_data_], 0, sizeof(fft_real_t) * (B0 - num_pooled_input_data_));
+    }
+
+    const long long t = time_ + B0;
+
+    // process segments
+    const int num_segments = static_cast<int>(segment_convolvers_.size());
+    for (int i = 0; i < num_segments; ++i) {
+        segment_convolver_type *CXXPH_RESTRICT sc = segment_convolvers_[i].get();
+
+        if (async_segments_[i]) {
+            process_async_segment(i, t);
+            continue;
+        }
+
+        sc->put_n(&mem_in_[0], B0);
+
+        if (sc->num_can_get() > 0) {
+            // a block of this segment has been completed;
+            // it corresponds to [T - Bk, T) where T is the end of the current input block
+            const fft_real_t *seg_out = nullptr;
+            int n = 0;
+
+            sc->refer_direct_output_buffer(&seg_out, &n);
+
+            const int pos = (delay_line_position_ + B0 - n + shared_context_->segment_offset(i)) & mask;
+            accumulate_to_delay_line(pos, seg_out, n);
+
+            sc->notify_direct_consumed_output_buffer_items(n);
+        }
+    }
+
+    // collect the results of the worker thread (all jobs which have reached their deadline)
+    if (worker_) {
+        bool queued = false;
+
+        for (int i = 0; i < num_segments; ++i) {
+            async_segment *as = async_segments_[i].get();
+
+            if (!as) {
+                continue;
+            }
+
+            const int state = as->state.load(std::memory_order_acquire);
+
+            if (state == job_done) {
+                collect_job(i);
+            } else if (state != job_idle && t >= as->deadline.load(std::memory_order_relaxed)) {
+                if (!complete_job(i, wait_for_worker_) && !(as->missed)) {
+                    // still running on the worker thread, collect the rest of the output later
+                    as->missed = true;
+                    ++num_deadline_misses_;
+                }
+            } else if (state == job_queued) {
+                queued = true;
+            }
+        }
+
+        // NOTE: the worker thread may have missed the wake up, see wake_worker()
+        if (queued) {
+            wake_worker();
+        }
+    }
+
+    // emit [T - B0, T)
+    fft_real_t *CXXPH_RESTRICT delay_line = &mem_delay_line_[0];
+
+    utils::fast_pod_copy(&mem_out_[0], &delay_line[delay_line_position_], B0);
+    ::memset(&delay_line[delay_line_position_], 0, sizeof(fft_real_t) * B0);
+
+    delay_line_position_ = (delay_line_position_ + B0) & mask;
+    time_ = t;
+
+    num_pooled_output_data_ = num_pooled_input_data_;
+    num_pooled_input_data_ = 0;
+    output_data_read_position_ = 0;
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::accumulate_to_delay_line(
+    int position, const fft_real_t *src, int n) CXXPH_NOEXCEPT
+{
+    const int size = shared_context_->delay_line_size();
+    fft_real_t *CXXPH_RESTRICT delay_line = &mem_delay_line_[0];
+
+    const int n1 = (std::min)(n, (size - position));
+    const int n2 = n - n1;
+
+    for (int i = 0; i < n1; ++i) {
+        delay_line[position + i] += src[i];
+    }
+    for (int i = 0; i < n2; ++i) {
+        delay_line[i] += src[n1 + i];
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::process_async_segment(
+    int index, long long t) CXXPH_NOEXCEPT
+{
+    const int B0 = shared_context_->latency();
+    const int Bk = shared_context_->segment(index).block_size();
+    const int Ok = shared_context_->segment_offset(index);
+    async_segment *as = async_segments_[index].get();
+
+    utils::fast_pod_copy(&(as->staging[as->fill_index][as->num_filled]), &mem_in_[0], B0);
+    as->num_filled += B0;
+
+    if (as->num_filled < Bk) {
+        return;
+    }
+
+    as->num_filled = 0;
+
+    // the previous job has to be finished before submitting the next one
+    if (as->state.load(std::memory_order_acquire) != job_idle) {
+        if (!complete_job(index, wait_for_worker_)) {
+            // the worker thread is still using the segment convolver; drop this input block
+            as->restart.store(true, std::memory_order_relaxed);
+            ++num_deadline_misses_;
+            return;
+        }
+    }
+
+    // submit a new job
+    as->fill_index ^= 1;
+    as->deadline.store(t + (Ok - Bk + B0), std::memory_order_relaxed);
+    as->target_time = t - Bk + Ok;
+    as->missed = false;
+    as->state.store(job_queued, std::memory_order_seq_cst);
+
+    wake_worker();
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::run_job(int index)
+    CXXPH_NOEXCEPT
+{
+    async_segment *as = async_segments_[index].get();
+    segment_convolver_type *sc = segment_convolvers_[index].get();
+
+    if (CXXPH_UNLIKELY(as->restart.load(std::memory_order_relaxed))) {
+        // some input blocks have been dropped, restart from silence not to produce misaligned output
+        sc->reset();
+        as->restart.store(false, std::memory_order_relaxed);
+    }
+
+    // NOTE: fill_index has been already flipped on submission
+    sc->put_n(&(as->staging[as->fill_index ^ 1][0]), sc->block_size());
+
+    as->state.store(job_done, std::memory_order_seq_cst);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline bool single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::complete_job(int index,
+                                                                                                    bool wait)
+    CXXPH_NOEXCEPT
+{
+    async_segment *as = async_segments_[index].get();
+
+    int expected = job_queued;
+    if (as->state.compare_exchange_strong(expected, job_running, std::memory_order_acq_rel)) {
+        // the worker thread has not started the job yet; process it on this thread
+        run_job(index);
+    } else if (as->state.load(std::memory_order_acquire) == job_running) {
+        if (!wait) {
+            return false;
+        }
+        wait_job(index);
+    }
+
+    if (as->state.load(std::memory_order_acquire) == job_done) {
+        collect_job(index);
+    }
+
+    return true;
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::collect_job(int index)
+    CXXPH_NOEXCEPT
+{
+    const int mask = shared_context_->delay_line_size() - 1;
+    async_segment *as = async_segments_[index].get();
+    segment_convolver_type *sc = segment_convolvers_[index].get();
+
+    const fft_real_t *seg_out = nullptr;
+    int n = 0;
+
+    sc->refer_direct_output_buffer(&seg_out, &n);
+
+    // [target_time, time_) has been already emitted if the job has missed its deadline
+    const long long n_emitted = (std::max)((time_ - as->target_time), 0LL);
+    const int n_skip = static_cast<int>((std::min)(n_emitted, static_cast<long long>(n)));
+
+    accumulate_to_delay_line(static_cast<int>((as->target_time + n_skip) & mask), &seg_out[n_skip], n - n_skip);
+    sc->notify_direct_consumed_output_buffer_items(n);
+
+    as->state.store(job_idle, std::memory_order_release);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::wait_all_jobs() CXXPH_NOEXCEPT
+{
+    for (int i = 0; i < static_cast<int>(async_segments_.size()); ++i) {
+        if (async_segments_[i] && async_segments_[i]->state.load(std::memory_order_acquire) != job_idle) {
+            complete_job(i, true);
+        }
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::start_worker()
+{
+    worker_context &wk = *worker_;
+
+    wk.quit.store(false);
+    wk.sleeping.store(false);
+    wk.caller_waiting.store(false);
+    wk.thread = std::thread(&single_channel_nonuniform_fft_convolver::worker_thread_main, this);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::stop_worker() CXXPH_NOEXCEPT
+{
+    if (!worker_) {
+        return;
+    }
+
+    worker_context &wk = *worker_;
+
+    wk.quit.store(true, std::memory_order_seq_cst);
+
+    // NOTE: not a real-time context, acquire the mutex not to miss the worker thread going to sleep
+    { std::lock_guard<std::mutex> lock(wk.mutex); }
+    wk.cv.notify_all();
+
+    if (wk.thread.joinable()) {
+        wk.thread.join();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::wake_worker() CXXPH_NOEXCEPT
+{
+    // NOTE:
+    // Called from the real-time thread, so the mutex is not acquired. The notification can be lost if it is sent
+    // just between the predicate check and the block of the worker thread, so the caller repeats it on every input
+    // block while a queued job remains (and the job is taken over by the caller thread at its deadline anyway).
+    worker_context &wk = *worker_;
+
+    if (wk.sleeping.load(std::memory_order_seq_cst)) {
+        wk.cv.notify_all();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::wait_job(int index)
+    CXXPH_NOEXCEPT
+{
+    worker_context &wk = *worker_;
+    async_segment *as = async_segments_[index].get();
+
+    wk.caller_waiting.store(true, std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(wk.mutex);
+        wk.cv.wait(lock, [as]() { return as->state.load(std::memory_order_seq_cst) != job_running; });
+    }
+    wk.caller_waiting.store(false, std::memory_order_relaxed);
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline int single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::find_queued_job() const
+    CXXPH_NOEXCEPT
+{
+    // earliest deadline first
+    const int num_segments = static_cast<int>(async_segments_.size());
+    int index = -1;
+    long long deadline = 0;
+
+    for (int i = 0; i < num_segments; ++i) {
+        const async_segment *as = async_segments_[i].get();
+
+        if (as && as->state.load(std::memory_order_seq_cst) == job_queued) {
+            const long long d = as->deadline.load(std::memory_order_relaxed);
+            if (index < 0 || d < deadline) {
+                index = i;
+                deadline = d;
+            }
+        }
+    }
+
+    return index;
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class TFFTBackend>
+inline void single_channel_nonuniform_fft_convolver<TSrc, TDest, TCoeffs, TFFTBackend>::worker_thread_main()
+    CXXPH_NOEXCEPT
+{
+    worker_context &wk = *worker_;
+
+    while (!wk.quit.load(std::memory_order_acquire)) {
+        const int index = find_queued_job();
+
+        if (index >= 0) {
+            int expected = job_queued;
+            if (async_segments_[index]->state.compare_exchange_strong(expected, job_running,
+                                                                     std::memory_order_acq_rel)) {
+                run_job(index);
+
+                if (wk.caller_waiting.load(std::memory_order_seq_cst)) {
+                    { std::lock_guard<std::mutex> lock(wk.mutex); }
+                    wk.cv.notify_all();
+                }
+            }
+        } else {
+            // NOTE: publish the flag before checking the job states again (pairs with wake_worker())
+            wk.sleeping.store(true, std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(wk.mutex);
+                wk.cv.wait(lock, [this, &wk]() {
+                    return wk.quit.load(std::memory_order_seq_cst) || (find_queued_job() >= 0);
+                });
+            }
+            wk.sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+/// @endcond
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_FFT_CONVOLVER_SINGLE_CHANNEL_NONUNIFORM_FFT_CONVOLVER_HPP_
@@ -0,0 +1,158 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_MULTICHANNEL_BIQUAD_F32_AVX_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
+#define CXXDASP_FILTER_MULTICHANNEL_BIQUAD_F32_AVX_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+#include <cxxdasp/utils/x86_platform_info.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+
+namespace cxxdasp {
+namespace filter {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+class f32_avx_multichannel_biquad_core_operator_impl {
+public:
+    static void perform(const float *src, float *dest, int n, int stride, const float *CXXPH_RESTRICT coeffs,
+                        float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT;
+};
+
+} // namespace impl
+/// @endcond
+
+/**
+ * AVX optimized multi-channel biquad filter core operator (8 channels, Transposed Direct Form 2)
+ */
+class f32_avx_multichannel_biquad_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    f32_avx_multichannel_biquad_core_operator(const f32_avx_multichannel_biquad_core_operator &) = delete;
+    f32_avx_multichannel_biquad_core_operator &operator=(const f32_avx_multichannel_biquad_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Value type.
+     */
+    typedef float value_type;
+
+/**
+     * Number of lanes (channels processed at once).
+     */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int num_lanes = 8;
+#else
+    enum { num_lanes = 8 };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static bool is_supported() CXXPH_NOEXCEPT { return utils::x86_platform_info::support_avx(); }
+
+    /**
+     * Constructor.
+     */
+    f32_avx_multichannel_biquad_core_operator();
+
+    /**
+     * Destructor.
+     */
+    ~f32_avx_multichannel_biquad_core_operator();
+
+    /**
+     * Set parameters.
+     * @param lane [in] lane index
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     */
+    void set_params(int lane, double b0, double b1, double b2, double a1, double a2) CXXPH_NOEXCEPT;
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src [in] source data buffer (may be the same as dest)
+     * @param dest [out] destination data buffer
+     * @param n [in] count of frames
+     * @param stride [in] distance between the successive frames [samples]
+     */
+    void perform(const value_type *src, value_type *dest, int n, int stride) CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef impl::f32_avx_multichannel_biquad_core_operator_impl impl_class;
+
+    // [b0 x 8, b1 x 8, b2 x 8, -a1 x 8, -a2 x 8]
+    float coeffs_[5 * 8];
+
+    // [s1 x 8, s2 x 8]
+    float state_[2 * 8];
+    /// @endcond
+};
+
+inline f32_avx_multichannel_biquad_core_operator::f32_avx_multichannel_biquad_core_operator()
+{
+    for (auto &r : coeffs_) {
+        r = 0;
+    }
+    for (auto &r : state_) {
+        r = 0;
+    }
+}
+
+inline f32_avx_multichannel_biquad_core_operator::~f32_avx_multichannel_biquad_core_operator() {}
+
+inline void f32_avx_multichannel_biquad_core_operator::set_params(int lane, double b0, double b1, double b2,
+                                                                  double a1, double a2) CXXPH_NOEXCEPT
+{
+    coeffs_[0 * num_lanes + lane] = static_cast<value_type>(b0);
+    coeffs_[1 * num_lanes + lane] = static_cast<value_type>(b1);
+    coeffs_[2 * num_lanes + lane] = static_cast<value_type>(b2);
+    coeffs_[3 * num_lanes + lane] = static_cast<value_type>(-a1);
+    coeffs_[4 * num_lanes + lane] = static_cast<value_type>(-a2);
+}
+
+inline void f32_avx_multichannel_biquad_core_operator::reset() CXXPH_NOEXCEPT
+{
+    for (auto &r : state_) {
+        r = 0;
+    }
+}
+
+inline void f32_avx_multichannel_biquad_core_operator::perform(const value_type *src, value_type *dest, int n,
+                                                               int stride) CXXPH_NOEXCEPT
+{
+    impl_class::perform(src, dest, n, stride, coeffs_, state_);
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#endif // CXXDASP_FILTER_MULTICHANNEL_BIQUAD_F32_AVX_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
@@ -0,0 +1,187 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_MULTICHANNEL_BIQUAD_GENERAL_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
+#define CXXDASP_FILTER_MULTICHANNEL_BIQUAD_GENERAL_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/**
+ * General multi-channel biquad filter core operator (Transposed Direct Form 2)
+ *
+ * This operator filters NLanes channels at once. Each channel (lane) has its own coefficients and state.
+ *
+ * @tparam TValue value type
+ * @tparam NLanes number of channels processed at once
+ */
+template <typename TValue, int NLanes>
+class general_multichannel_biquad_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    general_multichannel_biquad_core_operator(const general_multichannel_biquad_core_operator &) = delete;
+    general_multichannel_biquad_core_operator &operator=(const general_multichannel_biquad_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Value type.
+     */
+    typedef TValue value_type;
+
+/**
+     * Number of lanes (channels processed at once).
+     */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int num_lanes = NLanes;
+#else
+    enum { num_lanes = NLanes };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    CXXPH_OPTIONAL_CONSTEXPR static bool is_supported() CXXPH_NOEXCEPT { return true; }
+
+    /**
+     * Constructor.
+     */
+    general_multichannel_biquad_core_operator();
+
+    /**
+     * Destructor.
+     */
+    ~general_multichannel_biquad_core_operator();
+
+    /**
+     * Set parameters.
+     * @param lane [in] lane index
+     * @param b0 [in] b0 filter parameter
+     * @param b1 [in] b1 filter parameter
+     * @param b2 [in] b2 filter parameter
+     * @param a1 [in] a1 filter parameter
+     * @param a2 [in] a2 filter parameter
+     */
+    void set_params(int lane, double b0, double b1, double b2, double a1, double a2) CXXPH_NOEXCEPT;
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src [in] source data buffer (may be the same as dest)
+     * @param dest [out] destination data buffer
+     * @param n [in] count of frames
+     * @param stride [in] distance between the successive frames [samples]
+     */
+    void perform(const value_type *src, value_type *dest, int n, int stride) CXXPH_NOEXCEPT;
+
+private:
+    static_assert((num_lanes >= 1), "NLanes must be grater than or equals to 1");
+
+    /// @cond INTERNAL_FIELD
+    value_type b0_[NLanes];
+    value_type b1_[NLanes];
+    value_type b2_[NLanes];
+    value_type ia1_[NLanes];
+    value_type ia2_[NLanes];
+    value_type s1_[NLanes];
+    value_type s2_[NLanes];
+    /// @endcond
+};
+
+template <typename TValue, int NLanes>
+inline general_multichannel_biquad_core_operator<TValue, NLanes>::general_multichannel_biquad_core_operator()
+{
+    for (int i = 0; i < NLanes; ++i) {
+        b0_[i] = 0;
+        b1_[i] = 0;
+        b2_[i] = 0;
+        ia1_[i] = 0;
+        ia2_[i] = 0;
+    }
+    reset();
+}
+
+template <typename TValue, int NLanes>
+inline general_multichannel_biquad_core_operator<TValue, NLanes>::~general_multichannel_biquad_core_operator()
+{
+}
+
+template <typename TValue, int NLanes>
+inline void general_multichannel_biquad_core_operator<TValue, NLanes>::set_params(int lane, double b0, double b1,
+                                                                                  double b2, double a1, double a2)
+    CXXPH_NOEXCEPT
+{
+    b0_[lane] = static_cast<value_type>(b0);
+    b1_[lane] = static_cast<value_type>(b1);
+    b2_[lane] = static_cast<value_type>(b2);
+    ia1_[lane] = static_cast<value_type>(-a1);
+    ia2_[lane] = static_cast<value_type>(-a2);
+}
+
+template <typename TValue, int NLanes>
+inline void general_multichannel_biquad_core_operator<TValue, NLanes>::reset() CXXPH_NOEXCEPT
+{
+    for (int i = 0; i < NLanes; ++i) {
+        s1_[i] = 0;
+        s2_[i] = 0;
+    }
+}
+
+template <typename TValue, int NLanes>
+inline void general_multichannel_biquad_core_operator<TValue, NLanes>::perform(const value_type *src,
+                                                                               value_type *dest, int n, int stride)
+    CXXPH_NOEXCEPT
+{
+    value_type s1[NLanes];
+    value_type s2[NLanes];
+
+    for (int j = 0; j < NLanes; ++j) {
+        s1[j] = s1_[j];
+        s2[j] = s2_[j];
+    }
+
+    for (int i = 0; i < n; ++i) {
+        const value_type *x = &src[i * stride];
+        value_type *y = &dest[i * stride];
+
+        for (int j = 0; j < NLanes; ++j) {
+            const value_type x0 = x[j];
+            const value_type y0 = s1[j] + b0_[j] * x0;
+
+            s1[j] = (s2[j] + b1_[j] * x0) + ia1_[j] * y0;
+            s2[j] = b2_[j] * x0 + ia2_[j] * y0;
+
+            y[j] = y0;
+        }
+    }
+
+    for (int j = 0; j < NLanes; ++j) {
+        s1_[j] = s1[j];
+        s2_[j] = s2[j];
+    }
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_MULTICHANNEL_BIQUAD_GENERAL_MULTICHANNEL_BIQUAD_CORE_OPERATOR_HPP_
@@ -0,0 +1,381 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_FILTER_MULTICHANNEL_BIQUAD_MULTICHANNEL_BIQUAD_FILTER_HPP_
+#define CXXDASP_FILTER_MULTICHANNEL_BIQUAD_MULTICHANNEL_BIQUAD_FILTER_HPP_
+
+#include <algorithm>
+#include <new>
+#include <memory>
+#include <utility>
+
+#include <cxxporthelper/compiler.hpp>
+
+#include <cxxdasp/filter/digital_filter.hpp>
+#include <cxxdasp/filter/biquad/biquad_filter_coeffs.hpp>
+
+namespace cxxdasp {
+namespace filter {
+
+/**
+ * Multi-channel biquad filter
+ *
+ * Filters many independent channels of interleaved audio data. The channels are grouped by
+ * TMultichannelBiquadCoreOperator::num_lanes and each channel's state is kept in one SIMD lane,
+ * so one instruction processes num_lanes channels. Each channel has its own coefficients.
+ *
+ * @tparam TMultichannelBiquadCoreOperator core operator class
+ *
+ * @sa "Cookbook formulae for audio EQ biquad filter coefficients"
+ *     by Robert Bristow-Johnson  <rbj@audioimagination.com>
+ *     http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
+ */
+template <class TMultichannelBiquadCoreOperator>
+class multichannel_biquad_filter {
+
+    /// @cond INTERNAL_FIELD
+    multichannel_biquad_filter(const multichannel_biquad_filter &) = delete;
+    multichannel_biquad_filter &operator=(const multichannel_biquad_filter &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Core operator class.
+     */
+    typedef TMultichannelBiquadCoreOperator core_operator_type;
+
+    /**
+     * Value type.
+     */
+    typedef typename core_operator_type::value_type value_type;
+
+    /**
+     * Constructor.
+     */
+    multichannel_biquad_filter();
+
+    /**
+     * Destructor.
+     */
+    ~multichannel_biquad_filter();
+
+    /**
+     * Initialize (all channels share the same parameters).
+     * @param num_channels [in] number of channels
+     * @param params [in] general filter parameters
+     * @returns Success or Failure
+     */
+    bool init(int num_channels, const filter_params_t &params) CXXPH_NOEXCEPT;
+
+    /**
+     * Initialize (all channels share the same coefficients).
+     * @param num_channels [in] number of channels
+     * @param coeffs [in] biquad filter coefficients
+     * @returns Success or Failure
+     */
+    bool init(int num_channels, const biquad_filter_coeffs &coeffs) CXXPH_NOEXCEPT;
+
+    /**
+     * Initialize (per-channel coefficients).
+     * @param num_channels [in] number of channels
+     * @param coeffs [in] array of biquad filter coefficients (num_channels elements)
+     * @returns Success or Failure
+     */
+    bool init(int num_channels, const biquad_filter_coeffs *coeffs) CXXPH_NOEXCEPT;
+
+    /**
+     * Update filter parameters of a channel.
+     * @param channel [in] channel index
+     * @param params [in] general filter parameters
+     * @returns Success or Failure
+     */
+    bool update(int channel, const filter_params_t &params) CXXPH_NOEXCEPT;
+
+    /**
+     * Update filter parameters of a channel.
+     * @param channel [in] channel index
+     * @param coeffs [in] biquad filter coefficients
+     * @returns Success or Failure
+     */
+    bool update(int channel, const biquad_filter_coeffs &coeffs) CXXPH_NOEXCEPT;
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Get number of channels.
+     * @returns number of channels
+     */
+    int num_channels() const CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src_dest [in/out] interleaved data buffer (overwrite)
+     * @param n [in] count of frames
+     */
+    void perform(value_type *src_dest, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Perform filtering.
+     * @param src [in] interleaved source data buffer
+     * @param dest [out] interleaved destination data buffer
+     * @param n [in] count of frames
+     */
+    void perform(const value_type *CXXPH_RESTRICT src, value_type *CXXPH_RESTRICT dest, int n) CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    enum {
+        // frames processed at once (keeps the block of all channel groups in cache)
+        BLOCK_SIZE = 64
+    };
+
+    bool allocate(int num_channels) CXXPH_NOEXCEPT;
+    void perform_impl(const value_type *src, value_type *dest, int n) CXXPH_NOEXCEPT;
+    void perform_partial_group(const value_type *src, value_type *dest, int n) CXXPH_NOEXCEPT;
+
+    int num_channels_;
+    int num_full_groups_;
+    int num_partial_lanes_;
+    std::unique_ptr<core_operator_type[]> core_operators_;
+    std::unique_ptr<value_type[]> work_buffer_;
+    /// @endcond
+};
+
+template <class TMultichannelBiquadCoreOperator>
+inline multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::multichannel_biquad_filter()
+    : num_channels_(0), num_full_groups_(0), num_partial_lanes_(0), core_operators_(), work_buffer_()
+{
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::~multichannel_biquad_filter()
+{
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::init(int num_channels,
+                                                                               const filter_params_t &params)
+    CXXPH_NOEXCEPT
+{
+    biquad_filter_coeffs coeffs;
+
+    if (!coeffs.make(params)) {
+        return false;
+    }
+
+    return init(num_channels, coeffs);
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::init(int num_channels,
+                                                                               const biquad_filter_coeffs &coeffs)
+    CXXPH_NOEXCEPT
+{
+    if (!allocate(num_channels)) {
+        return false;
+    }
+
+    for (int ch = 0; ch < num_channels; ++ch) {
+        update(ch, coeffs);
+    }
+
+    return true;
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::init(int num_channels,
+                                                                               const biquad_filter_coeffs *coeffs)
+    CXXPH_NOEXCEPT
+{
+    if (!coeffs) {
+        return false;
+    }
+
+    if (!allocate(num_channels)) {
+        return false;
+    }
+
+    for (int ch = 0; ch < num_channels; ++ch) {
+        update(ch, coeffs[ch]);
+    }
+
+    return true;
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::update(int channel,
+                                                                                 const filter_params_t &params)
+    CXXPH_NOEXCEPT
+{
+    biquad_filter_coeffs coeffs;
+
+    if (!coeffs.make(params)) {
+        return false;
+    }
+
+    return update(channel, coeffs);
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::update(int channel,
+                                                                                 const biquad_filter_coeffs &coeffs)
+    CXXPH_NOEXCEPT
+{
+    if (!(channel >= 0 && channel < num_channels_)) {
+        return false;
+    }
+
+    const int lanes = core_operator_type::num_lanes;
+
+    core_operators_[channel / lanes].set_params((channel % lanes), coeffs.b0, coeffs.b1, coeffs.b2, coeffs.a1,
+                                                coeffs.a2);
+
+    return true;
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline void multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::reset() CXXPH_NOEXCEPT
+{
+    const int num_groups = num_full_groups_ + ((num_partial_lanes_ != 0) ? 1 : 0);
+
+    for (int i = 0; i < num_groups; ++i) {
+        core_operators_[i].reset();
+    }
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline int multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::num_channels() const CXXPH_NOEXCEPT
+{
+    return num_channels_;
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline void multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::perform(value_type *src_dest, int n)
+    CXXPH_NOEXCEPT
+{
+    perform_impl(src_dest, src_dest, n);
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline void multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::perform(const value_type *CXXPH_RESTRICT src,
+                                                                                  value_type *CXXPH_RESTRICT dest,
+                                                                                  int n) CXXPH_NOEXCEPT
+{
+    perform_impl(src, dest, n);
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline bool multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::allocate(int num_channels) CXXPH_NOEXCEPT
+{
+    const int lanes = core_operator_type::num_lanes;
+
+    if (!(num_channels > 0)) {
+        return false;
+    }
+
+    const int num_full_groups = num_channels / lanes;
+    const int num_partial_lanes = num_channels % lanes;
+    const int num_groups = num_full_groups + ((num_partial_lanes != 0) ? 1 : 0);
+
+    std::unique_ptr<core_operator_type[]> core_operators(new (std::nothrow) core_operator_type[num_groups]);
+    std::unique_ptr<value_type[]> work_buffer;
+
+    if (!core_operators) {
+        return false;
+    }
+
+    if (num_partial_lanes != 0) {
+        work_buffer.reset(new (std::nothrow) value_type[BLOCK_SIZE * lanes]);
+
+        if (!work_buffer) {
+            return false;
+        }
+
+        for (int i = 0; i < (BLOCK_SIZE * lanes); ++i) {
+            work_buffer[i] = 0;
+        }
+    }
+
+    for (int i = 0; i < num_groups; ++i) {
+        core_operators[i].reset();
+    }
+
+    num_channels_ = num_channels;
+    num_full_groups_ = num_full_groups;
+    num_partial_lanes_ = num_partial_lanes;
+    core_operators_ = std::move(core_operators);
+    work_buffer_ = std::move(work_buffer);
+
+    return true;
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline void multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::perform_impl(const value_type *src,
+                                                                                       value_type *dest, int n)
+    CXXPH_NOEXCEPT
+{
+    const int lanes = core_operator_type::num_lanes;
+    const int stride = num_channels_;
+
+    for (int offset = 0; offset < n; offset += BLOCK_SIZE) {
+        const int nb = (std::min)(static_cast<int>(BLOCK_SIZE), (n - offset));
+        const value_type *block_src = &src[offset * stride];
+        value_type *block_dest = &dest[offset * stride];
+
+        for (int g = 0; g < num_full_groups_; ++g) {
+            core_operators_[g].perform(&block_src[g * lanes], &block_dest[g * lanes], nb, stride);
+        }
+
+        if (num_partial_lanes_ != 0) {
+            perform_partial_group(&block_src[num_full_groups_ * lanes], &block_dest[num_full_groups_ * lanes], nb);
+        }
+    }
+}
+
+template <class TMultichannelBiquadCoreOperator>
+inline void multichannel_biquad_filter<TMultichannelBiquadCoreOperator>::perform_partial_group(const value_type *src,
+                                                                                                value_type *dest,
+                                                                                                int n) CXXPH_NOEXCEPT
+{
+    // NOTE:
+    // The last group does not fill all of the lanes, so it can't access the interleaved buffer directly
+    // (it would overrun the frame). Gather the channels into the work buffer, filter and scatter them.
+    const int lanes = core_operator_type::num_lanes;
+    const int stride = num_channels_;
+    value_type *work = work_buffer_.get();
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < num_partial_lanes_; ++j) {
+            work[i * lanes + j] = src[i * stride + j];
+        }
+    }
+
+    core_operators_[num_full_groups_].perform(work, work, n, lanes);
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < num_partial_lanes_; ++j) {
+            dest[i * stride + j] = work[i * lanes + j];
+        }
+    }
+}
+
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_FILTER_MULTICHANNEL_BIQUAD_MULTICHANNEL_BIQUAD_FILTER_HPP_
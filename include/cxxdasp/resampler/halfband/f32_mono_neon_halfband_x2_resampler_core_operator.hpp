@@ -103,6 +103,55 @@ public:
 
         (*dest) = (vget_lane_f32(ts2, 0) + vget_lane_f32(ts2, 1));
     }
+
+    /**
+     * Dual convolution with every other source frame (for 2:1 decimation).
+     *
+     * dest = sum(src1[2 * i] * coeffs1[i]) + sum(src2[2 * i] * coeffs2[i])   (i = 0 .. n - 1)
+     */
+    void decimating_dual_convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT src1,
+                                  const src_frame_t *CXXPH_RESTRICT src2, const coeffs_t *CXXPH_RESTRICT coeffs1,
+                                  const coeffs_t *CXXPH_RESTRICT coeffs2, int n) const CXXPH_NOEXCEPT
+    {
+
+        const float32_t *CXXPH_RESTRICT f32_src1 = reinterpret_cast<const float32_t *>(src1);
+        const float32_t *CXXPH_RESTRICT f32_src2 = reinterpret_cast<const float32_t *>(src2);
+        const float32_t *CXXPH_RESTRICT f32_coeffs1 =
+            reinterpret_cast<const float32_t *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs1, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+        const float32_t *CXXPH_RESTRICT f32_coeffs2 =
+            reinterpret_cast<const float32_t *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs2, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+
+        float32x4_t t1, t2;
+
+        t1 = vdupq_n_f32(0.0f);
+        t2 = vdupq_n_f32(0.0f);
+
+        int n2 = (n >> 2);
+        assert((n & 0x3) == 0);
+
+        do {
+            const float32x4_t c1 = vld1q_f32(f32_coeffs1);
+            f32_coeffs1 += 4;
+            const float32x4x2_t s1 = vld2q_f32(f32_src1);
+            f32_src1 += (2 * 4);
+
+            t1 = vmlaq_f32(t1, c1, s1.val[0]);
+
+            const float32x4_t c2 = vld1q_f32(f32_coeffs2);
+            f32_coeffs2 += 4;
+            const float32x4x2_t s2 = vld2q_f32(f32_src2);
+            f32_src2 += (2 * 4);
+
+            t2 = vmlaq_f32(t2, c2, s2.val[0]);
+
+            --n2;
+        } while (CXXPH_LIKELY(n2 != 0));
+
+        const float32x4_t ts1 = vaddq_f32(t1, t2);
+        const float32x2_t ts2 = vpadd_f32(vget_low_f32(ts1), vget_high_f32(ts1));
+
+        (*dest) = (vget_lane_f32(ts2, 0) + vget_lane_f32(ts2, 1));
+    }
 };
 
 } // namespace resampler
@@ -93,6 +93,48 @@ public:
         (*dest) = mm_hadd_all_ps(_mm_add_ps(t1, t2));
     }
 
+    /**
+     * Dual convolution with every other source frame (for 2:1 decimation).
+     *
+     * dest = sum(src1[2 * i] * coeffs1[i]) + sum(src2[2 * i] * coeffs2[i])   (i = 0 .. n - 1)
+     */
+    void decimating_dual_convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT src1,
+                                  const src_frame_t *CXXPH_RESTRICT src2, const coeffs_t *CXXPH_RESTRICT coeffs1,
+                                  const coeffs_t *CXXPH_RESTRICT coeffs2, int n) const CXXPH_NOEXCEPT
+    {
+
+        const float *CXXPH_RESTRICT f32_src1 = reinterpret_cast<const float *>(src1);
+        const float *CXXPH_RESTRICT f32_src2 = reinterpret_cast<const float *>(src2);
+        const float *CXXPH_RESTRICT f32_coeffs1 =
+            reinterpret_cast<const float *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs1, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+        const float *CXXPH_RESTRICT f32_coeffs2 =
+            reinterpret_cast<const float *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs2, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+
+        __m128 t1, t2;
+
+        t1 = _mm_setzero_ps();
+        t2 = _mm_setzero_ps();
+
+        assert((n & 0x3) == 0);
+        for (int i = 0; i < n; i += 4) {
+            const __m128 c1 = _mm_load_ps(&f32_coeffs1[i]);
+            const __m128 s1a = _mm_loadu_ps(&f32_src1[2 * i]);
+            const __m128 s1b = _mm_loadu_ps(&f32_src1[2 * i + 4]);
+            const __m128 s1 = _mm_shuffle_ps(s1a, s1b, _MM_SHUFFLE(2, 0, 2, 0));
+
+            t1 = _mm_add_ps(t1, _mm_mul_ps(c1, s1));
+
+            const __m128 c2 = _mm_load_ps(&f32_coeffs2[i]);
+            const __m128 s2a = _mm_loadu_ps(&f32_src2[2 * i]);
+            const __m128 s2b = _mm_loadu_ps(&f32_src2[2 * i + 4]);
+            const __m128 s2 = _mm_shuffle_ps(s2a, s2b, _MM_SHUFFLE(2, 0, 2, 0));
+
+            t2 = _mm_add_ps(t2, _mm_mul_ps(c2, s2));
+        }
+
+        (*dest) = mm_hadd_all_ps(_mm_add_ps(t1, t2));
+    }
+
 private:
     static float mm_hadd_all_ps(const __m128 &m) CXXPH_NOEXCEPT
     {
@@ -107,6 +107,60 @@ public:
 
         vst1_f32(reinterpret_cast<float32_t *>(dest), t);
     }
+
+    /**
+     * Dual convolution with every other source frame (for 2:1 decimation).
+     *
+     * dest = sum(src1[2 * i] * coeffs1[i]) + sum(src2[2 * i] * coeffs2[i])   (i = 0 .. n - 1)
+     */
+    void decimating_dual_convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT src1,
+                                  const src_frame_t *CXXPH_RESTRICT src2, const coeffs_t *CXXPH_RESTRICT coeffs1,
+                                  const coeffs_t *CXXPH_RESTRICT coeffs2, int n) const CXXPH_NOEXCEPT
+    {
+
+        const float32_t *CXXPH_RESTRICT f32_src1 = reinterpret_cast<const float32_t *>(src1);
+        const float32_t *CXXPH_RESTRICT f32_src2 = reinterpret_cast<const float32_t *>(src2);
+        const float32_t *CXXPH_RESTRICT f32_coeffs1 =
+            reinterpret_cast<const float32_t *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs1, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+        const float32_t *CXXPH_RESTRICT f32_coeffs2 =
+            reinterpret_cast<const float32_t *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs2, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+
+        float32x4_t tl, tr;
+
+        tl = vdupq_n_f32(0.0f);
+        tr = vdupq_n_f32(0.0f);
+
+        assert((n & 0x3) == 0);
+        int n2 = (n >> 2);
+
+        do {
+            // val[0]: [L0 L2 L4 L6], val[1]: [R0 R2 R4 R6]
+            const float32x4_t c1 = vld1q_f32(f32_coeffs1);
+            f32_coeffs1 += 4;
+            const float32x4x4_t s1 = vld4q_f32(f32_src1);
+            f32_src1 += (4 * 4);
+
+            tl = vmlaq_f32(tl, c1, s1.val[0]);
+            tr = vmlaq_f32(tr, c1, s1.val[1]);
+
+            const float32x4_t c2 = vld1q_f32(f32_coeffs2);
+            f32_coeffs2 += 4;
+            const float32x4x4_t s2 = vld4q_f32(f32_src2);
+            f32_src2 += (4 * 4);
+
+            tl = vmlaq_f32(tl, c2, s2.val[0]);
+            tr = vmlaq_f32(tr, c2, s2.val[1]);
+
+            --n2;
+        } while (CXXPH_LIKELY(n2 != 0));
+
+        const float32x2_t tl2 = vadd_f32(vget_low_f32(tl), vget_high_f32(tl));
+        const float32x2_t tr2 = vadd_f32(vget_low_f32(tr), vget_high_f32(tr));
+
+        const float32x2_t t = vpadd_f32(tl2, tr2);
+
+        vst1_f32(reinterpret_cast<float32_t *>(dest), t);
+    }
 };
 
 } // namespace resampler
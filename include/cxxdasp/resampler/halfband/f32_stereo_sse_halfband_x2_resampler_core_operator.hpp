@@ -106,6 +106,63 @@ public:
         dest->c(0) = (tmp[0] + tmp[2]);
         dest->c(1) = (tmp[1] + tmp[3]);
     }
+
+    /**
+     * Dual convolution with every other source frame (for 2:1 decimation).
+     *
+     * dest = sum(src1[2 * i] * coeffs1[i]) + sum(src2[2 * i] * coeffs2[i])   (i = 0 .. n - 1)
+     */
+    void decimating_dual_convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT src1,
+                                  const src_frame_t *CXXPH_RESTRICT src2, const coeffs_t *CXXPH_RESTRICT coeffs1,
+                                  const coeffs_t *CXXPH_RESTRICT coeffs2, int n) const CXXPH_NOEXCEPT
+    {
+
+        const float *CXXPH_RESTRICT f32_src1 = reinterpret_cast<const float *>(src1);
+        const float *CXXPH_RESTRICT f32_src2 = reinterpret_cast<const float *>(src2);
+        const float *CXXPH_RESTRICT f32_coeffs1 =
+            reinterpret_cast<const float *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs1, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+        const float *CXXPH_RESTRICT f32_coeffs2 =
+            reinterpret_cast<const float *>(CXXDASP_UTIL_ASSUME_ALIGNED_FUNC(coeffs2, CXXPH_PLATFORM_SIMD_ALIGNMENT));
+
+        __m128 ta, tb;
+
+        ta = _mm_setzero_ps();
+        tb = _mm_setzero_ps();
+
+        assert((n & 0x3) == 0);
+        for (int i = 0; i < n; i += 4) {
+            // [L0 R0 L2 R2], [L4 R4 L6 R6]
+            const __m128 c1 = _mm_load_ps(&f32_coeffs1[i]);
+            const __m128 c1a = _mm_shuffle_ps(c1, c1, _MM_SHUFFLE(1, 1, 0, 0));
+            const __m128 c1b = _mm_shuffle_ps(c1, c1, _MM_SHUFFLE(3, 3, 2, 2));
+            const __m128 s1a = _mm_shuffle_ps(_mm_loadu_ps(&f32_src1[4 * i + 0]), _mm_loadu_ps(&f32_src1[4 * i + 4]),
+                                              _MM_SHUFFLE(1, 0, 1, 0));
+            const __m128 s1b = _mm_shuffle_ps(_mm_loadu_ps(&f32_src1[4 * i + 8]), _mm_loadu_ps(&f32_src1[4 * i + 12]),
+                                              _MM_SHUFFLE(1, 0, 1, 0));
+
+            ta = _mm_add_ps(ta, _mm_mul_ps(c1a, s1a));
+            tb = _mm_add_ps(tb, _mm_mul_ps(c1b, s1b));
+
+            const __m128 c2 = _mm_load_ps(&f32_coeffs2[i]);
+            const __m128 c2a = _mm_shuffle_ps(c2, c2, _MM_SHUFFLE(1, 1, 0, 0));
+            const __m128 c2b = _mm_shuffle_ps(c2, c2, _MM_SHUFFLE(3, 3, 2, 2));
+            const __m128 s2a = _mm_shuffle_ps(_mm_loadu_ps(&f32_src2[4 * i + 0]), _mm_loadu_ps(&f32_src2[4 * i + 4]),
+                                              _MM_SHUFFLE(1, 0, 1, 0));
+            const __m128 s2b = _mm_shuffle_ps(_mm_loadu_ps(&f32_src2[4 * i + 8]), _mm_loadu_ps(&f32_src2[4 * i + 12]),
+                                              _MM_SHUFFLE(1, 0, 1, 0));
+
+            ta = _mm_add_ps(ta, _mm_mul_ps(c2a, s2a));
+            tb = _mm_add_ps(tb, _mm_mul_ps(c2b, s2b));
+        }
+
+        const __m128 t = _mm_add_ps(ta, tb);
+
+        CXXPH_ALIGNAS(16) float tmp[4];
+        _mm_store_ps(&tmp[0], t);
+
+        dest->c(0) = (tmp[0] + tmp[2]);
+        dest->c(1) = (tmp[1] + tmp[3]);
+    }
 };
 
 } // namespace resampler
@@ -83,6 +83,30 @@ public:
 
         (*dest) = (t1 + t2);
     }
+
+    /**
+     * Dual convolution with every other source frame (for 2:1 decimation).
+     *
+     * dest = sum(src1[2 * i] * coeffs1[i]) + sum(src2[2 * i] * coeffs2[i])   (i = 0 .. n - 1)
+     */
+    void decimating_dual_convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT src1,
+                                  const src_frame_t *CXXPH_RESTRICT src2, const coeffs_t *CXXPH_RESTRICT coeffs1,
+                                  const coeffs_t *CXXPH_RESTRICT coeffs2, int n) const CXXPH_NOEXCEPT
+    {
+
+        CXXDASP_UTIL_ASSUME_ALIGNED(coeffs1, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+        CXXDASP_UTIL_ASSUME_ALIGNED(coeffs2, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+
+        dest_frame_t t1(0);
+        dest_frame_t t2(0);
+
+        for (int i = 0; i < n; ++i) {
+            t1 += src1[2 * i] * coeffs1[i];
+            t2 += src2[2 * i] * coeffs2[i];
+        }
+
+        (*dest) = (t1 + t2);
+    }
 };
 
 // Well-known forms
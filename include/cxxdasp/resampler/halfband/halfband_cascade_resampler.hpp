@@ -0,0 +1,326 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_RESAMPLER_HALFBAND_HALFBAND_CASCADE_RESAMPLER_HPP_
+#define CXXDASP_RESAMPLER_HALFBAND_HALFBAND_CASCADE_RESAMPLER_HPP_
+
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+#include <cxxporthelper/type_traits>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/resampler/halfband/halfband_x2_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_decimator.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Cascaded half band filter resampler class (x4, x8, ... / 1/4, 1/8, ...).
+ *
+ * Chains halfband_x2_resampler (upsampling) or halfband_x2_decimator (downsampling) stages.
+ * Each stage can use its own filter kernel, so stages running at higher sample rates
+ * (where the transition band is relatively wider) can use shorter filters.
+ * The stages exchange data through a single shared work buffer.
+ *
+ * @tparam TSrcFrame source audio frame type
+ * @tparam TDestFrame destination audio frame type
+ * @tparam TCoeffs FIR coefficient data type
+ * @tparam THBFRCoreOperator Half band filter resampler implementation class type
+ */
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+class halfband_cascade_resampler {
+
+    /// @cond INTERNAL_FIELD
+    halfband_cascade_resampler(const halfband_cascade_resampler &) = delete;
+    halfband_cascade_resampler &operator=(const halfband_cascade_resampler &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source audio frame type.
+     */
+    typedef TSrc src_frame_t;
+
+    /**
+     * Destination audio frame type.
+     */
+    typedef TDest dest_frame_t;
+
+    /**
+     * FIR coefficients type.
+     */
+    typedef TCoeffs coeffs_t;
+
+    /**
+     * Operator
+     */
+    typedef THBFRCoreOperator core_operator_type;
+
+    /**
+     * Conversion direction.
+     */
+    enum direction_t {
+        Upsampling,   ///< x (2 ^ num_stages)
+        Downsampling, ///< 1 / (2 ^ num_stages)
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param [in] direction conversion direction
+     * @param [in] num_stages number of x2 stages (1..)
+     * @param [in] filter_kernels FIR coefficients of each stage (in processing order)
+     * @param [in] filter_lengths number of FIR coefficients of each stage (in processing order)
+     * @param [in] process_block_size_adjust specify processing block size of each stage (0..)
+     *
+     * @note Upsampling stages are processed from the lowest sample rate, and downsampling stages are processed
+     *       from the highest sample rate. So the longest filter is usually specified to the first upsampling stage
+     *       or to the last downsampling stage.
+     */
+    halfband_cascade_resampler(direction_t direction, int num_stages, const coeffs_t *const *filter_kernels,
+                               const int *filter_lengths, int process_block_size_adjust);
+
+    /**
+     * Destructor.
+     */
+    ~halfband_cascade_resampler();
+
+    /**
+     * Reset state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush buffered data.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Put input (original) data
+     *
+     * @param s [in] source data buffer
+     * @param n [in] count of data  (n >= 0 && n < num_can_put())
+     */
+    void put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get output (resampled) data
+     *
+     * @param d [in] destination data buffer
+     * @param n [in] count of data  (n >= 0 && n < num_can_get())
+     */
+    void get_n(dest_frame_t *d, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get free size of internal buffer.
+     * @returns count of free size of internal buffer [frames]
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get count of available resampled data.
+     * @returns count of available resampled data [frames]
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get number of x2 stages.
+     * @returns number of stages
+     */
+    int num_stages() const CXXPH_NOEXCEPT { return num_stages_; }
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef halfband_x2_resampler<src_frame_t, src_frame_t, coeffs_t, core_operator_type> upsampler_type;
+    typedef halfband_x2_decimator<src_frame_t, src_frame_t, coeffs_t, core_operator_type> decimator_type;
+
+    template <class TStage>
+    void transfer_between_stages(std::vector<std::unique_ptr<TStage>> &stages) CXXPH_NOEXCEPT;
+
+    const int num_stages_;
+    int num_flushed_stages_;
+    std::vector<std::unique_ptr<upsampler_type>> upsamplers_;
+    std::vector<std::unique_ptr<decimator_type>> decimators_;
+    cxxporthelper::aligned_memory<src_frame_t> work_buffer_;
+
+    // verify template parameters
+    static_assert(std::is_same<src_frame_t, dest_frame_t>::value, "source and destination frame types must be same");
+    /// @endcond
+};
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::halfband_cascade_resampler(
+    direction_t direction, int num_stages, const coeffs_t *const *filter_kernels, const int *filter_lengths,
+    int process_block_size_adjust)
+    : num_stages_(num_stages), num_flushed_stages_(0), upsamplers_(), decimators_(), work_buffer_()
+{
+    assert(num_stages >= 1);
+
+    int max_filter_length = 0;
+
+    for (int i = 0; i < num_stages; ++i) {
+        if (direction == Upsampling) {
+            upsamplers_.emplace_back(
+                new upsampler_type(filter_kernels[i], filter_lengths[i], process_block_size_adjust));
+        } else {
+            decimators_.emplace_back(
+                new decimator_type(filter_kernels[i], filter_lengths[i], process_block_size_adjust));
+        }
+        max_filter_length = (std::max)(max_filter_length, filter_lengths[i]);
+    }
+
+    work_buffer_.allocate((4 * max_filter_length) * (1 << process_block_size_adjust));
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::~halfband_cascade_resampler()
+{
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline void halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::reset() CXXPH_NOEXCEPT
+{
+    for (auto &s : upsamplers_) {
+        s->reset();
+    }
+    for (auto &s : decimators_) {
+        s->reset();
+    }
+
+    num_flushed_stages_ = 0;
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline void halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::flush() CXXPH_NOEXCEPT
+{
+    if (CXXPH_UNLIKELY(num_flushed_stages_ > 0)) {
+        return;
+    }
+
+    if (!upsamplers_.empty()) {
+        upsamplers_.front()->flush();
+        num_flushed_stages_ = 1;
+        transfer_between_stages(upsamplers_);
+    } else {
+        decimators_.front()->flush();
+        num_flushed_stages_ = 1;
+        transfer_between_stages(decimators_);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline void halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::put_n(const src_frame_t *s, int n)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+
+    if (!upsamplers_.empty()) {
+        upsamplers_.front()->put_n(s, n);
+        transfer_between_stages(upsamplers_);
+    } else {
+        decimators_.front()->put_n(s, n);
+        transfer_between_stages(decimators_);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline void halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::get_n(dest_frame_t *d, int n)
+    CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_get());
+
+    if (!upsamplers_.empty()) {
+        upsamplers_.back()->get_n(d, n);
+        transfer_between_stages(upsamplers_);
+    } else {
+        decimators_.back()->get_n(d, n);
+        transfer_between_stages(decimators_);
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline int halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::num_can_put() const CXXPH_NOEXCEPT
+{
+    if (!upsamplers_.empty()) {
+        return upsamplers_.front()->num_can_put();
+    } else {
+        return decimators_.front()->num_can_put();
+    }
+}
+
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+inline int halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::num_can_get() const CXXPH_NOEXCEPT
+{
+    if (!upsamplers_.empty()) {
+        return upsamplers_.back()->num_can_get();
+    } else {
+        return decimators_.back()->num_can_get();
+    }
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, typename TCoeffs, class THBFRCoreOperator>
+template <class TStage>
+inline void halfband_cascade_resampler<TSrc, TDest, TCoeffs, THBFRCoreOperator>::transfer_between_stages(
+    std::vector<std::unique_ptr<TStage>> &stages) CXXPH_NOEXCEPT
+{
+    const int n_stages = static_cast<int>(stages.size());
+    const int work_size = static_cast<int>(work_buffer_.size());
+    bool progress;
+
+    // repeat until no more data can be moved, because moving data out of a stage may unblock its upstream stage
+    do {
+        progress = false;
+
+        for (int i = 0; i < (n_stages - 1); ++i) {
+            TStage &src = *(stages[i]);
+            TStage &dest = *(stages[i + 1]);
+
+            while (true) {
+                int n = (std::min)(src.num_can_get(), dest.num_can_put());
+                n = (std::min)(n, work_size);
+
+                if (n <= 0) {
+                    break;
+                }
+
+                src.get_n(&work_buffer_[0], n);
+                dest.put_n(&work_buffer_[0], n);
+
+                progress = true;
+            }
+
+            // flush the next stage after all of the data of this stage has been consumed
+            if ((i + 1) == num_flushed_stages_ && src.num_can_get() == 0) {
+                dest.flush();
+                ++num_flushed_stages_;
+                progress = true;
+            }
+        }
+    } while (progress);
+}
+/// @endcond
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_RESAMPLER_HALFBAND_HALFBAND_CASCADE_RESAMPLER_HPP_
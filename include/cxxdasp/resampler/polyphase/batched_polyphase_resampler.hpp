@@ -0,0 +1,360 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_RESAMPLER_POLYPHASE_BATCHED_POLYPHASE_RESAMPLER_HPP_
+#define CXXDASP_RESAMPLER_POLYPHASE_BATCHED_POLYPHASE_RESAMPLER_HPP_
+
+#include <cassert>
+
+#include <cxxporthelper/type_traits>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/cxxdasp_config.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Batched poly-phase FIR based resampler class.
+ *
+ * Resamples multiple mono streams which share the same M/L and FIR coefficients. The delay line holds the streams
+ * in lane-interleaved (structure of arrays) layout, so the same output phase of all streams is calculated in a
+ * single pass and each coefficient load is shared among the streams.
+ *
+ * The output of each stream is equivalent to the one of polyphase_resampler (not pass-through case).
+ *
+ * @tparam TSample sample data type
+ * @tparam TCoeffs FIR coefficient data type
+ * @tparam TBatchCoreOperator core operator class type
+ */
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+class batched_polyphase_resampler {
+    // validate template parameters
+    static_assert(std::is_same<TSample, typename TBatchCoreOperator::sample_t>::value, "sample type is different");
+    static_assert(std::is_same<TCoeffs, typename TBatchCoreOperator::coeffs_t>::value,
+                  "FIR coefficient type is different");
+
+    /// @cond INTERNAL_FIELD
+    batched_polyphase_resampler(const batched_polyphase_resampler &) = delete;
+    batched_polyphase_resampler &operator=(const batched_polyphase_resampler &) = delete;
+    /// @endcond
+
+public:
+    /** Data type of sample */
+    typedef TSample sample_t;
+
+    /** Data type of FIR coefficients */
+    typedef TCoeffs coeffs_t;
+
+    /** Operator */
+    typedef TBatchCoreOperator core_operator_type;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] coeffs FIR coefficients
+     * @param [in] num_coeffs number of FIR coefficients
+     * @param [in] num_streams number of streams (1 <=)
+     * @param [in] m oversampling ratio
+     * @param [in] l decimation ratio
+     * @param [in] base_block_size specify additional internal delay line size to improve efficiency (1 >) [frames]
+     *
+     * @note {output rate} = (M / L) * {input rate}
+     * @note the interleaved coefficients table is shared with the other (batched) poly-phase resamplers.
+     */
+    batched_polyphase_resampler(const coeffs_t *coeffs, int num_coeffs, int num_streams, int m, int l,
+                                int base_block_size);
+
+    /**
+     * Destructor.
+     */
+    ~batched_polyphase_resampler();
+
+    /**
+     * Reset internal state.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush internal buffer.
+     *
+     * @note call this function when after all source data put into the resampler.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Get number of streams.
+     *
+     * @returns number of streams
+     */
+    int num_streams() const CXXPH_NOEXCEPT { return num_streams_; }
+
+    /**
+     * Put multiple samples to all streams.
+     *
+     * @param [in] s array of source sample pointers (num_streams() elements)
+     * @param [in] n count of source samples per stream (n <= num_can_put())
+     *
+     * @sa num_can_put()
+     */
+    void put_n(const sample_t *const *s, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get multiple resampled samples from all streams.
+     *
+     * @param [out] d array of destination sample pointers (num_streams() elements)
+     * @param [in] n count of resampled samples per stream (n <= num_can_get())
+     *
+     * @sa num_can_get()
+     */
+    void get_n(sample_t *const *d, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get available free buffer space size.
+     *
+     * \return available buffer space size [samples per stream]
+     *
+     * @sa put_n()
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get resampling-ready sample count.
+     *
+     * \return resampling-ready count [samples per stream]
+     *
+     * @sa get_n()
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef polyphase_resampler_utils pprutils;
+
+    static int calc_lane_stride(int num_streams) CXXPH_NOEXCEPT
+    {
+        const int align = static_cast<int>(core_operator_type::lane_alignment);
+        return ((num_streams + (align - 1)) / align) * align;
+    }
+
+    const core_operator_type core_operator_;
+    const int num_coeffs_;
+    const int num_streams_;
+    const int lane_stride_;
+    const int m_;
+    const int l_;
+
+    const int interleaved_coeffs_subtable_size_;
+    const int delay_line_size_;
+    const int m_delay_line_size_;
+
+    int count_;
+    int write_pos_;
+    int read_pos_;
+    bool flushed_;
+
+    const coeffs_t *interleaved_coeffs_;
+    const pprutils::phase_schedule_entry *phase_schedule_;
+    sample_t *delay_;
+    sample_t *work_;
+
+    std::shared_ptr<const coeffs_t> shared_interleaved_coeffs_;
+    cxxporthelper::aligned_memory<sample_t> mem_delay_;
+    cxxporthelper::aligned_memory<sample_t> mem_work_;
+    cxxporthelper::aligned_memory<pprutils::phase_schedule_entry> mem_phase_schedule_;
+    /// @endcond
+};
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::batched_polyphase_resampler(
+    const coeffs_t *coeffs, int num_coeffs, int num_streams, int m, int l, int base_block_size)
+    : core_operator_(), num_coeffs_(num_coeffs), num_streams_(num_streams), lane_stride_(calc_lane_stride(num_streams)),
+      m_(m), l_(l), interleaved_coeffs_subtable_size_(pprutils::calc_interleaved_coeffs_subtable_size(num_coeffs, m)),
+      delay_line_size_(pprutils::calc_delay_line_size(num_coeffs_, m, l, base_block_size)),
+      m_delay_line_size_(m_ * delay_line_size_), count_(0), write_pos_(0), read_pos_(0), flushed_(false),
+      interleaved_coeffs_(nullptr), phase_schedule_(nullptr), delay_(nullptr), work_(nullptr)
+{
+    assert(num_streams >= 1);
+
+    // allocate memory blocks
+    cxxporthelper::aligned_memory<sample_t> mem_delay;
+    cxxporthelper::aligned_memory<sample_t> mem_work;
+    cxxporthelper::aligned_memory<pprutils::phase_schedule_entry> mem_phase_schedule;
+    std::shared_ptr<const coeffs_t> shared_interleaved_coeffs;
+
+    mem_delay.allocate((delay_line_size_ * 2 * lane_stride_), CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    mem_work.allocate(lane_stride_, CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    mem_phase_schedule.allocate(m_);
+
+    pprutils::make_phase_schedule_table(m_, l_, interleaved_coeffs_subtable_size_, &mem_phase_schedule[0]);
+
+    // make (or share already made) interleaved coefficient array
+    shared_interleaved_coeffs = pprutils::acquire_shared_interleaved_coeffs_table(coeffs, num_coeffs, m, false);
+
+    // update fields
+    shared_interleaved_coeffs_ = std::move(shared_interleaved_coeffs);
+    mem_delay_ = std::move(mem_delay);
+    mem_work_ = std::move(mem_work);
+    mem_phase_schedule_ = std::move(mem_phase_schedule);
+
+    interleaved_coeffs_ = shared_interleaved_coeffs_.get();
+    delay_ = &mem_delay_[0];
+    work_ = &mem_work_[0];
+    phase_schedule_ = &mem_phase_schedule_[0];
+
+    // reset states
+    reset();
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::~batched_polyphase_resampler()
+{
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline void batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::reset() CXXPH_NOEXCEPT
+{
+    // NOTE: padding lanes also have to be cleared
+    for (int i = 0; i < static_cast<int>(mem_delay_.size()); ++i) {
+        delay_[i] = 0;
+    }
+
+    count_ = -(m_ - 1);
+    write_pos_ = (num_coeffs_ / 2) / m_;
+    read_pos_ = (m_ - 1) - ((num_coeffs_ / 2) % m_);
+
+    flushed_ = false;
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline void batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::flush() CXXPH_NOEXCEPT
+{
+    flushed_ = true;
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline void batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::put_n(const sample_t *const *s,
+                                                                                      int n) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+
+    const int num_streams = num_streams_;
+    const int stride = lane_stride_;
+    const int upper_offset = delay_line_size_ * stride;
+    int wp = write_pos_;
+
+    for (int i = 0; i < n; ++i) {
+        sample_t *CXXPH_RESTRICT row = &delay_[wp * stride];
+
+        // transpose into the lane-interleaved form (both halves of the delay line)
+        for (int k = 0; k < num_streams; ++k) {
+            const sample_t v = s[k][i];
+            row[k] = v;
+            row[upper_offset + k] = v;
+        }
+
+        wp += 1;
+        if (CXXPH_UNLIKELY(wp >= delay_line_size_)) {
+            wp = 0;
+        }
+    }
+
+    write_pos_ = wp;
+    count_ += (n * m_);
+    assert(count_ <= m_delay_line_size_);
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline void batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::get_n(sample_t *const *d,
+                                                                                      int n) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_get());
+
+    const int m = m_;
+    const int num_streams = num_streams_;
+    const int stride = lane_stride_;
+    const int subtable_size = interleaved_coeffs_subtable_size_;
+    const pprutils::phase_schedule_entry *CXXPH_RESTRICT schedule = phase_schedule_;
+    sample_t *CXXPH_RESTRICT work = work_;
+
+    int pos = read_pos_ / m;
+    int phase = read_pos_ - (pos * m);
+
+    for (int i = 0; i < n; ++i) {
+        const pprutils::phase_schedule_entry &e = schedule[phase];
+        const sample_t *CXXPH_RESTRICT data = &delay_[pos * stride];
+        const coeffs_t *CXXPH_RESTRICT coeffs = &interleaved_coeffs_[e.coeffs_offset];
+
+        // calculate the same phase of all streams at once
+        core_operator_.convolve(work, data, stride, coeffs, subtable_size, stride);
+
+        for (int k = 0; k < num_streams; ++k) {
+            d[k][i] = work[k];
+        }
+
+        pos += e.delay_advance;
+        phase = e.next_phase;
+    }
+
+    int rp = (pos * m) + phase;
+
+    if (CXXPH_UNLIKELY(rp >= m_delay_line_size_)) {
+        rp -= m_delay_line_size_;
+    }
+    read_pos_ = rp;
+    assert(read_pos_ < m_delay_line_size_);
+
+    count_ -= (n * l_);
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline int batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::num_can_put() const CXXPH_NOEXCEPT
+{
+    if (CXXPH_LIKELY(!flushed_)) {
+        const int rp = read_pos_ / m_;
+        const int wp = write_pos_;
+        int n;
+
+        if (wp >= rp) {
+            n = delay_line_size_ - (wp - rp) - 1;
+        } else {
+            n = (rp - wp) - 1;
+        }
+
+        assert((count_ + (n * m_)) <= m_delay_line_size_);
+
+        return n;
+    } else {
+        return 0;
+    }
+}
+
+template <typename TSample, typename TCoeffs, class TBatchCoreOperator>
+inline int batched_polyphase_resampler<TSample, TCoeffs, TBatchCoreOperator>::num_can_get() const CXXPH_NOEXCEPT
+{
+    if (count_ >= num_coeffs_) {
+        return (count_ - num_coeffs_ + 1) / l_;
+    } else {
+        return 0;
+    }
+}
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_RESAMPLER_POLYPHASE_BATCHED_POLYPHASE_RESAMPLER_HPP_
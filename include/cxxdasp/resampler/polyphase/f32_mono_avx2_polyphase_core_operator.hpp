@@ -0,0 +1,188 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_RESAMPLER_POLYPHASE_F32_MONO_AVX2_POLYPHASE_CORE_OPERATOR_HPP_
+#define CXXDASP_RESAMPLER_POLYPHASE_F32_MONO_AVX2_POLYPHASE_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+#include <cxxdasp/utils/x86_platform_info.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+
+#include <immintrin.h>
+
+#include <cxxdasp/datatype/audio_frame.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Audio frame operator (AVX2 + FMA optimized)
+ *
+ * source & dest: float32, 1 ch
+ */
+class f32_mono_avx2_polyphase_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    f32_mono_avx2_polyphase_core_operator(const f32_mono_avx2_polyphase_core_operator &) = delete;
+    f32_mono_avx2_polyphase_core_operator &operator=(const f32_mono_avx2_polyphase_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /** Data type of source audio frame */
+    typedef datatype::audio_frame<float, 1> src_frame_t;
+
+    /** Data type of destination audio frame */
+    typedef datatype::audio_frame<float, 1> dest_frame_t;
+
+    /** Data type of FIR coefficients */
+    typedef float coeffs_t;
+
+/** Number of channels */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int num_channels = 1;
+#else
+    enum { num_channels = 1 };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static bool is_supported()
+    {
+        return utils::x86_platform_info::support_avx2() && utils::x86_platform_info::support_fma();
+    }
+
+    /**
+     * Constructor.
+     */
+    f32_mono_avx2_polyphase_core_operator() {}
+
+    /**
+     * Destructor.
+     */
+    ~f32_mono_avx2_polyphase_core_operator() {}
+
+    /**
+     * Copy multiple frames to dual destinations.
+     *
+     * @param [out] dest1 pointer of first destination frames
+     * @param [out] dest2 pointer of second destination frames
+     * @param [in] src pointer of source frames
+     * @param [in] n copy length [frame]
+     */
+    CXXDASP_X86_TARGET_AVX2_FMA
+    void dual_copy(src_frame_t *CXXPH_RESTRICT dest1, src_frame_t *CXXPH_RESTRICT dest2,
+                   const src_frame_t *CXXPH_RESTRICT src, int n) const CXXPH_NOEXCEPT
+    {
+        int n_loop_1 = (n >> 3);   // (n / 8)
+        int n_loop_2 = (n & 0x07); // (n % 8)
+
+        if (CXXPH_LIKELY(n_loop_1 > 0)) {
+            float *CXXPH_RESTRICT nc_dest1 = reinterpret_cast<float *>(dest1);
+            float *CXXPH_RESTRICT nc_dest2 = reinterpret_cast<float *>(dest2);
+            const float *CXXPH_RESTRICT nc_src = reinterpret_cast<const float *>(src);
+
+            for (int i = 0; i < n_loop_1; ++i) {
+                const __m256 s = _mm256_loadu_ps(&nc_src[i * 8]);
+
+                _mm256_storeu_ps(&nc_dest1[i * 8], s);
+                _mm256_storeu_ps(&nc_dest2[i * 8], s);
+            }
+        }
+
+        for (int i = (n_loop_1 * 8); i < (n_loop_1 * 8 + n_loop_2); ++i) {
+            dest1[i] = src[i];
+            dest2[i] = src[i];
+        }
+    }
+
+    /**
+     * Calculate convolution.
+     *
+     * @param [out] dest pointer of destination frame
+     * @param [in] samples pointer of souurce samples frames
+     * @param [in] coeffs pointer of coefficients array frames
+     * @param [in] n length [frame]
+     */
+    CXXDASP_X86_TARGET_AVX2_FMA
+    void convolve(dest_frame_t *CXXPH_RESTRICT dest, const src_frame_t *CXXPH_RESTRICT samples,
+                  const coeffs_t *CXXPH_RESTRICT coeffs, int n) const CXXPH_NOEXCEPT
+    {
+        const int n_loop_1 = (n >> 5);              // (n / 32)
+        const int n_loop_2 = ((n & 0x1f) >> 3);     // ((n % 32) / 8)
+        const int n_loop_3 = (n & 0x07);            // (n % 8)
+
+        const float *CXXPH_RESTRICT nc_samples = reinterpret_cast<const float *>(samples);
+        const float *CXXPH_RESTRICT nc_coeffs = coeffs;
+
+        // NOTE: use 4 accumulators to hide the latency of FMA instructions
+        __m256 t0 = _mm256_setzero_ps();
+        __m256 t1 = _mm256_setzero_ps();
+        __m256 t2 = _mm256_setzero_ps();
+        __m256 t3 = _mm256_setzero_ps();
+
+        for (int i = 0; i < n_loop_1; ++i) {
+            const __m256 s0 = _mm256_loadu_ps(&nc_samples[0]);
+            const __m256 s1 = _mm256_loadu_ps(&nc_samples[8]);
+            const __m256 s2 = _mm256_loadu_ps(&nc_samples[16]);
+            const __m256 s3 = _mm256_loadu_ps(&nc_samples[24]);
+
+            t0 = _mm256_fmadd_ps(s0, _mm256_loadu_ps(&nc_coeffs[0]), t0);
+            t1 = _mm256_fmadd_ps(s1, _mm256_loadu_ps(&nc_coeffs[8]), t1);
+            t2 = _mm256_fmadd_ps(s2, _mm256_loadu_ps(&nc_coeffs[16]), t2);
+            t3 = _mm256_fmadd_ps(s3, _mm256_loadu_ps(&nc_coeffs[24]), t3);
+
+            nc_samples += 32;
+            nc_coeffs += 32;
+        }
+
+        for (int i = 0; i < n_loop_2; ++i) {
+            t0 = _mm256_fmadd_ps(_mm256_loadu_ps(&nc_samples[0]), _mm256_loadu_ps(&nc_coeffs[0]), t0);
+
+            nc_samples += 8;
+            nc_coeffs += 8;
+        }
+
+        t0 = _mm256_add_ps(_mm256_add_ps(t0, t1), _mm256_add_ps(t2, t3));
+
+        float sum = mm256_hadd_all_ps(t0);
+
+        for (int i = 0; i < n_loop_3; ++i) {
+            sum += (nc_samples[i] * nc_coeffs[i]);
+        }
+
+        dest->c(0) = sum;
+    }
+
+private:
+    CXXDASP_X86_TARGET_AVX2_FMA
+    static float mm256_hadd_all_ps(const __m256 &m) CXXPH_NOEXCEPT
+    {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(sum);
+    }
+};
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+#endif // CXXDASP_RESAMPLER_POLYPHASE_F32_MONO_AVX2_POLYPHASE_CORE_OPERATOR_HPP_
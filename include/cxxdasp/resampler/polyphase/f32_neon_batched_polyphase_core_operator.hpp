@@ -0,0 +1,137 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_RESAMPLER_POLYPHASE_F32_NEON_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
+#define CXXDASP_RESAMPLER_POLYPHASE_F32_NEON_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+
+#include <cxxporthelper/arm_neon.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Batched poly-phase resampler core operator (NEON optimized)
+ *
+ * sample: float32, coefficients: float32
+ */
+class f32_neon_batched_polyphase_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    f32_neon_batched_polyphase_core_operator(const f32_neon_batched_polyphase_core_operator &) = delete;
+    f32_neon_batched_polyphase_core_operator &operator=(const f32_neon_batched_polyphase_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /** Data type of sample */
+    typedef float sample_t;
+
+    /** Data type of FIR coefficients */
+    typedef float coeffs_t;
+
+/** Lane count alignment (number of lanes have to be a multiple of this value) */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int lane_alignment = 4;
+#else
+    enum { lane_alignment = 4 };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static bool is_supported() { return cxxporthelper::platform_info::support_arm_neon(); }
+
+    /**
+     * Constructor.
+     */
+    f32_neon_batched_polyphase_core_operator() {}
+
+    /**
+     * Destructor.
+     */
+    ~f32_neon_batched_polyphase_core_operator() {}
+
+    /**
+     * Calculate convolution for multiple lanes.
+     *
+     * dest[k] = sum(samples[i * stride + k] * coeffs[i]), (0 <= k < num_lanes, 0 <= i < n)
+     *
+     * @param [out] dest pointer of destination samples (num_lanes, 16 bytes aligned)
+     * @param [in] samples pointer of source samples (lane-interleaved, n rows, 16 bytes aligned)
+     * @param [in] stride row stride of the source samples (a multiple of 4) [samples]
+     * @param [in] coeffs pointer of coefficients array
+     * @param [in] n length [rows]
+     * @param [in] num_lanes number of lanes (a multiple of 4)
+     */
+    void convolve(float *CXXPH_RESTRICT dest, const float *CXXPH_RESTRICT samples, int stride,
+                  const float *CXXPH_RESTRICT coeffs, int n, int num_lanes) const CXXPH_NOEXCEPT
+    {
+        int k = 0;
+
+        // 16 lanes per pass (each coefficient load is shared by 16 lanes)
+        for (; (k + 16) <= num_lanes; k += 16) {
+            const float *CXXPH_RESTRICT s = &samples[k];
+
+            float32x4_t t0 = vdupq_n_f32(0.0f);
+            float32x4_t t1 = vdupq_n_f32(0.0f);
+            float32x4_t t2 = vdupq_n_f32(0.0f);
+            float32x4_t t3 = vdupq_n_f32(0.0f);
+
+            for (int i = 0; i < n; ++i) {
+                const float32x4_t c = vdupq_n_f32(coeffs[i]);
+
+                t0 = vmlaq_f32(t0, vld1q_f32(&s[0]), c);
+                t1 = vmlaq_f32(t1, vld1q_f32(&s[4]), c);
+                t2 = vmlaq_f32(t2, vld1q_f32(&s[8]), c);
+                t3 = vmlaq_f32(t3, vld1q_f32(&s[12]), c);
+
+                s += stride;
+            }
+
+            vst1q_f32(&dest[k + 0], t0);
+            vst1q_f32(&dest[k + 4], t1);
+            vst1q_f32(&dest[k + 8], t2);
+            vst1q_f32(&dest[k + 12], t3);
+        }
+
+        // remaining lanes
+        for (; k < num_lanes; k += 4) {
+            const float *CXXPH_RESTRICT s = &samples[k];
+
+            float32x4_t t0 = vdupq_n_f32(0.0f);
+
+            for (int i = 0; i < n; ++i) {
+                const float32x4_t c = vdupq_n_f32(coeffs[i]);
+
+                t0 = vmlaq_f32(t0, vld1q_f32(&s[0]), c);
+
+                s += stride;
+            }
+
+            vst1q_f32(&dest[k], t0);
+        }
+    }
+};
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON
+#endif // CXXDASP_RESAMPLER_POLYPHASE_F32_NEON_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
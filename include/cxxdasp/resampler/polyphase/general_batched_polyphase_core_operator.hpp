@@ -0,0 +1,105 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_RESAMPLER_POLYPHASE_GENERAL_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
+#define CXXDASP_RESAMPLER_POLYPHASE_GENERAL_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Batched poly-phase resampler core operator (basic implementation)
+ *
+ * @tparam TSample sample data type
+ * @tparam TCoeffs FIR coefficient data type
+ */
+template <typename TSample, typename TCoeffs>
+class general_batched_polyphase_core_operator {
+
+    /// @cond INTERNAL_FIELD
+    general_batched_polyphase_core_operator(const general_batched_polyphase_core_operator &) = delete;
+    general_batched_polyphase_core_operator &operator=(const general_batched_polyphase_core_operator &) = delete;
+    /// @endcond
+
+public:
+    /** Data type of sample */
+    typedef TSample sample_t;
+
+    /** Data type of FIR coefficients */
+    typedef TCoeffs coeffs_t;
+
+/** Lane count alignment (number of lanes have to be a multiple of this value) */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int lane_alignment = 1;
+#else
+    enum { lane_alignment = 1 };
+#endif
+
+    /**
+     * Check this operator class is available.
+     * @return whether the class is available
+     */
+    static CXXPH_OPTIONAL_CONSTEXPR bool is_supported() { return true; }
+
+    /**
+     * Constructor.
+     */
+    general_batched_polyphase_core_operator() {}
+
+    /**
+     * Destructor.
+     */
+    ~general_batched_polyphase_core_operator() {}
+
+    /**
+     * Calculate convolution for multiple lanes.
+     *
+     * dest[k] = sum(samples[i * stride + k] * coeffs[i]), (0 <= k < num_lanes, 0 <= i < n)
+     *
+     * @param [out] dest pointer of destination samples (num_lanes)
+     * @param [in] samples pointer of source samples (lane-interleaved, n rows)
+     * @param [in] stride row stride of the source samples [samples]
+     * @param [in] coeffs pointer of coefficients array
+     * @param [in] n length [rows]
+     * @param [in] num_lanes number of lanes (a multiple of lane_alignment)
+     */
+    void convolve(sample_t *CXXPH_RESTRICT dest, const sample_t *CXXPH_RESTRICT samples, int stride,
+                  const coeffs_t *CXXPH_RESTRICT coeffs, int n, int num_lanes) const CXXPH_NOEXCEPT
+    {
+        for (int k = 0; k < num_lanes; ++k) {
+            dest[k] = 0;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            const sample_t c = static_cast<sample_t>(coeffs[i]);
+            const sample_t *CXXPH_RESTRICT s = &samples[i * stride];
+
+            for (int k = 0; k < num_lanes; ++k) {
+                dest[k] += s[k] * c;
+            }
+        }
+    }
+};
+
+// Well-known forms
+typedef general_batched_polyphase_core_operator<float, float> f32_basic_batched_polyphase_core_operator;
+typedef general_batched_polyphase_core_operator<double, float> f64_basic_batched_polyphase_core_operator;
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_RESAMPLER_POLYPHASE_GENERAL_BATCHED_POLYPHASE_CORE_OPERATOR_HPP_
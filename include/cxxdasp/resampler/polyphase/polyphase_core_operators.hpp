@@ -21,18 +21,27 @@
 
 // basic implementation
 #include <cxxdasp/resampler/polyphase/general_polyphase_core_operator.hpp>
+#include <cxxdasp/resampler/polyphase/general_batched_polyphase_core_operator.hpp>
 
 // SSE optimized implementation
 #if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
 #include <cxxdasp/resampler/polyphase/f32_mono_sse_polyphase_core_operator.hpp>
 #include <cxxdasp/resampler/polyphase/f32_mono_sse3_polyphase_core_operator.hpp>
 #include <cxxdasp/resampler/polyphase/f32_stereo_sse_polyphase_core_operator.hpp>
+#include <cxxdasp/resampler/polyphase/f32_sse_batched_polyphase_core_operator.hpp>
+#endif
+
+// AVX2 + FMA optimized implementation
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#include <cxxdasp/resampler/polyphase/f32_mono_avx2_polyphase_core_operator.hpp>
+#include <cxxdasp/resampler/polyphase/f32_stereo_avx2_polyphase_core_operator.hpp>
 #endif
 
 // NEON optimized implementation
 #if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
 #include <cxxdasp/resampler/polyphase/f32_mono_neon_polyphase_core_operator.hpp>
 #include <cxxdasp/resampler/polyphase/f32_stereo_neon_polyphase_core_operator.hpp>
+#include <cxxdasp/resampler/polyphase/f32_neon_batched_polyphase_core_operator.hpp>
 #endif
 
 #endif // CXXDASP_RESAMPLER_POLYPHASE_POLYPHASE_CORE_OPERATORS_HPP_
@@ -30,12 +30,7 @@
 #include <cxxdasp/datatype/audio_frame.hpp>
 #include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
 #include <cxxdasp/utils/utils.hpp>
-
-// FIR delay line alignment
-#define CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE 32
-
-// FIR coefficients alignment
-#define CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE 32
+#include <cxxdasp/utils/mirrored_memory.hpp>
 
 namespace cxxdasp {
 namespace resampler {
@@ -43,6 +38,11 @@ namespace resampler {
 /**
  * Poly-phase FIR based resampler class.
  *
+ * When CXXDASP_USE_MIRRORED_DELAY_LINE is enabled and the platform supports it, the delay line is placed
+ * on a mirror-mapped memory block (see utils::mirrored_memory), so each input frame is written only once.
+ * Otherwise, each input frame is written twice into a double sized delay line. Delay lines smaller than
+ * a page always use the latter way, because the mirror-mapped block would be rounded up to whole pages.
+ *
  * @tparam TSrcFrame source audio frame type
  * @tparam TDestFrame destination audio frame type
  * @tparam TCoeffs FIR coefficient data type
@@ -90,6 +90,8 @@ public:
      *
      * @note {output rate} = (M / L) * {input rate}
      * @note ex.) 44100 -> 48000: M = 160, L = 147
+     * @note the interleaved coefficients table is shared among the instances which are constructed from the same
+     *       coefficients array and the same M.
      */
     polyphase_resampler(const coeffs_t *coeffs, int num_coeffs, int m, int l, int base_block_size);
 
@@ -108,6 +110,7 @@ public:
      *
      * @note {output rate} = (M / L) * {input rate}
      * @note ex.) 44100 -> 48000: M = 160, L = 147
+     * @note copied coefficients tables are shared in the same manner as the not-interleaved constructor does.
      */
     polyphase_resampler(const coeffs_t *interleaved_coeffs, int num_coeffs, bool copy_coeffs, int m, int l,
                         int base_block_size);
@@ -171,29 +174,116 @@ public:
      */
     int num_can_get() const CXXPH_NOEXCEPT;
 
+    /**
+     * Check whether the delay line is placed on a mirror-mapped memory block.
+     *
+     * \return whether the mirror-mapped delay line is used
+     */
+    bool is_delay_line_mirrored() const CXXPH_NOEXCEPT { return static_cast<bool>(mirrored_delay_); }
+
+    //
+    // Advanced APIs
+    //
+
+    /**
+     * Directly refer the internal input buffer (delay line).
+     *
+     * @param s [out] writable buffer pointer
+     * @param n [out] size of contiguous writable space [frames] (n <= num_can_put())
+     *
+     * @note the returned space may be smaller than num_can_put() when it wraps around the delay line.
+     * @sa notify_direct_produced_input_buffer_items()
+     */
+    void refer_direct_input_buffer(src_frame_t **s, int *n) CXXPH_NOEXCEPT;
+
+    /**
+     * Notify directly written data count.
+     *
+     * @param n [in] count of written data [frames]
+     *
+     * @sa refer_direct_input_buffer()
+     */
+    void notify_direct_produced_input_buffer_items(int n) CXXPH_NOEXCEPT;
+
 private:
     /// @cond INTERNAL_FIELD
     typedef polyphase_resampler_utils pprutils;
 
-    static int convolve_n(int m, int subtable_size, dest_frame_t *CXXPH_RESTRICT dest,
-                          const core_operator_type &core_op, const src_frame_t *CXXPH_RESTRICT delay,
-                          const coeffs_t *CXXPH_RESTRICT interleaved_coeffs, int l, int n, int rp) CXXPH_NOEXCEPT
+    static bool use_mirrored_delay_line(int delay_line_size, bool no_filtering) CXXPH_NOEXCEPT
+    {
+#if CXXDASP_USE_MIRRORED_DELAY_LINE
+        const std::size_t page_size = utils::mirrored_memory_allocator::granularity();
+
+        return !no_filtering && (page_size > 0) &&
+               ((sizeof(src_frame_t) * static_cast<std::size_t>(delay_line_size)) >= page_size);
+#else
+        (void)delay_line_size;
+        (void)no_filtering;
+        return false;
+#endif
+    }
+
+    static int calc_actual_delay_line_size(int num_coeffs, int m, int l, int base_block_size,
+                                           bool no_filtering) CXXPH_NOEXCEPT
+    {
+        int n = pprutils::calc_delay_line_size(num_coeffs, m, l, base_block_size);
+
+        if (use_mirrored_delay_line(n, no_filtering)) {
+            // mirror-mapped delay line requires page granularity
+            n = utils::mirrored_memory<src_frame_t>::round_up_size(n);
+        }
+
+        return n;
+    }
+
+    void advance_write_position(int n) CXXPH_NOEXCEPT
+    {
+        write_pos_ = (write_pos_ + n);
+        if (CXXPH_UNLIKELY(write_pos_ >= delay_line_size_)) {
+            write_pos_ -= delay_line_size_;
+        }
+        count_ += (n * m_);
+        assert(count_ <= m_delay_line_size_);
+    }
+
+    static int convolve_n(int m, const pprutils::phase_schedule_entry *CXXPH_RESTRICT schedule, int subtable_size,
+                          dest_frame_t *CXXPH_RESTRICT dest, const core_operator_type &core_op,
+                          const src_frame_t *CXXPH_RESTRICT delay, const coeffs_t *CXXPH_RESTRICT interleaved_coeffs,
+                          int n, int rp) CXXPH_NOEXCEPT
     {
+        // split the read position only once, then walk the phase schedule table
+        int pos = rp / m;
+        int phase = rp - (pos * m);
+        int i = 0;
+
+        for (; (i + 4) <= n; i += 4) {
+            const pprutils::phase_schedule_entry &e0 = schedule[phase];
+            core_op.convolve(&dest[i + 0], &delay[pos], &interleaved_coeffs[e0.coeffs_offset], subtable_size);
+            pos += e0.delay_advance;
+
+            const pprutils::phase_schedule_entry &e1 = schedule[e0.next_phase];
+            core_op.convolve(&dest[i + 1], &delay[pos], &interleaved_coeffs[e1.coeffs_offset], subtable_size);
+            pos += e1.delay_advance;
 
-        const float inv_m = 1.0f / m;
+            const pprutils::phase_schedule_entry &e2 = schedule[e1.next_phase];
+            core_op.convolve(&dest[i + 2], &delay[pos], &interleaved_coeffs[e2.coeffs_offset], subtable_size);
+            pos += e2.delay_advance;
 
-        for (int i = 0; i < n; ++i) {
-            // const int rp_div_m = rp / m;     // <-- this is very SLOW (!)
-            const int rp_div_m = static_cast<int>(rp * inv_m);
-            const int subtable_index = ((m - 1) - (rp - rp_div_m * m));
-            const src_frame_t *CXXPH_RESTRICT data = &delay[rp_div_m];
-            const coeffs_t *CXXPH_RESTRICT coeffs = &interleaved_coeffs[subtable_index * subtable_size];
+            const pprutils::phase_schedule_entry &e3 = schedule[e2.next_phase];
+            core_op.convolve(&dest[i + 3], &delay[pos], &interleaved_coeffs[e3.coeffs_offset], subtable_size);
+            pos += e3.delay_advance;
 
-            core_op.convolve(&dest[i], data, coeffs, subtable_size);
-            rp += l;
+            phase = e3.next_phase;
         }
 
-        return rp;
+        for (; i < n; ++i) {
+            const pprutils::phase_schedule_entry &e = schedule[phase];
+            core_op.convolve(&dest[i], &delay[pos], &interleaved_coeffs[e.coeffs_offset], subtable_size);
+            pos += e.delay_advance;
+            phase = e.next_phase;
+        }
+
+        return (pos * m) + phase;
     }
 
 private:
@@ -216,10 +306,13 @@ private:
     bool flushed_;
 
     const coeffs_t *interleaved_coeffs_;
+    const pprutils::phase_schedule_entry *phase_schedule_;
     src_frame_t *delay_;
 
-    cxxporthelper::aligned_memory<coeffs_t> mem_interleaved_coeffs_;
+    std::shared_ptr<const coeffs_t> shared_interleaved_coeffs_;
     cxxporthelper::aligned_memory<src_frame_t> mem_delay_;
+    utils::mirrored_memory<src_frame_t> mirrored_delay_;
+    cxxporthelper::aligned_memory<pprutils::phase_schedule_entry> mem_phase_schedule_;
     /// @endcond
 };
 
@@ -232,31 +325,43 @@ inline polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::p
       sparse_copy_(std::is_same<src_frame_t, dest_frame_t>::value &&
                    pprutils::check_is_sparse_copy(coeffs, num_coeffs, m, l)),
       interleaved_coeffs_subtable_size_(pprutils::calc_interleaved_coeffs_subtable_size(num_coeffs, m)),
-      delay_line_size_(pprutils::calc_delay_line_size(num_coeffs_, m, l, base_block_size)),
-      m_delay_line_size_(delay_line_size_), count_(0), write_pos_(0), read_pos_(0), flushed_(false),
-      interleaved_coeffs_(nullptr), delay_(nullptr)
+      delay_line_size_(
+          calc_actual_delay_line_size(num_coeffs_, m, l, base_block_size, (pass_through_ || sparse_copy_))),
+      m_delay_line_size_(m_ * delay_line_size_), count_(0), write_pos_(0), read_pos_(0), flushed_(false),
+      interleaved_coeffs_(nullptr), phase_schedule_(nullptr), delay_(nullptr)
 {
     // allocate memory blocks
     cxxporthelper::aligned_memory<src_frame_t> mem_delay;
-    cxxporthelper::aligned_memory<coeffs_t> mem_interleaved_coeffs;
+    utils::mirrored_memory<src_frame_t> mirrored_delay;
+    cxxporthelper::aligned_memory<pprutils::phase_schedule_entry> mem_phase_schedule;
+    std::shared_ptr<const coeffs_t> shared_interleaved_coeffs;
 
-    mem_delay.allocate((delay_line_size_ * ((pass_through_ || sparse_copy_) ? 1 : 2)),
-                       CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    if (use_mirrored_delay_line(delay_line_size_, (pass_through_ || sparse_copy_))) {
+        mirrored_delay.allocate(delay_line_size_);
+    }
+
+    if (!mirrored_delay) {
+        mem_delay.allocate((delay_line_size_ * ((pass_through_ || sparse_copy_) ? 1 : 2)),
+                           CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    }
 
     if (!(pass_through_ || sparse_copy_)) {
-        mem_interleaved_coeffs.allocate((interleaved_coeffs_subtable_size_ * m_),
-                                        CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+        mem_phase_schedule.allocate(m_);
+        pprutils::make_phase_schedule_table(m_, l_, interleaved_coeffs_subtable_size_, &mem_phase_schedule[0]);
 
-        // make interleaved coefficient array
-        pprutils::make_interleaved_coeffs_table(coeffs, num_coeffs_, m_, &mem_interleaved_coeffs[0]);
+        // make (or share already made) interleaved coefficient array
+        shared_interleaved_coeffs = pprutils::acquire_shared_interleaved_coeffs_table(coeffs, num_coeffs_, m_, false);
     }
 
     // update fields
-    mem_interleaved_coeffs_ = std::move(mem_interleaved_coeffs);
+    shared_interleaved_coeffs_ = std::move(shared_interleaved_coeffs);
     mem_delay_ = std::move(mem_delay);
+    mirrored_delay_ = std::move(mirrored_delay);
+    mem_phase_schedule_ = std::move(mem_phase_schedule);
 
-    delay_ = &mem_delay_[0];
-    interleaved_coeffs_ = &mem_interleaved_coeffs_[0];
+    delay_ = (mirrored_delay_) ? mirrored_delay_.get() : &mem_delay_[0];
+    phase_schedule_ = (mem_phase_schedule_.size() > 0) ? &mem_phase_schedule_[0] : nullptr;
+    interleaved_coeffs_ = shared_interleaved_coeffs_.get();
 
     // reset states
     reset();
@@ -266,41 +371,54 @@ template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TP
 inline polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::polyphase_resampler(
     const coeffs_t *interleaved_coeffs, int num_coeffs, bool copy_coeffs, int m, int l, int base_block_size)
     : core_operator_(), num_coeffs_(num_coeffs), m_(m), l_(l),
-      interleaved_coeffs_subtable_size_(pprutils::calc_interleaved_coeffs_subtable_size(num_coeffs, m)),
-      delay_line_size_(pprutils::calc_delay_line_size(num_coeffs_, m, l, base_block_size)),
-      m_delay_line_size_(m_ * delay_line_size_),
       pass_through_(std::is_same<src_frame_t, dest_frame_t>::value &&
                     pprutils::check_is_pass_through(interleaved_coeffs, num_coeffs, m, l)),
       sparse_copy_(std::is_same<src_frame_t, dest_frame_t>::value &&
                    pprutils::check_is_sparse_copy(interleaved_coeffs, num_coeffs, m, l)),
-      count_(0), write_pos_(0), read_pos_(0), flushed_(false), interleaved_coeffs_(nullptr), delay_(nullptr)
+      interleaved_coeffs_subtable_size_(pprutils::calc_interleaved_coeffs_subtable_size(num_coeffs, m)),
+      delay_line_size_(
+          calc_actual_delay_line_size(num_coeffs_, m, l, base_block_size, (pass_through_ || sparse_copy_))),
+      m_delay_line_size_(m_ * delay_line_size_), count_(0), write_pos_(0), read_pos_(0), flushed_(false),
+      interleaved_coeffs_(nullptr), phase_schedule_(nullptr), delay_(nullptr)
 {
     // allocate memory blocks
     cxxporthelper::aligned_memory<src_frame_t> mem_delay;
-    cxxporthelper::aligned_memory<coeffs_t> mem_interleaved_coeffs;
+    utils::mirrored_memory<src_frame_t> mirrored_delay;
+    cxxporthelper::aligned_memory<pprutils::phase_schedule_entry> mem_phase_schedule;
+    std::shared_ptr<const coeffs_t> shared_interleaved_coeffs;
 
-    mem_delay.allocate((delay_line_size_ * ((pass_through_ || sparse_copy_) ? 1 : 2)),
-                       CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    if (use_mirrored_delay_line(delay_line_size_, (pass_through_ || sparse_copy_))) {
+        mirrored_delay.allocate(delay_line_size_);
+    }
+
+    if (!mirrored_delay) {
+        mem_delay.allocate((delay_line_size_ * ((pass_through_ || sparse_copy_) ? 1 : 2)),
+                           CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    }
 
     if (!(pass_through_ || sparse_copy_)) {
+        mem_phase_schedule.allocate(m_);
+        pprutils::make_phase_schedule_table(m_, l_, interleaved_coeffs_subtable_size_, &mem_phase_schedule[0]);
+
         if (copy_coeffs || ((reinterpret_cast<uintptr_t>(interleaved_coeffs) %
                              CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE) != 0)) {
-            mem_interleaved_coeffs.allocate((interleaved_coeffs_subtable_size_ * m_),
-                                            CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+            // make (or share already made) a copy of the passed coefficients array
+            shared_interleaved_coeffs =
+                pprutils::acquire_shared_interleaved_coeffs_table(interleaved_coeffs, num_coeffs_, m_, true);
         }
     }
 
     // update fields
-    mem_interleaved_coeffs_ = std::move(mem_interleaved_coeffs);
+    shared_interleaved_coeffs_ = std::move(shared_interleaved_coeffs);
     mem_delay_ = std::move(mem_delay);
+    mirrored_delay_ = std::move(mirrored_delay);
+    mem_phase_schedule_ = std::move(mem_phase_schedule);
 
-    delay_ = &mem_delay_[0];
+    delay_ = (mirrored_delay_) ? mirrored_delay_.get() : &mem_delay_[0];
+    phase_schedule_ = (mem_phase_schedule_.size() > 0) ? &mem_phase_schedule_[0] : nullptr;
 
-    if (mem_interleaved_coeffs) {
-        // make a copy of the passed coefficients array
-        utils::fast_pod_copy(&mem_interleaved_coeffs[0], &interleaved_coeffs[0], num_coeffs_);
-
-        interleaved_coeffs_ = &mem_interleaved_coeffs[0];
+    if (shared_interleaved_coeffs_) {
+        interleaved_coeffs_ = shared_interleaved_coeffs_.get();
     } else {
         // just hold the passed coefficients array
         // (have to manage the life time of the array outside of this class!)
@@ -319,7 +437,9 @@ inline polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::~
 template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
 inline void polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::reset() CXXPH_NOEXCEPT
 {
-    for (int i = 0; i < mem_delay_.size(); ++i) {
+    const int num_delay_frames = (mirrored_delay_) ? mirrored_delay_.size() : static_cast<int>(mem_delay_.size());
+
+    for (int i = 0; i < num_delay_frames; ++i) {
         delay_[i] = 0.0f;
     }
 
@@ -388,7 +508,10 @@ inline void polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperato
 
     int n_append;
 
-    if (pass_through_ || sparse_copy_) {
+    if (mirrored_delay_) {
+        // the mirrored region absorbs the wrap around
+        ::memcpy(&(delay_[write_pos_]), &(s[0]), (sizeof(src_frame_t) * n));
+    } else if (pass_through_ || sparse_copy_) {
         if (CXXPH_LIKELY(n1 > 0)) {
             ::memcpy(&(delay_[write_pos_]), &(s[0]), (sizeof(src_frame_t) * n1));
         }
@@ -408,12 +531,47 @@ inline void polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperato
         }
     }
 
-    write_pos_ = (write_pos_ + n);
-    if (CXXPH_UNLIKELY(write_pos_ >= delay_line_size_)) {
-        write_pos_ -= delay_line_size_;
+    advance_write_position(n);
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void
+polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::refer_direct_input_buffer(src_frame_t **s,
+                                                                                              int *n) CXXPH_NOEXCEPT
+{
+    assert(s);
+    assert(n);
+
+    const int n_can_put = num_can_put();
+
+    (*s) = &(delay_[write_pos_]);
+
+    if (mirrored_delay_) {
+        // the mirrored region absorbs the wrap around
+        (*n) = n_can_put;
+    } else {
+        (*n) = (std::min)(n_can_put, (delay_line_size_ - write_pos_));
+    }
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void
+polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::notify_direct_produced_input_buffer_items(
+    int n) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+    assert(mirrored_delay_ || (n <= (delay_line_size_ - write_pos_)));
+
+    if (CXXPH_UNLIKELY(n <= 0)) {
+        return;
+    }
+
+    if (!(mirrored_delay_ || pass_through_ || sparse_copy_)) {
+        // fill the latter half of the delay line
+        ::memcpy(&(delay_[delay_line_size_ + write_pos_]), &(delay_[write_pos_]), (sizeof(src_frame_t) * n));
     }
-    count_ += (n * m_);
-    assert(count_ <= m_delay_line_size_);
+
+    advance_write_position(n);
 }
 
 template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
@@ -454,8 +612,8 @@ inline void polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperato
             rp += (n2 * l_);
         }
     } else {
-        rp = convolve_n(m_, interleaved_coeffs_subtable_size_, d, core_operator_, delay_, interleaved_coeffs_, l_, n,
-                        rp);
+        rp = convolve_n(m_, phase_schedule_, interleaved_coeffs_subtable_size_, d, core_operator_, delay_,
+                        interleaved_coeffs_, n, rp);
     }
 
     if (CXXPH_UNLIKELY(rp >= m_delay_line_size_)) {
@@ -18,6 +18,15 @@
 #define CXXDASP_RESAMPLER_POLYPHASE_POLYPHASE_RESAMPER_UTILS_HPP_
 
 #include <cstddef>
+#include <memory>
+
+#include <cxxporthelper/cstdint>
+
+// FIR delay line alignment
+#define CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE 32
+
+// FIR coefficients alignment
+#define CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE 32
 
 namespace cxxdasp {
 namespace resampler {
@@ -36,6 +45,32 @@ public:
     static void make_interleaved_coeffs_table(const float *src_coeffs, int num_src_coeffs, int m, float *dest_coeffs);
     static void make_interleaved_coeffs_table(const double *src_coeffs, int num_src_coeffs, int m, double *dest_coeffs);
 
+    // phase schedule table (indexed by the current phase [0, M))
+    struct phase_schedule_entry {
+        int coeffs_offset; // offset of the sub table in the interleaved coefficients table
+        int delay_advance; // delay line advance after this output [frames]
+        int next_phase;    // phase of the next output
+    };
+
+    static void make_phase_schedule_table(int m, int l, int subtable_size, phase_schedule_entry *dest_table);
+
+    static std::shared_ptr<const float> acquire_shared_interleaved_coeffs_table(const float *src_coeffs,
+                                                                                int num_src_coeffs, int m,
+                                                                                bool src_is_interleaved);
+    static std::shared_ptr<const double> acquire_shared_interleaved_coeffs_table(const double *src_coeffs,
+                                                                                 int num_src_coeffs, int m,
+                                                                                 bool src_is_interleaved);
+
+    // hash function used for bucketing the shared tables (replaceable for testing, nullptr: default)
+    typedef uint64_t (*coeffs_hash_func_t)(const void *data, size_t size);
+    static coeffs_hash_func_t set_shared_coeffs_table_hash_func(coeffs_hash_func_t func);
+
+    static int calc_variable_ratio_coeffs_subtable_stride(int num_coeffs, int num_phases, size_t coeffs_size);
+    static void make_variable_ratio_coeffs_table(const float *src_coeffs, int num_src_coeffs, int num_phases,
+                                                 float *dest_coeffs);
+    static void make_variable_ratio_coeffs_table(const double *src_coeffs, int num_src_coeffs, int num_phases,
+                                                 double *dest_coeffs);
+
     static bool check_is_pass_through(const float *src_coeffs, int num_src_coeffs, int m, int l);
     static bool check_is_pass_through(const double *src_coeffs, int num_src_coeffs, int m, int l);
 
@@ -0,0 +1,433 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_RESAMPLER_POLYPHASE_VARIABLE_RATIO_POLYPHASE_RESAMPLER_HPP_
+#define CXXDASP_RESAMPLER_POLYPHASE_VARIABLE_RATIO_POLYPHASE_RESAMPLER_HPP_
+
+#include <cassert>
+#include <cstring>
+
+#include <cxxporthelper/type_traits>
+#include <cxxporthelper/utility>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/cxxdasp_config.hpp>
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Variable ratio poly-phase FIR based resampler class.
+ *
+ * This resampler accepts a fractional resampling ratio which can be changed at runtime (ex. to track a clock drift
+ * between two audio devices). The output samples are calculated by linear interpolation between the two
+ * neighboring poly-phase sub filters.
+ *
+ * @tparam TSrcFrame source audio frame type
+ * @tparam TDestFrame destination audio frame type
+ * @tparam TCoeffs FIR coefficient data type
+ * @tparam TPolyCoreOperator core operator class type
+ */
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, class TPolyCoreOperator>
+class variable_ratio_polyphase_resampler {
+    // validate template parameters
+    static_assert(std::is_same<TSrcFrame, typename TPolyCoreOperator::src_frame_t>::value,
+                  "source frame type is different");
+    static_assert(std::is_same<TDestFrame, typename TPolyCoreOperator::dest_frame_t>::value,
+                  "source frame type is different");
+    static_assert(std::is_same<TCoeffs, typename TPolyCoreOperator::coeffs_t>::value,
+                  "FIR coefficient type is different");
+
+    /// @cond INTERNAL_FIELD
+    variable_ratio_polyphase_resampler(const variable_ratio_polyphase_resampler &) = delete;
+    variable_ratio_polyphase_resampler &operator=(const variable_ratio_polyphase_resampler &) = delete;
+    /// @endcond
+
+public:
+    /** Data type of source audio frame */
+    typedef TSrcFrame src_frame_t;
+
+    /** Data type of destination audio frame */
+    typedef TDestFrame dest_frame_t;
+
+    /** Data type of FIR coefficients */
+    typedef TCoeffs coeffs_t;
+
+    /** Operator */
+    typedef TPolyCoreOperator core_operator_type;
+
+    /**
+     * Constructor.
+     *
+     * @param [in] coeffs prototype FIR coefficients (designed for the {num_phases} times oversampled rate)
+     * @param [in] num_coeffs number of FIR coefficients
+     * @param [in] num_phases number of poly-phase sub filters (= oversampling ratio of the prototype filter)
+     * @param [in] ratio initial resampling ratio ({output rate} / {input rate})
+     * @param [in] base_block_size specify additional internal delay line size to improve efficiency (1 >) [frames]
+     *
+     * @note the cutoff frequency of the prototype filter has to be lower than the Nyquist frequency of both input
+     *       and output rate, so the ratio is expected to stay close to the designed one.
+     */
+    variable_ratio_polyphase_resampler(const coeffs_t *coeffs, int num_coeffs, int num_phases, double ratio,
+                                       int base_block_size);
+
+    /**
+     * Destructor.
+     */
+    ~variable_ratio_polyphase_resampler();
+
+    /**
+     * Reset internal state.
+     *
+     * @note the resampling ratio is not changed.
+     */
+    void reset() CXXPH_NOEXCEPT;
+
+    /**
+     * Flush internal buffer.
+     *
+     * @note call this function when after all source data put into the resampler.
+     */
+    void flush() CXXPH_NOEXCEPT;
+
+    /**
+     * Set resampling ratio.
+     *
+     * @param [in] ratio new resampling ratio ({output rate} / {input rate}, 0 <)
+     * @param [in] ramp_length transition length [output frames], the ratio changes immediately if 0
+     */
+    void set_ratio(double ratio, int ramp_length = 0) CXXPH_NOEXCEPT;
+
+    /**
+     * Get current resampling ratio.
+     *
+     * @returns current resampling ratio ({output rate} / {input rate})
+     */
+    double get_ratio() const CXXPH_NOEXCEPT;
+
+    /**
+     * Put multiple audio frames.
+     *
+     * @param [in] s pointer of source audio frames
+     * @param [in] n count of source audio frames (n <= num_can_put())
+     *
+     * @sa num_can_put()
+     */
+    void put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get multiple resampled audio frames.
+     *
+     * @param [out] d pointer of resampled audio frames
+     * @param [in] n count of resample audio frames (n <= num_can_get())
+     *
+     * @sa num_can_get()
+     */
+    void get_n(dest_frame_t *d, int n) CXXPH_NOEXCEPT;
+
+    /**
+     * Get available free buffer space size.
+     *
+     * \return available buffer space size [frames]
+     *
+     * @sa put_n()
+     */
+    int num_can_put() const CXXPH_NOEXCEPT;
+
+    /**
+     * Get resampling-ready frame count.
+     *
+     * \return resampling-ready count [frames]
+     *
+     * @sa get_n()
+     *
+     * @note the returned value is a conservative estimation while the ratio is changing.
+     */
+    int num_can_get() const CXXPH_NOEXCEPT;
+
+private:
+    /// @cond INTERNAL_FIELD
+    typedef polyphase_resampler_utils pprutils;
+    typedef typename dest_frame_t::data_type dest_data_t;
+
+    const core_operator_type core_operator_;
+    const int num_coeffs_;
+    const int num_phases_;
+    const int subtable_size_;
+    const int subtable_stride_;
+    const int delay_line_size_;
+
+    int count_;
+    int write_pos_;
+    int read_pos_;
+    double frac_;
+    double step_;
+    double target_step_;
+    double step_delta_;
+    int ramp_remains_;
+    bool flushed_;
+
+    coeffs_t *coeffs_;
+    src_frame_t *delay_;
+
+    cxxporthelper::aligned_memory<coeffs_t> mem_coeffs_;
+    cxxporthelper::aligned_memory<src_frame_t> mem_delay_;
+    /// @endcond
+};
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::
+    variable_ratio_polyphase_resampler(const coeffs_t *coeffs, int num_coeffs, int num_phases, double ratio,
+                                       int base_block_size)
+    : core_operator_(), num_coeffs_(num_coeffs), num_phases_(num_phases),
+      subtable_size_(pprutils::calc_interleaved_coeffs_subtable_size(num_coeffs, num_phases)),
+      subtable_stride_(pprutils::calc_variable_ratio_coeffs_subtable_stride(num_coeffs, num_phases, sizeof(coeffs_t))),
+      delay_line_size_(pprutils::calc_delay_line_size(subtable_size_, 1, 1, base_block_size)), count_(0),
+      write_pos_(0), read_pos_(0), frac_(0.0), step_(1.0 / ratio), target_step_(1.0 / ratio), step_delta_(0.0),
+      ramp_remains_(0), flushed_(false), coeffs_(nullptr), delay_(nullptr)
+{
+    assert(ratio > 0.0);
+
+    // allocate memory blocks
+    cxxporthelper::aligned_memory<src_frame_t> mem_delay;
+    cxxporthelper::aligned_memory<coeffs_t> mem_coeffs;
+
+    mem_delay.allocate((delay_line_size_ * 2), CXXDASP_POLYPHASE_RESAMPLER_DELAY_LINE_ALIGN_SIZE);
+    mem_coeffs.allocate((subtable_stride_ * (num_phases_ + 1)), CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+
+    // make (num_phases + 1) sub tables
+    pprutils::make_variable_ratio_coeffs_table(coeffs, num_coeffs_, num_phases_, &mem_coeffs[0]);
+
+    // update fields
+    mem_coeffs_ = std::move(mem_coeffs);
+    mem_delay_ = std::move(mem_delay);
+
+    coeffs_ = &mem_coeffs_[0];
+    delay_ = &mem_delay_[0];
+
+    // reset states
+    reset();
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs,
+                                          TPolyCoreOperator>::~variable_ratio_polyphase_resampler()
+{
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::reset()
+    CXXPH_NOEXCEPT
+{
+    for (int i = 0; i < static_cast<int>(mem_delay_.size()); ++i) {
+        delay_[i] = 0.0f;
+    }
+
+    // pre-fill a half of the delay line with zeros (to reduce the latency)
+    count_ = subtable_size_ / 2;
+    write_pos_ = subtable_size_ / 2;
+    read_pos_ = 0;
+    frac_ = 0.0;
+
+    // finish the current transition
+    step_ = target_step_;
+    step_delta_ = 0.0;
+    ramp_remains_ = 0;
+
+    flushed_ = false;
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::flush()
+    CXXPH_NOEXCEPT
+{
+    if (CXXPH_UNLIKELY(flushed_)) {
+        return;
+    }
+
+    // push out the remaining frames
+    int k = subtable_size_ - (subtable_size_ / 2);
+    const int c = num_can_put();
+
+    if (k > c) {
+        k = c;
+    }
+
+    const src_frame_t zero_pad(0.0f);
+    for (int i = 0; i < k; ++i) {
+        put_n(&zero_pad, 1);
+    }
+
+    flushed_ = true;
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::set_ratio(
+    double ratio, int ramp_length) CXXPH_NOEXCEPT
+{
+    assert(ratio > 0.0);
+
+    target_step_ = 1.0 / ratio;
+
+    if (ramp_length > 0) {
+        step_delta_ = (target_step_ - step_) / ramp_length;
+        ramp_remains_ = ramp_length;
+    } else {
+        step_ = target_step_;
+        step_delta_ = 0.0;
+        ramp_remains_ = 0;
+    }
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline double variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::get_ratio() const
+    CXXPH_NOEXCEPT
+{
+    return 1.0 / step_;
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::put_n(
+    const src_frame_t *s, int n) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_put());
+
+    const int dn = (delay_line_size_ - write_pos_);
+    int n1, n2;
+
+    if (CXXPH_LIKELY(dn >= n)) {
+        n1 = n;
+        n2 = 0;
+    } else {
+        n1 = dn;
+        n2 = (n - n1);
+    }
+
+    if (CXXPH_LIKELY(n1 > 0)) {
+        core_operator_.dual_copy(&(delay_[(0 * delay_line_size_) + write_pos_]),
+                                 &(delay_[(1 * delay_line_size_) + write_pos_]), &(s[0]), n1);
+    }
+
+    if (CXXPH_UNLIKELY(n2 > 0)) {
+        core_operator_.dual_copy(&(delay_[(0 * delay_line_size_) + 0]), &(delay_[(1 * delay_line_size_) + 0]),
+                                 &(s[n1]), n2);
+    }
+
+    write_pos_ = (write_pos_ + n);
+    if (CXXPH_UNLIKELY(write_pos_ >= delay_line_size_)) {
+        write_pos_ -= delay_line_size_;
+    }
+    count_ += n;
+    assert(count_ <= delay_line_size_);
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline void variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::get_n(
+    dest_frame_t *d, int n) CXXPH_NOEXCEPT
+{
+    assert(n <= num_can_get());
+
+    const int num_phases = num_phases_;
+    const int subtable_size = subtable_size_;
+    const int subtable_stride = subtable_stride_;
+    const coeffs_t *CXXPH_RESTRICT coeffs = coeffs_;
+
+    int rp = read_pos_;
+    double frac = frac_;
+    double step = step_;
+
+    for (int i = 0; i < n; ++i) {
+        const double phase = frac * num_phases;
+        int branch = static_cast<int>(phase);
+        if (CXXPH_UNLIKELY(branch >= num_phases)) {
+            branch = num_phases - 1;
+        }
+        const dest_data_t mu = static_cast<dest_data_t>(phase - branch);
+
+        const src_frame_t *CXXPH_RESTRICT data = &delay_[rp];
+        const coeffs_t *CXXPH_RESTRICT c0 = &coeffs[subtable_stride * branch];
+        const coeffs_t *CXXPH_RESTRICT c1 = &coeffs[subtable_stride * (branch + 1)];
+
+        dest_frame_t y0, y1;
+        core_operator_.convolve(&y0, data, c0, subtable_size);
+        core_operator_.convolve(&y1, data, c1, subtable_size);
+
+        // interpolate between the neighboring sub filters
+        y1 -= y0;
+        y1 *= mu;
+        y0 += y1;
+        d[i] = y0;
+
+        // advance
+        if (CXXPH_UNLIKELY(ramp_remains_ > 0)) {
+            step += step_delta_;
+            if (--ramp_remains_ == 0) {
+                step = target_step_;
+            }
+        }
+
+        frac += step;
+        const int advance = static_cast<int>(frac);
+        frac -= advance;
+
+        rp += advance;
+        if (CXXPH_UNLIKELY(rp >= delay_line_size_)) {
+            rp -= delay_line_size_;
+        }
+        count_ -= advance;
+    }
+
+    read_pos_ = rp;
+    frac_ = frac;
+    step_ = step;
+
+    assert(count_ >= 0);
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline int variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::num_can_put() const
+    CXXPH_NOEXCEPT
+{
+    if (CXXPH_LIKELY(!flushed_)) {
+        return (delay_line_size_ - count_);
+    } else {
+        return 0;
+    }
+}
+
+template <typename TSrcFrame, typename TDestFrame, typename TCoeffs, typename TPolyCoreOperator>
+inline int variable_ratio_polyphase_resampler<TSrcFrame, TDestFrame, TCoeffs, TPolyCoreOperator>::num_can_get() const
+    CXXPH_NOEXCEPT
+{
+    // the i-th output requires (frac + i * step) < (count - subtable_size + 1)
+    const double avail = (count_ - subtable_size_ + 1) - frac_;
+
+    if (avail <= 0.0) {
+        return 0;
+    }
+
+    const double max_step = (step_ >= target_step_) ? step_ : target_step_;
+
+    return static_cast<int>((avail - 1.0e-9) / max_step) + 1;
+}
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_RESAMPLER_POLYPHASE_VARIABLE_RATIO_POLYPHASE_RESAMPLER_HPP_
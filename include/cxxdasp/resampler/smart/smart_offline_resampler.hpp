@@ -0,0 +1,391 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_RESAMPLER_SMART_SMART_OFFLINE_RESAMPLER_HPP_
+#define CXXDASP_RESAMPLER_SMART_SMART_OFFLINE_RESAMPLER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+#include <cxxporthelper/memory>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/resampler/smart/smart_resampler.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler_params.hpp>
+#include <cxxdasp/utils/utils.hpp>
+
+namespace cxxdasp {
+namespace resampler {
+
+/**
+ * Chunk-parallel offline resampler
+ *
+ * Resamples a whole input buffer on multiple threads. The input is split into chunks at multiples of
+ * smart_resampler::calc_input_period(), and each chunk is processed by its own smart_resampler instance after
+ * warming up with the preceding input frames (overlap). The output is bit-identical to the one of a single
+ * smart_resampler which processes the whole input and then is flushed.
+ *
+ * @tparam Tsrc source audio frame type
+ * @tparam TDest destination audio frame type
+ * @tparam THBFRCoreOperator halfband x2 resampler core operator class
+ * @tparam TFFTBackend FFT backend class
+ * @tparam TPolyCoreOperator polyphase filter core operator class
+ */
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+class smart_offline_resampler {
+
+    /// @cond INTERNAL_FIELD
+    smart_offline_resampler(const smart_offline_resampler &) = delete;
+    smart_offline_resampler &operator=(const smart_offline_resampler &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Source audio frame type.
+     */
+    typedef TSrc src_frame_t;
+
+    /**
+     * Destination audio frame type.
+     */
+    typedef TDest dest_frame_t;
+
+    /**
+     * Streaming resampler type.
+     */
+    typedef smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator> resampler_type;
+
+    /**
+     * Constructor.
+     *
+     * @param params [in] parameters
+     * @param num_threads [in] count of worker threads (0: use std::thread::hardware_concurrency())
+     * @param chunk_size [in] input chunk size [frames] (0: auto, rounded up to a multiple of input_period())
+     */
+    smart_offline_resampler(const smart_resampler_params &params, int num_threads = 0, int chunk_size = 0);
+
+    /**
+     * Destructor.
+     */
+    ~smart_offline_resampler();
+
+    /**
+     * Resample whole of the input data.
+     *
+     * @param src [in] source data buffer
+     * @param n_src [in] count of source data
+     * @param dest [out] destination data buffer
+     * @param n_dest [in] capacity of the destination data buffer
+     * @returns count of written data
+     *
+     * @note the result is the same as the one of the following streaming processing;
+     *       put all of the source data, call flush(), and get data until the resampler is finished
+     *       or the destination buffer gets full.
+     */
+    int process(const src_frame_t *src, int n_src, dest_frame_t *dest, int n_dest);
+
+    /**
+     * Get count of worker threads.
+     * @returns count of worker threads
+     */
+    int num_threads() const CXXPH_NOEXCEPT { return static_cast<int>(workers_.size()); }
+
+    /**
+     * Get chunk boundary alignment.
+     * @returns chunk boundary alignment [frames]
+     */
+    int input_period() const CXXPH_NOEXCEPT { return period_; }
+
+    /**
+     * Get count of overlapped input frames per chunk.
+     * @returns count of overlapped frames
+     */
+    int overlap() const CXXPH_NOEXCEPT { return overlap_; }
+
+private:
+    /// @cond INTERNAL_FIELD
+    enum { work_buffer_size = 1024, };
+
+    struct chunk_info {
+        int src_begin;     // first input frame of the chunk
+        int warmup_begin;  // first input frame fed to the resampler (src_begin - overlap)
+        int dest_begin;    // first output frame of the chunk
+        int dest_end;      // end of the output frames of the chunk
+        int num_written;   // count of written output frames
+    };
+
+    struct worker_context {
+        std::unique_ptr<resampler_type> resampler;
+        cxxporthelper::aligned_memory<dest_frame_t> work;
+    };
+
+    long long calc_num_outputs(long long n_src) const CXXPH_NOEXCEPT;
+    int round_up_to_period(long long n) const CXXPH_NOEXCEPT;
+    void process_chunk(worker_context &wc, chunk_info &c, const src_frame_t *src, int n_src,
+                       dest_frame_t *dest) CXXPH_NOEXCEPT;
+    void run_worker(worker_context &wc, std::atomic<int> &next_chunk, std::vector<chunk_info> &chunks,
+                    const src_frame_t *src, int n_src, dest_frame_t *dest) CXXPH_NOEXCEPT;
+
+    int period_;
+    int overlap_;
+    int chunk_size_;
+    long long ratio_num_;
+    long long ratio_den_;
+    std::vector<std::unique_ptr<worker_context>> workers_;
+    /// @endcond
+};
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::smart_offline_resampler(
+    const smart_resampler_params &params, int num_threads, int chunk_size)
+    : period_(1), overlap_(0), chunk_size_(0), ratio_num_(1), ratio_den_(1), workers_()
+{
+    const smart_resampler_params::stage1_x2_fir_info &s1 = params.stage1;
+    const smart_resampler_params::stage2_poly_fir_info &s2 = params.stage2;
+
+    if (num_threads <= 0) {
+        num_threads = (std::max)(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // output frames per input frame
+    int num = 1;
+    int den = 1;
+
+    if (params.have_stage1) {
+        if (s1.use_halfband_decimator) {
+            den *= s1.decimation_factor();
+        } else {
+            num *= 2;
+        }
+    }
+
+    if (params.have_stage2) {
+        num *= s2.m;
+        den *= s2.l;
+    }
+
+    const int g = utils::gcd(num, den);
+
+    period_ = resampler_type::calc_input_period(params);
+    ratio_num_ = (num / g);
+    ratio_den_ = (den / g);
+
+    // filter history required to reproduce the streaming state [input frames]
+    int history = 16;
+
+    if (params.have_stage1) {
+        if (s1.use_halfband_decimator) {
+            // the last decimator stage runs at (input freq. / 2 ^ (num_decimator_stages - 1))
+            history += 4 * (std::max)(s1.n_coeffs, s1.n_pre_coeffs) * (s1.decimation_factor() / 2);
+        } else {
+            history += 4 * s1.n_coeffs;
+        }
+    }
+    if (params.have_stage2) {
+        history += 2 * ((s2.n_coeffs / s2.m) + 1);
+    }
+
+    overlap_ = round_up_to_period(history);
+
+    if (chunk_size > 0) {
+        chunk_size_ = round_up_to_period(chunk_size);
+    } else {
+        chunk_size_ = 0; // decided in process()
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        std::unique_ptr<worker_context> wc(new worker_context());
+
+        wc->resampler.reset(new resampler_type(params));
+        wc->work.allocate(work_buffer_size);
+
+        workers_.push_back(std::move(wc));
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend,
+                               TPolyCoreOperator>::~smart_offline_resampler()
+{
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::process(
+    const src_frame_t *src, int n_src, dest_frame_t *dest, int n_dest)
+{
+    if (n_src <= 0 || n_dest <= 0) {
+        return 0;
+    }
+
+    const int n_threads = num_threads();
+
+    // split into chunks
+    int chunk_size = chunk_size_;
+
+    if (chunk_size == 0) {
+        const long long n_per_chunk = (n_src + (4LL * n_threads) - 1) / (4LL * n_threads);
+        chunk_size = (std::max)(round_up_to_period(n_per_chunk), 4 * overlap_);
+    }
+
+    std::vector<chunk_info> chunks;
+
+    for (int src_begin = 0; src_begin < n_src; src_begin += (std::min)(chunk_size, n_src - src_begin)) {
+        const bool is_last = (n_src - src_begin) <= chunk_size;
+        chunk_info c;
+
+        c.src_begin = src_begin;
+        c.warmup_begin = (std::max)(0, src_begin - overlap_);
+        c.dest_begin = static_cast<int>((std::min)(static_cast<long long>(n_dest), calc_num_outputs(src_begin)));
+        c.dest_end = (is_last) ? n_dest : static_cast<int>((std::min)(static_cast<long long>(n_dest),
+                                                                      calc_num_outputs(src_begin + chunk_size)));
+        c.num_written = 0;
+
+        chunks.push_back(c);
+
+        if (c.dest_end >= n_dest) {
+            break;
+        }
+    }
+
+    // process chunks (the caller thread is also used as a worker)
+    std::atomic<int> next_chunk(0);
+    std::vector<std::thread> threads;
+
+    const int n_workers = (std::min)(n_threads, static_cast<int>(chunks.size()));
+
+    for (int i = 1; i < n_workers; ++i) {
+        threads.push_back(std::thread(&smart_offline_resampler::run_worker, this, std::ref(*workers_[i]),
+                                      std::ref(next_chunk), std::ref(chunks), src, n_src, dest));
+    }
+
+    run_worker(*workers_[0], next_chunk, chunks, src, n_src, dest);
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    // stitch (the stream may end before the end of the chunk)
+    int n_written = 0;
+
+    for (const auto &c : chunks) {
+        n_written = c.dest_begin + c.num_written;
+
+        if (c.num_written < (c.dest_end - c.dest_begin)) {
+            break;
+        }
+    }
+
+    return n_written;
+}
+
+/// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline long long smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend,
+                                         TPolyCoreOperator>::calc_num_outputs(long long n_src) const CXXPH_NOEXCEPT
+{
+    // NOTE: n_src has to be a multiple of the input period
+    return (n_src * ratio_num_) / ratio_den_;
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::round_up_to_period(
+    long long n) const CXXPH_NOEXCEPT
+{
+    return static_cast<int>(((n + period_ - 1) / period_) * period_);
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::run_worker(
+    worker_context &wc, std::atomic<int> &next_chunk, std::vector<chunk_info> &chunks, const src_frame_t *src,
+    int n_src, dest_frame_t *dest) CXXPH_NOEXCEPT
+{
+    const int n_chunks = static_cast<int>(chunks.size());
+
+    while (true) {
+        const int index = next_chunk.fetch_add(1);
+
+        if (index >= n_chunks) {
+            break;
+        }
+
+        process_chunk(wc, chunks[index], src, n_src, dest);
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void smart_offline_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::process_chunk(
+    worker_context &wc, chunk_info &c, const src_frame_t *src, int n_src, dest_frame_t *dest) CXXPH_NOEXCEPT
+{
+    resampler_type &r = *(wc.resampler);
+
+    // output frames produced from the warm-up input are same with the tail of the previous chunk
+    int n_discard = static_cast<int>(calc_num_outputs(c.src_begin) - calc_num_outputs(c.warmup_begin));
+    int n_remains = (c.dest_end - c.dest_begin);
+    int src_pos = c.warmup_begin;
+    dest_frame_t *d = &dest[c.dest_begin];
+
+    if (n_remains <= 0) {
+        c.num_written = 0;
+        return;
+    }
+
+    r.reset();
+
+    while ((n_discard + n_remains) > 0 && !r.is_finished()) {
+        // put (continues beyond the end of the chunk to fill the filters)
+        if (src_pos < n_src) {
+            const int n = (std::min)(r.num_can_put(), (n_src - src_pos));
+
+            r.put_n(&src[src_pos], n);
+            src_pos += n;
+
+            if (src_pos == n_src) {
+                r.flush();
+            }
+        }
+
+        // get
+        int n_avail = r.num_can_get();
+
+        while (n_avail > 0 && n_discard > 0) {
+            const int n = (std::min)((std::min)(n_avail, n_discard), static_cast<int>(work_buffer_size));
+
+            r.get_n(&(wc.work[0]), n);
+            n_avail -= n;
+            n_discard -= n;
+        }
+
+        if (n_avail > 0 && n_remains > 0) {
+            const int n = (std::min)(n_avail, n_remains);
+
+            r.get_n(d, n);
+            d += n;
+            n_remains -= n;
+        }
+    }
+
+    c.num_written = (c.dest_end - c.dest_begin) - n_remains;
+}
+/// @endcond
+
+} // namespace resampler
+} // namespace cxxdasp
+
+#endif // CXXDASP_RESAMPLER_SMART_SMART_OFFLINE_RESAMPLER_HPP_
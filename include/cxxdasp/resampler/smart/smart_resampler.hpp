@@ -17,6 +17,11 @@
 #ifndef CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_HPP_
 #define CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_HPP_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <cxxporthelper/utility>
 #include <cxxporthelper/memory>
 #include <cxxporthelper/compiler.hpp>
@@ -25,10 +30,14 @@
 #include <cxxdasp/datatype/audio_frame.hpp>
 #include <cxxdasp/resampler/fft/fft_x2_resampler.hpp>
 #include <cxxdasp/resampler/halfband/halfband_x2_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_decimator.hpp>
+#include <cxxdasp/resampler/halfband/halfband_cascade_resampler.hpp>
 #include <cxxdasp/resampler/halfband/halfband_x2_core_operators.hpp>
 #include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
 #include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
 #include <cxxdasp/resampler/smart/smart_resampler_params.hpp>
+#include <cxxdasp/utils/spsc_ring_buffer.hpp>
+#include <cxxdasp/utils/utils.hpp>
 
 namespace cxxdasp {
 namespace resampler {
@@ -36,6 +45,11 @@ namespace resampler {
 /**
  * Smart resampler
  *
+ * In pipelined mode, stage 1 and stage 2 run on their own worker threads. They are connected by lock-free SPSC ring
+ * buffers, and put_n() / get_n() only copy data from / to the ring buffers. This mode is intended for offline
+ * (batch) conversion on multi-core machines, the output is identical to the one of the normal mode.
+ * Use wait_num_can_put() / wait_num_can_get() to block until the worker threads make progress.
+ *
  * @tparam Tsrc source audio frame type
  * @tparam TDest destination audio frame type
  * @tparam THBFRCoreOperator half band filter resampler core operator
@@ -80,8 +94,11 @@ public:
      * Constructor.
      *
      * @param params [in] parameters
+     * @param pipelined [in] run stage 1 and stage 2 on separate worker threads
+     *
+     * @note pipelined mode is ignored if the parameters do not have both of the stages.
      */
-    smart_resampler(const smart_resampler_params &params);
+    smart_resampler(const smart_resampler_params &params, bool pipelined = false);
 
     /**
      * Destructor.
@@ -90,8 +107,10 @@ public:
 
     /**
      * Reset state.
+     *
+     * @throws std::system_error if the worker threads could not be restarted (pipelined mode only)
      */
-    void reset() CXXPH_NOEXCEPT;
+    void reset();
 
     /**
      * Flush buffered data.
@@ -126,6 +145,54 @@ public:
      */
     int num_can_get() const CXXPH_NOEXCEPT;
 
+    /**
+     * Check whether the resampler is running in pipelined mode.
+     * @returns whether pipelined mode is active
+     */
+    bool is_pipelined() const CXXPH_NOEXCEPT { return static_cast<bool>(pipeline_); }
+
+    /**
+     * Check whether all of the resampled data have been read out.
+     *
+     * @returns true if flush() has been called and no more resampled data will become available
+     *
+     * @note in pipelined mode, num_can_get() may return 0 while worker threads are still processing,
+     *       so use this function to detect the end of the stream.
+     */
+    bool is_finished() const CXXPH_NOEXCEPT;
+
+    /**
+     * Wait until free space becomes available in the internal buffer.
+     *
+     * @returns count of free size of internal buffer [frames] (0 if flush() has been called)
+     *
+     * @note this function blocks only in pipelined mode, otherwise it is same as num_can_put().
+     */
+    int wait_num_can_put() CXXPH_NOEXCEPT;
+
+    /**
+     * Wait until resampled data become available or the end of the stream is reached.
+     *
+     * @returns count of available resampled data [frames] (0 if is_finished())
+     *
+     * @note this function blocks only in pipelined mode, otherwise it is same as num_can_get().
+     *       Do not call this function while the worker threads are starving for input, i.e. before
+     *       the pending input frames have been put or flush() has been called.
+     */
+    int wait_num_can_get() CXXPH_NOEXCEPT;
+
+    /**
+     * Get the input period of the processing state.
+     *
+     * A resampler which starts at a multiple of this count of input frames produces bit-identical output frames with
+     * a resampler which has processed the whole stream from the beginning (once the filters have been filled with
+     * the preceding input frames).
+     *
+     * @param params [in] parameters
+     * @returns input period [frames]
+     */
+    static int calc_input_period(const smart_resampler_params &params) CXXPH_NOEXCEPT;
+
 private:
     /// @cond INTERNAL_FIELD
 
@@ -137,14 +204,53 @@ private:
     typedef fft_x2_resampler<src_frame_t, src_frame_t, stage1_coeffs_t, fft_backend_type> stage1_fft_resampler_type;
     typedef halfband_x2_resampler<src_frame_t, src_frame_t, stage1_coeffs_t, halfband_x2_resampler_operator_type>
     stage1_halfband_resampler_type;
+    typedef halfband_x2_decimator<src_frame_t, src_frame_t, stage1_coeffs_t, halfband_x2_resampler_operator_type>
+    stage1_halfband_decimator_type;
+    typedef halfband_cascade_resampler<src_frame_t, src_frame_t, stage1_coeffs_t, halfband_x2_resampler_operator_type>
+    stage1_halfband_cascade_decimator_type;
     typedef polyphase_resampler<src_frame_t, dest_frame_t, stage2_coeffs_t, polyphase_operator_type>
     stage2_resampler_type;
 
     enum { num_channels = src_frame_t::num_channels, };
 
+    enum { pipeline_ring_buffer_size = 16384, };
+
+    struct pipeline_context {
+        utils::spsc_ring_buffer<src_frame_t> input_ring;  // caller -> stage 1
+        utils::spsc_ring_buffer<src_frame_t> mid_ring;    // stage 1 -> stage 2
+        utils::spsc_ring_buffer<dest_frame_t> output_ring; // stage 2 -> caller
+        std::atomic<bool> input_eos;
+        std::atomic<bool> mid_eos;
+        std::atomic<bool> output_eos;
+        std::atomic<bool> quit;
+        std::atomic<unsigned int> seq; // incremented on every state transition, see notify_pipeline()
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::thread stage1_thread;
+        std::thread stage2_thread;
+    };
+
+    static int calc_stage1_block_size_adjust(const smart_resampler_params &params) CXXPH_NOEXCEPT;
+
     void move_stage1_output_to_stage2_input() CXXPH_NOEXCEPT;
+    template <class TStage1>
+    void move_stage1_output_to_stage2_delay_line(TStage1 &s1_resampler) CXXPH_NOEXCEPT;
     void check_stage2_flush() CXXPH_NOEXCEPT;
 
+    void stage1_put_n(const src_frame_t *s, int n) CXXPH_NOEXCEPT;
+    void stage1_get_n(src_frame_t *d, int n) CXXPH_NOEXCEPT;
+    void stage1_flush() CXXPH_NOEXCEPT;
+    int stage1_num_can_put() const CXXPH_NOEXCEPT;
+    int stage1_num_can_get() const CXXPH_NOEXCEPT;
+
+    void start_pipeline();
+    void stop_pipeline() CXXPH_NOEXCEPT;
+    void notify_pipeline() CXXPH_NOEXCEPT;
+    void wait_pipeline(unsigned int seq) CXXPH_NOEXCEPT;
+    unsigned int pipeline_seq() CXXPH_NOEXCEPT;
+    void stage1_worker() CXXPH_NOEXCEPT;
+    void stage2_worker() CXXPH_NOEXCEPT;
+
     bool have_stage1() const CXXPH_NOEXCEPT { return params_.have_stage1; }
 
     bool have_stage2() const CXXPH_NOEXCEPT { return params_.have_stage2; }
@@ -155,10 +261,12 @@ private:
     bool stage2_flushed_;
 
     std::unique_ptr<stage1_halfband_resampler_type> stage1_halfband_resampler_;
+    std::unique_ptr<stage1_halfband_decimator_type> stage1_halfband_decimator_;
+    std::unique_ptr<stage1_halfband_cascade_decimator_type> stage1_halfband_cascade_decimator_;
     std::unique_ptr<stage1_fft_resampler_type> stage1_fft_resampler_;
     std::unique_ptr<stage2_resampler_type> stage2_resampler_;
 
-    cxxporthelper::aligned_memory<src_frame_t> work_buffer_;
+    std::unique_ptr<pipeline_context> pipeline_;
 
     // verify template parameters
     static_assert(static_cast<int>(src_frame_t::num_channels) == static_cast<int>(dest_frame_t::num_channels),
@@ -169,14 +277,17 @@ private:
 
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
 inline smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::smart_resampler(
-    const smart_resampler_params &params)
+    const smart_resampler_params &params, bool pipelined)
     : params_(params), stage1_flushed_(false), stage2_flushed_(false), stage1_halfband_resampler_(),
-      stage1_fft_resampler_(), stage2_resampler_(), work_buffer_()
+      stage1_halfband_decimator_(), stage1_halfband_cascade_decimator_(), stage1_fft_resampler_(), stage2_resampler_(),
+      pipeline_()
 {
     std::unique_ptr<stage1_halfband_resampler_type> s1_halfband_resampler;
+    std::unique_ptr<stage1_halfband_decimator_type> s1_halfband_decimator;
+    std::unique_ptr<stage1_halfband_cascade_decimator_type> s1_halfband_cascade_decimator;
     std::unique_ptr<stage1_fft_resampler_type> s1_fft_resampler;
     std::unique_ptr<stage2_resampler_type> s2_resampler;
-    cxxporthelper::aligned_memory<src_frame_t> work_buffer;
+    std::unique_ptr<pipeline_context> pipeline;
 
     try
     {
@@ -185,16 +296,34 @@ inline smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOpe
 
         int s2_block_size;
 
-        if (params.have_stage1 && !s1.use_fft_resampler) {
-            int k;
-            for (k = 0; (s1.n_coeffs << k) < 512; ++k)
-                ;
+        if (params.have_stage1 && s1.use_halfband_decimator && s1.num_decimator_stages > 1) {
+            const int k = calc_stage1_block_size_adjust(params);
+            const int n_stages = s1.num_decimator_stages;
+            const stage1_coeffs_t *kernels[8];
+            int lengths[8];
+
+            assert(n_stages <= 8);
+
+            // the last stage (at the lowest sample rate) determines the quality
+            for (int i = 0; i < n_stages; ++i) {
+                const bool is_last = (i == (n_stages - 1)) || !s1.pre_coeffs;
+                kernels[i] = (is_last) ? s1.coeffs : s1.pre_coeffs;
+                lengths[i] = (is_last) ? s1.n_coeffs : s1.n_pre_coeffs;
+            }
+
+            s1_halfband_cascade_decimator.reset(new stage1_halfband_cascade_decimator_type(
+                stage1_halfband_cascade_decimator_type::Downsampling, n_stages, kernels, lengths, k));
+            s2_block_size = (4 * s1.n_coeffs) * (1 << k);
+        } else if (params.have_stage1 && s1.use_halfband_decimator) {
+            const int k = calc_stage1_block_size_adjust(params);
+            s1_halfband_decimator.reset(new stage1_halfband_decimator_type(s1.coeffs, s1.n_coeffs, k));
+            s2_block_size = (4 * s1.n_coeffs) * (1 << k);
+        } else if (params.have_stage1 && !s1.use_fft_resampler) {
+            const int k = calc_stage1_block_size_adjust(params);
             s1_halfband_resampler.reset(new stage1_halfband_resampler_type(s1.coeffs, s1.n_coeffs, k));
             s2_block_size = (4 * s1.n_coeffs) * (1 << k);
         } else if (params.have_stage1 && s1.use_fft_resampler) {
-            int k;
-            for (k = 0; (s1.n_coeffs << k) < 4096; ++k)
-                ;
+            const int k = calc_stage1_block_size_adjust(params);
             s1_fft_resampler.reset(new stage1_fft_resampler_type(s1.coeffs, s1.n_coeffs, k));
             s2_block_size = (((2 << k) - 1) * s1.n_coeffs);
         } else {
@@ -206,28 +335,46 @@ inline smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOpe
                 new stage2_resampler_type(s2.coeffs, s2.n_coeffs, !(s2.is_static), s2.m, s2.l, s2_block_size));
         }
 
-        work_buffer.allocate(128, 16, false);
+        if (pipelined && params.have_stage1 && params.have_stage2) {
+            pipeline.reset(new pipeline_context());
+            pipeline->input_ring.allocate(pipeline_ring_buffer_size);
+            pipeline->mid_ring.allocate(pipeline_ring_buffer_size);
+            pipeline->output_ring.allocate(pipeline_ring_buffer_size);
+        }
     }
     catch (...) { throw; }
 
     // update fields
     stage1_halfband_resampler_ = std::move(s1_halfband_resampler);
+    stage1_halfband_decimator_ = std::move(s1_halfband_decimator);
+    stage1_halfband_cascade_decimator_ = std::move(s1_halfband_cascade_decimator);
     stage1_fft_resampler_ = std::move(s1_fft_resampler);
     stage2_resampler_ = std::move(s2_resampler);
-    work_buffer_ = std::move(work_buffer);
+    pipeline_ = std::move(pipeline);
+
+    if (pipeline_) {
+        start_pipeline();
+    }
 }
 
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
 inline smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::~smart_resampler()
 {
+    stop_pipeline();
 }
 
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
-inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::reset() CXXPH_NOEXCEPT
+inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::reset()
 {
+    stop_pipeline();
+
     if (have_stage1()) {
         if (stage1_fft_resampler_) {
             stage1_fft_resampler_->reset();
+        } else if (stage1_halfband_decimator_) {
+            stage1_halfband_decimator_->reset();
+        } else if (stage1_halfband_cascade_decimator_) {
+            stage1_halfband_cascade_decimator_->reset();
         } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
             stage1_halfband_resampler_->reset();
         } else {
@@ -241,19 +388,23 @@ inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCo
 
     stage1_flushed_ = false;
     stage2_flushed_ = false;
+
+    if (pipeline_) {
+        start_pipeline();
+    }
 }
 
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
 inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::flush() CXXPH_NOEXCEPT
 {
-    if (have_stage1() && have_stage2()) {
-        if (stage1_fft_resampler_) {
-            stage1_fft_resampler_->flush();
-        } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
-            stage1_halfband_resampler_->flush();
-        } else {
-            assert(false);
+    if (pipeline_) {
+        if (!stage1_flushed_) {
+            stage1_flushed_ = true;
+            pipeline_->input_eos.store(true, std::memory_order_release);
+            notify_pipeline();
         }
+    } else if (have_stage1() && have_stage2()) {
+        stage1_flush();
 
         stage1_flushed_ = true;
 
@@ -272,14 +423,12 @@ template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBack
 inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::put_n(const src_frame_t *s,
                                                                                                    int n) CXXPH_NOEXCEPT
 {
-    if (have_stage1() && have_stage2()) {
-        if (stage1_fft_resampler_) {
-            stage1_fft_resampler_->put_n(s, n);
-        } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
-            stage1_halfband_resampler_->put_n(s, n);
-        } else {
-            assert(false);
+    if (pipeline_) {
+        if (pipeline_->input_ring.write(s, n)) {
+            notify_pipeline();
         }
+    } else if (have_stage1() && have_stage2()) {
+        stage1_put_n(s, n);
 
         move_stage1_output_to_stage2_input();
         check_stage2_flush();
@@ -292,7 +441,11 @@ template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBack
 inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::get_n(dest_frame_t *d,
                                                                                                    int n) CXXPH_NOEXCEPT
 {
-    if (have_stage1() && have_stage2()) {
+    if (pipeline_) {
+        if (pipeline_->output_ring.read(d, n)) {
+            notify_pipeline();
+        }
+    } else if (have_stage1() && have_stage2()) {
         stage2_resampler_->get_n(d, n);
 
         move_stage1_output_to_stage2_input();
@@ -310,15 +463,10 @@ inline int smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCor
         return 0;
     }
 
-    if (have_stage1() && have_stage2()) {
-        if (stage1_fft_resampler_) {
-            return stage1_fft_resampler_->num_can_put();
-        } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
-            return stage1_halfband_resampler_->num_can_put();
-        } else {
-            assert(false);
-            return 0;
-        }
+    if (pipeline_) {
+        return pipeline_->input_ring.num_can_write();
+    } else if (have_stage1() && have_stage2()) {
+        return stage1_num_can_put();
     } else if (have_stage2()) {
         return stage2_resampler_->num_can_put();
     }
@@ -330,14 +478,131 @@ template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBack
 inline int smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::num_can_get() const
     CXXPH_NOEXCEPT
 {
-    if (have_stage2()) {
+    if (pipeline_) {
+        return pipeline_->output_ring.num_can_read();
+    } else if (have_stage2()) {
         return stage2_resampler_->num_can_get();
     }
 
     return 0;
 }
 
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline bool smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::is_finished() const
+    CXXPH_NOEXCEPT
+{
+    if (pipeline_) {
+        return pipeline_->output_eos.load(std::memory_order_acquire) && pipeline_->output_ring.num_can_read() == 0;
+    } else if (have_stage1() && have_stage2()) {
+        return stage2_flushed_ && stage2_resampler_->num_can_get() == 0;
+    } else if (have_stage2()) {
+        return stage1_flushed_ && stage2_resampler_->num_can_get() == 0;
+    }
+
+    return stage1_flushed_;
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::wait_num_can_put() CXXPH_NOEXCEPT
+{
+    if (!pipeline_ || stage1_flushed_) {
+        return num_can_put();
+    }
+
+    pipeline_context &pl = *pipeline_;
+
+    while (true) {
+        const unsigned int seq = pipeline_seq();
+        const int n = pl.input_ring.num_can_write();
+
+        if (n > 0) {
+            return n;
+        }
+
+        wait_pipeline(seq);
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::wait_num_can_get() CXXPH_NOEXCEPT
+{
+    if (!pipeline_) {
+        return num_can_get();
+    }
+
+    pipeline_context &pl = *pipeline_;
+
+    while (true) {
+        const unsigned int seq = pipeline_seq();
+        // NOTE: check the EOS flag first, it is set after the last frame has been written
+        const bool eos = pl.output_eos.load(std::memory_order_acquire);
+        const int n = pl.output_ring.num_can_read();
+
+        if (n > 0 || eos) {
+            return n;
+        }
+
+        wait_pipeline(seq);
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::calc_input_period(
+    const smart_resampler_params &params) CXXPH_NOEXCEPT
+{
+    const smart_resampler_params::stage1_x2_fir_info &s1 = params.stage1;
+    const smart_resampler_params::stage2_poly_fir_info &s2 = params.stage2;
+
+    // stage 1: input frames per processing block
+    int s1_period = 1;
+
+    if (params.have_stage1) {
+        if (s1.use_halfband_decimator) {
+            s1_period = s1.decimation_factor();
+        } else if (s1.use_fft_resampler) {
+            // overlap-save block boundaries have to be aligned
+            const int k = calc_stage1_block_size_adjust(params);
+            s1_period = (((2 << k) - 1) * s1.n_coeffs) / 2;
+        }
+    }
+
+    // stage 2: input frames per polyphase cycle (L stage 2 input frames)
+    int s2_period = 1;
+
+    if (params.have_stage2) {
+        const int l = s2.l;
+
+        if (!params.have_stage1) {
+            s2_period = l;
+        } else if (s1.use_halfband_decimator) {
+            s2_period = s1.decimation_factor() * l;
+        } else {
+            s2_period = l / utils::gcd(l, 2);
+        }
+    }
+
+    return (s1_period / utils::gcd(s1_period, s2_period)) * s2_period;
+}
+
 /// @cond INTERNAL_FIELD
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::calc_stage1_block_size_adjust(
+    const smart_resampler_params &params) CXXPH_NOEXCEPT
+{
+    const smart_resampler_params::stage1_x2_fir_info &s1 = params.stage1;
+    const int min_block_size = (s1.use_fft_resampler && !s1.use_halfband_decimator) ? 4096 : 512;
+
+    int k;
+    for (k = 0; (s1.n_coeffs << k) < min_block_size; ++k)
+        ;
+
+    return k;
+}
+
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
 inline void
 smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::move_stage1_output_to_stage2_input()
@@ -371,51 +636,348 @@ smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>:
 
             s2_remains -= n_consumed;
         }
+    } else if (stage1_halfband_decimator_) {
+        move_stage1_output_to_stage2_delay_line(*stage1_halfband_decimator_);
+    } else if (stage1_halfband_cascade_decimator_) {
+        move_stage1_output_to_stage2_delay_line(*stage1_halfband_cascade_decimator_);
     } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
-        auto &s1_resampler = stage1_halfband_resampler_;
-        cxxporthelper::aligned_memory<src_frame_t> &work = work_buffer_;
+        move_stage1_output_to_stage2_delay_line(*stage1_halfband_resampler_);
+    } else {
+        assert(false);
+    }
+}
 
-        int s2_remains = s2_n_can_put;
-        while (CXXPH_LIKELY(s2_remains > 0)) {
-            const int s1_n_available = s1_resampler->num_can_get();
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+template <class TStage1>
+inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::
+    move_stage1_output_to_stage2_delay_line(TStage1 &s1_resampler) CXXPH_NOEXCEPT
+{
+    // write stage 1 output directly into the stage 2 delay line
+    while (true) {
+        const int s1_n_available = s1_resampler.num_can_get();
 
-            if (s1_n_available == 0)
-                break;
+        if (s1_n_available == 0)
+            break;
 
-            int n_consumed;
-            n_consumed = (std::min)(s2_remains, s1_n_available);
-            n_consumed = (std::min)(n_consumed, static_cast<int>(work.size()));
+        src_frame_t *s2_in_data = nullptr;
+        int s2_n_available = 0;
 
-            s1_resampler->get_n(&work[0], n_consumed);
+        stage2_resampler_->refer_direct_input_buffer(&s2_in_data, &s2_n_available);
 
-            stage2_resampler_->put_n(&work[0], n_consumed);
+        if (s2_n_available == 0)
+            break;
 
-            s2_remains -= n_consumed;
-        }
+        const int n_consumed = (std::min)(s2_n_available, s1_n_available);
+
+        s1_resampler.get_n(s2_in_data, n_consumed);
+
+        stage2_resampler_->notify_direct_produced_input_buffer_items(n_consumed);
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::check_stage2_flush()
+    CXXPH_NOEXCEPT
+{
+    const int s1_n_can_get = stage1_num_can_get();
+
+    // flush stage 2 resampler after all of the stage 1 data has been consumed
+    if (stage2_resampler_ && stage1_flushed_ && s1_n_can_get == 0 && !stage2_flushed_) {
+        stage2_resampler_->flush();
+        stage2_flushed_ = true;
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_put_n(const src_frame_t *s,
+                                                                                              int n)
+    CXXPH_NOEXCEPT
+{
+    if (stage1_fft_resampler_) {
+        stage1_fft_resampler_->put_n(s, n);
+    } else if (stage1_halfband_decimator_) {
+        stage1_halfband_decimator_->put_n(s, n);
+    } else if (stage1_halfband_cascade_decimator_) {
+        stage1_halfband_cascade_decimator_->put_n(s, n);
+    } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
+        stage1_halfband_resampler_->put_n(s, n);
     } else {
         assert(false);
     }
 }
 
 template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
-inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::check_stage2_flush()
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_get_n(src_frame_t *d, int n)
     CXXPH_NOEXCEPT
 {
-    int s1_n_can_get;
+    if (stage1_fft_resampler_) {
+        stage1_fft_resampler_->get_n(d, n);
+    } else if (stage1_halfband_decimator_) {
+        stage1_halfband_decimator_->get_n(d, n);
+    } else if (stage1_halfband_cascade_decimator_) {
+        stage1_halfband_cascade_decimator_->get_n(d, n);
+    } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
+        stage1_halfband_resampler_->get_n(d, n);
+    } else {
+        assert(false);
+    }
+}
 
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_flush()
+    CXXPH_NOEXCEPT
+{
     if (stage1_fft_resampler_) {
-        s1_n_can_get = stage1_fft_resampler_->num_can_get();
+        stage1_fft_resampler_->flush();
+    } else if (stage1_halfband_decimator_) {
+        stage1_halfband_decimator_->flush();
+    } else if (stage1_halfband_cascade_decimator_) {
+        stage1_halfband_cascade_decimator_->flush();
     } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
-        s1_n_can_get = stage1_halfband_resampler_->num_can_get();
+        stage1_halfband_resampler_->flush();
     } else {
-        s1_n_can_get = 0;
         assert(false);
     }
+}
 
-    // flush stage 2 resampler after all of the stage 1 data has been consumed
-    if (stage2_resampler_ && stage1_flushed_ && s1_n_can_get == 0 && !stage2_flushed_) {
-        stage2_resampler_->flush();
-        stage2_flushed_ = true;
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_num_can_put() const
+    CXXPH_NOEXCEPT
+{
+    if (stage1_fft_resampler_) {
+        return stage1_fft_resampler_->num_can_put();
+    } else if (stage1_halfband_decimator_) {
+        return stage1_halfband_decimator_->num_can_put();
+    } else if (stage1_halfband_cascade_decimator_) {
+        return stage1_halfband_cascade_decimator_->num_can_put();
+    } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
+        return stage1_halfband_resampler_->num_can_put();
+    } else {
+        assert(false);
+        return 0;
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline int smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_num_can_get() const
+    CXXPH_NOEXCEPT
+{
+    if (stage1_fft_resampler_) {
+        return stage1_fft_resampler_->num_can_get();
+    } else if (stage1_halfband_decimator_) {
+        return stage1_halfband_decimator_->num_can_get();
+    } else if (stage1_halfband_cascade_decimator_) {
+        return stage1_halfband_cascade_decimator_->num_can_get();
+    } else if (CXXPH_LIKELY(stage1_halfband_resampler_)) {
+        return stage1_halfband_resampler_->num_can_get();
+    } else {
+        assert(false);
+        return 0;
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::start_pipeline()
+{
+    pipeline_context &pl = *pipeline_;
+
+    pl.input_ring.clear();
+    pl.mid_ring.clear();
+    pl.output_ring.clear();
+    pl.input_eos.store(false);
+    pl.mid_eos.store(false);
+    pl.output_eos.store(false);
+    pl.quit.store(false);
+    pl.seq.store(0);
+
+    pl.stage1_thread = std::thread(&smart_resampler::stage1_worker, this);
+    pl.stage2_thread = std::thread(&smart_resampler::stage2_worker, this);
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stop_pipeline() CXXPH_NOEXCEPT
+{
+    if (!pipeline_) {
+        return;
+    }
+
+    pipeline_context &pl = *pipeline_;
+
+    pl.quit.store(true, std::memory_order_release);
+    notify_pipeline();
+
+    if (pl.stage1_thread.joinable()) {
+        pl.stage1_thread.join();
+    }
+    if (pl.stage2_thread.joinable()) {
+        pl.stage2_thread.join();
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::notify_pipeline() CXXPH_NOEXCEPT
+{
+    pipeline_context &pl = *pipeline_;
+
+    pl.seq.fetch_add(1);
+
+    // NOTE:
+    // Acquire the mutex once after updating the sequence number. A waiter which has checked the sequence number
+    // under the mutex is then guaranteed to be blocked in the condition variable before notify_all() is called.
+    { std::lock_guard<std::mutex> lock(pl.mutex); }
+
+    pl.cv.notify_all();
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline unsigned int
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::pipeline_seq() CXXPH_NOEXCEPT
+{
+    pipeline_context &pl = *pipeline_;
+    const unsigned int seq = pl.seq.load();
+
+    // NOTE:
+    // The fence pairs with the one in spsc_ring_buffer::commit_write() / commit_read(), so either the following
+    // state checks observe the latest commit, or the committer observes the transition and calls notify_pipeline().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    return seq;
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::wait_pipeline(unsigned int seq)
+    CXXPH_NOEXCEPT
+{
+    pipeline_context &pl = *pipeline_;
+    std::unique_lock<std::mutex> lock(pl.mutex);
+    pl.cv.wait(lock, [&pl, seq]() { return pl.seq.load() != seq || pl.quit.load(std::memory_order_acquire); });
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage1_worker() CXXPH_NOEXCEPT
+{
+    pipeline_context &pl = *pipeline_;
+    bool flushed = false;
+
+    while (!pl.quit.load(std::memory_order_acquire)) {
+        // NOTE: take the sequence number before checking the state not to miss notifications
+        const unsigned int seq = pipeline_seq();
+        const bool input_eos = pl.input_eos.load(std::memory_order_acquire);
+        bool progress = false;
+        bool notify = false;
+
+        // input ring -> stage 1
+        {
+            const src_frame_t *s;
+            int n;
+            pl.input_ring.refer_read_span(&s, &n);
+            n = (std::min)(n, stage1_num_can_put());
+            if (n > 0) {
+                stage1_put_n(s, n);
+                notify |= pl.input_ring.commit_read(n);
+                progress = true;
+            }
+        }
+
+        if (input_eos && !flushed && pl.input_ring.num_can_read() == 0) {
+            stage1_flush();
+            flushed = true;
+            progress = true;
+        }
+
+        // stage 1 -> mid ring
+        {
+            src_frame_t *d;
+            int n;
+            pl.mid_ring.refer_write_span(&d, &n);
+            n = (std::min)(n, stage1_num_can_get());
+            if (n > 0) {
+                stage1_get_n(d, n);
+                notify |= pl.mid_ring.commit_write(n);
+                progress = true;
+            }
+        }
+
+        if (flushed && stage1_num_can_get() == 0) {
+            pl.mid_eos.store(true, std::memory_order_release);
+            notify_pipeline();
+            break;
+        }
+
+        if (notify) {
+            notify_pipeline();
+        }
+
+        if (!progress) {
+            wait_pipeline(seq);
+        }
+    }
+}
+
+template <typename TSrc, typename TDest, class THBFRCoreOperator, class TFFTBackend, class TPolyCoreOperator>
+inline void
+smart_resampler<TSrc, TDest, THBFRCoreOperator, TFFTBackend, TPolyCoreOperator>::stage2_worker() CXXPH_NOEXCEPT
+{
+    pipeline_context &pl = *pipeline_;
+    bool flushed = false;
+
+    while (!pl.quit.load(std::memory_order_acquire)) {
+        const unsigned int seq = pipeline_seq();
+        const bool mid_eos = pl.mid_eos.load(std::memory_order_acquire);
+        bool progress = false;
+        bool notify = false;
+
+        // mid ring -> stage 2
+        {
+            const src_frame_t *s;
+            int n;
+            pl.mid_ring.refer_read_span(&s, &n);
+            n = (std::min)(n, stage2_resampler_->num_can_put());
+            if (n > 0) {
+                stage2_resampler_->put_n(s, n);
+                notify |= pl.mid_ring.commit_read(n);
+                progress = true;
+            }
+        }
+
+        if (mid_eos && !flushed && pl.mid_ring.num_can_read() == 0) {
+            stage2_resampler_->flush();
+            flushed = true;
+            progress = true;
+        }
+
+        // stage 2 -> output ring
+        {
+            dest_frame_t *d;
+            int n;
+            pl.output_ring.refer_write_span(&d, &n);
+            n = (std::min)(n, stage2_resampler_->num_can_get());
+            if (n > 0) {
+                stage2_resampler_->get_n(d, n);
+                notify |= pl.output_ring.commit_write(n);
+                progress = true;
+            }
+        }
+
+        if (flushed && stage2_resampler_->num_can_get() == 0) {
+            pl.output_eos.store(true, std::memory_order_release);
+            notify_pipeline();
+            break;
+        }
+
+        if (notify) {
+            notify_pipeline();
+        }
+
+        if (!progress) {
+            wait_pipeline(seq);
+        }
     }
 }
 /// @endcond
@@ -17,6 +17,8 @@
 #ifndef CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_PARAMS_HPP_
 #define CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_PARAMS_HPP_
 
+#include <cxxporthelper/compiler.hpp>
+
 namespace cxxdasp {
 namespace resampler {
 
@@ -42,15 +44,23 @@ struct smart_resampler_params {
      * Stage 1 parameters type
      */
     struct stage1_x2_fir_info {
-        bool is_static;                ///< indicates whether the coefficient table is statically allocated
-        const stage1_coeffs_t *coeffs; ///< coefficients table
-        int n_coeffs;                  ///< coefficients table size
-        bool use_fft_resampler;        ///< true: fft_x2_resampler, false: halfband_x2_resampler
+        bool is_static;                    ///< indicates whether the coefficient table is statically allocated
+        const stage1_coeffs_t *coeffs;     ///< coefficients table
+        int n_coeffs;                      ///< coefficients table size
+        bool use_fft_resampler;            ///< true: fft_x2_resampler, false: halfband_x2_resampler
+        bool use_halfband_decimator;       ///< true: halfband_x2_decimator (downsampling, not x2 oversampling)
+        int num_decimator_stages;          ///< number of cascaded decimator stages (1: 2:1, 2: 4:1, 3: 8:1)
+        const stage1_coeffs_t *pre_coeffs; ///< coefficients table of the decimator stages except the last one
+        int n_pre_coeffs;                  ///< pre_coeffs table size
 
         /**
          * Constructor.
          */
-        stage1_x2_fir_info() : is_static(false), coeffs(nullptr), n_coeffs(0), use_fft_resampler(false) {}
+        stage1_x2_fir_info()
+            : is_static(false), coeffs(nullptr), n_coeffs(0), use_fft_resampler(false), use_halfband_decimator(false),
+              num_decimator_stages(1), pre_coeffs(nullptr), n_pre_coeffs(0)
+        {
+        }
 
         /**
          * Constructor.
@@ -59,10 +69,28 @@ struct smart_resampler_params {
          * @param coeffs [in] "coeffs" field value
          * @param n_coeffs [in] "n_coeffs" field value
          * @param use_fft_resampler [in] "use_fft_resampler" field value
+         * @param use_halfband_decimator [in] "use_halfband_decimator" field value
+         * @param num_decimator_stages [in] "num_decimator_stages" field value
+         * @param pre_coeffs [in] "pre_coeffs" field value
+         * @param n_pre_coeffs [in] "n_pre_coeffs" field value
+         */
+        stage1_x2_fir_info(bool is_static, const stage1_coeffs_t *coeffs, int n_coeffs, bool use_fft_resampler,
+                           bool use_halfband_decimator = false, int num_decimator_stages = 1,
+                           const stage1_coeffs_t *pre_coeffs = nullptr, int n_pre_coeffs = 0)
+            : is_static(is_static), coeffs(coeffs), n_coeffs(n_coeffs), use_fft_resampler(use_fft_resampler),
+              use_halfband_decimator(use_halfband_decimator), num_decimator_stages(num_decimator_stages),
+              pre_coeffs(pre_coeffs), n_pre_coeffs(n_pre_coeffs)
+        {
+        }
+
+        /**
+         * Get the decimation factor of the halfband decimator stages.
+         *
+         * @returns (2 ^ num_decimator_stages), or 1 if the halfband decimator is not used
          */
-        stage1_x2_fir_info(bool is_static, const stage1_coeffs_t *coeffs, int n_coeffs, bool use_fft_resampler)
-            : is_static(is_static), coeffs(coeffs), n_coeffs(n_coeffs), use_fft_resampler(use_fft_resampler)
+        int decimation_factor() const CXXPH_NOEXCEPT
         {
+            return (use_halfband_decimator) ? (1 << num_decimator_stages) : 1;
         }
     };
 
@@ -108,7 +136,7 @@ struct smart_resampler_params {
     //
     // fields
     //
-    bool have_stage1;            ///< have stage 1 (FFT based x2 oversampling)
+    bool have_stage1;            ///< have stage 1 (x2 oversampling or 2:1, 4:1, 8:1 decimation)
     bool have_stage2;            ///< have stage 2 (Rational resampling with polyphase filter)
     stage1_x2_fir_info stage1;   ///< stage 1 parameters
     stage2_poly_fir_info stage2; ///< stage 2 parameters
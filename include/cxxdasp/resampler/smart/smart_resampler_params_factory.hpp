@@ -17,6 +17,8 @@
 #ifndef CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_PARAMS_FACTORY_HPP_
 #define CXXDASP_RESAMPLER_SMART_SMART_RESAMPLER_PARAMS_FACTORY_HPP_
 
+#include <memory>
+
 #include <cxxporthelper/compiler.hpp>
 
 #include <cxxdasp/resampler/smart/smart_resampler_params.hpp>
@@ -26,6 +28,17 @@ namespace resampler {
 
 /**
  * Factory class of the smart_resampler_params
+ *
+ * The pre-designed coefficient tables are used for the common frequency pairs
+ * (input: any of 8000 - 192000 Hz, output: 44100 or 48000 Hz). Filters for the other
+ * integer frequency pairs are designed at runtime and cached, so creating a factory
+ * for the same pair again does not re-design the filters. Runtime designed pairs which
+ * downsample more than 2:1 skip the x2 oversampling stage (stage 1) and use a single
+ * anti-aliasing polyphase stage. LowQuality and MidQuality 2:1, 4:1 and 8:1 down-conversions
+ * only use (cascaded) halfband decimators.
+ *
+ * @note The params() result refers to the coefficients owned by this factory,
+ *       so keep the factory alive until the smart_resampler is constructed.
  */
 class smart_resampler_params_factory {
 
@@ -63,10 +76,40 @@ public:
      */
     operator bool() const CXXPH_NOEXCEPT { return is_valid_; }
 
+    /**
+     * Release the cached runtime designed filters.
+     *
+     * The filters used by the living factory instances are released when they are destroyed.
+     */
+    static void clear_design_cache() CXXPH_NOEXCEPT;
+
+    /**
+     * Max. upsampling factor (M) of the runtime designed stage 2 filter.
+     *
+     * The coefficients table of a designed stage 2 filter has (8 or 16) x M taps and the polyphase
+     * resampler holds an M entries phase schedule, so this limit caps them at 256 KiB / 48 KiB.
+     * Larger M only comes from (nearly) coprime frequency pairs (e.g. 44101 Hz -> 48000 Hz, M = 48000),
+     * whose tables would not fit in the cache and are unlikely to be shared; use
+     * variable_ratio_polyphase_resampler for such pairs. The decimating stage 2 filter
+     * (without stage 1) applies the same limit to the decimation factor (L), otherwise
+     * the x2 oversampling stage is used.
+     */
+#if CXXPH_COMPILER_SUPPORTS_CONSTEXPR
+    static constexpr int max_designed_stage2_m = 4096;
+#else
+    enum { max_designed_stage2_m = 4096 };
+#endif
+
+    /// @cond INTERNAL_FIELD
+    struct designed_fir;
+    /// @endcond
+
 private:
     /// @cond INTERNAL_FIELD
     bool is_valid_;
     smart_resampler_params params_;
+    std::shared_ptr<const designed_fir> designed_stage1_;
+    std::shared_ptr<const designed_fir> designed_stage2_;
     /// @endcond
 };
 
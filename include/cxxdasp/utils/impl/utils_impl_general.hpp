@@ -169,6 +169,62 @@ inline void multiply_aligned(std::complex<T> *CXXPH_RESTRICT dest, const std::co
     multiply(dest, src, x, n);
 }
 
+template <typename T>
+inline void multiply_accumulate(std::complex<T> *CXXPH_RESTRICT src_dest, const std::complex<T> *CXXPH_RESTRICT x,
+                                const std::complex<T> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    // NOTE: avoid std::complex operator*() because it may call a slow function to handle NaN & Inf
+    for (int i = 0; i < n; ++i) {
+        const T ar = x[i].real();
+        const T ai = x[i].imag();
+        const T br = y[i].real();
+        const T bi = y[i].imag();
+
+        src_dest[i] = std::complex<T>(src_dest[i].real() + (ar * br - ai * bi),
+                                      src_dest[i].imag() + (ar * bi + ai * br));
+    }
+}
+
+template <typename T>
+inline void multiply_conj_accumulate(std::complex<T> *CXXPH_RESTRICT src_dest, const std::complex<T> *CXXPH_RESTRICT x,
+                                     const std::complex<T> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    // NOTE: avoid std::complex operator*() because it may call a slow function to handle NaN & Inf
+    for (int i = 0; i < n; ++i) {
+        const T ar = x[i].real();
+        const T ai = x[i].imag();
+        const T br = y[i].real();
+        const T bi = y[i].imag();
+
+        src_dest[i] = std::complex<T>(src_dest[i].real() + (ar * br + ai * bi),
+                                      src_dest[i].imag() + (ai * br - ar * bi));
+    }
+}
+
+template <typename T>
+inline void multiply_accumulate_aligned(std::complex<T> *CXXPH_RESTRICT src_dest,
+                                        const std::complex<T> *CXXPH_RESTRICT x,
+                                        const std::complex<T> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+
+    multiply_accumulate(src_dest, x, y, n);
+}
+
+template <typename T>
+inline void multiply_conj_accumulate_aligned(std::complex<T> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<T> *CXXPH_RESTRICT x,
+                                             const std::complex<T> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, CXXPH_PLATFORM_SIMD_ALIGNMENT);
+
+    multiply_conj_accumulate(src_dest, x, y, n);
+}
+
 template <typename T>
 inline void conj(std::complex<T> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
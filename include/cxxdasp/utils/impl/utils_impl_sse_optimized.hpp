@@ -69,6 +69,22 @@ void multiply_aligned(std::complex<double> *CXXPH_RESTRICT src_dest, const std::
 void multiply_aligned(std::complex<double> *CXXPH_RESTRICT dest, const std::complex<double> *CXXPH_RESTRICT src,
                       const std::complex<double> *CXXPH_RESTRICT x, int n) CXXPH_NOEXCEPT;
 
+void multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<float> *CXXPH_RESTRICT x,
+                                 const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT;
+
+void multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<double> *CXXPH_RESTRICT x,
+                                 const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT;
+
+void multiply_conj_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<float> *CXXPH_RESTRICT x,
+                                      const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT;
+
+void multiply_conj_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<double> *CXXPH_RESTRICT x,
+                                      const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT;
+
 void conj_aligned(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT;
 
 void conj_aligned(std::complex<float> *CXXPH_RESTRICT dest, const std::complex<float> *CXXPH_RESTRICT src,
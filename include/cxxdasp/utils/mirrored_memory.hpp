@@ -0,0 +1,239 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_UTILS_MIRRORED_MEMORY_HPP_
+#define CXXDASP_UTILS_MIRRORED_MEMORY_HPP_
+
+#include <cstddef>
+#include <cassert>
+
+#include <cxxporthelper/utility>
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+namespace cxxdasp {
+namespace utils {
+
+/**
+ * Mirror-mapped memory allocator (low level interface)
+ *
+ * Maps the same physical pages twice at adjacent virtual addresses, so that
+ * p[i] and p[i + size] refer to the same byte (for 0 <= i < size).
+ * Currently implemented on Linux and Android only (memfd + mmap).
+ */
+class mirrored_memory_allocator {
+public:
+    /// @cond INTERNAL_FIELD
+    mirrored_memory_allocator() = delete;
+    /// @endcond
+
+    /**
+     * Check mirror-mapped memory is available.
+     * @returns whether the platform supports mirror-mapped memory
+     */
+    static bool is_supported() CXXPH_NOEXCEPT;
+
+    /**
+     * Get allocation granularity.
+     * @returns allocation granularity (= page size) [bytes], or 0 if not supported
+     */
+    static std::size_t granularity() CXXPH_NOEXCEPT;
+
+    /**
+     * Allocate mirror-mapped memory.
+     *
+     * @param size [in] size of the physical memory block (have to be a multiple of granularity()) [bytes]
+     * @returns head address of the (2 * size) bytes virtual memory region, or nullptr if failed
+     */
+    static void *allocate(std::size_t size) CXXPH_NOEXCEPT;
+
+    /**
+     * Release mirror-mapped memory.
+     *
+     * @param p [in] address returned by allocate()
+     * @param size [in] size passed to allocate() [bytes]
+     */
+    static void deallocate(void *p, std::size_t size) CXXPH_NOEXCEPT;
+};
+
+/**
+ * Mirror-mapped memory block
+ *
+ * Provides (2 * size()) contiguous elements, where the latter half is an alias of the former half.
+ * The allocated memory is zero-filled, and elements are not constructed (POD types only).
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class mirrored_memory {
+
+    /// @cond INTERNAL_FIELD
+    mirrored_memory(const mirrored_memory &) = delete;
+    mirrored_memory &operator=(const mirrored_memory &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Constructor.
+     */
+    mirrored_memory() CXXPH_NOEXCEPT : p_(nullptr), size_(0) {}
+
+    /**
+     * Move constructor.
+     */
+    mirrored_memory(mirrored_memory &&other) CXXPH_NOEXCEPT : p_(other.p_), size_(other.size_)
+    {
+        other.p_ = nullptr;
+        other.size_ = 0;
+    }
+
+    /**
+     * Destructor.
+     */
+    ~mirrored_memory() { release(); }
+
+    /**
+     * Move assignment operator.
+     */
+    mirrored_memory &operator=(mirrored_memory &&other) CXXPH_NOEXCEPT
+    {
+        if (this != &other) {
+            release();
+            p_ = other.p_;
+            size_ = other.size_;
+            other.p_ = nullptr;
+            other.size_ = 0;
+        }
+        return (*this);
+    }
+
+    /**
+     * Round up the number of elements to the allocation granularity.
+     *
+     * @param n [in] requested number of elements
+     * @returns number of elements which can be passed to allocate(), or n if not supported
+     */
+    static int round_up_size(int n) CXXPH_NOEXCEPT
+    {
+        const int g = granularity();
+        return (g > 0) ? (((n + (g - 1)) / g) * g) : n;
+    }
+
+    /**
+     * Get allocation granularity.
+     * @returns allocation granularity [elements], or 0 if not supported
+     */
+    static int granularity() CXXPH_NOEXCEPT
+    {
+        const std::size_t page_size = mirrored_memory_allocator::granularity();
+
+        if (page_size == 0) {
+            return 0;
+        }
+
+        // lcm(page_size, sizeof(T)) / sizeof(T)
+        std::size_t a = page_size;
+        std::size_t b = sizeof(T);
+        while (b != 0) {
+            const std::size_t t = a % b;
+            a = b;
+            b = t;
+        }
+
+        return static_cast<int>(page_size / a);
+    }
+
+    /**
+     * Allocate.
+     *
+     * @param n [in] number of elements (have to be a multiple of granularity())
+     * @returns whether the allocation succeeded
+     */
+    bool allocate(int n) CXXPH_NOEXCEPT
+    {
+        release();
+
+        assert(n > 0);
+        assert((granularity() > 0) && ((n % granularity()) == 0));
+
+        void *p = mirrored_memory_allocator::allocate(sizeof(T) * n);
+
+        if (!p) {
+            return false;
+        }
+
+        p_ = static_cast<T *>(p);
+        size_ = n;
+
+        return true;
+    }
+
+    /**
+     * Release.
+     */
+    void release() CXXPH_NOEXCEPT
+    {
+        if (p_) {
+            mirrored_memory_allocator::deallocate(p_, sizeof(T) * size_);
+        }
+        p_ = nullptr;
+        size_ = 0;
+    }
+
+    /**
+     * Get size.
+     * @returns number of the (physical) elements
+     */
+    int size() const CXXPH_NOEXCEPT { return size_; }
+
+    /**
+     * Get pointer.
+     * @returns head address (valid range: [0, 2 * size()))
+     */
+    T *get() CXXPH_NOEXCEPT { return p_; }
+
+    /**
+     * Get pointer.
+     * @returns head address (valid range: [0, 2 * size()))
+     */
+    const T *get() const CXXPH_NOEXCEPT { return p_; }
+
+    /**
+     * Subscript operator.
+     */
+    T &operator[](int index) CXXPH_NOEXCEPT { return p_[index]; }
+
+    /**
+     * Subscript operator.
+     */
+    const T &operator[](int index) const CXXPH_NOEXCEPT { return p_[index]; }
+
+    /**
+     * Check allocated.
+     */
+    explicit operator bool() const CXXPH_NOEXCEPT { return (p_ != nullptr); }
+
+private:
+    /// @cond INTERNAL_FIELD
+    T *p_;
+    int size_;
+    /// @endcond
+};
+
+} // namespace utils
+} // namespace cxxdasp
+
+#endif // CXXDASP_UTILS_MIRRORED_MEMORY_HPP_
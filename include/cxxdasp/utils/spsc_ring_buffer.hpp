@@ -0,0 +1,267 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef CXXDASP_UTILS_SPSC_RING_BUFFER_HPP_
+#define CXXDASP_UTILS_SPSC_RING_BUFFER_HPP_
+
+#include <cassert>
+#include <cstring>
+#include <atomic>
+
+#include <cxxporthelper/compiler.hpp>
+#include <cxxporthelper/aligned_memory.hpp>
+
+namespace cxxdasp {
+namespace utils {
+
+/**
+ * Lock-free single producer / single consumer ring buffer
+ *
+ * Write side functions have to be called from only one thread (producer), and read side functions have to be called
+ * from only one thread (consumer). Other functions are not thread safe.
+ *
+ * @tparam T element type (POD types only)
+ */
+template <typename T>
+class spsc_ring_buffer {
+
+    /// @cond INTERNAL_FIELD
+    spsc_ring_buffer(const spsc_ring_buffer &) = delete;
+    spsc_ring_buffer &operator=(const spsc_ring_buffer &) = delete;
+    /// @endcond
+
+public:
+    /**
+     * Constructor.
+     */
+    spsc_ring_buffer() : capacity_(0), mask_(0), write_count_(0), read_count_(0), buff_() {}
+
+    /**
+     * Destructor.
+     */
+    ~spsc_ring_buffer() {}
+
+    /**
+     * Allocate.
+     *
+     * @param capacity [in] requested capacity (rounded up to a power of two) [elements]
+     */
+    void allocate(int capacity)
+    {
+        assert(capacity > 0);
+
+        int n = 1;
+        while (n < capacity) {
+            n <<= 1;
+        }
+
+        buff_.allocate(n);
+        capacity_ = n;
+        mask_ = static_cast<unsigned int>(n - 1);
+
+        clear();
+    }
+
+    /**
+     * Clear contents. (not thread safe)
+     */
+    void clear() CXXPH_NOEXCEPT
+    {
+        write_count_.store(0, std::memory_order_relaxed);
+        read_count_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get capacity.
+     * @returns capacity [elements]
+     */
+    int capacity() const CXXPH_NOEXCEPT { return capacity_; }
+
+    //
+    // Producer side
+    //
+
+    /**
+     * Get writable space size.
+     * @returns writable space size [elements]
+     */
+    int num_can_write() const CXXPH_NOEXCEPT
+    {
+        const unsigned int wc = write_count_.load(std::memory_order_relaxed);
+        const unsigned int rc = read_count_.load(std::memory_order_acquire);
+        return capacity_ - static_cast<int>(wc - rc);
+    }
+
+    /**
+     * Directly refer the contiguous writable space.
+     *
+     * @param p [out] pointer of the writable space
+     * @param n [out] size of the contiguous writable space [elements]
+     */
+    void refer_write_span(T **p, int *n) CXXPH_NOEXCEPT
+    {
+        const unsigned int wc = write_count_.load(std::memory_order_relaxed);
+        const int pos = static_cast<int>(wc & mask_);
+        const int n_free = num_can_write();
+
+        (*p) = &buff_[pos];
+        (*n) = (n_free < (capacity_ - pos)) ? n_free : (capacity_ - pos);
+    }
+
+    /**
+     * Publish written elements to the consumer.
+     *
+     * @param n [in] count of written elements
+     * @returns true if the consumer may have found the buffer empty (empty -> non-empty transition)
+     *
+     * @note The return value never misses a transition observed by a consumer which has issued a sequentially
+     *       consistent fence before checking num_can_read(), but it can be a false positive.
+     */
+    bool commit_write(int n) CXXPH_NOEXCEPT
+    {
+        assert(n <= num_can_write());
+        const unsigned int wc = write_count_.load(std::memory_order_relaxed);
+        write_count_.store(wc + n, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return static_cast<int>(read_count_.load(std::memory_order_relaxed) - wc) >= 0;
+    }
+
+    /**
+     * Write elements.
+     *
+     * @param s [in] source elements
+     * @param n [in] count of elements (n <= num_can_write())
+     * @returns true if any of the commits was an empty -> non-empty transition (see commit_write())
+     */
+    bool write(const T *s, int n) CXXPH_NOEXCEPT
+    {
+        bool transition = false;
+
+        while (n > 0) {
+            T *p;
+            int n_span;
+
+            refer_write_span(&p, &n_span);
+            assert(n_span > 0);
+
+            const int n_copy = (n < n_span) ? n : n_span;
+            ::memcpy(p, s, sizeof(T) * n_copy);
+            transition |= commit_write(n_copy);
+
+            s += n_copy;
+            n -= n_copy;
+        }
+
+        return transition;
+    }
+
+    //
+    // Consumer side
+    //
+
+    /**
+     * Get readable data size.
+     * @returns readable data size [elements]
+     */
+    int num_can_read() const CXXPH_NOEXCEPT
+    {
+        const unsigned int wc = write_count_.load(std::memory_order_acquire);
+        const unsigned int rc = read_count_.load(std::memory_order_relaxed);
+        return static_cast<int>(wc - rc);
+    }
+
+    /**
+     * Directly refer the contiguous readable data.
+     *
+     * @param p [out] pointer of the readable data
+     * @param n [out] size of the contiguous readable data [elements]
+     */
+    void refer_read_span(const T **p, int *n) const CXXPH_NOEXCEPT
+    {
+        const unsigned int rc = read_count_.load(std::memory_order_relaxed);
+        const int pos = static_cast<int>(rc & mask_);
+        const int n_avail = num_can_read();
+
+        (*p) = &buff_[pos];
+        (*n) = (n_avail < (capacity_ - pos)) ? n_avail : (capacity_ - pos);
+    }
+
+    /**
+     * Release consumed elements to the producer.
+     *
+     * @param n [in] count of consumed elements
+     * @returns true if the producer may have found the buffer full (full -> non-full transition)
+     *
+     * @note The return value never misses a transition observed by a producer which has issued a sequentially
+     *       consistent fence before checking num_can_write(), but it can be a false positive.
+     */
+    bool commit_read(int n) CXXPH_NOEXCEPT
+    {
+        assert(n <= num_can_read());
+        const unsigned int rc = read_count_.load(std::memory_order_relaxed);
+        read_count_.store(rc + n, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return static_cast<int>(write_count_.load(std::memory_order_relaxed) - rc) >= capacity_;
+    }
+
+    /**
+     * Read elements.
+     *
+     * @param d [out] destination elements
+     * @param n [in] count of elements (n <= num_can_read())
+     * @returns true if any of the commits was a full -> non-full transition (see commit_read())
+     */
+    bool read(T *d, int n) CXXPH_NOEXCEPT
+    {
+        bool transition = false;
+
+        while (n > 0) {
+            const T *p;
+            int n_span;
+
+            refer_read_span(&p, &n_span);
+            assert(n_span > 0);
+
+            const int n_copy = (n < n_span) ? n : n_span;
+            ::memcpy(d, p, sizeof(T) * n_copy);
+            transition |= commit_read(n_copy);
+
+            d += n_copy;
+            n -= n_copy;
+        }
+
+        return transition;
+    }
+
+private:
+    /// @cond INTERNAL_FIELD
+    int capacity_;
+    unsigned int mask_;
+
+    // NOTE: padded to be placed on separate cache lines (avoid false sharing)
+    char pad0_[64];
+    std::atomic<unsigned int> write_count_;
+    char pad1_[64];
+    std::atomic<unsigned int> read_count_;
+    char pad2_[64];
+
+    cxxporthelper::aligned_memory<T> buff_;
+    /// @endcond
+};
+
+} // namespace utils
+} // namespace cxxdasp
+
+#endif // CXXDASP_UTILS_SPSC_RING_BUFFER_HPP_
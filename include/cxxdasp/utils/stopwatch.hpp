@@ -56,6 +56,18 @@ public:
         return static_cast<int>(t);
     }
 
+    /**
+     * Get elapes time.
+     * @returns elapsed time [ns]
+     */
+    long long get_elapsed_time_ns() const CXXPH_NOEXCEPT
+    {
+        long long t = 0;
+        t += (te_.tv_sec - ts_.tv_sec) * 1000000000LL;
+        t += (te_.tv_nsec - ts_.tv_nsec);
+        return t;
+    }
+
 private:
     /// @cond INTERNAL_FIELD
     ::timespec ts_, te_;
@@ -98,6 +110,18 @@ public:
         return static_cast<int>(nsec / 1000);
     }
 
+    /**
+     * Get elapes time.
+     * @returns elapsed time [ns]
+     */
+    long long get_elapsed_time_ns() const CXXPH_NOEXCEPT
+    {
+        mach_timebase_info_data_t tb;
+        ::mach_timebase_info(&tb);
+        uint64_t nsec = (te_ - ts_) * tb.numer / tb.denom;
+        return static_cast<long long>(nsec);
+    }
+
 private:
     /// @cond INTERNAL_FIELD
     uint64_t ts_, te_;
@@ -139,6 +163,20 @@ public:
         return static_cast<int>(usec);
     }
 
+    /**
+     * Get elapes time.
+     * @returns elapsed time [ns]
+     */
+    long long get_elapsed_time_ns() const CXXPH_NOEXCEPT
+    {
+        LARGE_INTEGER freq;
+        ::QueryPerformanceFrequency(&freq);
+        const __int64 ticks = (te_.QuadPart - ts_.QuadPart);
+        __int64 nsec = (ticks / freq.QuadPart) * 1000000000;
+        nsec += (ticks % freq.QuadPart) * 1000000000 / freq.QuadPart;
+        return static_cast<long long>(nsec);
+    }
+
 private:
     /// @cond INTERNAL_FIELD
     LARGE_INTEGER ts_, te_;
@@ -353,6 +353,90 @@ inline void multiply_aligned(std::complex<double> *CXXPH_RESTRICT dest, const st
 #endif
 }
 
+inline void multiply_accumulate(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                const std::complex<float> *CXXPH_RESTRICT x,
+                                const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    impl_general::multiply_accumulate(src_dest, x, y, n);
+}
+
+inline void multiply_accumulate(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                const std::complex<double> *CXXPH_RESTRICT x,
+                                const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    impl_general::multiply_accumulate(src_dest, x, y, n);
+}
+
+inline void multiply_conj_accumulate(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                     const std::complex<float> *CXXPH_RESTRICT x,
+                                     const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    impl_general::multiply_conj_accumulate(src_dest, x, y, n);
+}
+
+inline void multiply_conj_accumulate(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                     const std::complex<double> *CXXPH_RESTRICT x,
+                                     const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    impl_general::multiply_conj_accumulate(src_dest, x, y, n);
+}
+
+inline void multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                        const std::complex<float> *CXXPH_RESTRICT x,
+                                        const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::multiply_accumulate_aligned(src_dest, x, y, n);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::multiply_accumulate_aligned(src_dest, x, y, n);
+#else
+    impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+#endif
+}
+
+inline void multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                        const std::complex<double> *CXXPH_RESTRICT x,
+                                        const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::multiply_accumulate_aligned(src_dest, x, y, n);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::multiply_accumulate_aligned(src_dest, x, y, n);
+#else
+    impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+#endif
+}
+
+inline void multiply_conj_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<float> *CXXPH_RESTRICT x,
+                                             const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#else
+    impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#endif
+}
+
+inline void multiply_conj_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<double> *CXXPH_RESTRICT x,
+                                             const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+    impl_sse::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#elif CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                              \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+    impl_neon::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#else
+    impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+#endif
+}
+
 inline void conj(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
     impl_general::conj(src_dest, n);
@@ -0,0 +1,101 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#ifndef CXXDASP_UTILS_X86_PLATFORM_INFO_HPP_
+#define CXXDASP_UTILS_X86_PLATFORM_INFO_HPP_
+
+#include <cxxporthelper/compiler.hpp>
+
+//
+// AVX family instructions are not enabled by the global compiler flags (-msse -msse2 -msse3),
+// so AVX optimized functions are compiled with function level target attributes instead.
+// Callers have to check x86_platform_info::support_xxx() before using them.
+//
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+#if defined(_MSC_VER)
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX 1
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA 1
+#define CXXDASP_X86_TARGET_AVX
+#define CXXDASP_X86_TARGET_AVX2_FMA
+#if (_MSC_VER >= 1910)
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX512F 1
+#define CXXDASP_X86_TARGET_AVX512F
+#endif
+#elif defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX 1
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA 1
+#define CXXDASP_X86_TARGET_AVX __attribute__((target("avx")))
+#define CXXDASP_X86_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX512F 1
+#define CXXDASP_X86_TARGET_AVX512F __attribute__((target("avx512f")))
+#endif
+#endif
+
+#ifndef CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX 0
+#endif
+
+#ifndef CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA 0
+#endif
+
+#ifndef CXXDASP_COMPILER_SUPPORTS_X86_AVX512F
+#define CXXDASP_COMPILER_SUPPORTS_X86_AVX512F 0
+#endif
+
+namespace cxxdasp {
+namespace utils {
+
+/**
+ * x86 platform information (AVX family instruction sets)
+ *
+ * @note cxxporthelper::platform_info covers SSE family only.
+ */
+class x86_platform_info {
+public:
+    /// @cond INTERNAL_FIELD
+    x86_platform_info() = delete;
+    /// @endcond
+
+    /**
+     * Check AVX instructions are available.
+     * @return whether both the CPU and the OS support AVX
+     */
+    static bool support_avx() CXXPH_NOEXCEPT;
+
+    /**
+     * Check AVX2 instructions are available.
+     * @return whether both the CPU and the OS support AVX2
+     */
+    static bool support_avx2() CXXPH_NOEXCEPT;
+
+    /**
+     * Check FMA (FMA3) instructions are available.
+     * @return whether both the CPU and the OS support FMA
+     */
+    static bool support_fma() CXXPH_NOEXCEPT;
+
+    /**
+     * Check AVX-512 Foundation instructions are available.
+     * @return whether both the CPU and the OS support AVX-512F
+     */
+    static bool support_avx512f() CXXPH_NOEXCEPT;
+};
+
+} // namespace utils
+} // namespace cxxdasp
+
+#endif // CXXDASP_UTILS_X86_PLATFORM_INFO_HPP_
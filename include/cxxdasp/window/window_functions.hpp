@@ -28,6 +28,7 @@ void generate_hann_window(float *dest, size_t n) CXXPH_NOEXCEPT;
 void generate_hamming_window(float *dest, size_t n) CXXPH_NOEXCEPT;
 void generate_blackman_window(float *dest, size_t n, double alpha = 0.16) CXXPH_NOEXCEPT;
 void generate_flat_top_window(float *dest, size_t n) CXXPH_NOEXCEPT;
+void generate_kaiser_window(float *dest, size_t n, double beta) CXXPH_NOEXCEPT;
 
 } // namespace window
 } // namespace cxxdasp
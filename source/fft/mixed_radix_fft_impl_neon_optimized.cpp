@@ -0,0 +1,206 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_neon_optimized.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON &&                                                                                \
+    ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64))
+
+#include <cxxporthelper/arm_neon.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_general.hpp>
+
+namespace cxxdasp {
+namespace fft {
+namespace impl_neon {
+
+//
+// internal functions
+//
+
+// NOTE:
+// The vector types hold interleaved complex values (re0, im0, re1, im1).
+// The pointers are not always aligned, because the first pass reads the user's input buffer.
+
+struct neon_f32_ops {
+    typedef float32x4_t vec_type;
+    typedef std::complex<float> complex_type;
+    enum { width = 2 };
+
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return vld1q_f32(reinterpret_cast<const float *>(p));
+    }
+
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT { vst1q_f32(reinterpret_cast<float *>(p), a); }
+
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        const float32x2_t t = vld1_f32(reinterpret_cast<const float *>(p));
+        return vcombine_f32(t, t);
+    }
+
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return vaddq_f32(a, b); }
+
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return vsubq_f32(a, b); }
+
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        // wt.val[0] = (wr0, wr0, wr1, wr1), wt.val[1] = (wi0, wi0, wi1, wi1)
+        const float32x4x2_t wt = vtrnq_f32(w, w);
+        const float32x4_t as = vrev64q_f32(a);
+        const float32x4_t sign = { -1.0f, 1.0f, -1.0f, 1.0f };
+
+        return vmlaq_f32(vmulq_f32(a, wt.val[0]), as, vmulq_f32(wt.val[1], sign));
+    }
+
+    template <bool Inverse>
+    static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const float32x4_t sign_fwd = { 1.0f, -1.0f, 1.0f, -1.0f };
+        const float32x4_t sign_inv = { -1.0f, 1.0f, -1.0f, 1.0f };
+        return vmulq_f32(vrev64q_f32(a), (Inverse) ? sign_inv : sign_fwd);
+    }
+
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        float *fp = reinterpret_cast<float *>(p);
+        vst1q_f32(&fp[0], vcombine_f32(vget_low_f32(a), vget_low_f32(b)));
+        vst1q_f32(&fp[4], vcombine_f32(vget_high_f32(a), vget_high_f32(b)));
+    }
+
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        float *fp = reinterpret_cast<float *>(p);
+        vst1q_f32(&fp[0], vcombine_f32(vget_low_f32(a), vget_low_f32(b)));
+        vst1q_f32(&fp[4], vcombine_f32(vget_low_f32(c), vget_low_f32(d)));
+        vst1q_f32(&fp[8], vcombine_f32(vget_high_f32(a), vget_high_f32(b)));
+        vst1q_f32(&fp[12], vcombine_f32(vget_high_f32(c), vget_high_f32(d)));
+    }
+};
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+struct neon_f64_ops {
+    typedef float64x2_t vec_type;
+    typedef std::complex<double> complex_type;
+    enum { width = 1 };
+
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return vld1q_f64(reinterpret_cast<const double *>(p));
+    }
+
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT { vst1q_f64(reinterpret_cast<double *>(p), a); }
+
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT { return load(p); }
+
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return vaddq_f64(a, b); }
+
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return vsubq_f64(a, b); }
+
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const float64x2_t wr = vdupq_laneq_f64(w, 0);
+        const float64x2_t wi = vdupq_laneq_f64(w, 1);
+        const float64x2_t as = vextq_f64(a, a, 1);
+        const float64x2_t sign = { -1.0, 1.0 };
+
+        return vfmaq_f64(vmulq_f64(a, wr), as, vmulq_f64(wi, sign));
+    }
+
+    template <bool Inverse>
+    static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const float64x2_t sign_fwd = { 1.0, -1.0 };
+        const float64x2_t sign_inv = { -1.0, 1.0 };
+        return vmulq_f64(vextq_f64(a, a, 1), (Inverse) ? sign_inv : sign_fwd);
+    }
+
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        store(&p[0], a);
+        store(&p[1], b);
+    }
+
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        store(&p[0], a);
+        store(&p[1], b);
+        store(&p[2], c);
+        store(&p[3], d);
+    }
+};
+#endif
+
+namespace neon_kernels {
+#define CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET
+#include "mixed_radix_fft_simd_kernels.inc"
+#undef CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET
+} // namespace neon_kernels
+
+//
+// exposed functions
+//
+
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+    if (neon_kernels::radix2_pass<neon_f32_ops>(m, s, x, y, tw, inverse)) {
+        return;
+    }
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+}
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+    if (neon_kernels::radix4_pass<neon_f32_ops>(m, s, x, y, tw, inverse)) {
+        return;
+    }
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+}
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+    // NOTE: neon_f64_ops handles every pass shape (width = 1)
+    neon_kernels::radix2_pass<neon_f64_ops>(m, s, x, y, tw, inverse);
+}
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+    // NOTE: neon_f64_ops handles every pass shape (width = 1)
+    neon_kernels::radix4_pass<neon_f64_ops>(m, s, x, y, tw, inverse);
+}
+#endif
+
+} // namespace impl_neon
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON && ((CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH ==
+       // CXXPH_ARCH_ARM64))
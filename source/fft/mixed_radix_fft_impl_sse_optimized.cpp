@@ -0,0 +1,475 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_sse_optimized.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+#include <cxxporthelper/platform_info.hpp>
+
+#include <cxxdasp/fft/impl/mixed_radix_fft_impl_general.hpp>
+#include <cxxdasp/utils/x86_platform_info.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#include <immintrin.h>
+#endif
+
+namespace cxxdasp {
+namespace fft {
+namespace impl_sse {
+
+//
+// internal functions
+//
+
+// NOTE:
+// The vector types hold interleaved complex values (re0, im0, re1, im1, ...).
+// Unaligned load / store instructions are used, because the first pass reads the user's input buffer.
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+struct sse_f32_ops {
+    typedef __m128 vec_type;
+    typedef std::complex<float> complex_type;
+    enum { width = 2 };
+
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm_loadu_ps(reinterpret_cast<const float *>(p));
+    }
+
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT
+    {
+        _mm_storeu_ps(reinterpret_cast<float *>(p), a);
+    }
+
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        const __m128 t = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(p));
+        return _mm_movelh_ps(t, t);
+    }
+
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm_add_ps(a, b); }
+
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm_sub_ps(a, b); }
+
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m128 wr = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 wi = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 sign = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+
+        return _mm_add_ps(_mm_mul_ps(a, wr), _mm_xor_ps(_mm_mul_ps(as, wi), sign));
+    }
+
+    template <bool Inverse>
+    static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 sign = (Inverse) ? _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f) : _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+        return _mm_xor_ps(as, sign);
+    }
+
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        float *fp = reinterpret_cast<float *>(p);
+        _mm_storeu_ps(&fp[0], _mm_movelh_ps(a, b));
+        _mm_storeu_ps(&fp[4], _mm_movehl_ps(b, a));
+    }
+
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        float *fp = reinterpret_cast<float *>(p);
+        _mm_storeu_ps(&fp[0], _mm_movelh_ps(a, b));
+        _mm_storeu_ps(&fp[4], _mm_movelh_ps(c, d));
+        _mm_storeu_ps(&fp[8], _mm_movehl_ps(b, a));
+        _mm_storeu_ps(&fp[12], _mm_movehl_ps(d, c));
+    }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+struct sse3_f32_ops : public sse_f32_ops {
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m128 wr = _mm_moveldup_ps(w);
+        const __m128 wi = _mm_movehdup_ps(w);
+        const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return _mm_addsub_ps(_mm_mul_ps(a, wr), _mm_mul_ps(as, wi));
+    }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+struct sse2_f64_ops {
+    typedef __m128d vec_type;
+    typedef std::complex<double> complex_type;
+    enum { width = 1 };
+
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm_loadu_pd(reinterpret_cast<const double *>(p));
+    }
+
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT
+    {
+        _mm_storeu_pd(reinterpret_cast<double *>(p), a);
+    }
+
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT { return load(p); }
+
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm_add_pd(a, b); }
+
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm_sub_pd(a, b); }
+
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m128d wr = _mm_unpacklo_pd(w, w);
+        const __m128d wi = _mm_unpackhi_pd(w, w);
+        const __m128d as = _mm_shuffle_pd(a, a, _MM_SHUFFLE2(0, 1));
+        const __m128d sign = _mm_set_pd(0.0, -0.0);
+
+        return _mm_add_pd(_mm_mul_pd(a, wr), _mm_xor_pd(_mm_mul_pd(as, wi), sign));
+    }
+
+    template <bool Inverse>
+    static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const __m128d as = _mm_shuffle_pd(a, a, _MM_SHUFFLE2(0, 1));
+        const __m128d sign = (Inverse) ? _mm_set_pd(0.0, -0.0) : _mm_set_pd(-0.0, 0.0);
+        return _mm_xor_pd(as, sign);
+    }
+
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        store(&p[0], a);
+        store(&p[1], b);
+    }
+
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        store(&p[0], a);
+        store(&p[1], b);
+        store(&p[2], c);
+        store(&p[3], d);
+    }
+};
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+struct sse3_f64_ops : public sse2_f64_ops {
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m128d wr = _mm_movedup_pd(w);
+        const __m128d wi = _mm_unpackhi_pd(w, w);
+        const __m128d as = _mm_shuffle_pd(a, a, _MM_SHUFFLE2(0, 1));
+
+        return _mm_addsub_pd(_mm_mul_pd(a, wr), _mm_mul_pd(as, wi));
+    }
+};
+#endif
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+struct avx_f32_ops {
+    typedef __m256 vec_type;
+    typedef std::complex<float> complex_type;
+    enum { width = 4 };
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm256_loadu_ps(reinterpret_cast<const float *>(p));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT
+    {
+        _mm256_storeu_ps(reinterpret_cast<float *>(p), a);
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm256_castpd_ps(_mm256_broadcast_sd(reinterpret_cast<const double *>(p)));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm256_add_ps(a, b); }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm256_sub_ps(a, b); }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m256 wr = _mm256_moveldup_ps(w);
+        const __m256 wi = _mm256_movehdup_ps(w);
+        const __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+
+        return _mm256_addsub_ps(_mm256_mul_ps(a, wr), _mm256_mul_ps(as, wi));
+    }
+
+    template <bool Inverse>
+    CXXDASP_X86_TARGET_AVX static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m256 sign = (Inverse) ? _mm256_set_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f)
+                                      : _mm256_set_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+        return _mm256_xor_ps(as, sign);
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        // lo = (a0, b0 | a2, b2), hi = (a1, b1 | a3, b3)
+        const __m256d lo = _mm256_unpacklo_pd(_mm256_castps_pd(a), _mm256_castps_pd(b));
+        const __m256d hi = _mm256_unpackhi_pd(_mm256_castps_pd(a), _mm256_castps_pd(b));
+        double *dp = reinterpret_cast<double *>(p);
+
+        _mm256_storeu_pd(&dp[0], _mm256_permute2f128_pd(lo, hi, 0x20));
+        _mm256_storeu_pd(&dp[4], _mm256_permute2f128_pd(lo, hi, 0x31));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        // ab_lo = (a0, b0 | a2, b2), ab_hi = (a1, b1 | a3, b3), (cd_lo, cd_hi: likewise)
+        const __m256d ab_lo = _mm256_unpacklo_pd(_mm256_castps_pd(a), _mm256_castps_pd(b));
+        const __m256d ab_hi = _mm256_unpackhi_pd(_mm256_castps_pd(a), _mm256_castps_pd(b));
+        const __m256d cd_lo = _mm256_unpacklo_pd(_mm256_castps_pd(c), _mm256_castps_pd(d));
+        const __m256d cd_hi = _mm256_unpackhi_pd(_mm256_castps_pd(c), _mm256_castps_pd(d));
+        double *dp = reinterpret_cast<double *>(p);
+
+        _mm256_storeu_pd(&dp[0], _mm256_permute2f128_pd(ab_lo, cd_lo, 0x20));
+        _mm256_storeu_pd(&dp[4], _mm256_permute2f128_pd(ab_hi, cd_hi, 0x20));
+        _mm256_storeu_pd(&dp[8], _mm256_permute2f128_pd(ab_lo, cd_lo, 0x31));
+        _mm256_storeu_pd(&dp[12], _mm256_permute2f128_pd(ab_hi, cd_hi, 0x31));
+    }
+};
+
+struct avx_f64_ops {
+    typedef __m256d vec_type;
+    typedef std::complex<double> complex_type;
+    enum { width = 2 };
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type load(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm256_loadu_pd(reinterpret_cast<const double *>(p));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store(complex_type *p, vec_type a) CXXPH_NOEXCEPT
+    {
+        _mm256_storeu_pd(reinterpret_cast<double *>(p), a);
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type broadcast(const complex_type *p) CXXPH_NOEXCEPT
+    {
+        return _mm256_broadcast_pd(reinterpret_cast<const __m128d *>(p));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type add(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm256_add_pd(a, b); }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type sub(vec_type a, vec_type b) CXXPH_NOEXCEPT { return _mm256_sub_pd(a, b); }
+
+    CXXDASP_X86_TARGET_AVX
+    static vec_type mul(vec_type a, vec_type w) CXXPH_NOEXCEPT
+    {
+        const __m256d wr = _mm256_movedup_pd(w);
+        const __m256d wi = _mm256_permute_pd(w, 0xf);
+        const __m256d as = _mm256_permute_pd(a, 0x5);
+
+        return _mm256_addsub_pd(_mm256_mul_pd(a, wr), _mm256_mul_pd(as, wi));
+    }
+
+    template <bool Inverse>
+    CXXDASP_X86_TARGET_AVX static vec_type rotate(vec_type a) CXXPH_NOEXCEPT
+    {
+        // forward: (re, im) -> (im, -re), inverse: (re, im) -> (-im, re)
+        const __m256d as = _mm256_permute_pd(a, 0x5);
+        const __m256d sign =
+            (Inverse) ? _mm256_set_pd(0.0, -0.0, 0.0, -0.0) : _mm256_set_pd(-0.0, 0.0, -0.0, 0.0);
+        return _mm256_xor_pd(as, sign);
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store_interleave2(complex_type *p, vec_type a, vec_type b) CXXPH_NOEXCEPT
+    {
+        double *dp = reinterpret_cast<double *>(p);
+        _mm256_storeu_pd(&dp[0], _mm256_permute2f128_pd(a, b, 0x20));
+        _mm256_storeu_pd(&dp[4], _mm256_permute2f128_pd(a, b, 0x31));
+    }
+
+    CXXDASP_X86_TARGET_AVX
+    static void store_interleave4(complex_type *p, vec_type a, vec_type b, vec_type c, vec_type d) CXXPH_NOEXCEPT
+    {
+        double *dp = reinterpret_cast<double *>(p);
+        _mm256_storeu_pd(&dp[0], _mm256_permute2f128_pd(a, b, 0x20));
+        _mm256_storeu_pd(&dp[4], _mm256_permute2f128_pd(c, d, 0x20));
+        _mm256_storeu_pd(&dp[8], _mm256_permute2f128_pd(a, b, 0x31));
+        _mm256_storeu_pd(&dp[12], _mm256_permute2f128_pd(c, d, 0x31));
+    }
+};
+#endif
+
+namespace sse_kernels {
+#define CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET
+#include "mixed_radix_fft_simd_kernels.inc"
+#undef CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET
+} // namespace sse_kernels
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+namespace avx_kernels {
+#define CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET CXXDASP_X86_TARGET_AVX
+#include "mixed_radix_fft_simd_kernels.inc"
+#undef CXXDASP_MIXED_RADIX_FFT_KERNEL_TARGET
+} // namespace avx_kernels
+#endif
+
+//
+// exposed functions
+//
+
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        if (avx_kernels::radix2_pass<avx_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse() && cxxporthelper::platform_info::support_sse3()) {
+        if (sse_kernels::radix2_pass<sse3_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (cxxporthelper::platform_info::support_sse()) {
+        if (sse_kernels::radix2_pass<sse_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+}
+
+void mixed_radix_fft_radix2_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        if (avx_kernels::radix2_pass<avx_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse2() && cxxporthelper::platform_info::support_sse3()) {
+        if (sse_kernels::radix2_pass<sse3_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+    if (cxxporthelper::platform_info::support_sse2()) {
+        if (sse_kernels::radix2_pass<sse2_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix2_pass(m, s, x, y, tw, inverse);
+}
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<float> *CXXPH_RESTRICT x,
+                                 std::complex<float> *CXXPH_RESTRICT y, const std::complex<float> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        if (avx_kernels::radix4_pass<avx_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse() && cxxporthelper::platform_info::support_sse3()) {
+        if (sse_kernels::radix4_pass<sse3_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (cxxporthelper::platform_info::support_sse()) {
+        if (sse_kernels::radix4_pass<sse_f32_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+}
+
+void mixed_radix_fft_radix4_pass(int m, int s, const std::complex<double> *CXXPH_RESTRICT x,
+                                 std::complex<double> *CXXPH_RESTRICT y, const std::complex<double> *CXXPH_RESTRICT tw,
+                                 bool inverse) CXXPH_NOEXCEPT
+{
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        if (avx_kernels::radix4_pass<avx_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse2() && cxxporthelper::platform_info::support_sse3()) {
+        if (sse_kernels::radix4_pass<sse3_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+    if (cxxporthelper::platform_info::support_sse2()) {
+        if (sse_kernels::radix4_pass<sse2_f64_ops>(m, s, x, y, tw, inverse)) {
+            return;
+        }
+    }
+#endif
+
+    cxxdasp::fft::impl_general::mixed_radix_fft_radix4_pass(m, s, x, y, tw, inverse);
+}
+
+} // namespace impl_sse
+} // namespace fft
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
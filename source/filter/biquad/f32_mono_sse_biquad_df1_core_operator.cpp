@@ -0,0 +1,131 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/biquad/f32_mono_sse_biquad_df1_core_operator.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+static void perform_remains(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c, float &x1,
+                            float &x2, float &y1, float &y2) CXXPH_NOEXCEPT
+{
+    const float b0 = c[0];
+    const float b1 = c[1];
+    const float b2 = c[2];
+    const float ia1 = c[3];
+    const float ia2 = c[4];
+
+    for (int i = 0; i < n; ++i) {
+        const float x0 = src[i];
+        const float y0 = (x0 * b0) + (x1 * b1) + (x2 * b2) + (y1 * ia1) + (y2 * ia2);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+
+        dest[i] = y0;
+    }
+}
+
+// NOTE:
+// The input terms (D * x and the x[-1], x[-2] state terms) do not depend on the previous outputs,
+// so only the y[-1], y[-2] terms stay on the loop-carried dependency chain (once per 4 samples).
+// The source and destination may point to the same buffer.
+void f32_mono_sse_biquad_direct_form_1_core_operator_impl::perform(const float *src, float *dest, int n,
+                                                                   const float *CXXPH_RESTRICT c,
+                                                                   float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_df1_block_state_space_coeffs block_coeffs_type;
+
+    const int n_blocks = n / block_coeffs_type::block_size;
+    const int n_remains = n % block_coeffs_type::block_size;
+
+    float x1 = state[0];
+    float x2 = state[1];
+    float y1 = state[2];
+    float y2 = state[3];
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (n_blocks > 0) {
+        const __m128 d0 = _mm_loadu_ps(&c[0]);
+        const __m128 d1 = _mm_loadu_ps(&c[4]);
+        const __m128 d2 = _mm_loadu_ps(&c[8]);
+        const __m128 d3 = _mm_loadu_ps(&c[12]);
+        const __m128 cx1 = _mm_loadu_ps(&c[16]);
+        const __m128 cx2 = _mm_loadu_ps(&c[20]);
+        const __m128 cy1 = _mm_loadu_ps(&c[24]);
+        const __m128 cy2 = _mm_loadu_ps(&c[28]);
+
+        __m128 vx1 = _mm_set1_ps(x1);
+        __m128 vx2 = _mm_set1_ps(x2);
+        __m128 vy1 = _mm_set1_ps(y1);
+        __m128 vy2 = _mm_set1_ps(y2);
+
+        for (int i = 0; i < n_blocks; ++i) {
+            const __m128 x = _mm_loadu_ps(src);
+
+            const __m128 x0 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 xb1 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 xb2 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 xb3 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // input terms (independent of the previous outputs)
+            const __m128 yx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d0, x0), _mm_mul_ps(d1, xb1)),
+                                                    _mm_add_ps(_mm_mul_ps(d2, xb2), _mm_mul_ps(d3, xb3))),
+                                         _mm_add_ps(_mm_mul_ps(cx1, vx1), _mm_mul_ps(cx2, vx2)));
+
+            // output terms
+            const __m128 y = _mm_add_ps(yx, _mm_add_ps(_mm_mul_ps(cy1, vy1), _mm_mul_ps(cy2, vy2)));
+
+            _mm_storeu_ps(dest, y);
+
+            vx1 = xb3;
+            vx2 = xb2;
+            vy1 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3));
+            vy2 = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 2, 2, 2));
+
+            src += 4;
+            dest += 4;
+        }
+
+        x1 = _mm_cvtss_f32(vx1);
+        x2 = _mm_cvtss_f32(vx2);
+        y1 = _mm_cvtss_f32(vy1);
+        y2 = _mm_cvtss_f32(vy2);
+    }
+
+    perform_remains(src, dest, n_remains, &c[32], x1, x2, y1, y2);
+#else
+    perform_remains(src, dest, n, &c[32], x1, x2, y1, y2);
+#endif
+
+    state[0] = x1;
+    state[1] = x2;
+    state[2] = y1;
+    state[3] = y2;
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
@@ -0,0 +1,172 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/biquad/f32_stereo_avx_biquad_df1_core_operator.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+
+#include <immintrin.h>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+static void perform_remains(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c,
+                            float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const float b0 = c[0];
+    const float b1 = c[1];
+    const float b2 = c[2];
+    const float ia1 = c[3];
+    const float ia2 = c[4];
+
+    for (int ch = 0; ch < 2; ++ch) {
+        float x1 = state[4 * ch + 0];
+        float x2 = state[4 * ch + 1];
+        float y1 = state[4 * ch + 2];
+        float y2 = state[4 * ch + 3];
+
+        for (int i = 0; i < n; ++i) {
+            const float x0 = src[2 * i + ch];
+            const float y0 = (x0 * b0) + (x1 * b1) + (x2 * b2) + (y1 * ia1) + (y2 * ia2);
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+
+            dest[2 * i + ch] = y0;
+        }
+
+        state[4 * ch + 0] = x1;
+        state[4 * ch + 1] = x2;
+        state[4 * ch + 2] = y1;
+        state[4 * ch + 3] = y2;
+    }
+}
+
+// [L0, R0, L1, R1 | L2, R2, L3, R3] -> [L0, L1, L2, L3 | R0, R1, R2, R3]
+CXXDASP_X86_TARGET_AVX
+static inline __m256 load_deinterleaved(const float *src) CXXPH_NOEXCEPT
+{
+    const __m256 v = _mm256_loadu_ps(src);
+    const __m256 t = _mm256_permute2f128_ps(v, v, 0x01);
+    const __m256 l = _mm256_shuffle_ps(v, t, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 r = _mm256_shuffle_ps(t, v, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_blend_ps(l, r, 0xf0);
+}
+
+// [L0, L1, L2, L3 | R0, R1, R2, R3] -> [L0, R0, L1, R1 | L2, R2, L3, R3]
+CXXDASP_X86_TARGET_AVX
+static inline void store_interleaved(float *dest, __m256 v) CXXPH_NOEXCEPT
+{
+    const __m256 t = _mm256_permute2f128_ps(v, v, 0x01);
+    const __m256 lo = _mm256_unpacklo_ps(v, t);
+    const __m256 hi = _mm256_unpackhi_ps(v, t);
+    _mm256_storeu_ps(dest, _mm256_permute2f128_ps(lo, hi, 0x20));
+}
+
+// NOTE:
+// Same block state-space formulation as the monaural SSE operator, but the lower 128-bit lane holds
+// the left channel and the upper one holds the right channel, so each vector step processes
+// 4 frames of both channels. The coefficient columns are shared by both lanes.
+// The source and destination may point to the same buffer.
+CXXDASP_X86_TARGET_AVX
+static void perform_blocks(const float *src, float *dest, int n_blocks, const float *CXXPH_RESTRICT c,
+                           float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const __m256 d0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[0]));
+    const __m256 d1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[4]));
+    const __m256 d2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[8]));
+    const __m256 d3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[12]));
+    const __m256 cx1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[16]));
+    const __m256 cx2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[20]));
+    const __m256 cy1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[24]));
+    const __m256 cy2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[28]));
+
+    __m256 vx1 = _mm256_setr_ps(state[0], state[0], state[0], state[0], state[4], state[4], state[4], state[4]);
+    __m256 vx2 = _mm256_setr_ps(state[1], state[1], state[1], state[1], state[5], state[5], state[5], state[5]);
+    __m256 vy1 = _mm256_setr_ps(state[2], state[2], state[2], state[2], state[6], state[6], state[6], state[6]);
+    __m256 vy2 = _mm256_setr_ps(state[3], state[3], state[3], state[3], state[7], state[7], state[7], state[7]);
+
+    for (int i = 0; i < n_blocks; ++i) {
+        const __m256 x = load_deinterleaved(src);
+
+        const __m256 x0 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 xb1 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 xb2 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 xb3 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // input terms (independent of the previous outputs)
+        const __m256 yx =
+            _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d0, x0), _mm256_mul_ps(d1, xb1)),
+                                        _mm256_add_ps(_mm256_mul_ps(d2, xb2), _mm256_mul_ps(d3, xb3))),
+                          _mm256_add_ps(_mm256_mul_ps(cx1, vx1), _mm256_mul_ps(cx2, vx2)));
+
+        // output terms
+        const __m256 y = _mm256_add_ps(yx, _mm256_add_ps(_mm256_mul_ps(cy1, vy1), _mm256_mul_ps(cy2, vy2)));
+
+        store_interleaved(dest, y);
+
+        vx1 = xb3;
+        vx2 = xb2;
+        vy1 = _mm256_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3));
+        vy2 = _mm256_shuffle_ps(y, y, _MM_SHUFFLE(2, 2, 2, 2));
+
+        src += 8;
+        dest += 8;
+    }
+
+    CXXPH_ALIGNAS(32) float t[8];
+
+    _mm256_store_ps(t, vx1);
+    state[0] = t[0];
+    state[4] = t[4];
+    _mm256_store_ps(t, vx2);
+    state[1] = t[0];
+    state[5] = t[4];
+    _mm256_store_ps(t, vy1);
+    state[2] = t[0];
+    state[6] = t[4];
+    _mm256_store_ps(t, vy2);
+    state[3] = t[0];
+    state[7] = t[4];
+}
+
+void f32_stereo_avx_biquad_direct_form_1_core_operator_impl::perform(const float *src, float *dest, int n,
+                                                                     const float *CXXPH_RESTRICT c,
+                                                                     float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_df1_block_state_space_coeffs block_coeffs_type;
+
+    const int n_blocks = n / block_coeffs_type::block_size;
+    const int n_remains = n % block_coeffs_type::block_size;
+
+    if (n_blocks > 0) {
+        perform_blocks(src, dest, n_blocks, c, state);
+
+        src += 2 * block_coeffs_type::block_size * n_blocks;
+        dest += 2 * block_coeffs_type::block_size * n_blocks;
+    }
+
+    perform_remains(src, dest, n_remains, &c[32], state);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX
@@ -0,0 +1,161 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/biquad/f32_stereo_avx_biquad_tdf2_core_operator.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+
+#include <immintrin.h>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+static void perform_remains(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c,
+                            float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const float b0 = c[0];
+    const float b1 = c[1];
+    const float b2 = c[2];
+    const float ia1 = c[3];
+    const float ia2 = c[4];
+
+    for (int ch = 0; ch < 2; ++ch) {
+        float s1 = state[2 * ch + 0];
+        float s2 = state[2 * ch + 1];
+
+        for (int i = 0; i < n; ++i) {
+            const float x0 = src[2 * i + ch];
+            const float y0 = s1 + (x0 * b0);
+
+            s1 = (s2 + (x0 * b1)) + (y0 * ia1);
+            s2 = (x0 * b2) + (y0 * ia2);
+
+            dest[2 * i + ch] = y0;
+        }
+
+        state[2 * ch + 0] = s1;
+        state[2 * ch + 1] = s2;
+    }
+}
+
+// [L0, R0, L1, R1 | L2, R2, L3, R3] -> [L0, L1, L2, L3 | R0, R1, R2, R3]
+CXXDASP_X86_TARGET_AVX
+static inline __m256 load_deinterleaved(const float *src) CXXPH_NOEXCEPT
+{
+    const __m256 v = _mm256_loadu_ps(src);
+    const __m256 t = _mm256_permute2f128_ps(v, v, 0x01);
+    const __m256 l = _mm256_shuffle_ps(v, t, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 r = _mm256_shuffle_ps(t, v, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_blend_ps(l, r, 0xf0);
+}
+
+// [L0, L1, L2, L3 | R0, R1, R2, R3] -> [L0, R0, L1, R1 | L2, R2, L3, R3]
+CXXDASP_X86_TARGET_AVX
+static inline void store_interleaved(float *dest, __m256 v) CXXPH_NOEXCEPT
+{
+    const __m256 t = _mm256_permute2f128_ps(v, v, 0x01);
+    const __m256 lo = _mm256_unpacklo_ps(v, t);
+    const __m256 hi = _mm256_unpackhi_ps(v, t);
+    _mm256_storeu_ps(dest, _mm256_permute2f128_ps(lo, hi, 0x20));
+}
+
+// NOTE:
+// Same block state-space formulation as the monaural SSE operator, but the lower 128-bit lane holds
+// the left channel and the upper one holds the right channel, so each vector step processes
+// 4 frames of both channels and the 2-element state of both channels is updated once per block.
+// The source and destination may point to the same buffer.
+CXXDASP_X86_TARGET_AVX
+static void perform_blocks(const float *src, float *dest, int n_blocks, const float *CXXPH_RESTRICT c,
+                           float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const __m256 d0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[0]));
+    const __m256 d1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[4]));
+    const __m256 d2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[8]));
+    const __m256 d3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[12]));
+    const __m256 cs1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[16]));
+    const __m256 cs2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[20]));
+    const __m256 e0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[24]));
+    const __m256 e1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[28]));
+    const __m256 e2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[32]));
+    const __m256 e3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[36]));
+    const __m256 fs1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[40]));
+    const __m256 fs2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&c[44]));
+
+    // s = (s1 (L), s2 (L), 0, 0 | s1 (R), s2 (R), 0, 0)
+    __m256 s = _mm256_setr_ps(state[0], state[1], 0.0f, 0.0f, state[2], state[3], 0.0f, 0.0f);
+
+    for (int i = 0; i < n_blocks; ++i) {
+        const __m256 x = load_deinterleaved(src);
+
+        const __m256 x0 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 x1 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 x2 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 x3 = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+        // input terms (independent of the state)
+        const __m256 yx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d0, x0), _mm256_mul_ps(d1, x1)),
+                                        _mm256_add_ps(_mm256_mul_ps(d2, x2), _mm256_mul_ps(d3, x3)));
+        const __m256 sx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e0, x0), _mm256_mul_ps(e1, x1)),
+                                        _mm256_add_ps(_mm256_mul_ps(e2, x2), _mm256_mul_ps(e3, x3)));
+
+        // state terms
+        const __m256 vs1 = _mm256_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 vs2 = _mm256_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1));
+
+        const __m256 y = _mm256_add_ps(yx, _mm256_add_ps(_mm256_mul_ps(cs1, vs1), _mm256_mul_ps(cs2, vs2)));
+        s = _mm256_add_ps(sx, _mm256_add_ps(_mm256_mul_ps(fs1, vs1), _mm256_mul_ps(fs2, vs2)));
+
+        store_interleaved(dest, y);
+
+        src += 8;
+        dest += 8;
+    }
+
+    CXXPH_ALIGNAS(32) float t[8];
+
+    _mm256_store_ps(t, s);
+    state[0] = t[0];
+    state[1] = t[1];
+    state[2] = t[4];
+    state[3] = t[5];
+}
+
+void f32_stereo_avx_biquad_transposed_direct_form_2_core_operator_impl::perform(const float *src, float *dest, int n,
+                                                                                const float *CXXPH_RESTRICT c,
+                                                                                float *CXXPH_RESTRICT state)
+    CXXPH_NOEXCEPT
+{
+    typedef biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    const int n_blocks = n / block_coeffs_type::block_size;
+    const int n_remains = n % block_coeffs_type::block_size;
+
+    if (n_blocks > 0) {
+        perform_blocks(src, dest, n_blocks, c, state);
+
+        src += 2 * block_coeffs_type::block_size * n_blocks;
+        dest += 2 * block_coeffs_type::block_size * n_blocks;
+    }
+
+    perform_remains(src, dest, n_remains, &c[48], state);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX
@@ -0,0 +1,129 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/biquad/f32_stereo_sse_biquad_df1_core_operator.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+// NOTE:
+// The feed-forward part is calculated 2 frames at once, and the feedback part is calculated
+// frame by frame (both channels at once) using the lower half of the SSE registers.
+// The source and destination may point to the same buffer.
+static void perform_impl(const float *src, float *dest, unsigned int n, const float *CXXPH_RESTRICT b_,
+                         const float *CXXPH_RESTRICT ia_, float *CXXPH_RESTRICT x_,
+                         float *CXXPH_RESTRICT y_) CXXPH_NOEXCEPT
+{
+    unsigned int i = 0;
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    const unsigned int n1 = (n >> 1) << 1; // (n / 2) * 2
+
+    if (n1 != 0) {
+        const __m128 vb0 = _mm_set1_ps(b_[0]);
+        const __m128 vb1 = _mm_set1_ps(b_[1]);
+        const __m128 vb2 = _mm_set1_ps(b_[2]);
+        const __m128 via1 = _mm_set1_ps(ia_[0]);
+        const __m128 via2 = _mm_set1_ps(ia_[1]);
+
+        // [x[n-2] (L, R), x[n-1] (L, R)]
+        __m128 px = _mm_set_ps(x_[1], x_[0], x_[3], x_[2]);
+        // [y[n-1] (L, R), -, -]
+        __m128 y1 = _mm_set_ps(0.0f, 0.0f, y_[1], y_[0]);
+        // [y[n-2] (L, R), -, -]
+        __m128 y2 = _mm_set_ps(0.0f, 0.0f, y_[3], y_[2]);
+
+        for (; i < n1; i += 2) {
+            const __m128 x = _mm_loadu_ps(&src[2 * i]);
+
+            // xm1: [x[n-1] (L, R), x[n+0] (L, R)]
+            // xm2: [x[n-2] (L, R), x[n-1] (L, R)]
+            const __m128 xm1 = _mm_shuffle_ps(px, x, _MM_SHUFFLE(1, 0, 3, 2));
+            const __m128 xm2 = px;
+
+            __m128 f = _mm_mul_ps(vb0, x);
+            f = _mm_add_ps(f, _mm_mul_ps(vb1, xm1));
+            f = _mm_add_ps(f, _mm_mul_ps(vb2, xm2));
+
+            __m128 ya = _mm_add_ps(f, _mm_mul_ps(via2, y2));
+            ya = _mm_add_ps(ya, _mm_mul_ps(via1, y1));
+
+            __m128 yb = _mm_add_ps(_mm_movehl_ps(f, f), _mm_mul_ps(via2, y1));
+            yb = _mm_add_ps(yb, _mm_mul_ps(via1, ya));
+
+            _mm_storeu_ps(&dest[2 * i], _mm_movelh_ps(ya, yb));
+
+            px = x;
+            y2 = ya;
+            y1 = yb;
+        }
+
+        CXXPH_ALIGNAS(16) float t[4];
+
+        _mm_store_ps(&t[0], px);
+        x_[0] = t[2];
+        x_[1] = t[3];
+        x_[2] = t[0];
+        x_[3] = t[1];
+
+        _mm_store_ps(&t[0], _mm_movelh_ps(y1, y2));
+        y_[0] = t[0];
+        y_[1] = t[1];
+        y_[2] = t[2];
+        y_[3] = t[3];
+    }
+#endif
+
+    for (; i < n; ++i) {
+        for (int c = 0; c < 2; ++c) {
+            const float x0 = src[2 * i + c];
+            const float y0 = b_[0] * x0 + b_[1] * x_[0 + c] + b_[2] * x_[2 + c] + ia_[0] * y_[0 + c] +
+                             ia_[1] * y_[2 + c];
+
+            dest[2 * i + c] = y0;
+
+            x_[2 + c] = x_[0 + c];
+            x_[0 + c] = x0;
+            y_[2 + c] = y_[0 + c];
+            y_[0 + c] = y0;
+        }
+    }
+}
+
+void f32_stereo_sse_biquad_direct_form_1_core_operator_impl::perform(
+    float *src_dest, unsigned int n, const float *CXXPH_RESTRICT b_, const float *CXXPH_RESTRICT ia_,
+    float *CXXPH_RESTRICT x_, float *CXXPH_RESTRICT y_) CXXPH_NOEXCEPT
+{
+    perform_impl(src_dest, src_dest, n, b_, ia_, x_, y_);
+}
+
+void f32_stereo_sse_biquad_direct_form_1_core_operator_impl::perform(
+    const float *src, float *dest, unsigned int n, const float *CXXPH_RESTRICT b_, const float *CXXPH_RESTRICT ia_,
+    float *CXXPH_RESTRICT x_, float *CXXPH_RESTRICT y_) CXXPH_NOEXCEPT
+{
+    perform_impl(src, dest, n, b_, ia_, x_, y_);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
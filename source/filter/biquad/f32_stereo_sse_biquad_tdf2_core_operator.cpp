@@ -0,0 +1,111 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/biquad/f32_stereo_sse_biquad_tdf2_core_operator.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+// NOTE:
+// The products of the input samples and the b0, b1, b2 coefficients are calculated 2 frames at once,
+// and the state variables are updated frame by frame (both channels at once) using the lower half of
+// the SSE registers.
+// The source and destination may point to the same buffer.
+static void perform_impl(const float *src, float *dest, unsigned int n, const float *CXXPH_RESTRICT b_,
+                         const float *CXXPH_RESTRICT ia_, float *CXXPH_RESTRICT s_) CXXPH_NOEXCEPT
+{
+    unsigned int i = 0;
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    const unsigned int n1 = (n >> 1) << 1; // (n / 2) * 2
+
+    if (n1 != 0) {
+        const __m128 vb0 = _mm_set1_ps(b_[0]);
+        const __m128 vb1 = _mm_set1_ps(b_[1]);
+        const __m128 vb2 = _mm_set1_ps(b_[2]);
+        const __m128 via1 = _mm_set1_ps(ia_[0]);
+        const __m128 via2 = _mm_set1_ps(ia_[1]);
+
+        // [s1 (L, R), -, -]
+        __m128 s1 = _mm_set_ps(0.0f, 0.0f, s_[1], s_[0]);
+        // [s2 (L, R), -, -]
+        __m128 s2 = _mm_set_ps(0.0f, 0.0f, s_[3], s_[2]);
+
+        for (; i < n1; i += 2) {
+            const __m128 x = _mm_loadu_ps(&src[2 * i]);
+
+            const __m128 bx0 = _mm_mul_ps(vb0, x);
+            const __m128 bx1 = _mm_mul_ps(vb1, x);
+            const __m128 bx2 = _mm_mul_ps(vb2, x);
+
+            const __m128 ya = _mm_add_ps(s1, bx0);
+            s1 = _mm_add_ps(_mm_add_ps(s2, bx1), _mm_mul_ps(via1, ya));
+            s2 = _mm_add_ps(_mm_mul_ps(via2, ya), bx2);
+
+            const __m128 yb = _mm_add_ps(s1, _mm_movehl_ps(bx0, bx0));
+            s1 = _mm_add_ps(_mm_add_ps(s2, _mm_movehl_ps(bx1, bx1)), _mm_mul_ps(via1, yb));
+            s2 = _mm_add_ps(_mm_mul_ps(via2, yb), _mm_movehl_ps(bx2, bx2));
+
+            _mm_storeu_ps(&dest[2 * i], _mm_movelh_ps(ya, yb));
+        }
+
+        CXXPH_ALIGNAS(16) float t[4];
+
+        _mm_store_ps(&t[0], _mm_movelh_ps(s1, s2));
+        s_[0] = t[0];
+        s_[1] = t[1];
+        s_[2] = t[2];
+        s_[3] = t[3];
+    }
+#endif
+
+    for (; i < n; ++i) {
+        for (int c = 0; c < 2; ++c) {
+            const float x0 = src[2 * i + c];
+            const float y0 = s_[0 + c] + b_[0] * x0;
+
+            s_[0 + c] = s_[2 + c] + ia_[0] * y0 + b_[1] * x0;
+            s_[2 + c] = ia_[1] * y0 + b_[2] * x0;
+
+            dest[2 * i + c] = y0;
+        }
+    }
+}
+
+void f32_stereo_sse_biquad_transposed_direct_form_2_core_operator_impl::perform(
+    float *src_dest, unsigned int n, const float *CXXPH_RESTRICT b_, const float *CXXPH_RESTRICT ia_,
+    float *CXXPH_RESTRICT s_) CXXPH_NOEXCEPT
+{
+    perform_impl(src_dest, src_dest, n, b_, ia_, s_);
+}
+
+void f32_stereo_sse_biquad_transposed_direct_form_2_core_operator_impl::perform(
+    const float *src, float *dest, unsigned int n, const float *CXXPH_RESTRICT b_, const float *CXXPH_RESTRICT ia_,
+    float *CXXPH_RESTRICT s_) CXXPH_NOEXCEPT
+{
+    perform_impl(src, dest, n, b_, ia_, s_);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
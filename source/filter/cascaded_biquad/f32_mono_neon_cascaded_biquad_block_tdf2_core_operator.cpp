@@ -0,0 +1,127 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/cascaded_biquad/f32_mono_neon_cascaded_biquad_block_tdf2_core_operator.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+
+#include <cxxporthelper/arm_neon.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+static void perform_remains(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c, float &s1,
+                            float &s2) CXXPH_NOEXCEPT
+{
+    const float b0 = c[0];
+    const float b1 = c[1];
+    const float b2 = c[2];
+    const float ia1 = c[3];
+    const float ia2 = c[4];
+
+    for (int i = 0; i < n; ++i) {
+        const float x0 = src[i];
+        const float y0 = s1 + (x0 * b0);
+
+        s1 = (s2 + (x0 * b1)) + (y0 * ia1);
+        s2 = (x0 * b2) + (y0 * ia2);
+
+        dest[i] = y0;
+    }
+}
+
+// NOTE:
+// Each section is applied over the whole buffer in turn (the 1st section reads from src, the others
+// overwrite dest), so the section state stays in a register during the loop. The source and
+// destination may point to the same buffer.
+static void perform_section(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c,
+                            float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    const int n_blocks = n / block_coeffs_type::block_size;
+    const int n_remains = n % block_coeffs_type::block_size;
+
+    float s1 = state[0];
+    float s2 = state[1];
+
+    if (n_blocks > 0) {
+        const float32x4_t d0 = vld1q_f32(&c[0]);
+        const float32x4_t d1 = vld1q_f32(&c[4]);
+        const float32x4_t d2 = vld1q_f32(&c[8]);
+        const float32x4_t d3 = vld1q_f32(&c[12]);
+        const float32x4_t cs1 = vld1q_f32(&c[16]);
+        const float32x4_t cs2 = vld1q_f32(&c[20]);
+        const float32x2_t e0 = vld1_f32(&c[24]);
+        const float32x2_t e1 = vld1_f32(&c[28]);
+        const float32x2_t e2 = vld1_f32(&c[32]);
+        const float32x2_t e3 = vld1_f32(&c[36]);
+        const float32x2_t fs1 = vld1_f32(&c[40]);
+        const float32x2_t fs2 = vld1_f32(&c[44]);
+
+        // s = (s1, s2)
+        float32x2_t s = vset_lane_f32(s2, vdup_n_f32(s1), 1);
+
+        for (int i = 0; i < n_blocks; ++i) {
+            const float32x4_t x = vld1q_f32(src);
+            const float32x2_t x01 = vget_low_f32(x);
+            const float32x2_t x23 = vget_high_f32(x);
+
+            // input terms (independent of the state)
+            const float32x4_t yx = vaddq_f32(vmlaq_lane_f32(vmulq_lane_f32(d0, x01, 0), d1, x01, 1),
+                                             vmlaq_lane_f32(vmulq_lane_f32(d2, x23, 0), d3, x23, 1));
+            const float32x2_t sx = vadd_f32(vmla_lane_f32(vmul_lane_f32(e0, x01, 0), e1, x01, 1),
+                                            vmla_lane_f32(vmul_lane_f32(e2, x23, 0), e3, x23, 1));
+
+            // state terms
+            const float32x4_t y = vaddq_f32(yx, vmlaq_lane_f32(vmulq_lane_f32(cs1, s, 0), cs2, s, 1));
+            s = vadd_f32(sx, vmla_lane_f32(vmul_lane_f32(fs1, s, 0), fs2, s, 1));
+
+            vst1q_f32(dest, y);
+
+            src += 4;
+            dest += 4;
+        }
+
+        s1 = vget_lane_f32(s, 0);
+        s2 = vget_lane_f32(s, 1);
+    }
+
+    perform_remains(src, dest, n_remains, &c[48], s1, s2);
+
+    state[0] = s1;
+    state[1] = s2;
+}
+
+void f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator_impl::perform(
+    const float *src, float *dest, int n, int num_cascaded, const float *CXXPH_RESTRICT coeffs,
+    float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    perform_section(src, dest, n, &coeffs[0], &state[0]);
+
+    for (int no = 1; no < num_cascaded; ++no) {
+        perform_section(dest, dest, n, &coeffs[block_coeffs_type::size * no], &state[2 * no]);
+    }
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON
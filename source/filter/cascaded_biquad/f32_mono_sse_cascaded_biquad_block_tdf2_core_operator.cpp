@@ -0,0 +1,137 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/cascaded_biquad/f32_mono_sse_cascaded_biquad_block_tdf2_core_operator.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+static void perform_remains(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c, float &s1,
+                            float &s2) CXXPH_NOEXCEPT
+{
+    const float b0 = c[0];
+    const float b1 = c[1];
+    const float b2 = c[2];
+    const float ia1 = c[3];
+    const float ia2 = c[4];
+
+    for (int i = 0; i < n; ++i) {
+        const float x0 = src[i];
+        const float y0 = s1 + (x0 * b0);
+
+        s1 = (s2 + (x0 * b1)) + (y0 * ia1);
+        s2 = (x0 * b2) + (y0 * ia2);
+
+        dest[i] = y0;
+    }
+}
+
+// NOTE:
+// Each section is applied over the whole buffer in turn (the 1st section reads from src, the others
+// overwrite dest), so the section state stays in a register during the loop. The source and
+// destination may point to the same buffer.
+static void perform_section(const float *src, float *dest, int n, const float *CXXPH_RESTRICT c,
+                            float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    const int n_blocks = n / block_coeffs_type::block_size;
+    const int n_remains = n % block_coeffs_type::block_size;
+
+    float s1 = state[0];
+    float s2 = state[1];
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (n_blocks > 0) {
+        const __m128 d0 = _mm_loadu_ps(&c[0]);
+        const __m128 d1 = _mm_loadu_ps(&c[4]);
+        const __m128 d2 = _mm_loadu_ps(&c[8]);
+        const __m128 d3 = _mm_loadu_ps(&c[12]);
+        const __m128 cs1 = _mm_loadu_ps(&c[16]);
+        const __m128 cs2 = _mm_loadu_ps(&c[20]);
+        const __m128 e0 = _mm_loadu_ps(&c[24]);
+        const __m128 e1 = _mm_loadu_ps(&c[28]);
+        const __m128 e2 = _mm_loadu_ps(&c[32]);
+        const __m128 e3 = _mm_loadu_ps(&c[36]);
+        const __m128 fs1 = _mm_loadu_ps(&c[40]);
+        const __m128 fs2 = _mm_loadu_ps(&c[44]);
+
+        // s = (s1, s2, 0, 0)
+        __m128 s = _mm_setr_ps(s1, s2, 0.0f, 0.0f);
+
+        for (int i = 0; i < n_blocks; ++i) {
+            const __m128 x = _mm_loadu_ps(src);
+
+            const __m128 x0 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 x1 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 x2 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 x3 = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // input terms (independent of the state)
+            const __m128 yx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d0, x0), _mm_mul_ps(d1, x1)),
+                                         _mm_add_ps(_mm_mul_ps(d2, x2), _mm_mul_ps(d3, x3)));
+            const __m128 sx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e0, x0), _mm_mul_ps(e1, x1)),
+                                         _mm_add_ps(_mm_mul_ps(e2, x2), _mm_mul_ps(e3, x3)));
+
+            // state terms
+            const __m128 vs1 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 vs2 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1));
+
+            const __m128 y = _mm_add_ps(yx, _mm_add_ps(_mm_mul_ps(cs1, vs1), _mm_mul_ps(cs2, vs2)));
+            s = _mm_add_ps(sx, _mm_add_ps(_mm_mul_ps(fs1, vs1), _mm_mul_ps(fs2, vs2)));
+
+            _mm_storeu_ps(dest, y);
+
+            src += 4;
+            dest += 4;
+        }
+
+        s1 = _mm_cvtss_f32(s);
+        s2 = _mm_cvtss_f32(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+
+    perform_remains(src, dest, n_remains, &c[48], s1, s2);
+#else
+    perform_remains(src, dest, n, &c[48], s1, s2);
+#endif
+
+    state[0] = s1;
+    state[1] = s2;
+}
+
+void f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator_impl::perform(
+    const float *src, float *dest, int n, int num_cascaded, const float *CXXPH_RESTRICT coeffs,
+    float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    typedef biquad_tdf2_block_state_space_coeffs block_coeffs_type;
+
+    perform_section(src, dest, n, &coeffs[0], &state[0]);
+
+    for (int no = 1; no < num_cascaded; ++no) {
+        perform_section(dest, dest, n, &coeffs[block_coeffs_type::size * no], &state[2 * no]);
+    }
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
@@ -0,0 +1,60 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/multichannel_biquad/f32_avx512_multichannel_biquad_core_operator.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX512F
+
+#include <immintrin.h>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+CXXDASP_X86_TARGET_AVX512F
+void f32_avx512_multichannel_biquad_core_operator_impl::perform(const float *src, float *dest, int n, int stride,
+                                                                const float *CXXPH_RESTRICT coeffs,
+                                                                float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const __m512 b0 = _mm512_loadu_ps(&coeffs[0 * 16]);
+    const __m512 b1 = _mm512_loadu_ps(&coeffs[1 * 16]);
+    const __m512 b2 = _mm512_loadu_ps(&coeffs[2 * 16]);
+    const __m512 ia1 = _mm512_loadu_ps(&coeffs[3 * 16]);
+    const __m512 ia2 = _mm512_loadu_ps(&coeffs[4 * 16]);
+
+    __m512 s1 = _mm512_loadu_ps(&state[0 * 16]);
+    __m512 s2 = _mm512_loadu_ps(&state[1 * 16]);
+
+    for (int i = 0; i < n; ++i) {
+        const __m512 x = _mm512_loadu_ps(&src[i * stride]);
+        const __m512 y = _mm512_add_ps(s1, _mm512_mul_ps(b0, x));
+
+        // NOTE: (s2 + b1 * x) does not depend on y, so it is kept out of the critical path
+        s1 = _mm512_add_ps(_mm512_add_ps(s2, _mm512_mul_ps(b1, x)), _mm512_mul_ps(ia1, y));
+        s2 = _mm512_add_ps(_mm512_mul_ps(b2, x), _mm512_mul_ps(ia2, y));
+
+        _mm512_storeu_ps(&dest[i * stride], y);
+    }
+
+    _mm512_storeu_ps(&state[0 * 16], s1);
+    _mm512_storeu_ps(&state[1 * 16], s2);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX512F
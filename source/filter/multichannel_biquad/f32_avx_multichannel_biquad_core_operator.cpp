@@ -0,0 +1,60 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/multichannel_biquad/f32_avx_multichannel_biquad_core_operator.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+
+#include <immintrin.h>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+CXXDASP_X86_TARGET_AVX
+void f32_avx_multichannel_biquad_core_operator_impl::perform(const float *src, float *dest, int n, int stride,
+                                                             const float *CXXPH_RESTRICT coeffs,
+                                                             float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const __m256 b0 = _mm256_loadu_ps(&coeffs[0 * 8]);
+    const __m256 b1 = _mm256_loadu_ps(&coeffs[1 * 8]);
+    const __m256 b2 = _mm256_loadu_ps(&coeffs[2 * 8]);
+    const __m256 ia1 = _mm256_loadu_ps(&coeffs[3 * 8]);
+    const __m256 ia2 = _mm256_loadu_ps(&coeffs[4 * 8]);
+
+    __m256 s1 = _mm256_loadu_ps(&state[0 * 8]);
+    __m256 s2 = _mm256_loadu_ps(&state[1 * 8]);
+
+    for (int i = 0; i < n; ++i) {
+        const __m256 x = _mm256_loadu_ps(&src[i * stride]);
+        const __m256 y = _mm256_add_ps(s1, _mm256_mul_ps(b0, x));
+
+        // NOTE: (s2 + b1 * x) does not depend on y, so it is kept out of the critical path
+        s1 = _mm256_add_ps(_mm256_add_ps(s2, _mm256_mul_ps(b1, x)), _mm256_mul_ps(ia1, y));
+        s2 = _mm256_add_ps(_mm256_mul_ps(b2, x), _mm256_mul_ps(ia2, y));
+
+        _mm256_storeu_ps(&dest[i * stride], y);
+    }
+
+    _mm256_storeu_ps(&state[0 * 8], s1);
+    _mm256_storeu_ps(&state[1 * 8], s2);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX
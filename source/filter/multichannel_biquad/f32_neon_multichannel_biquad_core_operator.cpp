@@ -0,0 +1,59 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/multichannel_biquad/f32_neon_multichannel_biquad_core_operator.hpp>
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+
+#include <cxxporthelper/arm_neon.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+void f32_neon_multichannel_biquad_core_operator_impl::perform(const float *src, float *dest, int n, int stride,
+                                                              const float *CXXPH_RESTRICT coeffs,
+                                                              float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+    const float32x4_t b0 = vld1q_f32(&coeffs[0 * 4]);
+    const float32x4_t b1 = vld1q_f32(&coeffs[1 * 4]);
+    const float32x4_t b2 = vld1q_f32(&coeffs[2 * 4]);
+    const float32x4_t ia1 = vld1q_f32(&coeffs[3 * 4]);
+    const float32x4_t ia2 = vld1q_f32(&coeffs[4 * 4]);
+
+    float32x4_t s1 = vld1q_f32(&state[0 * 4]);
+    float32x4_t s2 = vld1q_f32(&state[1 * 4]);
+
+    for (int i = 0; i < n; ++i) {
+        const float32x4_t x = vld1q_f32(&src[i * stride]);
+        const float32x4_t y = vaddq_f32(s1, vmulq_f32(b0, x));
+
+        // NOTE: (s2 + b1 * x) does not depend on y, so it is kept out of the critical path
+        s1 = vaddq_f32(vaddq_f32(s2, vmulq_f32(b1, x)), vmulq_f32(ia1, y));
+        s2 = vaddq_f32(vmulq_f32(b2, x), vmulq_f32(ia2, y));
+
+        vst1q_f32(&dest[i * stride], y);
+    }
+
+    vst1q_f32(&state[0 * 4], s1);
+    vst1q_f32(&state[1 * 4], s2);
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // CXXPH_COMPILER_SUPPORTS_ARM_NEON
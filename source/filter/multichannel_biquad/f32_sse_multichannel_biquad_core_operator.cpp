@@ -0,0 +1,76 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/filter/multichannel_biquad/f32_sse_multichannel_biquad_core_operator.hpp>
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
+#include <cxxporthelper/x86_intrinsics.hpp>
+
+namespace cxxdasp {
+namespace filter {
+namespace impl {
+
+void f32_sse_multichannel_biquad_core_operator_impl::perform(const float *src, float *dest, int n, int stride,
+                                                             const float *CXXPH_RESTRICT coeffs,
+                                                             float *CXXPH_RESTRICT state) CXXPH_NOEXCEPT
+{
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    const __m128 b0 = _mm_loadu_ps(&coeffs[0 * 4]);
+    const __m128 b1 = _mm_loadu_ps(&coeffs[1 * 4]);
+    const __m128 b2 = _mm_loadu_ps(&coeffs[2 * 4]);
+    const __m128 ia1 = _mm_loadu_ps(&coeffs[3 * 4]);
+    const __m128 ia2 = _mm_loadu_ps(&coeffs[4 * 4]);
+
+    __m128 s1 = _mm_loadu_ps(&state[0 * 4]);
+    __m128 s2 = _mm_loadu_ps(&state[1 * 4]);
+
+    for (int i = 0; i < n; ++i) {
+        const __m128 x = _mm_loadu_ps(&src[i * stride]);
+        const __m128 y = _mm_add_ps(s1, _mm_mul_ps(b0, x));
+
+        // NOTE: (s2 + b1 * x) does not depend on y, so it is kept out of the critical path
+        s1 = _mm_add_ps(_mm_add_ps(s2, _mm_mul_ps(b1, x)), _mm_mul_ps(ia1, y));
+        s2 = _mm_add_ps(_mm_mul_ps(b2, x), _mm_mul_ps(ia2, y));
+
+        _mm_storeu_ps(&dest[i * stride], y);
+    }
+
+    _mm_storeu_ps(&state[0 * 4], s1);
+    _mm_storeu_ps(&state[1 * 4], s2);
+#else
+    for (int i = 0; i < n; ++i) {
+        const float *x = &src[i * stride];
+        float *y = &dest[i * stride];
+
+        for (int j = 0; j < 4; ++j) {
+            const float x0 = x[j];
+            const float y0 = state[j] + coeffs[0 * 4 + j] * x0;
+
+            state[j] = (state[4 + j] + coeffs[1 * 4 + j] * x0) + coeffs[3 * 4 + j] * y0;
+            state[4 + j] = coeffs[2 * 4 + j] * x0 + coeffs[4 * 4 + j] * y0;
+
+            y[j] = y0;
+        }
+    }
+#endif
+}
+
+} // namespace impl
+} // namespace filter
+} // namespace cxxdasp
+
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
@@ -16,6 +16,14 @@
 
 #include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
 
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/aligned_memory.hpp>
+
 namespace cxxdasp {
 namespace resampler {
 
@@ -63,6 +71,227 @@ void polyphase_resampler_utils::make_interleaved_coeffs_table(const double *src_
     template_func_make_interleaved_coeffs_table(src_coeffs, num_src_coeffs, m, dest_interleaved_coeffs);
 }
 
+void polyphase_resampler_utils::make_phase_schedule_table(int m, int l, int subtable_size,
+                                                          phase_schedule_entry *dest_table)
+{
+    // read position (in M times oversampled rate) = (delay offset * M + phase),
+    // it advances L per output and the (phase -> next phase) mapping repeats every M outputs.
+    for (int phase = 0; phase < m; ++phase) {
+        const int t = phase + l;
+
+        dest_table[phase].coeffs_offset = ((m - 1) - phase) * subtable_size;
+        dest_table[phase].delay_advance = t / m;
+        dest_table[phase].next_phase = t % m;
+    }
+}
+
+int polyphase_resampler_utils::calc_variable_ratio_coeffs_subtable_stride(int num_coeffs, int num_phases,
+                                                                          size_t coeffs_size)
+{
+    // round up to keep each sub table aligned
+    const int align = static_cast<int>(CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE / coeffs_size);
+    const int subtable_size = calc_interleaved_coeffs_subtable_size(num_coeffs, num_phases);
+
+    return ((subtable_size + (align - 1)) / align) * align;
+}
+
+template <typename T>
+void template_func_make_variable_ratio_coeffs_table(const T *src_coeffs, int num_src_coeffs, int num_phases,
+                                                    T *dest_coeffs)
+{
+    const int sub_table_size = polyphase_resampler_utils::calc_interleaved_coeffs_subtable_size(num_src_coeffs,
+                                                                                                num_phases);
+    const int stride =
+        polyphase_resampler_utils::calc_variable_ratio_coeffs_subtable_stride(num_src_coeffs, num_phases, sizeof(T));
+
+    // (num_phases + 1) sub tables, the last one is equivalent to the first one advanced by a sample
+    for (int i = 0; i <= num_phases; ++i) {
+        T *dest_sub_table = &dest_coeffs[stride * i];
+
+        for (int j = 0; j < stride; ++j) {
+            const int k = ((sub_table_size - 1 - j) * num_phases) + i;
+            dest_sub_table[j] =
+                (j < sub_table_size && k < num_src_coeffs) ? (src_coeffs[k] * num_phases) : static_cast<T>(0);
+        }
+    }
+}
+
+void polyphase_resampler_utils::make_variable_ratio_coeffs_table(const float *src_coeffs, int num_src_coeffs,
+                                                                 int num_phases, float *dest_coeffs)
+{
+    template_func_make_variable_ratio_coeffs_table(src_coeffs, num_src_coeffs, num_phases, dest_coeffs);
+}
+
+void polyphase_resampler_utils::make_variable_ratio_coeffs_table(const double *src_coeffs, int num_src_coeffs,
+                                                                 int num_phases, double *dest_coeffs)
+{
+    template_func_make_variable_ratio_coeffs_table(src_coeffs, num_src_coeffs, num_phases, dest_coeffs);
+}
+
+namespace {
+
+// 64-bit FNV-1a over the bit patterns of the coefficients
+uint64_t default_coeffs_hash(const void *data, size_t size)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+    uint64_t h = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+std::atomic<polyphase_resampler_utils::coeffs_hash_func_t> coeffs_hash_func(&default_coeffs_hash);
+
+// Process-wide cache of interleaved coefficient tables.
+// Entries are bucketed by the shape of the table and a hash of the source coefficients, so resamplers built from
+// identical coefficients share a table regardless of where the source array lives. The hash is only used for
+// bucketing; the contents of an entry are always compared with the source before it is shared.
+// Entries only hold weak references, so a table is released as soon as the last resampler using it is destroyed.
+template <typename T>
+class interleaved_coeffs_table_cache {
+public:
+    static interleaved_coeffs_table_cache &instance()
+    {
+        static interleaved_coeffs_table_cache cache;
+        return cache;
+    }
+
+    std::shared_ptr<const T> acquire(const T *src_coeffs, int num_src_coeffs, int m, bool src_is_interleaved)
+    {
+        const int subtable_size = polyphase_resampler_utils::calc_interleaved_coeffs_subtable_size(num_src_coeffs, m);
+        const int table_size = subtable_size * m;
+        const int num_hashed = (src_is_interleaved) ? table_size : num_src_coeffs;
+        const uint64_t hash = (coeffs_hash_func.load())(src_coeffs, sizeof(T) * static_cast<size_t>(num_hashed));
+        const key_t key(hash, num_src_coeffs, m, src_is_interleaved);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const std::pair<typename map_t::iterator, typename map_t::iterator> range = tables_.equal_range(key);
+
+        for (typename map_t::iterator it = range.first; it != range.second; ++it) {
+            std::shared_ptr<const table_t> table = it->second.lock();
+
+            if (table && is_same_contents(*table, src_coeffs, num_src_coeffs, m, src_is_interleaved)) {
+                return std::shared_ptr<const T>(table, &((*table)[0]));
+            }
+        }
+
+        std::shared_ptr<table_t> table(new table_t());
+
+        table->allocate(table_size, CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+
+        if (src_is_interleaved) {
+            for (int i = 0; i < table_size; ++i) {
+                (*table)[i] = src_coeffs[i];
+            }
+        } else {
+            polyphase_resampler_utils::make_interleaved_coeffs_table(src_coeffs, num_src_coeffs, m, &((*table)[0]));
+        }
+
+        sweep_expired_entries();
+        tables_.insert(typename map_t::value_type(key, table));
+
+        return std::shared_ptr<const T>(table, &((*table)[0]));
+    }
+
+private:
+    typedef cxxporthelper::aligned_memory<T> table_t;
+
+    struct key_t {
+        uint64_t hash;
+        int num_src_coeffs;
+        int m;
+        bool src_is_interleaved;
+
+        key_t(uint64_t hash, int num_src_coeffs, int m, bool src_is_interleaved)
+            : hash(hash), num_src_coeffs(num_src_coeffs), m(m), src_is_interleaved(src_is_interleaved)
+        {
+        }
+
+        bool operator<(const key_t &rhs) const
+        {
+            if (hash != rhs.hash)
+                return hash < rhs.hash;
+            if (num_src_coeffs != rhs.num_src_coeffs)
+                return num_src_coeffs < rhs.num_src_coeffs;
+            if (m != rhs.m)
+                return m < rhs.m;
+            return src_is_interleaved < rhs.src_is_interleaved;
+        }
+    };
+
+    // NOTE: entries of different contents can share a key on hash collisions
+    typedef std::multimap<key_t, std::weak_ptr<const table_t>> map_t;
+
+    // bitwise comparison (same as the table which would be built from the source)
+    static bool is_same_contents(const table_t &table, const T *src_coeffs, int num_src_coeffs, int m,
+                                 bool src_is_interleaved)
+    {
+        const int subtable_size = polyphase_resampler_utils::calc_interleaved_coeffs_subtable_size(num_src_coeffs, m);
+
+        if (src_is_interleaved) {
+            return ::memcmp(&table[0], src_coeffs, sizeof(T) * static_cast<size_t>(subtable_size * m)) == 0;
+        }
+
+        for (int i = 0; i < m; ++i) {
+            const T *sub_table = &table[subtable_size * i];
+
+            for (int j = 0; j < subtable_size; ++j) {
+                const int k = (j * m) + i;
+                const T expected = (k < num_src_coeffs) ? (src_coeffs[k] * m) : 0.0f;
+
+                if (::memcmp(&sub_table[j], &expected, sizeof(T)) != 0) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void sweep_expired_entries()
+    {
+        typename map_t::iterator it = tables_.begin();
+
+        while (it != tables_.end()) {
+            if (it->second.expired()) {
+                it = tables_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    map_t tables_;
+};
+
+} // anonymous namespace
+
+polyphase_resampler_utils::coeffs_hash_func_t
+polyphase_resampler_utils::set_shared_coeffs_table_hash_func(coeffs_hash_func_t func)
+{
+    return coeffs_hash_func.exchange((func) ? func : &default_coeffs_hash);
+}
+
+std::shared_ptr<const float> polyphase_resampler_utils::acquire_shared_interleaved_coeffs_table(
+    const float *src_coeffs, int num_src_coeffs, int m, bool src_is_interleaved)
+{
+    return interleaved_coeffs_table_cache<float>::instance().acquire(src_coeffs, num_src_coeffs, m,
+                                                                     src_is_interleaved);
+}
+
+std::shared_ptr<const double> polyphase_resampler_utils::acquire_shared_interleaved_coeffs_table(
+    const double *src_coeffs, int num_src_coeffs, int m, bool src_is_interleaved)
+{
+    return interleaved_coeffs_table_cache<double>::instance().acquire(src_coeffs, num_src_coeffs, m,
+                                                                      src_is_interleaved);
+}
+
 bool polyphase_resampler_utils::check_is_pass_through(const float *src_coeffs, int num_src_coeffs, int m, int l)
 {
     return (m == 1 && l == 1 && num_src_coeffs == 1 && src_coeffs[0] == 1.0f);
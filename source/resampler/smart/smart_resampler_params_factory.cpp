@@ -16,7 +16,15 @@
 
 #include <cxxdasp/resampler/smart/smart_resampler_params_factory.hpp>
 #include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
+#include <cxxdasp/window/window_functions.hpp>
 
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <cxxporthelper/aligned_memory.hpp>
+#include <cxxporthelper/cmath>
 #include <cxxporthelper/compiler.hpp>
 
 //
@@ -39,6 +47,17 @@
         true, (var_name), (sizeof(var_name) / sizeof((var_name)[0])), false                                            \
     }
 
+#define DECL_HALFBAND_DECIMATOR_FIR_INFO(var_name)                                                                     \
+    {                                                                                                                  \
+        true, (var_name), (sizeof(var_name) / sizeof((var_name)[0])), false, true                                      \
+    }
+
+#define DECL_HALFBAND_CASCADE_DECIMATOR_FIR_INFO(var_name, num_stages, pre_var_name)                                \
+    {                                                                                                                  \
+        true, (var_name), (sizeof(var_name) / sizeof((var_name)[0])), false, true, (num_stages), (pre_var_name),       \
+            (sizeof(pre_var_name) / sizeof((pre_var_name)[0]))                                                         \
+    }
+
 #define DECL_FFT_FIR_INFO(var_name)                                                                                    \
     {                                                                                                                  \
         true, (var_name), (sizeof(var_name) / sizeof((var_name)[0])), true                                             \
@@ -200,6 +219,21 @@ VERIFY_POLY_FIR_COEFFS_SIZE(stage2_coeffs_hq_m441, 441);
 //
 static const stage1_x2_fir_info stage1_halfband_lq = DECL_HALFBAND_FIR_INFO(stage1_halfband_coeffs_lq);
 static const stage1_x2_fir_info stage1_halfband_mq = DECL_HALFBAND_FIR_INFO(stage1_halfband_coeffs_mq);
+static const stage1_x2_fir_info stage1_halfband_decimator_lq =
+    DECL_HALFBAND_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_lq);
+static const stage1_x2_fir_info stage1_halfband_decimator_mq =
+    DECL_HALFBAND_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_mq);
+
+// NOTE: The stages except the last one only have to keep the band below the final output Nyquist freq.,
+//       so they always use the short (LQ) kernel.
+static const stage1_x2_fir_info stage1_halfband_decimator_x4_lq =
+    DECL_HALFBAND_CASCADE_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_lq, 2, stage1_halfband_coeffs_lq);
+static const stage1_x2_fir_info stage1_halfband_decimator_x4_mq =
+    DECL_HALFBAND_CASCADE_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_mq, 2, stage1_halfband_coeffs_lq);
+static const stage1_x2_fir_info stage1_halfband_decimator_x8_lq =
+    DECL_HALFBAND_CASCADE_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_lq, 3, stage1_halfband_coeffs_lq);
+static const stage1_x2_fir_info stage1_halfband_decimator_x8_mq =
+    DECL_HALFBAND_CASCADE_DECIMATOR_FIR_INFO(stage1_halfband_coeffs_mq, 3, stage1_halfband_coeffs_lq);
 
 static const stage1_x2_fir_info stage1_fft_nyq = DECL_FFT_FIR_INFO(stage1_fft_coeffs_nyq);
 static const stage1_x2_fir_info stage1_fft_half_nyq = DECL_FFT_FIR_INFO(stage1_fft_coeffs_half_nyq);
@@ -210,6 +244,8 @@ static const stage1_x2_fir_info stage1_fft_96000_44100 = DECL_FFT_FIR_INFO(stage
 static const stage1_x2_fir_info stage1_fft_176400_48000 = DECL_FFT_FIR_INFO(stage1_fft_coeffs_176400_48000);
 static const stage1_x2_fir_info stage1_fft_192000_44100 = DECL_FFT_FIR_INFO(stage1_fft_coeffs_192000_44100);
 
+static const stage2_poly_fir_info stage2_pass_through = DECL_POLY_FIR_INFO(stage2_coeffs_m1, 1, 1);
+
 static const stage2_poly_fir_info stage2_m1_l1[] = { DECL_LQ_POLY_FIR_INFO(stage2_coeffs_m1, 1, 1),
                                                      DECL_HQ_POLY_FIR_INFO(stage2_coeffs_m1, 1, 1), };
 static const stage2_poly_fir_info stage2_m1_l4[] = { DECL_LQ_POLY_FIR_INFO(stage2_coeffs_m1, 1, 4),
@@ -261,6 +297,27 @@ static const stage1_x2_fir_info *get_stage1_filter_info(int input_freq, int outp
         return nullptr;
     }
 
+    if ((quality == smart_resampler_params_factory::LowQuality ||
+         quality == smart_resampler_params_factory::MidQuality) &&
+        (output_freq * 2) == input_freq) {
+        // 2:1 decimation only (stage 2 just passes through)
+        return (quality == smart_resampler_params_factory::LowQuality) ? &stage1_halfband_decimator_lq
+                                                                        : &stage1_halfband_decimator_mq;
+    }
+
+    if ((quality == smart_resampler_params_factory::LowQuality ||
+         quality == smart_resampler_params_factory::MidQuality) &&
+        ((output_freq * 4) == input_freq || (output_freq * 8) == input_freq)) {
+        // 4:1 / 8:1 decimation only (cascaded halfband decimators, stage 2 just passes through)
+        if ((output_freq * 4) == input_freq) {
+            return (quality == smart_resampler_params_factory::LowQuality) ? &stage1_halfband_decimator_x4_lq
+                                                                            : &stage1_halfband_decimator_x4_mq;
+        } else {
+            return (quality == smart_resampler_params_factory::LowQuality) ? &stage1_halfband_decimator_x8_lq
+                                                                            : &stage1_halfband_decimator_x8_mq;
+        }
+    }
+
     if (quality == smart_resampler_params_factory::LowQuality) {
         return &stage1_halfband_lq;
     }
@@ -403,14 +460,248 @@ static const stage2_poly_fir_info *get_stage2_filter_info(int input_freq, int ou
     return &(info[q_index]);
 }
 
+//
+// runtime filter design
+//
+// NOTE: Same design as utils/design_smart_resampler_filter.sce (Kaiser windowed sinc)
+//
+struct smart_resampler_params_factory::designed_fir {
+    cxxporthelper::aligned_memory<float> coeffs; ///< coefficients table
+    int n_coeffs;                                ///< coefficients table size
+
+    designed_fir() : coeffs(), n_coeffs(0) {}
+};
+
+typedef std::shared_ptr<const smart_resampler_params_factory::designed_fir> designed_fir_ptr;
+typedef std::pair<int, int> design_key_t;
+typedef std::pair<design_key_t, int> decimating_design_key_t;
+
+struct design_cache {
+    std::mutex mutex;
+    std::map<design_key_t, designed_fir_ptr> stage1; ///< key: (reduced output freq., reduced input freq.)
+    std::map<design_key_t, designed_fir_ptr> stage2; ///< key: (M, high quality)
+    std::map<decimating_design_key_t, designed_fir_ptr> stage2_dec; ///< key: ((M, L), high quality)
+};
+
+static const int stage1_design_order = 1024;
+static const double stage1_design_alpha = 21.0;
+
+static const int stage2_lq_design_order_k = 8;
+static const double stage2_lq_design_alpha = 8.6;
+static const double stage2_lq_design_fc_shift = 0.14;
+
+static const int stage2_hq_design_order_k = 16;
+static const double stage2_hq_design_alpha = 16.8;
+static const double stage2_hq_design_fc_shift = 0.16;
+
+static const double stage2_design_fc_base = 0.25;
+
+// stage 2 filters used without stage 1 (output freq. < input freq. / 2)
+// (order: taps per output sample period, transition band width ~= 0.17 (LQ) / 0.12 (HQ) of the output freq.)
+static const int stage2_lq_dec_design_order_k = 32;
+static const double stage2_lq_dec_design_alpha = 8.6;
+
+static const int stage2_hq_dec_design_order_k = 64;
+static const double stage2_hq_dec_design_alpha = 12.0;
+
+static design_cache &get_design_cache()
+{
+    static design_cache cache;
+    return cache;
+}
+
+static int calc_gcd(int a, int b) CXXPH_NOEXCEPT
+{
+    while (b != 0) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static void design_kaiser_windowed_lpf(float *dest, int n, double fc, double alpha) CXXPH_NOEXCEPT
+{
+    window::generate_kaiser_window(dest, n, alpha);
+
+    const double center = 0.5 * (n - 1);
+
+    for (int i = 0; i < n; ++i) {
+        const double t = i - center;
+        const double h = (t == 0.0) ? (2.0 * fc) : (sin(2.0 * M_PI * fc * t) / (M_PI * t));
+
+        dest[i] = static_cast<float>(h * dest[i]);
+    }
+}
+
+static designed_fir_ptr get_designed_stage1_filter(int input_freq, int output_freq)
+{
+    const int g = calc_gcd(input_freq, output_freq);
+    const design_key_t key(output_freq / g, input_freq / g);
+
+    design_cache &cache = get_design_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    designed_fir_ptr &entry = cache.stage1[key];
+
+    if (!entry) {
+        const int n = stage1_design_order;
+        const double f_lim = (output_freq >= input_freq) ? 0.25 : (0.25 * output_freq / input_freq);
+        const double fc = f_lim - ((pow(stage1_design_alpha, 0.91) * 0.45) / n);
+
+        std::shared_ptr<smart_resampler_params_factory::designed_fir> fir(
+            new smart_resampler_params_factory::designed_fir());
+
+        fir->coeffs.allocate(n, CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+        fir->n_coeffs = n;
+
+        design_kaiser_windowed_lpf(&(fir->coeffs[0]), n, fc, stage1_design_alpha);
+
+        entry = fir;
+    }
+
+    return entry;
+}
+
+static designed_fir_ptr get_designed_stage2_filter(int m, bool high_quality)
+{
+    const design_key_t key(m, (high_quality) ? 1 : 0);
+
+    design_cache &cache = get_design_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    designed_fir_ptr &entry = cache.stage2[key];
+
+    if (!entry) {
+        const int order_k = (high_quality) ? stage2_hq_design_order_k : stage2_lq_design_order_k;
+        const double alpha = (high_quality) ? stage2_hq_design_alpha : stage2_lq_design_alpha;
+        const double fc_shift = (high_quality) ? stage2_hq_design_fc_shift : stage2_lq_design_fc_shift;
+
+        const int n = order_k * m;
+        const double fc = (stage2_design_fc_base + fc_shift) / m;
+
+        cxxporthelper::aligned_memory<float> prototype(n);
+        design_kaiser_windowed_lpf(&prototype[0], n, fc, alpha);
+
+        std::shared_ptr<smart_resampler_params_factory::designed_fir> fir(
+            new smart_resampler_params_factory::designed_fir());
+
+        fir->coeffs.allocate(n, CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+        fir->n_coeffs = n;
+
+        // convert to poly-phase optimized form (also multiplies by M)
+        polyphase_resampler_utils::make_interleaved_coeffs_table(&prototype[0], n, m, &(fir->coeffs[0]));
+
+        entry = fir;
+    }
+
+    return entry;
+}
+
+static designed_fir_ptr get_designed_decimating_stage2_filter(int m, int l, bool high_quality)
+{
+    const decimating_design_key_t key(design_key_t(m, l), (high_quality) ? 1 : 0);
+
+    design_cache &cache = get_design_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    designed_fir_ptr &entry = cache.stage2_dec[key];
+
+    if (!entry) {
+        const int order_k = (high_quality) ? stage2_hq_dec_design_order_k : stage2_lq_dec_design_order_k;
+        const double alpha = (high_quality) ? stage2_hq_dec_design_alpha : stage2_lq_dec_design_alpha;
+
+        // round up to keep the sub table size multiple of 4 (for SIMD ops)
+        const int subtable_size = ((((order_k * l) + (m - 1)) / m + 3) / 4) * 4;
+        const int n = subtable_size * m;
+
+        // Kaiser window: attenuation [dB] and transition band width (normalized by the output freq.)
+        const double atten = (alpha / 0.1102) + 8.7;
+        const double tw = (atten - 7.95) / (14.36 * n / l);
+
+        // stop band starts at the output Nyquist freq.
+        const double fc = (0.5 - 0.5 * tw) / l;
+
+        cxxporthelper::aligned_memory<float> prototype(n);
+        design_kaiser_windowed_lpf(&prototype[0], n, fc, alpha);
+
+        std::shared_ptr<smart_resampler_params_factory::designed_fir> fir(
+            new smart_resampler_params_factory::designed_fir());
+
+        fir->coeffs.allocate(n, CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE);
+        fir->n_coeffs = n;
+
+        // convert to poly-phase optimized form (also multiplies by M)
+        polyphase_resampler_utils::make_interleaved_coeffs_table(&prototype[0], n, m, &(fir->coeffs[0]));
+
+        entry = fir;
+    }
+
+    return entry;
+}
+
 //
 // smart_resampler_params_factory
 //
 smart_resampler_params_factory::smart_resampler_params_factory(int input_freq, int output_freq, quality_spec_t quality)
-    : is_valid_(false), params_()
+    : is_valid_(false), params_(), designed_stage1_(), designed_stage2_()
 {
+    if (!(input_freq > 0 && output_freq > 0)) {
+        return;
+    }
+
     const stage1_x2_fir_info *s1 = get_stage1_filter_info(input_freq, output_freq, quality);
-    const stage2_poly_fir_info *s2 = get_stage2_filter_info(input_freq, output_freq, quality);
+    const stage2_poly_fir_info *s2 = (s1 && s1->use_halfband_decimator)
+                                         ? &stage2_pass_through
+                                         : get_stage2_filter_info(input_freq, output_freq, quality);
+
+    stage1_x2_fir_info designed_s1;
+    stage2_poly_fir_info designed_s2;
+
+    // design filters which are not in the pre-designed tables
+    bool skip_stage1 = false;
+
+    if (!(s1 && s2) && (output_freq * 2LL) < input_freq) {
+        // Downsampling more than 2:1; the x2 oversampling stage would run at (input freq. x 2)
+        // only to be decimated again, so a single polyphase stage does the anti-aliasing instead.
+        const int g = calc_gcd(output_freq, input_freq);
+        const int m = output_freq / g;
+        const int l = input_freq / g;
+
+        if (l <= max_designed_stage2_m) {
+            designed_stage2_ = get_designed_decimating_stage2_filter(m, l, (quality != LowQuality));
+            designed_s2 =
+                stage2_poly_fir_info(false, &(designed_stage2_->coeffs[0]), designed_stage2_->n_coeffs, m, l);
+            s1 = nullptr;
+            s2 = &designed_s2;
+            skip_stage1 = true;
+        }
+    }
+
+    if (!s1 && !skip_stage1 && (input_freq != output_freq)) {
+        designed_stage1_ = get_designed_stage1_filter(input_freq, output_freq);
+        designed_s1 = stage1_x2_fir_info(false, &(designed_stage1_->coeffs[0]), designed_stage1_->n_coeffs, true);
+        s1 = &designed_s1;
+    }
+
+    if (!s2) {
+        const int mid_freq = (s1) ? (input_freq * 2) : input_freq;
+        const int g = calc_gcd(output_freq, mid_freq);
+        const int m = output_freq / g;
+        const int l = mid_freq / g;
+
+        if (m == 1) {
+            designed_s2 = stage2_poly_fir_info(true, stage2_coeffs_m1, 1, 1, l);
+        } else if (m <= max_designed_stage2_m) {
+            designed_stage2_ = get_designed_stage2_filter(m, (quality != LowQuality));
+            designed_s2 =
+                stage2_poly_fir_info(false, &(designed_stage2_->coeffs[0]), designed_stage2_->n_coeffs, m, l);
+        } else {
+            return;
+        }
+
+        s2 = &designed_s2;
+    }
 
     if (!((s1 && s2) || (s2))) {
         return;
@@ -429,5 +720,15 @@ smart_resampler_params_factory::smart_resampler_params_factory(int input_freq, i
     is_valid_ = true;
 }
 
+void smart_resampler_params_factory::clear_design_cache() CXXPH_NOEXCEPT
+{
+    design_cache &cache = get_design_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    cache.stage1.clear();
+    cache.stage2.clear();
+    cache.stage2_dec.clear();
+}
+
 } // namespace resampler
 } // namespace cxxdasp
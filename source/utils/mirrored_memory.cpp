@@ -0,0 +1,144 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/utils/mirrored_memory.hpp>
+
+#if (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_LINUX) || (CXXPH_TARGET_PLATFORM == CXXPH_PLATFORM_ANDROID)
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define CXXDASP_MIRRORED_MEMORY_USE_MEMFD 1
+#else
+#define CXXDASP_MIRRORED_MEMORY_USE_MEMFD 0
+#endif
+
+namespace cxxdasp {
+namespace utils {
+
+#if CXXDASP_MIRRORED_MEMORY_USE_MEMFD
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+static int create_memfd(const char *name) CXXPH_NOEXCEPT
+{
+#ifdef SYS_memfd_create
+    // NOTE: call via syscall() to support older C libraries which do not have memfd_create() wrapper
+    return static_cast<int>(::syscall(SYS_memfd_create, name, 0U));
+#else
+    (void)name;
+    return -1;
+#endif
+}
+
+} // namespace impl
+/// @endcond
+
+bool mirrored_memory_allocator::is_supported() CXXPH_NOEXCEPT
+{
+    static const bool supported = []() {
+        const int fd = impl::create_memfd("cxxdasp_mirrored_memory");
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+
+    return supported;
+}
+
+std::size_t mirrored_memory_allocator::granularity() CXXPH_NOEXCEPT
+{
+    if (!is_supported()) {
+        return 0;
+    }
+
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    return (page_size > 0) ? static_cast<std::size_t>(page_size) : 0;
+}
+
+void *mirrored_memory_allocator::allocate(std::size_t size) CXXPH_NOEXCEPT
+{
+    const std::size_t g = granularity();
+
+    if (g == 0 || size == 0 || (size % g) != 0) {
+        return nullptr;
+    }
+
+    const int fd = impl::create_memfd("cxxdasp_mirrored_memory");
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // reserve (2 * size) bytes of contiguous address space
+    void *base = ::mmap(nullptr, (2 * size), PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    // map the same pages to the both halves
+    unsigned char *p = static_cast<unsigned char *>(base);
+    void *p1 = ::mmap(p, size, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0);
+    void *p2 = ::mmap((p + size), size, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0);
+
+    // the mappings hold the reference to the memory object
+    ::close(fd);
+
+    if (p1 != p || p2 != (p + size)) {
+        ::munmap(base, (2 * size));
+        return nullptr;
+    }
+
+    return base;
+}
+
+void mirrored_memory_allocator::deallocate(void *p, std::size_t size) CXXPH_NOEXCEPT
+{
+    if (p) {
+        ::munmap(p, (2 * size));
+    }
+}
+
+#else
+
+bool mirrored_memory_allocator::is_supported() CXXPH_NOEXCEPT { return false; }
+
+std::size_t mirrored_memory_allocator::granularity() CXXPH_NOEXCEPT { return 0; }
+
+void *mirrored_memory_allocator::allocate(std::size_t size) CXXPH_NOEXCEPT
+{
+    (void)size;
+    return nullptr;
+}
+
+void mirrored_memory_allocator::deallocate(void *p, std::size_t size) CXXPH_NOEXCEPT
+{
+    (void)p;
+    (void)size;
+}
+
+#endif
+
+} // namespace utils
+} // namespace cxxdasp
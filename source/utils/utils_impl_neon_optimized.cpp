@@ -896,6 +896,100 @@ static void aarch64_neon_multiply_aligned(std::complex<double> *CXXPH_RESTRICT d
 }
 #endif
 
+//
+// multiply_accumulate / multiply_conj_accumulate
+//
+// A = a0 + {a1}i
+// B = b0 + {b1}i
+// (A * B) = (a0*b0 - a1*b1) + {(a0*b1 + a1*b0)}i
+// (A * conj(B)) = (a0*b0 + a1*b1) + {(a1*b0 - a0*b1)}i
+//
+// NOTE: written with intrinsics; vld2q/vst2q (de)interleave real and imaginary parts,
+// so the same code is used for both of AArch32 and AArch64.
+//
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+template <bool ConjY>
+static void neon_multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<float> *CXXPH_RESTRICT x,
+                                             const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    float *CXXPH_RESTRICT fsd = reinterpret_cast<float *>(src_dest);
+    const float *CXXPH_RESTRICT fx = reinterpret_cast<const float *>(x);
+    const float *CXXPH_RESTRICT fy = reinterpret_cast<const float *>(y);
+
+    const int n1 = (n >> 2);
+
+    for (int i = 0; i < n1; ++i) {
+        float32x4x2_t acc = vld2q_f32(&fsd[8 * i]);
+        const float32x4x2_t a = vld2q_f32(&fx[8 * i]);
+        const float32x4x2_t b = vld2q_f32(&fy[8 * i]);
+
+        if (ConjY) {
+            acc.val[0] = vmlaq_f32(acc.val[0], a.val[0], b.val[0]);
+            acc.val[0] = vmlaq_f32(acc.val[0], a.val[1], b.val[1]);
+            acc.val[1] = vmlaq_f32(acc.val[1], a.val[1], b.val[0]);
+            acc.val[1] = vmlsq_f32(acc.val[1], a.val[0], b.val[1]);
+        } else {
+            acc.val[0] = vmlaq_f32(acc.val[0], a.val[0], b.val[0]);
+            acc.val[0] = vmlsq_f32(acc.val[0], a.val[1], b.val[1]);
+            acc.val[1] = vmlaq_f32(acc.val[1], a.val[0], b.val[1]);
+            acc.val[1] = vmlaq_f32(acc.val[1], a.val[1], b.val[0]);
+        }
+
+        vst2q_f32(&fsd[8 * i], acc);
+    }
+
+    const int m = n1 * 4;
+    if (ConjY) {
+        cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    } else {
+        cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    }
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+template <bool ConjY>
+static void aarch64_neon_multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                                     const std::complex<double> *CXXPH_RESTRICT x,
+                                                     const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    double *CXXPH_RESTRICT dsd = reinterpret_cast<double *>(src_dest);
+    const double *CXXPH_RESTRICT dx = reinterpret_cast<const double *>(x);
+    const double *CXXPH_RESTRICT dy = reinterpret_cast<const double *>(y);
+
+    const int n1 = (n >> 1);
+
+    for (int i = 0; i < n1; ++i) {
+        float64x2x2_t acc = vld2q_f64(&dsd[4 * i]);
+        const float64x2x2_t a = vld2q_f64(&dx[4 * i]);
+        const float64x2x2_t b = vld2q_f64(&dy[4 * i]);
+
+        if (ConjY) {
+            acc.val[0] = vmlaq_f64(acc.val[0], a.val[0], b.val[0]);
+            acc.val[0] = vmlaq_f64(acc.val[0], a.val[1], b.val[1]);
+            acc.val[1] = vmlaq_f64(acc.val[1], a.val[1], b.val[0]);
+            acc.val[1] = vmlsq_f64(acc.val[1], a.val[0], b.val[1]);
+        } else {
+            acc.val[0] = vmlaq_f64(acc.val[0], a.val[0], b.val[0]);
+            acc.val[0] = vmlsq_f64(acc.val[0], a.val[1], b.val[1]);
+            acc.val[1] = vmlaq_f64(acc.val[1], a.val[0], b.val[1]);
+            acc.val[1] = vmlaq_f64(acc.val[1], a.val[1], b.val[0]);
+        }
+
+        vst2q_f64(&dsd[4 * i], acc);
+    }
+
+    if (n & 1) {
+        if (ConjY) {
+            cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        } else {
+            cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        }
+    }
+}
+#endif
+
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM)
 static void aarch32_neon_conj_aligned(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
@@ -2357,6 +2451,78 @@ void multiply_aligned(std::complex<double> *CXXPH_RESTRICT dest, const std::comp
     cxxdasp::utils::impl_general::multiply_aligned(dest, src, x, n);
 }
 
+void multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<float> *CXXPH_RESTRICT x,
+                                 const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    if (cxxporthelper::platform_info::support_arm_neon()) {
+        neon_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<double> *CXXPH_RESTRICT x,
+                                 const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+    if (cxxporthelper::platform_info::support_arm_neon()) {
+        aarch64_neon_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_conj_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<float> *CXXPH_RESTRICT x,
+                                      const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+    if (cxxporthelper::platform_info::support_arm_neon()) {
+        neon_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_conj_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<double> *CXXPH_RESTRICT x,
+                                      const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON && (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+    if (cxxporthelper::platform_info::support_arm_neon()) {
+        aarch64_neon_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+}
+
 void conj_aligned(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
     CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
@@ -23,6 +23,11 @@
 
 #include <cxxdasp/utils/impl/utils_impl_core.hpp>
 #include <cxxdasp/utils/impl/utils_impl_general.hpp>
+#include <cxxdasp/utils/x86_platform_info.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#include <immintrin.h>
+#endif
 
 namespace cxxdasp {
 namespace utils {
@@ -506,6 +511,228 @@ static void sse3_multiply_aligned(std::complex<double> *CXXPH_RESTRICT dest,
 }
 #endif
 
+//
+// multiply_accumulate / multiply_conj_accumulate
+//
+// A = a0 + {a1}i
+// B = b0 + {b1}i
+// (A * B) = (a0*b0 - a1*b1) + {(a0*b1 + a1*b0)}i
+// (A * conj(B)) is calculated as (A * B') where B' = b0 + {-b1}i, flipping the sign bits of b1 on load.
+//
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+template <bool ConjY>
+static void sse_multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                            const std::complex<float> *CXXPH_RESTRICT x,
+                                            const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    float *CXXPH_RESTRICT fsd = reinterpret_cast<float *>(src_dest);
+    const float *CXXPH_RESTRICT fx = reinterpret_cast<const float *>(x);
+    const float *CXXPH_RESTRICT fy = reinterpret_cast<const float *>(y);
+
+    CXXPH_ALIGNAS(16) static const float add_sub_sign_array[4] = { -1.0f, 1.0f, -1.0f, 1.0f };
+    CXXPH_ALIGNAS(16) static const float conj_sign_array[4] = { 0.0f, -0.0f, 0.0f, -0.0f };
+    const __m128 add_sub_sign = _mm_load_ps(add_sub_sign_array);
+    const __m128 conj_sign = _mm_load_ps(conj_sign_array);
+
+    const int n1 = (n >> 1);
+
+    for (int i = 0; i < n1; ++i) {
+        const __m128 acc = _mm_load_ps(&fsd[4 * i]);
+        const __m128 a01 = _mm_load_ps(&fx[4 * i]);
+        const __m128 b01 = (ConjY) ? _mm_xor_ps(_mm_load_ps(&fy[4 * i]), conj_sign) : _mm_load_ps(&fy[4 * i]);
+
+        const __m128 a01r = _mm_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 a01i = _mm_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 b01s = _mm_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 3, 0, 1));
+
+        const __m128 t0 = _mm_mul_ps(a01r, b01);
+        const __m128 t1 = _mm_mul_ps(add_sub_sign, _mm_mul_ps(a01i, b01s));
+
+        _mm_store_ps(&fsd[4 * i], _mm_add_ps(acc, _mm_add_ps(t0, t1)));
+    }
+
+    if (n & 1) {
+        if (ConjY) {
+            cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        } else {
+            cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        }
+    }
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+template <bool ConjY>
+static void sse3_multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<float> *CXXPH_RESTRICT x,
+                                             const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    float *CXXPH_RESTRICT fsd = reinterpret_cast<float *>(src_dest);
+    const float *CXXPH_RESTRICT fx = reinterpret_cast<const float *>(x);
+    const float *CXXPH_RESTRICT fy = reinterpret_cast<const float *>(y);
+
+    CXXPH_ALIGNAS(16) static const float conj_sign_array[4] = { 0.0f, -0.0f, 0.0f, -0.0f };
+    const __m128 conj_sign = _mm_load_ps(conj_sign_array);
+
+    const int n1 = (n >> 2);
+
+    for (int i = 0; i < n1; ++i) {
+        const __m128 acc0 = _mm_load_ps(&fsd[8 * i + 0]);
+        const __m128 acc1 = _mm_load_ps(&fsd[8 * i + 4]);
+        const __m128 a0 = _mm_load_ps(&fx[8 * i + 0]);
+        const __m128 a1 = _mm_load_ps(&fx[8 * i + 4]);
+        const __m128 b0 = (ConjY) ? _mm_xor_ps(_mm_load_ps(&fy[8 * i + 0]), conj_sign) : _mm_load_ps(&fy[8 * i + 0]);
+        const __m128 b1 = (ConjY) ? _mm_xor_ps(_mm_load_ps(&fy[8 * i + 4]), conj_sign) : _mm_load_ps(&fy[8 * i + 4]);
+
+        const __m128 t00 = _mm_mul_ps(_mm_moveldup_ps(a0), b0);
+        const __m128 t01 = _mm_mul_ps(_mm_movehdup_ps(a0), _mm_shuffle_ps(b0, b0, _MM_SHUFFLE(2, 3, 0, 1)));
+        const __m128 t10 = _mm_mul_ps(_mm_moveldup_ps(a1), b1);
+        const __m128 t11 = _mm_mul_ps(_mm_movehdup_ps(a1), _mm_shuffle_ps(b1, b1, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        _mm_store_ps(&fsd[8 * i + 0], _mm_add_ps(acc0, _mm_addsub_ps(t00, t01)));
+        _mm_store_ps(&fsd[8 * i + 4], _mm_add_ps(acc1, _mm_addsub_ps(t10, t11)));
+    }
+
+    const int m = n1 * 4;
+    if (ConjY) {
+        cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    } else {
+        cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    }
+}
+#endif
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+template <bool ConjY>
+CXXDASP_X86_TARGET_AVX
+static void avx_multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                            const std::complex<float> *CXXPH_RESTRICT x,
+                                            const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    // NOTE: arrays are only guaranteed to be 16 bytes aligned, so use unaligned load/store
+    float *CXXPH_RESTRICT fsd = reinterpret_cast<float *>(src_dest);
+    const float *CXXPH_RESTRICT fx = reinterpret_cast<const float *>(x);
+    const float *CXXPH_RESTRICT fy = reinterpret_cast<const float *>(y);
+
+    const __m256 conj_sign = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+
+    const int n1 = (n >> 2);
+
+    for (int i = 0; i < n1; ++i) {
+        const __m256 acc = _mm256_loadu_ps(&fsd[8 * i]);
+        const __m256 a = _mm256_loadu_ps(&fx[8 * i]);
+        const __m256 b = (ConjY) ? _mm256_xor_ps(_mm256_loadu_ps(&fy[8 * i]), conj_sign) : _mm256_loadu_ps(&fy[8 * i]);
+
+        const __m256 t0 = _mm256_mul_ps(_mm256_moveldup_ps(a), b);
+        const __m256 t1 = _mm256_mul_ps(_mm256_movehdup_ps(a), _mm256_permute_ps(b, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        _mm256_storeu_ps(&fsd[8 * i], _mm256_add_ps(acc, _mm256_addsub_ps(t0, t1)));
+    }
+
+    const int m = n1 * 4;
+    if (ConjY) {
+        cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    } else {
+        cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[m], &x[m], &y[m], (n - m));
+    }
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+template <bool ConjY>
+static void sse2_multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<double> *CXXPH_RESTRICT x,
+                                             const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    double *CXXPH_RESTRICT dsd = reinterpret_cast<double *>(src_dest);
+    const double *CXXPH_RESTRICT dx = reinterpret_cast<const double *>(x);
+    const double *CXXPH_RESTRICT dy = reinterpret_cast<const double *>(y);
+
+    CXXPH_ALIGNAS(16) static const double add_sub_sign_array[2] = { -1.0, 1.0 };
+    CXXPH_ALIGNAS(16) static const double conj_sign_array[2] = { 0.0, -0.0 };
+    const __m128d add_sub_sign = _mm_load_pd(add_sub_sign_array);
+    const __m128d conj_sign = _mm_load_pd(conj_sign_array);
+
+    for (int i = 0; i < n; ++i) {
+        const __m128d acc = _mm_load_pd(&dsd[2 * i]);
+        const __m128d a = _mm_load_pd(&dx[2 * i]);
+        const __m128d b = (ConjY) ? _mm_xor_pd(_mm_load_pd(&dy[2 * i]), conj_sign) : _mm_load_pd(&dy[2 * i]);
+
+        const __m128d ar = _mm_unpacklo_pd(a, a);
+        const __m128d ai = _mm_unpackhi_pd(a, a);
+        const __m128d bs = _mm_shuffle_pd(b, b, _MM_SHUFFLE2(0, 1));
+
+        const __m128d t0 = _mm_mul_pd(ar, b);
+        const __m128d t1 = _mm_mul_pd(add_sub_sign, _mm_mul_pd(ai, bs));
+
+        _mm_store_pd(&dsd[2 * i], _mm_add_pd(acc, _mm_add_pd(t0, t1)));
+    }
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+template <bool ConjY>
+static void sse3_multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                             const std::complex<double> *CXXPH_RESTRICT x,
+                                             const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    double *CXXPH_RESTRICT dsd = reinterpret_cast<double *>(src_dest);
+    const double *CXXPH_RESTRICT dx = reinterpret_cast<const double *>(x);
+    const double *CXXPH_RESTRICT dy = reinterpret_cast<const double *>(y);
+
+    CXXPH_ALIGNAS(16) static const double conj_sign_array[2] = { 0.0, -0.0 };
+    const __m128d conj_sign = _mm_load_pd(conj_sign_array);
+
+    for (int i = 0; i < n; ++i) {
+        const __m128d acc = _mm_load_pd(&dsd[2 * i]);
+        const __m128d a = _mm_load_pd(&dx[2 * i]);
+        const __m128d b = (ConjY) ? _mm_xor_pd(_mm_load_pd(&dy[2 * i]), conj_sign) : _mm_load_pd(&dy[2 * i]);
+
+        const __m128d t0 = _mm_mul_pd(_mm_movedup_pd(a), b);
+        const __m128d t1 = _mm_mul_pd(_mm_unpackhi_pd(a, a), _mm_shuffle_pd(b, b, _MM_SHUFFLE2(0, 1)));
+
+        _mm_store_pd(&dsd[2 * i], _mm_add_pd(acc, _mm_addsub_pd(t0, t1)));
+    }
+}
+#endif
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+template <bool ConjY>
+CXXDASP_X86_TARGET_AVX
+static void avx_multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                            const std::complex<double> *CXXPH_RESTRICT x,
+                                            const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    // NOTE: arrays are only guaranteed to be 16 bytes aligned, so use unaligned load/store
+    double *CXXPH_RESTRICT dsd = reinterpret_cast<double *>(src_dest);
+    const double *CXXPH_RESTRICT dx = reinterpret_cast<const double *>(x);
+    const double *CXXPH_RESTRICT dy = reinterpret_cast<const double *>(y);
+
+    const __m256d conj_sign = _mm256_setr_pd(0.0, -0.0, 0.0, -0.0);
+
+    const int n1 = (n >> 1);
+
+    for (int i = 0; i < n1; ++i) {
+        const __m256d acc = _mm256_loadu_pd(&dsd[4 * i]);
+        const __m256d a = _mm256_loadu_pd(&dx[4 * i]);
+        const __m256d b = (ConjY) ? _mm256_xor_pd(_mm256_loadu_pd(&dy[4 * i]), conj_sign) : _mm256_loadu_pd(&dy[4 * i]);
+
+        const __m256d t0 = _mm256_mul_pd(_mm256_movedup_pd(a), b);
+        const __m256d t1 = _mm256_mul_pd(_mm256_permute_pd(a, 0xF), _mm256_permute_pd(b, 0x5));
+
+        _mm256_storeu_pd(&dsd[4 * i], _mm256_add_pd(acc, _mm256_addsub_pd(t0, t1)));
+    }
+
+    if (n & 1) {
+        if (ConjY) {
+            cxxdasp::utils::impl_general::multiply_conj_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        } else {
+            cxxdasp::utils::impl_general::multiply_accumulate(&src_dest[n - 1], &x[n - 1], &y[n - 1], 1);
+        }
+    }
+}
+#endif
+
 #if CXXPH_COMPILER_SUPPORTS_X86_SSE
 static void sse_conj_aligned(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
@@ -1081,6 +1308,126 @@ void multiply_aligned(std::complex<double> *CXXPH_RESTRICT dest, const std::comp
     cxxdasp::utils::impl_general::multiply_aligned(dest, src, x, n);
 }
 
+void multiply_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<float> *CXXPH_RESTRICT x,
+                                 const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        avx_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse() && cxxporthelper::platform_info::support_sse3()) {
+        sse3_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (cxxporthelper::platform_info::support_sse()) {
+        sse_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                 const std::complex<double> *CXXPH_RESTRICT x,
+                                 const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        avx_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse2() && cxxporthelper::platform_info::support_sse3()) {
+        sse3_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+    if (cxxporthelper::platform_info::support_sse2()) {
+        sse2_multiply_accumulate_aligned<false>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_conj_accumulate_aligned(std::complex<float> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<float> *CXXPH_RESTRICT x,
+                                      const std::complex<float> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        avx_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse() && cxxporthelper::platform_info::support_sse3()) {
+        sse3_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+    if (cxxporthelper::platform_info::support_sse()) {
+        sse_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+}
+
+void multiply_conj_accumulate_aligned(std::complex<double> *CXXPH_RESTRICT src_dest,
+                                      const std::complex<double> *CXXPH_RESTRICT x,
+                                      const std::complex<double> *CXXPH_RESTRICT y, int n) CXXPH_NOEXCEPT
+{
+    CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(x, 16);
+    CXXDASP_UTIL_ASSUME_ALIGNED(y, 16);
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+    if (cxxdasp::utils::x86_platform_info::support_avx()) {
+        avx_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2 && CXXPH_COMPILER_SUPPORTS_X86_SSE3
+    if (cxxporthelper::platform_info::support_sse2() && cxxporthelper::platform_info::support_sse3()) {
+        sse3_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE2
+    if (cxxporthelper::platform_info::support_sse2()) {
+        sse2_multiply_accumulate_aligned<true>(src_dest, x, y, n);
+        return;
+    }
+#endif
+
+    cxxdasp::utils::impl_general::multiply_conj_accumulate_aligned(src_dest, x, y, n);
+}
+
 void conj_aligned(std::complex<float> *CXXPH_RESTRICT src_dest, int n) CXXPH_NOEXCEPT
 {
     CXXDASP_UTIL_ASSUME_ALIGNED(src_dest, 16);
@@ -0,0 +1,138 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include <cxxdasp/utils/x86_platform_info.hpp>
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace cxxdasp {
+namespace utils {
+
+/// @cond INTERNAL_FIELD
+namespace impl {
+
+enum {
+    X86_FEATURE_AVX = (1 << 0),
+    X86_FEATURE_AVX2 = (1 << 1),
+    X86_FEATURE_FMA = (1 << 2),
+    X86_FEATURE_AVX512F = (1 << 3),
+};
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+
+static void x86_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) CXXPH_NOEXCEPT
+{
+#if defined(_MSC_VER)
+    int t[4];
+    __cpuidex(t, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned int>(t[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long x86_xgetbv0() CXXPH_NOEXCEPT
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+static int detect_x86_features() CXXPH_NOEXCEPT
+{
+    unsigned int regs[4] = { 0, 0, 0, 0 };
+
+    x86_cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+
+    if (max_leaf < 1) {
+        return 0;
+    }
+
+    x86_cpuid(1, 0, regs);
+
+    const bool has_osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool has_avx = (regs[2] & (1u << 28)) != 0;
+    const bool has_fma = (regs[2] & (1u << 12)) != 0;
+
+    // OS has to save/restore both XMM and YMM registers on context switch
+    if (!(has_osxsave && has_avx && ((x86_xgetbv0() & 0x6) == 0x6))) {
+        return 0;
+    }
+
+    int features = X86_FEATURE_AVX;
+
+    if (has_fma) {
+        features |= X86_FEATURE_FMA;
+    }
+
+    if (max_leaf >= 7) {
+        x86_cpuid(7, 0, regs);
+        if (regs[1] & (1u << 5)) {
+            features |= X86_FEATURE_AVX2;
+        }
+        // OS has to save/restore opmask and ZMM registers too
+        if ((regs[1] & (1u << 16)) && ((x86_xgetbv0() & 0xe6) == 0xe6)) {
+            features |= X86_FEATURE_AVX512F;
+        }
+    }
+
+    return features;
+}
+
+#else
+
+static int detect_x86_features() CXXPH_NOEXCEPT { return 0; }
+
+#endif
+
+static int get_x86_features() CXXPH_NOEXCEPT
+{
+    static const int features = detect_x86_features();
+    return features;
+}
+
+} // namespace impl
+/// @endcond
+
+bool x86_platform_info::support_avx() CXXPH_NOEXCEPT { return (impl::get_x86_features() & impl::X86_FEATURE_AVX) != 0; }
+
+bool x86_platform_info::support_avx2() CXXPH_NOEXCEPT
+{
+    return (impl::get_x86_features() & impl::X86_FEATURE_AVX2) != 0;
+}
+
+bool x86_platform_info::support_fma() CXXPH_NOEXCEPT { return (impl::get_x86_features() & impl::X86_FEATURE_FMA) != 0; }
+
+bool x86_platform_info::support_avx512f() CXXPH_NOEXCEPT
+{
+    return (impl::get_x86_features() & impl::X86_FEATURE_AVX512F) != 0;
+}
+
+} // namespace utils
+} // namespace cxxdasp
@@ -200,5 +200,63 @@ void generate_flat_top_window(float *dest, size_t n) CXXPH_NOEXCEPT
     }
 }
 
+//
+// Kaiser
+//
+static double bessel_i0(double x) CXXPH_NOEXCEPT
+{
+    // power series: I0(x) = sum_k ((x / 2)^k / k!)^2
+    const double hx = 0.5 * x;
+    double sum = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; k < 500; ++k) {
+        const double t = hx / k;
+        term *= (t * t);
+        sum += term;
+
+        if (term < (sum * 1e-17)) {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+void generate_kaiser_window(float *dest, size_t n, double beta) CXXPH_NOEXCEPT
+{
+    assert(dest);
+    assert(n > 0);
+
+    if (!dest) {
+        return;
+    }
+    if (n == 0) {
+        return;
+    }
+
+    if (n == 1) {
+        dest[0] = 1.0f;
+        return;
+    }
+
+    const double inv_i0_beta = 1.0 / bessel_i0(beta);
+    const double r_step = 2.0 / (n - 1);
+
+    const size_t n1 = ((n + 1) / 2);
+    const size_t n2 = (n / 2);
+
+    for (size_t i = 0; i < n1; ++i) {
+        const double r = (r_step * i) - 1.0;
+        const double t = (std::max)(0.0, (1.0 - r * r));
+
+        dest[i] = static_cast<float>(bessel_i0(beta * sqrt(t)) * inv_i0_beta);
+    }
+
+    if (n1 < n) {
+        mirror_copy(&dest[n1], &dest[n2 - 1], n2);
+    }
+}
+
 } // namespace window
 } // namespace cxxdasp
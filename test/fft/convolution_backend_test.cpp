@@ -0,0 +1,165 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/fft/convolution_backend.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix test_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+typedef fft::convolution_backend<test_fft_backend_f> test_convolution_backend;
+
+class ConvolutionBackendTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void make_random_data(std::vector<float> &v, int n, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    v.resize(n);
+    for (auto &x : v) {
+        x = dist(engine);
+    }
+}
+
+static void reference_circular_convolve(const std::vector<float> &x, const std::vector<float> &y,
+                                        std::vector<float> &dest)
+{
+    const int n = static_cast<int>(x.size());
+
+    dest.resize(n);
+    for (int i = 0; i < n; ++i) {
+        double acc = 0.0;
+        for (int j = 0; j < n; ++j) {
+            acc += static_cast<double>(x[j]) * y[(i - j + n) % n];
+        }
+        dest[i] = static_cast<float>(acc);
+    }
+}
+
+// calculates  x1 * y1 (+ x2 * y2)  by fast convolution
+static void fast_circular_convolve(const std::vector<float> &x1, const std::vector<float> &y1,
+                                   const std::vector<float> *x2, const std::vector<float> *y2, std::vector<float> &dest)
+{
+    typedef test_convolution_backend::fft_complex_t complex_t;
+    typedef fft::fft<float, complex_t, test_convolution_backend::forward_real> fft_forward_real;
+    typedef fft::fft<complex_t, float, test_convolution_backend::inverse_real> fft_inverse_real;
+
+    const int n = static_cast<int>(x1.size());
+    const int n_spectrum = test_convolution_backend::num_spectrum_elements(n);
+    const int stride = (n_spectrum + 7) & ~7; // keep each spectrum aligned
+
+    cxxporthelper::aligned_memory<float> f_in(n, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<complex_t> f_out(n_spectrum, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<complex_t> spectra(stride * 4, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<complex_t> i_in(n_spectrum, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<float> i_out(n, FFT_MEMORY_ALIGNMENT);
+
+    fft_forward_real fftr_f(n, &f_in[0], &f_out[0]);
+    fft_inverse_real fftr_i(n, &i_in[0], &i_out[0]);
+    test_convolution_backend::multiplier multiplier(n);
+
+    const std::vector<float> *src[4] = { &x1, &y1, x2, y2 };
+    const int num_src = (x2) ? 4 : 2;
+
+    for (int i = 0; i < num_src; ++i) {
+        utils::fast_pod_copy(&f_in[0], &(*src[i])[0], n);
+        fftr_f.execute();
+        std::copy(&f_out[0], &f_out[0] + n_spectrum, &spectra[stride * i]);
+    }
+
+    multiplier.multiply(&i_in[0], &spectra[0], &spectra[stride]);
+    if (x2) {
+        multiplier.multiply_accumulate(&i_in[0], &spectra[stride * 2], &spectra[stride * 3]);
+    }
+
+    fftr_i.execute();
+
+    const float scale = 1.0f / (fftr_f.scale() * fftr_f.scale() * fftr_i.scale());
+
+    dest.resize(n);
+    for (int i = 0; i < n; ++i) {
+        dest[i] = i_out[i] * scale;
+    }
+}
+
+TEST_F(ConvolutionBackendTest, multiply)
+{
+    const int n = 256;
+    std::vector<float> x, y, expected, actual;
+
+    make_random_data(x, n, 1);
+    make_random_data(y, n, 2);
+
+    reference_circular_convolve(x, y, expected);
+    fast_circular_convolve(x, y, nullptr, nullptr, actual);
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], 1e-4f) << "i = " << i;
+    }
+}
+
+TEST_F(ConvolutionBackendTest, multiply_accumulate)
+{
+    const int n = 256;
+    std::vector<float> x1, y1, x2, y2, expected1, expected2, actual;
+
+    make_random_data(x1, n, 1);
+    make_random_data(y1, n, 2);
+    make_random_data(x2, n, 3);
+    make_random_data(y2, n, 4);
+
+    reference_circular_convolve(x1, y1, expected1);
+    reference_circular_convolve(x2, y2, expected2);
+    fast_circular_convolve(x1, y1, &x2, &y2, actual);
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR((expected1[i] + expected2[i]), actual[i], 2e-4f) << "i = " << i;
+    }
+}
@@ -0,0 +1,188 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/fft/dynamic_backend.hpp>
+
+using namespace cxxdasp;
+
+typedef fft::backend::f::dynamic dynamic_backend_f;
+
+class DynamicBackendTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+        dynamic_backend_f::clear_selections();
+    }
+    virtual void TearDown() { dynamic_backend_f::clear_selections(); }
+};
+
+static std::vector<std::complex<double>> reference_dft(const std::vector<std::complex<double>> &x, int sign)
+{
+    const int n = static_cast<int>(x.size());
+    const double pi = 3.14159265358979323846;
+    std::vector<std::complex<double>> y(n);
+
+    for (int k = 0; k < n; ++k) {
+        std::complex<double> acc(0.0, 0.0);
+        for (int i = 0; i < n; ++i) {
+            const double phase = 2.0 * pi * static_cast<double>((i * k) % n) / n;
+            acc += x[i] * std::polar(1.0, sign * phase);
+        }
+        y[k] = acc;
+    }
+
+    return y;
+}
+
+static bool is_candidate(const char *name)
+{
+    for (int i = 0; i < dynamic_backend_f::num_candidates(); ++i) {
+        if (::strcmp(name, dynamic_backend_f::candidate_name(i)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F(DynamicBackendTest, candidates) { ASSERT_GE(dynamic_backend_f::num_candidates(), 1); }
+
+TEST_F(DynamicBackendTest, forward)
+{
+    const int n = 64;
+    cxxporthelper::aligned_memory<std::complex<float>> in(n, FFT_MEMORY_ALIGNMENT), out(n, FFT_MEMORY_ALIGNMENT);
+    std::vector<std::complex<double>> x(n);
+
+    for (int i = 0; i < n; ++i) {
+        x[i] = std::complex<double>(std::sin(0.1 * i), std::cos(0.3 * i));
+        in[i] = std::complex<float>(x[i]);
+    }
+
+    dynamic_backend_f::forward fft(n, &in[0], &out[0]);
+
+    ASSERT_TRUE(is_candidate(fft.backend_name()));
+
+    fft.execute();
+
+    const std::vector<std::complex<double>> expected = reference_dft(x, -1);
+    const double scale = fft.scale();
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i].real() * scale, out[i].real(), 1e-3) << "i = " << i;
+        ASSERT_NEAR(expected[i].imag() * scale, out[i].imag(), 1e-3) << "i = " << i;
+    }
+}
+
+TEST_F(DynamicBackendTest, inverse)
+{
+    const int n = 64;
+    cxxporthelper::aligned_memory<std::complex<float>> in(n, FFT_MEMORY_ALIGNMENT), out(n, FFT_MEMORY_ALIGNMENT);
+    std::vector<std::complex<double>> x(n);
+
+    for (int i = 0; i < n; ++i) {
+        x[i] = std::complex<double>(std::sin(0.2 * i), std::cos(0.7 * i));
+        in[i] = std::complex<float>(x[i]);
+    }
+
+    fft::fft<std::complex<float>, std::complex<float>, dynamic_backend_f::inverse> fft(n, &in[0], &out[0]);
+
+    fft.execute();
+
+    const std::vector<std::complex<double>> expected = reference_dft(x, 1);
+    const double scale = static_cast<double>(fft.scale()) / n;
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i].real() * scale, out[i].real(), 1e-3) << "i = " << i;
+        ASSERT_NEAR(expected[i].imag() * scale, out[i].imag(), 1e-3) << "i = " << i;
+    }
+}
+
+TEST_F(DynamicBackendTest, real_round_trip)
+{
+    const int n = 128;
+    cxxporthelper::aligned_memory<float> in(n, FFT_MEMORY_ALIGNMENT), out(n, FFT_MEMORY_ALIGNMENT);
+    cxxporthelper::aligned_memory<std::complex<float>> spectrum(n / 2 + 1, FFT_MEMORY_ALIGNMENT);
+
+    for (int i = 0; i < n; ++i) {
+        in[i] = static_cast<float>(std::sin(0.05 * i) + 0.25 * std::cos(0.9 * i));
+    }
+
+    fft::fft<float, std::complex<float>, dynamic_backend_f::forward_real> fftr_f(n, &in[0], &spectrum[0]);
+    fft::fft<std::complex<float>, float, dynamic_backend_f::inverse_real> fftr_i(n, &spectrum[0], &out[0]);
+
+    fftr_f.execute();
+    fftr_i.execute();
+
+    const float scale = 1.0f / (fftr_f.scale() * fftr_i.scale());
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(in[i], out[i] * scale, 1e-4f) << "i = " << i;
+    }
+}
+
+TEST_F(DynamicBackendTest, selection_is_cached)
+{
+    const char *name1 = dynamic_backend_f::select_backend(fft::DynamicBackendForwardReal, 256);
+    const char *name2 = dynamic_backend_f::select_backend(fft::DynamicBackendForwardReal, 256);
+
+    ASSERT_TRUE(is_candidate(name1));
+    ASSERT_EQ(name1, name2);
+}
+
+TEST_F(DynamicBackendTest, unsupported_size)
+{
+    ASSERT_THROW(dynamic_backend_f::select_backend(fft::DynamicBackendForward, 0), std::runtime_error);
+}
+
+TEST_F(DynamicBackendTest, export_and_import)
+{
+    const char *filename = "dynamic_backend_test_selections.txt";
+
+    // select the last candidate explicitly through the file
+    const char *last = dynamic_backend_f::candidate_name(dynamic_backend_f::num_candidates() - 1);
+    {
+        std::FILE *fp = std::fopen(filename, "w");
+        ASSERT_TRUE(fp != nullptr);
+        std::fprintf(fp, "%d %d %d %s\n", static_cast<int>(sizeof(float) * 8),
+                     static_cast<int>(fft::DynamicBackendForward), 64, last);
+        std::fprintf(fp, "%d %d %d %s\n", static_cast<int>(sizeof(float) * 8),
+                     static_cast<int>(fft::DynamicBackendInverse), 64, "unknown_backend");
+        std::fclose(fp);
+    }
+
+    ASSERT_TRUE(dynamic_backend_f::import_selections(filename));
+    ASSERT_STREQ(last, dynamic_backend_f::select_backend(fft::DynamicBackendForward, 64));
+    ASSERT_TRUE(is_candidate(dynamic_backend_f::select_backend(fft::DynamicBackendInverse, 64)));
+
+    ASSERT_TRUE(dynamic_backend_f::export_selections(filename));
+
+    dynamic_backend_f::clear_selections();
+
+    ASSERT_TRUE(dynamic_backend_f::import_selections(filename));
+    ASSERT_STREQ(last, dynamic_backend_f::select_backend(fft::DynamicBackendForward, 64));
+
+    std::remove(filename);
+
+    ASSERT_FALSE(dynamic_backend_f::import_selections(filename));
+}
@@ -16,6 +16,8 @@
 
 #include "test_common.hpp"
 
+#include <cstdio>
+
 #include <cxxporthelper/aligned_memory.hpp>
 
 #include <cxxdasp/utils/utils.hpp>
@@ -34,6 +36,7 @@ using namespace cxxdasp;
 // #undef CXXDASP_USE_FFT_BACKEND_FFTW
 // #undef CXXDASP_USE_FFT_BACKEND_GP_FFT
 // #undef CXXDASP_USE_FFT_BACKEND_KFR_D
+// #undef CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
 
 template <typename TFFTBackend, typename T>
 class ForwardFFTTest : public ::testing::Test {
@@ -420,6 +423,55 @@ TEST_F(ForwardRealFFTTest_FFTWF_Float, forward_real) { do_forward_real_fft_test(
 
 typedef InverseRealFFTTest<fft::backend::f::fftw, float> InverseRealFFTTest_FFTWF_Float;
 TEST_F(InverseRealFFTTest_FFTWF_Float, inverse_real) { do_inverse_real_fft_test(this); }
+
+template <typename TFFTTest>
+class FFTWFMeasuredPlanTest : public TFFTTest {
+protected:
+    virtual void SetUp()
+    {
+        TFFTTest::SetUp();
+        fft::backend::set_fftw_planning_rigor(fft::backend::FFTWPlanMeasure);
+    }
+    virtual void TearDown()
+    {
+        fft::backend::set_fftw_planning_rigor(fft::backend::FFTWPlanEstimate);
+        TFFTTest::TearDown();
+    }
+};
+
+typedef FFTWFMeasuredPlanTest<ForwardFFTTest_FFTWF_Float> ForwardFFTTest_FFTWF_Float_Measure;
+TEST_F(ForwardFFTTest_FFTWF_Float_Measure, forward) { do_forward_fft_test(this); }
+
+typedef FFTWFMeasuredPlanTest<InverseFFTTest_FFTWF_Float> InverseFFTTest_FFTWF_Float_Measure;
+TEST_F(InverseFFTTest_FFTWF_Float_Measure, inverse) { do_inverse_fft_test(this); }
+
+typedef FFTWFMeasuredPlanTest<ForwardRealFFTTest_FFTWF_Float> ForwardRealFFTTest_FFTWF_Float_Measure;
+TEST_F(ForwardRealFFTTest_FFTWF_Float_Measure, forward_real) { do_forward_real_fft_test(this); }
+
+typedef FFTWFMeasuredPlanTest<InverseRealFFTTest_FFTWF_Float> InverseRealFFTTest_FFTWF_Float_Measure;
+TEST_F(InverseRealFFTTest_FFTWF_Float_Measure, inverse_real) { do_inverse_real_fft_test(this); }
+
+TEST(FFTWisdomTest_FFTWF, export_and_import)
+{
+    cxxdasp_init();
+
+    const char *filename = "fft_test_fftwf_wisdom.dat";
+
+    {
+        cxxporthelper::aligned_memory<std::complex<float>> in, out;
+        in.allocate(64);
+        out.allocate(64);
+        fft::fft<std::complex<float>, std::complex<float>, fft::backend::f::fftw::forward> fft;
+        fft.setup(64, &in[0], &out[0]);
+    }
+
+    ASSERT_TRUE(fft::backend::f::fftw::export_wisdom_to_file(filename));
+    ASSERT_TRUE(fft::backend::f::fftw::import_wisdom_from_file(filename));
+
+    std::remove(filename);
+
+    ASSERT_FALSE(fft::backend::f::fftw::import_wisdom_from_file(filename));
+}
 #endif
 
 //
@@ -505,6 +557,55 @@ TEST_F(ForwardRealFFTTest_FFTW_Double, forward_real) { do_forward_real_fft_test(
 
 typedef InverseRealFFTTest<fft::backend::d::fftw, double> InverseRealFFTTest_FFTW_Double;
 TEST_F(InverseRealFFTTest_FFTW_Double, inverse_real) { do_inverse_real_fft_test(this); }
+
+template <typename TFFTTest>
+class FFTWMeasuredPlanTest : public TFFTTest {
+protected:
+    virtual void SetUp()
+    {
+        TFFTTest::SetUp();
+        fft::backend::set_fftw_planning_rigor(fft::backend::FFTWPlanMeasure);
+    }
+    virtual void TearDown()
+    {
+        fft::backend::set_fftw_planning_rigor(fft::backend::FFTWPlanEstimate);
+        TFFTTest::TearDown();
+    }
+};
+
+typedef FFTWMeasuredPlanTest<ForwardFFTTest_FFTW_Double> ForwardFFTTest_FFTW_Double_Measure;
+TEST_F(ForwardFFTTest_FFTW_Double_Measure, forward) { do_forward_fft_test(this); }
+
+typedef FFTWMeasuredPlanTest<InverseFFTTest_FFTW_Double> InverseFFTTest_FFTW_Double_Measure;
+TEST_F(InverseFFTTest_FFTW_Double_Measure, inverse) { do_inverse_fft_test(this); }
+
+typedef FFTWMeasuredPlanTest<ForwardRealFFTTest_FFTW_Double> ForwardRealFFTTest_FFTW_Double_Measure;
+TEST_F(ForwardRealFFTTest_FFTW_Double_Measure, forward_real) { do_forward_real_fft_test(this); }
+
+typedef FFTWMeasuredPlanTest<InverseRealFFTTest_FFTW_Double> InverseRealFFTTest_FFTW_Double_Measure;
+TEST_F(InverseRealFFTTest_FFTW_Double_Measure, inverse_real) { do_inverse_real_fft_test(this); }
+
+TEST(FFTWisdomTest_FFTW, export_and_import)
+{
+    cxxdasp_init();
+
+    const char *filename = "fft_test_fftw_wisdom.dat";
+
+    {
+        cxxporthelper::aligned_memory<std::complex<double>> in, out;
+        in.allocate(64);
+        out.allocate(64);
+        fft::fft<std::complex<double>, std::complex<double>, fft::backend::d::fftw::forward> fft;
+        fft.setup(64, &in[0], &out[0]);
+    }
+
+    ASSERT_TRUE(fft::backend::d::fftw::export_wisdom_to_file(filename));
+    ASSERT_TRUE(fft::backend::d::fftw::import_wisdom_from_file(filename));
+
+    std::remove(filename);
+
+    ASSERT_FALSE(fft::backend::d::fftw::import_wisdom_from_file(filename));
+}
 #endif
 
 //
@@ -540,3 +641,32 @@ TEST_F(ForwardRealFFTTest_KFR_Double, forward_real) { do_forward_real_fft_test(t
 typedef InverseRealFFTTest<fft::backend::d::kfr, double> InverseRealFFTTest_KFR_Double;
 TEST_F(InverseRealFFTTest_KFR_Double, inverse_real) { do_inverse_real_fft_test(this); }
 #endif
+
+//
+// Built-in mixed-radix FFT
+//
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef ForwardFFTTest<fft::backend::f::mixed_radix, float> ForwardFFTTest_MixedRadix_Float;
+TEST_F(ForwardFFTTest_MixedRadix_Float, forward) { do_forward_fft_test(this); }
+
+typedef InverseFFTTest<fft::backend::f::mixed_radix, float> InverseFFTTest_MixedRadix_Float;
+TEST_F(InverseFFTTest_MixedRadix_Float, inverse) { do_inverse_fft_test(this); }
+
+typedef ForwardRealFFTTest<fft::backend::f::mixed_radix, float> ForwardRealFFTTest_MixedRadix_Float;
+TEST_F(ForwardRealFFTTest_MixedRadix_Float, forward_real) { do_forward_real_fft_test(this); }
+
+typedef InverseRealFFTTest<fft::backend::f::mixed_radix, float> InverseRealFFTTest_MixedRadix_Float;
+TEST_F(InverseRealFFTTest_MixedRadix_Float, inverse_real) { do_inverse_real_fft_test(this); }
+
+typedef ForwardFFTTest<fft::backend::d::mixed_radix, double> ForwardFFTTest_MixedRadix_Double;
+TEST_F(ForwardFFTTest_MixedRadix_Double, forward) { do_forward_fft_test(this); }
+
+typedef InverseFFTTest<fft::backend::d::mixed_radix, double> InverseFFTTest_MixedRadix_Double;
+TEST_F(InverseFFTTest_MixedRadix_Double, inverse) { do_inverse_fft_test(this); }
+
+typedef ForwardRealFFTTest<fft::backend::d::mixed_radix, double> ForwardRealFFTTest_MixedRadix_Double;
+TEST_F(ForwardRealFFTTest_MixedRadix_Double, forward_real) { do_forward_real_fft_test(this); }
+
+typedef InverseRealFFTTest<fft::backend::d::mixed_radix, double> InverseRealFFTTest_MixedRadix_Double;
+TEST_F(InverseRealFFTTest_MixedRadix_Double, inverse_real) { do_inverse_real_fft_test(this); }
+#endif
@@ -0,0 +1,252 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/fft/fft.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+
+template <typename T>
+class MixedRadixFFTTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+
+public:
+    typedef fft::backend::mixed_radix_backend<T> backend_type;
+    typedef T data_type;
+    typedef std::complex<T> complex_type;
+
+    static std::vector<complex_type> make_input(int n)
+    {
+        std::vector<complex_type> x(n);
+        for (int i = 0; i < n; ++i) {
+            x[i] = complex_type(static_cast<T>(std::sin(0.37 * i) + 0.25 * (i % 7)),
+                                static_cast<T>(std::cos(0.91 * i) - 0.125 * (i % 5)));
+        }
+        return x;
+    }
+
+    // naive DFT (double precision)
+    static std::vector<std::complex<double>> dft(const std::vector<complex_type> &x, bool inverse)
+    {
+        const int n = static_cast<int>(x.size());
+        const double sign = (inverse) ? 1.0 : -1.0;
+        std::vector<std::complex<double>> y(n);
+
+        for (int k = 0; k < n; ++k) {
+            std::complex<double> sum(0.0, 0.0);
+            for (int i = 0; i < n; ++i) {
+                const double theta = sign * 2.0 * M_PI * static_cast<double>((static_cast<long long>(i) * k) % n) / n;
+                sum += std::complex<double>(x[i].real(), x[i].imag()) * std::polar(1.0, theta);
+            }
+            y[k] = sum;
+        }
+
+        return y;
+    }
+
+    static double tolerance(int n)
+    {
+        const double eps = (sizeof(T) == sizeof(float)) ? 1e-6 : 1e-14;
+        return 8 * eps * (std::log(static_cast<double>(n) + 1.0) + 1.0);
+    }
+
+    // max. error relative to the peak magnitude of the expected values
+    template <typename TValue>
+    static double relative_error(const std::vector<std::complex<double>> &expected, const TValue *actual, int n)
+    {
+        double peak = 1.0;
+        double err = 0.0;
+        for (int i = 0; i < n; ++i) {
+            peak = (std::max)(peak, std::abs(expected[i]));
+            const std::complex<double> a(std::real(actual[i]), std::imag(actual[i]));
+            err = (std::max)(err, std::abs(a - expected[i]));
+        }
+        return err / peak;
+    }
+};
+
+typedef ::testing::Types<float, double> MixedRadixFFTTestTypes;
+TYPED_TEST_CASE(MixedRadixFFTTest, MixedRadixFFTTestTypes);
+
+static const int complex_test_sizes[] = { 1, 2, 3, 4, 5, 6, 8, 12, 15, 16, 30, 48, 60, 64, 100, 120, 128, 1024, 4096 };
+static const int real_test_sizes[] = { 2, 4, 6, 8, 10, 12, 16, 24, 30, 32, 60, 64, 100, 128, 240, 1024, 4096 };
+
+TYPED_TEST(MixedRadixFFTTest, supported_size)
+{
+    typedef typename TestFixture::backend_type backend_type;
+
+    ASSERT_FALSE(backend_type::is_supported_size(0, false));
+    ASSERT_TRUE(backend_type::is_supported_size(1, false));
+    ASSERT_TRUE(backend_type::is_supported_size(360, false));
+    ASSERT_FALSE(backend_type::is_supported_size(7, false));
+    ASSERT_FALSE(backend_type::is_supported_size(22, false));
+
+    ASSERT_FALSE(backend_type::is_supported_size(1, true));
+    ASSERT_TRUE(backend_type::is_supported_size(2, true));
+    ASSERT_FALSE(backend_type::is_supported_size(15, true));
+    ASSERT_FALSE(backend_type::is_supported_size(14, true));
+    ASSERT_TRUE(backend_type::is_supported_size(1024, true));
+}
+
+TYPED_TEST(MixedRadixFFTTest, forward_and_inverse)
+{
+    typedef typename TestFixture::backend_type backend_type;
+    typedef typename TestFixture::complex_type complex_type;
+
+    for (int n : complex_test_sizes) {
+        const std::vector<complex_type> in_data = TestFixture::make_input(n);
+        cxxporthelper::aligned_memory<complex_type> in(n), out(n);
+
+        // forward
+        {
+            std::copy(in_data.begin(), in_data.end(), &in[0]);
+            fft::fft<complex_type, complex_type, typename backend_type::forward> fft(n, &in[0], &out[0]);
+
+            ASSERT_EQ(1, fft.scale());
+            fft.execute();
+
+            ASSERT_LE(TestFixture::relative_error(TestFixture::dft(in_data, false), &out[0], n),
+                      TestFixture::tolerance(n))
+                << "n = " << n;
+            for (int i = 0; i < n; ++i) {
+                ASSERT_EQ(in_data[i], in[i]);
+            }
+        }
+
+        // inverse
+        {
+            std::copy(in_data.begin(), in_data.end(), &in[0]);
+            fft::fft<complex_type, complex_type, typename backend_type::inverse> fft(n, &in[0], &out[0]);
+
+            ASSERT_EQ(n, fft.scale());
+            fft.execute();
+
+            ASSERT_LE(TestFixture::relative_error(TestFixture::dft(in_data, true), &out[0], n),
+                      TestFixture::tolerance(n))
+                << "n = " << n;
+            for (int i = 0; i < n; ++i) {
+                ASSERT_EQ(in_data[i], in[i]);
+            }
+        }
+    }
+}
+
+TYPED_TEST(MixedRadixFFTTest, in_place)
+{
+    typedef typename TestFixture::backend_type backend_type;
+    typedef typename TestFixture::complex_type complex_type;
+
+    for (int n : complex_test_sizes) {
+        const std::vector<complex_type> in_data = TestFixture::make_input(n);
+        cxxporthelper::aligned_memory<complex_type> buf(n);
+
+        std::copy(in_data.begin(), in_data.end(), &buf[0]);
+        fft::fft<complex_type, complex_type, typename backend_type::forward> fft(n, &buf[0], &buf[0]);
+        fft.execute();
+
+        ASSERT_LE(TestFixture::relative_error(TestFixture::dft(in_data, false), &buf[0], n), TestFixture::tolerance(n))
+            << "n = " << n;
+    }
+}
+
+TYPED_TEST(MixedRadixFFTTest, forward_real_and_inverse_real)
+{
+    typedef typename TestFixture::backend_type backend_type;
+    typedef typename TestFixture::data_type data_type;
+    typedef typename TestFixture::complex_type complex_type;
+
+    for (int n : real_test_sizes) {
+        const std::vector<complex_type> in_complex = TestFixture::make_input(n);
+        std::vector<complex_type> in_data(n);
+        for (int i = 0; i < n; ++i) {
+            in_data[i] = complex_type(in_complex[i].real(), 0);
+        }
+
+        cxxporthelper::aligned_memory<data_type> real_buf(n);
+        cxxporthelper::aligned_memory<complex_type> spectrum(n / 2 + 1);
+
+        // forward_real
+        for (int i = 0; i < n; ++i) {
+            real_buf[i] = in_data[i].real();
+        }
+        fft::fft<data_type, complex_type, typename backend_type::forward_real> fftr(n, &real_buf[0], &spectrum[0]);
+
+        ASSERT_EQ(1, fftr.scale());
+        fftr.execute();
+
+        ASSERT_LE(TestFixture::relative_error(TestFixture::dft(in_data, false), &spectrum[0], n / 2 + 1),
+                  TestFixture::tolerance(n))
+            << "n = " << n;
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(in_data[i].real(), real_buf[i]);
+        }
+
+        // inverse_real (round trip)
+        const std::vector<complex_type> saved_spectrum(&spectrum[0], &spectrum[0] + (n / 2 + 1));
+        cxxporthelper::aligned_memory<data_type> restored(n);
+        fft::fft<complex_type, data_type, typename backend_type::inverse_real> ifftr(n, &spectrum[0], &restored[0]);
+
+        ASSERT_EQ(n, ifftr.scale());
+        ifftr.execute();
+
+        std::vector<std::complex<double>> expected(n);
+        for (int i = 0; i < n; ++i) {
+            expected[i] = std::complex<double>(in_data[i].real() * n, 0.0);
+        }
+        ASSERT_LE(TestFixture::relative_error(expected, &restored[0], n), TestFixture::tolerance(n)) << "n = " << n;
+        for (int i = 0; i < (n / 2 + 1); ++i) {
+            ASSERT_EQ(saved_spectrum[i], spectrum[i]);
+        }
+    }
+}
+
+TYPED_TEST(MixedRadixFFTTest, shared_setup)
+{
+    typedef typename TestFixture::backend_type backend_type;
+    typedef typename TestFixture::complex_type complex_type;
+
+    const int n = 240;
+    const std::vector<complex_type> in_data = TestFixture::make_input(n);
+    cxxporthelper::aligned_memory<complex_type> in(n), out1(n), out2(n);
+
+    std::copy(in_data.begin(), in_data.end(), &in[0]);
+
+    typename backend_type::forward fft1(n, &in[0], &out1[0]);
+    typename backend_type::forward fft2(n, &in[0], &out2[0]);
+
+    ASSERT_EQ(1, backend_type::setup_cache::num_cached_plans());
+
+    fft1.execute();
+    fft2.execute();
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(out1[i], out2[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,199 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/fft/fft.hpp>
+#include <cxxdasp/fft/plan_cache.hpp>
+
+using namespace cxxdasp;
+
+namespace {
+
+struct dummy_plan {
+    int n;
+    int variant;
+};
+
+struct dummy_plan_factory {
+    static int num_created;
+    static int num_destroyed;
+
+    static dummy_plan *create(int n, int variant)
+    {
+        ++num_created;
+        return new dummy_plan{ n, variant };
+    }
+
+    static void destroy(dummy_plan *plan)
+    {
+        ++num_destroyed;
+        delete plan;
+    }
+};
+
+int dummy_plan_factory::num_created = 0;
+int dummy_plan_factory::num_destroyed = 0;
+
+template <typename TTag>
+typename fft::shared_plan_cache<TTag, dummy_plan>::plan_ptr acquire_dummy_plan(int n, int variant)
+{
+    return fft::shared_plan_cache<TTag, dummy_plan>::acquire(
+        n, variant, [n, variant]() { return dummy_plan_factory::create(n, variant); }, &dummy_plan_factory::destroy);
+}
+
+} // anonymous namespace
+
+class SharedPlanCacheTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+        dummy_plan_factory::num_created = 0;
+        dummy_plan_factory::num_destroyed = 0;
+    }
+    virtual void TearDown() {}
+};
+
+TEST_F(SharedPlanCacheTest, same_key_shares_plan)
+{
+    struct tag {
+    };
+    typedef fft::shared_plan_cache<tag, dummy_plan> cache;
+
+    cache::plan_ptr p1 = acquire_dummy_plan<tag>(256, 0);
+    cache::plan_ptr p2 = acquire_dummy_plan<tag>(256, 0);
+
+    ASSERT_TRUE(p1.get() != nullptr);
+    ASSERT_EQ(p1.get(), p2.get());
+    ASSERT_EQ(1, dummy_plan_factory::num_created);
+    ASSERT_EQ(1, cache::num_cached_plans());
+}
+
+TEST_F(SharedPlanCacheTest, different_key_creates_new_plan)
+{
+    struct tag {
+    };
+    struct other_tag {
+    };
+    typedef fft::shared_plan_cache<tag, dummy_plan> cache;
+
+    cache::plan_ptr p1 = acquire_dummy_plan<tag>(256, 0);
+    cache::plan_ptr p2 = acquire_dummy_plan<tag>(512, 0);
+    cache::plan_ptr p3 = acquire_dummy_plan<tag>(256, 1);
+    cache::plan_ptr p4 = acquire_dummy_plan<other_tag>(256, 0);
+
+    ASSERT_NE(p1.get(), p2.get());
+    ASSERT_NE(p1.get(), p3.get());
+    ASSERT_NE(p1.get(), p4.get());
+    ASSERT_EQ(512, p2->n);
+    ASSERT_EQ(1, p3->variant);
+    ASSERT_EQ(4, dummy_plan_factory::num_created);
+    ASSERT_EQ(3, cache::num_cached_plans());
+}
+
+TEST_F(SharedPlanCacheTest, plan_is_destroyed_with_last_reference)
+{
+    struct tag {
+    };
+    typedef fft::shared_plan_cache<tag, dummy_plan> cache;
+
+    cache::plan_ptr p1 = acquire_dummy_plan<tag>(256, 0);
+    cache::plan_ptr p2 = p1;
+
+    p1.reset();
+    ASSERT_EQ(0, dummy_plan_factory::num_destroyed);
+    ASSERT_EQ(1, cache::num_cached_plans());
+
+    p2.reset();
+    ASSERT_EQ(1, dummy_plan_factory::num_destroyed);
+    ASSERT_EQ(0, cache::num_cached_plans());
+
+    // re-created on demand
+    cache::plan_ptr p3 = acquire_dummy_plan<tag>(256, 0);
+    ASSERT_EQ(2, dummy_plan_factory::num_created);
+}
+
+TEST_F(SharedPlanCacheTest, concurrent_acquire)
+{
+    struct tag {
+    };
+    typedef fft::shared_plan_cache<tag, dummy_plan> cache;
+
+    const int num_threads = 8;
+    const int num_iterations = 1000;
+
+    cache::plan_ptr holder = acquire_dummy_plan<tag>(1024, 0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.push_back(std::thread([holder, num_iterations]() {
+            for (int i = 0; i < num_iterations; ++i) {
+                cache::plan_ptr p = acquire_dummy_plan<tag>(1024, 0);
+                if (p.get() != holder.get()) {
+                    ADD_FAILURE();
+                    return;
+                }
+                acquire_dummy_plan<tag>(64 + (i & 7), 1);
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    ASSERT_EQ(1, cache::num_cached_plans());
+    ASSERT_EQ(dummy_plan_factory::num_created - 1, dummy_plan_factory::num_destroyed);
+}
+
+#if CXXDASP_USE_FFT_BACKEND_KISS_FFT
+TEST_F(SharedPlanCacheTest, kiss_fft_instances_share_cfg)
+{
+    typedef fft::backend::f::kiss_fft backend_type;
+
+    const int n = 64;
+    cxxporthelper::aligned_memory<std::complex<float>> buff1(n);
+    cxxporthelper::aligned_memory<std::complex<float>> buff2(n);
+
+    const int base_count = backend_type::cfg_cache::num_cached_plans();
+    {
+        fft::fft<std::complex<float>, std::complex<float>, backend_type::forward> fft1(n, &buff1[0], &buff1[0]);
+        fft::fft<std::complex<float>, std::complex<float>, backend_type::forward> fft2(n, &buff2[0], &buff2[0]);
+        fft::fft<std::complex<float>, std::complex<float>, backend_type::inverse> ifft(n, &buff1[0], &buff1[0]);
+
+        ASSERT_EQ(base_count + 2, backend_type::cfg_cache::num_cached_plans());
+
+        // both instances have to work on their own buffers
+        for (int i = 0; i < n; ++i) {
+            buff1[i] = std::complex<float>(1.0f, 0.0f);
+            buff2[i] = std::complex<float>(2.0f, 0.0f);
+        }
+
+        fft1.execute();
+        fft2.execute();
+
+        ASSERT_FLOAT_EQ(1.0f * n, buff1[0].real());
+        ASSERT_FLOAT_EQ(2.0f * n, buff2[0].real());
+    }
+    ASSERT_EQ(base_count, backend_type::cfg_cache::num_cached_plans());
+}
+#endif
@@ -418,6 +418,185 @@ TEST_F(GeneralF64StereoCoreOperatorTest, random_size_non_overwrite)
     do_random_size_non_overwrite_test<filter_t>(100, 10);
 }
 
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+//
+// f32_mono_sse_biquad_transposed_direct_form_2_core_operator
+//
+class SseF32MonoCoreOperatorTest : public TransposedDirectForm2BiquadFilterTest {
+};
+
+TEST_F(SseF32MonoCoreOperatorTest, oneshot_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_overwrite_test<filter_t>(100);
+}
+
+TEST_F(SseF32MonoCoreOperatorTest, oneshot_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_non_overwrite_test<filter_t>(100);
+}
+
+TEST_F(SseF32MonoCoreOperatorTest, random_size_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_overwrite_test<filter_t>(100, 10);
+}
+
+TEST_F(SseF32MonoCoreOperatorTest, random_size_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_mono_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_non_overwrite_test<filter_t>(100, 10);
+}
+
+//
+// f32_stereo_sse_biquad_transposed_direct_form_2_core_operator
+//
+class SseF32StereoCoreOperatorTest : public TransposedDirectForm2BiquadFilterTest {
+};
+
+TEST_F(SseF32StereoCoreOperatorTest, oneshot_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_overwrite_test<filter_t>(100);
+}
+
+TEST_F(SseF32StereoCoreOperatorTest, oneshot_non_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_non_overwrite_test<filter_t>(100);
+}
+
+TEST_F(SseF32StereoCoreOperatorTest, random_size_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_overwrite_test<filter_t>(100, 10);
+}
+
+TEST_F(SseF32StereoCoreOperatorTest, random_size_non_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_sse_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_non_overwrite_test<filter_t>(100, 10);
+}
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+//
+// f32_stereo_avx_biquad_transposed_direct_form_2_core_operator
+//
+class AvxF32StereoCoreOperatorTest : public TransposedDirectForm2BiquadFilterTest {
+};
+
+TEST_F(AvxF32StereoCoreOperatorTest, oneshot_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_overwrite_test<filter_t>(100);
+}
+
+TEST_F(AvxF32StereoCoreOperatorTest, oneshot_non_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_non_overwrite_test<filter_t>(100);
+}
+
+TEST_F(AvxF32StereoCoreOperatorTest, random_size_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_overwrite_test<filter_t>(100, 10);
+}
+
+TEST_F(AvxF32StereoCoreOperatorTest, random_size_non_overwrite)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+    typedef filter::biquad_filter<frame_t, filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator> filter_t;
+
+    if (!filter::f32_stereo_avx_biquad_transposed_direct_form_2_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx_biquad_transposed_direct_form_2_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_non_overwrite_test<filter_t>(100, 10);
+}
+
+#endif // CXXDASP_COMPILER_SUPPORTS_X86_AVX
+#endif // (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+
 #if CXXPH_COMPILER_SUPPORTS_ARM_NEON
 //
 // f32_mono_neon_biquad_transposed_direct_form_2_core_operator
@@ -478,4 +478,146 @@ TEST_F(NeonF32Cascaded2StereoCoreOperatorTest, random_size_non_overwrite)
 
     do_random_size_non_overwrite_test<filter_t>(100, 10);
 }
+
+//
+// f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+//
+class NeonF32MonoCascadedBlockCoreOperatorTest : public CascadedTrasposedDirectForm2BiquadFilterTest {
+};
+
+TEST_F(NeonF32MonoCascadedBlockCoreOperatorTest, oneshot_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_overwrite_test<filter_t>(100000);
+}
+
+TEST_F(NeonF32MonoCascadedBlockCoreOperatorTest, oneshot_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_non_overwrite_test<filter_t>(100000);
+}
+
+TEST_F(NeonF32MonoCascadedBlockCoreOperatorTest, random_size_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_overwrite_test<filter_t>(100, 10);
+}
+
+TEST_F(NeonF32MonoCascadedBlockCoreOperatorTest, random_size_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_non_overwrite_test<filter_t>(100, 10);
+}
+#endif
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+//
+// f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+//
+class SseF32MonoCascadedBlockCoreOperatorTest : public CascadedTrasposedDirectForm2BiquadFilterTest {
+};
+
+TEST_F(SseF32MonoCascadedBlockCoreOperatorTest, oneshot_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_overwrite_test<filter_t>(100000);
+}
+
+TEST_F(SseF32MonoCascadedBlockCoreOperatorTest, oneshot_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_oneshot_non_overwrite_test<filter_t>(100000);
+}
+
+TEST_F(SseF32MonoCascadedBlockCoreOperatorTest, random_size_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_overwrite_test<filter_t>(100, 10);
+}
+
+TEST_F(SseF32MonoCascadedBlockCoreOperatorTest, random_size_non_overwrite)
+{
+    typedef datatype::f32_mono_frame_t frame_t;
+    typedef filter::f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator<2>
+        cascaded_core_operator_t;
+    typedef filter::cascaded_biquad_filter<frame_t, cascaded_core_operator_t> filter_t;
+
+    if (!cascaded_core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_cascaded_biquad_block_transposed_direct_form_2_core_operator"
+                     " is not supported" << std::endl;
+        return;
+    }
+
+    do_random_size_non_overwrite_test<filter_t>(100, 10);
+}
 #endif
@@ -0,0 +1,297 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/fft_convolver/fft_convolver.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix test_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+typedef filter::single_channel_fft_convolver<float, float, float, test_fft_backend_f> mono_convolver_t;
+typedef filter::fft_convolver<datatype::f32_stereo_frame_t, datatype::f32_stereo_frame_t, float, test_fft_backend_f>
+    stereo_convolver_t;
+
+class FFTConvolverTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void make_random_data(std::vector<float> &v, int n, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    v.resize(n);
+    for (auto &x : v) {
+        x = dist(engine);
+    }
+}
+
+static void reference_convolve(const std::vector<float> &h, const float *src, int src_stride, float *dest,
+                               int dest_stride, int n)
+{
+    const int m = static_cast<int>(h.size());
+
+    for (int i = 0; i < n; ++i) {
+        double acc = 0.0;
+        for (int j = 0; j < m && j <= i; ++j) {
+            acc += static_cast<double>(h[j]) * src[(i - j) * src_stride];
+        }
+        dest[i * dest_stride] = static_cast<float>(acc);
+    }
+}
+
+static float calc_tolerance(const std::vector<float> &h)
+{
+    double sum = 0.0;
+    for (auto x : h) {
+        sum += std::abs(x);
+    }
+    return static_cast<float>(sum * 1e-5 + 1e-6);
+}
+
+static void run_mono(mono_convolver_t &c, const std::vector<float> &src, std::vector<float> &dest, int max_chunk,
+                     unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> dist(1, max_chunk);
+
+    const int n = static_cast<int>(src.size());
+    int n_put = 0;
+
+    dest.clear();
+
+    while (static_cast<int>(dest.size()) < n) {
+        if (n_put < n) {
+            const int m = (std::min)((std::min)(dist(engine), c.num_can_put()), (n - n_put));
+            c.put_n(&src[n_put], m);
+            n_put += m;
+            if (n_put == n) {
+                c.flush();
+            }
+        }
+
+        const int m = (std::min)(dist(engine), c.num_can_get());
+        if (m > 0) {
+            const size_t pos = dest.size();
+            dest.resize(pos + m);
+            c.get_n(&dest[pos], m);
+        }
+    }
+}
+
+static void check_mono(int filter_length, int block_size, int n, int max_chunk)
+{
+    std::vector<float> h, src, expected, actual;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    expected.resize(n);
+    reference_convolve(h, &src[0], 1, &expected[0], 1, n);
+
+    mono_convolver_t c(&h[0], filter_length, block_size);
+
+    if (block_size > 0) {
+        ASSERT_EQ(block_size, c.block_size());
+    }
+
+    run_mono(c, src, actual, max_chunk, 3);
+
+    ASSERT_EQ(n, static_cast<int>(actual.size()));
+    ASSERT_EQ(0, c.num_can_get());
+
+    const float tolerance = calc_tolerance(h);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], tolerance) << "filter_length = " << filter_length
+                                                       << ", block_size = " << c.block_size() << ", i = " << i;
+    }
+}
+
+TEST_F(FFTConvolverTest, calc_optimal_block_size)
+{
+    typedef mono_convolver_t::shared_context context_t;
+
+    int prev = 0;
+    for (int len = 1; len <= (1 << 18); len *= 2) {
+        const int B = context_t::calc_optimal_block_size(len);
+
+        ASSERT_TRUE(utils::is_pow_of_two(B));
+        ASSERT_GE(B, 32);
+        ASSERT_LE(B, (std::max)(32, len));
+        ASSERT_GE(B, prev);
+        prev = B;
+    }
+
+    // long filters should be partitioned
+    ASSERT_LT(context_t::calc_optimal_block_size(1 << 18), (1 << 18));
+}
+
+TEST_F(FFTConvolverTest, shared_context_params)
+{
+    std::vector<float> h;
+    make_random_data(h, 1000, 1);
+
+    mono_convolver_t::shared_context ctx(&h[0], 1000, 128);
+
+    ASSERT_EQ(1000, ctx.filter_length());
+    ASSERT_EQ(128, ctx.block_size());
+    ASSERT_EQ(8, ctx.num_partitions());
+}
+
+TEST_F(FFTConvolverTest, mono_short_filter) { check_mono(1, 32, 1000, 50); }
+
+TEST_F(FFTConvolverTest, mono_single_partition) { check_mono(100, 128, 3000, 300); }
+
+TEST_F(FFTConvolverTest, mono_multiple_partitions)
+{
+    check_mono(1000, 64, 5000, 200);
+    check_mono(1000, 256, 5000, 1000);
+    check_mono(1025, 128, 5000, 7);
+}
+
+TEST_F(FFTConvolverTest, mono_long_filter_auto_block_size) { check_mono(8192, 0, 20000, 5000); }
+
+TEST_F(FFTConvolverTest, mono_reset)
+{
+    const int filter_length = 300;
+    const int n = 2000;
+    std::vector<float> h, src, out1, out2;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    mono_convolver_t c(&h[0], filter_length, 64);
+
+    run_mono(c, src, out1, 100, 3);
+    c.reset();
+    run_mono(c, src, out2, 37, 4);
+
+    ASSERT_EQ(out1.size(), out2.size());
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(out1[i], out2[i], calc_tolerance(h));
+    }
+}
+
+TEST_F(FFTConvolverTest, mono_shared_context)
+{
+    const int filter_length = 500;
+    const int n = 3000;
+    std::vector<float> h, src1, src2, expected, actual;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src1, n, 2);
+    make_random_data(src2, n, 3);
+
+    mono_convolver_t::shared_context ctx(&h[0], filter_length, 128);
+    mono_convolver_t c1(&ctx);
+    mono_convolver_t c2(&ctx);
+
+    expected.resize(n);
+
+    run_mono(c1, src1, actual, 200, 4);
+    reference_convolve(h, &src1[0], 1, &expected[0], 1, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], calc_tolerance(h));
+    }
+
+    run_mono(c2, src2, actual, 200, 5);
+    reference_convolve(h, &src2[0], 1, &expected[0], 1, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], calc_tolerance(h));
+    }
+}
+
+TEST_F(FFTConvolverTest, stereo)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+
+    const int filter_length = 2000;
+    const int n = 10000;
+    std::vector<float> h, l, r;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(l, n, 2);
+    make_random_data(r, n, 3);
+
+    std::vector<frame_t> src(n), dest(n);
+    for (int i = 0; i < n; ++i) {
+        src[i].c(0) = l[i];
+        src[i].c(1) = r[i];
+    }
+
+    std::vector<float> expected(n * 2);
+    reference_convolve(h, &l[0], 1, &expected[0], 2, n);
+    reference_convolve(h, &r[0], 1, &expected[1], 2, n);
+
+    stereo_convolver_t c(&h[0], filter_length, 256);
+
+    ASSERT_EQ(256, c.block_size());
+    ASSERT_EQ(8, c.num_partitions());
+
+    int n_put = 0, n_get = 0;
+    while (n_get < n) {
+        if (n_put < n) {
+            const int m = (std::min)((std::min)(100, c.num_can_put()), (n - n_put));
+            c.put_n(&src[n_put], m);
+            n_put += m;
+            if (n_put == n) {
+                c.flush();
+            }
+        }
+
+        const int m = (std::min)(77, c.num_can_get());
+        c.get_n(&dest[n_get], m);
+        n_get += m;
+    }
+
+    ASSERT_EQ(0, c.num_can_get());
+
+    const float tolerance = calc_tolerance(h);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[2 * i + 0], dest[i].c(0), tolerance) << "i = " << i;
+        ASSERT_NEAR(expected[2 * i + 1], dest[i].c(1), tolerance) << "i = " << i;
+    }
+}
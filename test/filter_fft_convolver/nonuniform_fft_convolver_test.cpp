@@ -0,0 +1,438 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <random>
+#include <vector>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/datatype/audio_frame.hpp>
+#include <cxxdasp/filter/fft_convolver/nonuniform_fft_convolver.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix test_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+typedef filter::single_channel_nonuniform_fft_convolver<float, float, float, test_fft_backend_f> mono_convolver_t;
+typedef filter::nonuniform_fft_convolver<datatype::f32_stereo_frame_t, datatype::f32_stereo_frame_t, float,
+                                         test_fft_backend_f> stereo_convolver_t;
+
+class NonUniformFFTConvolverTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void make_random_data(std::vector<float> &v, int n, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    v.resize(n);
+    for (auto &x : v) {
+        x = dist(engine);
+    }
+}
+
+static void reference_convolve(const std::vector<float> &h, const float *src, int src_stride, float *dest,
+                               int dest_stride, int n)
+{
+    const int m = static_cast<int>(h.size());
+
+    for (int i = 0; i < n; ++i) {
+        double acc = 0.0;
+        for (int j = 0; j < m && j <= i; ++j) {
+            acc += static_cast<double>(h[j]) * src[(i - j) * src_stride];
+        }
+        dest[i * dest_stride] = static_cast<float>(acc);
+    }
+}
+
+static float calc_tolerance(const std::vector<float> &h)
+{
+    double sum = 0.0;
+    for (auto x : h) {
+        sum += std::abs(x);
+    }
+    return static_cast<float>(sum * 1e-5 + 1e-6);
+}
+
+static void check_mono(int filter_length, int latency, int max_block_size, int n, int max_chunk,
+                       bool use_worker_thread = false)
+{
+    std::vector<float> h, src, expected, actual;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    expected.resize(n);
+    reference_convolve(h, &src[0], 1, &expected[0], 1, n);
+
+    mono_convolver_t c(&h[0], filter_length, latency, max_block_size, use_worker_thread);
+
+    ASSERT_EQ(latency, c.latency());
+    if (!use_worker_thread) {
+        ASSERT_FALSE(c.uses_worker_thread());
+    }
+
+    // offline processing: the caller runs ahead of the worker thread
+    c.set_wait_for_worker(true);
+
+    std::mt19937 engine(3);
+    std::uniform_int_distribution<int> dist(1, max_chunk);
+
+    int n_put = 0;
+    while (static_cast<int>(actual.size()) < n) {
+        if (n_put < n) {
+            const int m = (std::min)((std::min)(dist(engine), c.num_can_put()), (n - n_put));
+            c.put_n(&src[n_put], m);
+            n_put += m;
+            if (n_put == n) {
+                c.flush();
+            }
+        }
+
+        const int m = (std::min)(dist(engine), c.num_can_get());
+        if (m > 0) {
+            const size_t pos = actual.size();
+            actual.resize(pos + m);
+            c.get_n(&actual[pos], m);
+        }
+
+        // latency
+        ASSERT_LE(n_put - static_cast<int>(actual.size()), (n_put < n) ? (2 * latency) : latency);
+    }
+
+    ASSERT_EQ(n, static_cast<int>(actual.size()));
+
+    const float tolerance = calc_tolerance(h);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], tolerance) << "filter_length = " << filter_length << ", i = " << i;
+    }
+}
+
+TEST_F(NonUniformFFTConvolverTest, partitioning_plan)
+{
+    std::vector<float> h;
+    make_random_data(h, 100000, 1);
+
+    mono_convolver_t::shared_context ctx(&h[0], 100000, 64, 4096);
+
+    ASSERT_EQ(100000, ctx.filter_length());
+    ASSERT_EQ(64, ctx.latency());
+    ASSERT_GT(ctx.num_segments(), 1);
+
+    // head segment
+    ASSERT_EQ(0, ctx.segment_offset(0));
+    ASSERT_EQ(64, ctx.segment(0).block_size());
+
+    int offset = 0;
+    int prev_block_size = 0;
+    for (int i = 0; i < ctx.num_segments(); ++i) {
+        const int block_size = ctx.segment(i).block_size();
+
+        // contiguous
+        ASSERT_EQ(offset, ctx.segment_offset(i));
+        // non-decreasing block size
+        ASSERT_GE(block_size, prev_block_size);
+        ASSERT_LE(block_size, 4096);
+        // in time
+        ASSERT_GE(ctx.segment_offset(i), block_size - ctx.latency());
+
+        offset += ctx.segment(i).filter_length();
+        prev_block_size = block_size;
+    }
+    ASSERT_EQ(100000, offset);
+
+    // uniform tail
+    ASSERT_EQ(4096, ctx.segment(ctx.num_segments() - 1).block_size());
+}
+
+TEST_F(NonUniformFFTConvolverTest, mono_short_filter)
+{
+    check_mono(1, 32, 0, 1000, 50);
+    check_mono(50, 64, 0, 1000, 50);
+}
+
+TEST_F(NonUniformFFTConvolverTest, mono_head_segments_only) { check_mono(1000, 32, 256, 4000, 100); }
+
+TEST_F(NonUniformFFTConvolverTest, mono_long_filter)
+{
+    check_mono(10000, 64, 0, 20000, 300);
+    check_mono(10001, 32, 1024, 20000, 17);
+}
+
+TEST_F(NonUniformFFTConvolverTest, mono_reset)
+{
+    const int filter_length = 3000;
+    const int n = 5000;
+    std::vector<float> h, src, out1(n), out2(n);
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    mono_convolver_t c(&h[0], filter_length, 32, 512);
+
+    for (int k = 0; k < 2; ++k) {
+        std::vector<float> &out = (k == 0) ? out1 : out2;
+        int n_put = 0, n_get = 0;
+
+        while (n_get < n) {
+            if (n_put < n) {
+                const int m = (std::min)(c.num_can_put(), (n - n_put));
+                c.put_n(&src[n_put], m);
+                n_put += m;
+                if (n_put == n) {
+                    c.flush();
+                }
+            }
+            const int m = c.num_can_get();
+            c.get_n(&out[n_get], m);
+            n_get += m;
+        }
+
+        c.reset();
+    }
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(out1[i], out2[i]);
+    }
+}
+
+TEST_F(NonUniformFFTConvolverTest, stereo)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+
+    const int filter_length = 5000;
+    const int n = 10000;
+    std::vector<float> h, l, r;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(l, n, 2);
+    make_random_data(r, n, 3);
+
+    std::vector<frame_t> src(n), dest(n);
+    for (int i = 0; i < n; ++i) {
+        src[i].c(0) = l[i];
+        src[i].c(1) = r[i];
+    }
+
+    std::vector<float> expected(n * 2);
+    reference_convolve(h, &l[0], 1, &expected[0], 2, n);
+    reference_convolve(h, &r[0], 1, &expected[1], 2, n);
+
+    stereo_convolver_t c(&h[0], filter_length, 64, 1024);
+
+    ASSERT_EQ(64, c.latency());
+    ASSERT_LT(1, c.num_segments());
+
+    int n_put = 0, n_get = 0;
+    while (n_get < n) {
+        if (n_put < n) {
+            const int m = (std::min)((std::min)(100, c.num_can_put()), (n - n_put));
+            c.put_n(&src[n_put], m);
+            n_put += m;
+            if (n_put == n) {
+                c.flush();
+            }
+        }
+
+        const int m = (std::min)(77, c.num_can_get());
+        c.get_n(&dest[n_get], m);
+        n_get += m;
+    }
+
+    const float tolerance = calc_tolerance(h);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[2 * i + 0], dest[i].c(0), tolerance) << "i = " << i;
+        ASSERT_NEAR(expected[2 * i + 1], dest[i].c(1), tolerance) << "i = " << i;
+    }
+}
+
+TEST_F(NonUniformFFTConvolverTest, worker_thread_mono)
+{
+    check_mono(10000, 64, 0, 20000, 300, true);
+    check_mono(10001, 32, 1024, 20000, 17, true);
+    check_mono(3000, 32, 512, 5000, 1000, true);
+}
+
+TEST_F(NonUniformFFTConvolverTest, worker_thread_not_required)
+{
+    std::vector<float> h;
+    make_random_data(h, 100, 1);
+
+    // all segments have to be processed on the caller thread
+    mono_convolver_t c1(&h[0], 100, 64, 64, true);
+    ASSERT_FALSE(c1.uses_worker_thread());
+
+    mono_convolver_t c2(&h[0], 100, 32, 0, true);
+    ASSERT_TRUE(c2.uses_worker_thread());
+}
+
+TEST_F(NonUniformFFTConvolverTest, worker_thread_stereo)
+{
+    typedef datatype::f32_stereo_frame_t frame_t;
+
+    const int filter_length = 5000;
+    const int n = 10000;
+    std::vector<float> h, l, r;
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(l, n, 2);
+    make_random_data(r, n, 3);
+
+    std::vector<frame_t> src(n), dest(n);
+    for (int i = 0; i < n; ++i) {
+        src[i].c(0) = l[i];
+        src[i].c(1) = r[i];
+    }
+
+    std::vector<float> expected(n * 2);
+    reference_convolve(h, &l[0], 1, &expected[0], 2, n);
+    reference_convolve(h, &r[0], 1, &expected[1], 2, n);
+
+    stereo_convolver_t c(&h[0], filter_length, 64, 1024, true);
+
+    ASSERT_TRUE(c.uses_worker_thread());
+    c.set_wait_for_worker(true);
+
+    int n_put = 0, n_get = 0;
+    while (n_get < n) {
+        if (n_put < n) {
+            const int m = (std::min)((std::min)(64, c.num_can_put()), (n - n_put));
+            c.put_n(&src[n_put], m);
+            n_put += m;
+            if (n_put == n) {
+                c.flush();
+            }
+        }
+
+        const int m = c.num_can_get();
+        c.get_n(&dest[n_get], m);
+        n_get += m;
+    }
+
+    const float tolerance = calc_tolerance(h);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[2 * i + 0], dest[i].c(0), tolerance) << "i = " << i;
+        ASSERT_NEAR(expected[2 * i + 1], dest[i].c(1), tolerance) << "i = " << i;
+    }
+}
+
+TEST_F(NonUniformFFTConvolverTest, worker_thread_reset_and_destroy_while_running)
+{
+    const int filter_length = 20000;
+    const int n = 4096;
+    std::vector<float> h, src, out1(n), out2(n);
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    mono_convolver_t c(&h[0], filter_length, 64, 4096, true);
+
+    ASSERT_TRUE(c.uses_worker_thread());
+    c.set_wait_for_worker(true);
+
+    for (int k = 0; k < 3; ++k) {
+        std::vector<float> &out = (k == 0) ? out1 : out2;
+        int n_put = 0, n_get = 0;
+
+        // stop feeding in the middle of the stream (jobs of the tail segments are still in flight)
+        while (n_get < n) {
+            const int m1 = (std::min)(c.num_can_put(), (n - n_put));
+            c.put_n(&src[n_put], m1);
+            n_put += m1;
+
+            const int m2 = c.num_can_get();
+            c.get_n(&out[n_get], m2);
+            n_get += m2;
+        }
+
+        c.reset();
+    }
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(out1[i], out2[i], calc_tolerance(h));
+    }
+
+    {
+        mono_convolver_t c2(&h[0], filter_length, 64, 4096, true);
+
+        for (int i = 0; i < n; i += c2.latency()) {
+            c2.put_n(&src[i], c2.latency());
+            c2.get_n(&out1[i], c2.num_can_get());
+        }
+        // destroy while the worker thread is (possibly) running
+    }
+}
+
+TEST_F(NonUniformFFTConvolverTest, worker_thread_never_blocks_caller)
+{
+    const int filter_length = 20000;
+    const int n = 64 * 800;
+    std::vector<float> h, src, expected, actual(n);
+
+    make_random_data(h, filter_length, 1);
+    make_random_data(src, n, 2);
+
+    expected.resize(n);
+    reference_convolve(h, &src[0], 1, &expected[0], 1, n);
+
+    mono_convolver_t c(&h[0], filter_length, 64, 4096, true);
+
+    ASSERT_TRUE(c.uses_worker_thread());
+    ASSERT_EQ(0, c.num_deadline_misses());
+
+    // the caller runs ahead of the worker thread without waiting for it
+    for (int i = 0; i < n; i += c.latency()) {
+        c.put_n(&src[i], c.latency());
+        ASSERT_EQ(c.latency(), c.num_can_get());
+        c.get_n(&actual[i], c.latency());
+    }
+
+    // output is exact unless some jobs have missed their deadlines
+    if (c.num_deadline_misses() == 0) {
+        const float tolerance = calc_tolerance(h);
+        for (int i = 0; i < n; ++i) {
+            ASSERT_NEAR(expected[i], actual[i], tolerance) << "i = " << i;
+        }
+    }
+
+    c.reset();
+    ASSERT_EQ(0, c.num_deadline_misses());
+}
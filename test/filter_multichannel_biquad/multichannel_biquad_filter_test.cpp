@@ -0,0 +1,291 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <random>
+
+#include <cxxdasp/utils/utils.hpp>
+#include <cxxdasp/filter/multichannel_biquad/multichannel_biquad_filter.hpp>
+#include <cxxdasp/filter/multichannel_biquad/multichannel_biquad_filter_core_operators.hpp>
+
+using namespace cxxdasp;
+
+class MultichannelBiquadFilterTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+filter::filter_params_t make_lpf_params(int ch)
+{
+    filter::filter_params_t params;
+
+    params.type = filter::types::LowPass;
+    params.fs = 44100.0;
+    params.f0 = 500.0 + 250.0 * ch; // different cutoff frequency for each channel
+    params.db_gain = 0.0;           // Not used
+    params.q = 0.7071;
+
+    return params;
+}
+
+template <typename TValue>
+void reference_filter_impl(const filter::filter_params_t fparams, const std::vector<TValue> &src,
+                           std::vector<TValue> &dest, int n, int num_channels, int ch)
+{
+    typedef TValue data_type;
+
+    filter::biquad_filter_coeffs bcoeffs;
+
+    ASSERT_TRUE(bcoeffs.make(fparams));
+
+    const data_type b0 = static_cast<data_type>(bcoeffs.b0);
+    const data_type b1 = static_cast<data_type>(bcoeffs.b1);
+    const data_type b2 = static_cast<data_type>(bcoeffs.b2);
+    const data_type a1 = static_cast<data_type>(bcoeffs.a1);
+    const data_type a2 = static_cast<data_type>(bcoeffs.a2);
+
+    data_type s1, s2, x0, y0;
+
+    s1 = s2 = 0;
+
+    for (int i = 0; i < n; ++i) {
+        x0 = src[i * num_channels + ch];
+
+        y0 = s1 + (x0 * b0);
+
+        s1 = s2 + (x0 * b1);
+        s2 = (x0 * b2);
+
+        s1 += (y0 * (-a1));
+        s2 += (y0 * (-a2));
+
+        dest[i * num_channels + ch] = y0;
+    }
+}
+
+template <typename TValue>
+void make_random_data(std::vector<TValue> &data, int n)
+{
+    std::mt19937 mt(0);
+    std::uniform_real_distribution<TValue> gen(static_cast<TValue>(-1), static_cast<TValue>(+1));
+
+    data.resize(n);
+    for (int i = 0; i < n; ++i) {
+        data[i] = gen(mt);
+    }
+}
+
+template <typename TFilter>
+void init_filter(TFilter &flt, int num_channels)
+{
+    std::vector<filter::biquad_filter_coeffs> coeffs(num_channels);
+
+    for (int ch = 0; ch < num_channels; ++ch) {
+        ASSERT_TRUE(coeffs[ch].make(make_lpf_params(ch)));
+    }
+
+    ASSERT_TRUE(flt.init(num_channels, &coeffs[0]));
+    ASSERT_EQ(num_channels, flt.num_channels());
+}
+
+template <typename TFilter>
+void do_random_size_test(int n, int max_size, int num_channels, bool overwrite)
+{
+    typedef TFilter filter_type;
+    typedef typename filter_type::value_type value_type;
+    std::vector<value_type> in_data;
+    std::vector<value_type> out_data(n * num_channels);
+    std::vector<value_type> expected_data(n * num_channels);
+    filter_type flt;
+
+    if (!filter_type::core_operator_type::is_supported()) {
+        std::cout << "SKIPPED: core operator is not supported" << std::endl;
+        return;
+    }
+
+    // make input data
+    make_random_data(in_data, n * num_channels);
+
+    // calculate expected output
+    for (int ch = 0; ch < num_channels; ++ch) {
+        reference_filter_impl(make_lpf_params(ch), in_data, expected_data, n, num_channels, ch);
+    }
+
+    // initialize filter
+    init_filter(flt, num_channels);
+
+    // perform
+    if (overwrite) {
+        out_data = in_data;
+    }
+
+    std::mt19937 mt(0);
+    std::uniform_int_distribution<int> gen(1, max_size);
+    int offset = 0;
+    while (offset < n) {
+        const int s = (std::min)(gen(mt), (n - offset));
+
+        if (overwrite) {
+            flt.perform(&out_data[offset * num_channels], s);
+        } else {
+            flt.perform(&in_data[offset * num_channels], &out_data[offset * num_channels], s);
+        }
+
+        offset += s;
+    }
+
+    // check
+    for (int i = 0; i < (n * num_channels); ++i) {
+        ASSERT_AUTO_FLOATING_POINT_NEAR(expected_data[i], out_data[i], static_cast<value_type>(1e-5));
+    }
+}
+
+template <typename TFilter>
+void do_update_and_reset_test(int num_channels)
+{
+    typedef TFilter filter_type;
+    typedef typename filter_type::value_type value_type;
+    const int n = 100;
+    std::vector<value_type> in_data;
+    std::vector<value_type> out_data(n * num_channels);
+    std::vector<value_type> expected_data(n * num_channels);
+    filter_type flt;
+
+    if (!filter_type::core_operator_type::is_supported()) {
+        std::cout << "SKIPPED: core operator is not supported" << std::endl;
+        return;
+    }
+
+    make_random_data(in_data, n * num_channels);
+
+    // initialize all channels with the channel 0 params, then update each channel
+    ASSERT_TRUE(flt.init(num_channels, make_lpf_params(0)));
+    for (int ch = 0; ch < num_channels; ++ch) {
+        ASSERT_TRUE(flt.update(ch, make_lpf_params(ch)));
+    }
+    ASSERT_FALSE(flt.update(num_channels, make_lpf_params(0)));
+
+    // dirty state
+    flt.perform(&in_data[0], &out_data[0], n);
+    flt.reset();
+
+    for (int ch = 0; ch < num_channels; ++ch) {
+        reference_filter_impl(make_lpf_params(ch), in_data, expected_data, n, num_channels, ch);
+    }
+
+    flt.perform(&in_data[0], &out_data[0], n);
+
+    for (int i = 0; i < (n * num_channels); ++i) {
+        ASSERT_AUTO_FLOATING_POINT_NEAR(expected_data[i], out_data[i], static_cast<value_type>(1e-5));
+    }
+}
+
+TEST_F(MultichannelBiquadFilterTest, init_invalid_args)
+{
+    filter::multichannel_biquad_filter<filter::general_multichannel_biquad_core_operator<float, 4>> flt;
+
+    ASSERT_FALSE(flt.init(0, make_lpf_params(0)));
+    ASSERT_FALSE(flt.init(-1, make_lpf_params(0)));
+    ASSERT_FALSE(flt.init(4, static_cast<const filter::biquad_filter_coeffs *>(nullptr)));
+    ASSERT_EQ(0, flt.num_channels());
+}
+
+//
+// general_multichannel_biquad_core_operator<float, 4>
+//
+TEST_F(MultichannelBiquadFilterTest, general_f32_4lanes)
+{
+    typedef filter::multichannel_biquad_filter<filter::general_multichannel_biquad_core_operator<float, 4>> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 4, true);
+    do_random_size_test<filter_t>(300, 100, 19, false);
+    do_update_and_reset_test<filter_t>(19);
+}
+
+//
+// general_multichannel_biquad_core_operator<double, 2>
+//
+TEST_F(MultichannelBiquadFilterTest, general_f64_2lanes)
+{
+    typedef filter::multichannel_biquad_filter<filter::general_multichannel_biquad_core_operator<double, 2>> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 7, true);
+    do_update_and_reset_test<filter_t>(7);
+}
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+//
+// f32_sse_multichannel_biquad_core_operator
+//
+TEST_F(MultichannelBiquadFilterTest, f32_sse)
+{
+    typedef filter::multichannel_biquad_filter<filter::f32_sse_multichannel_biquad_core_operator> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 8, true);
+    do_random_size_test<filter_t>(300, 100, 19, false);
+    do_update_and_reset_test<filter_t>(19);
+}
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX
+//
+// f32_avx_multichannel_biquad_core_operator
+//
+TEST_F(MultichannelBiquadFilterTest, f32_avx)
+{
+    typedef filter::multichannel_biquad_filter<filter::f32_avx_multichannel_biquad_core_operator> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 16, true);
+    do_random_size_test<filter_t>(300, 100, 37, false);
+    do_update_and_reset_test<filter_t>(37);
+}
+#endif
+
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX512F
+//
+// f32_avx512_multichannel_biquad_core_operator
+//
+TEST_F(MultichannelBiquadFilterTest, f32_avx512)
+{
+    typedef filter::multichannel_biquad_filter<filter::f32_avx512_multichannel_biquad_core_operator> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 32, true);
+    do_random_size_test<filter_t>(300, 100, 37, false);
+    do_update_and_reset_test<filter_t>(37);
+}
+#endif
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+//
+// f32_neon_multichannel_biquad_core_operator
+//
+TEST_F(MultichannelBiquadFilterTest, f32_neon)
+{
+    typedef filter::multichannel_biquad_filter<filter::f32_neon_multichannel_biquad_core_operator> filter_t;
+
+    do_random_size_test<filter_t>(300, 100, 1, false);
+    do_random_size_test<filter_t>(300, 100, 8, true);
+    do_random_size_test<filter_t>(300, 100, 19, false);
+    do_update_and_reset_test<filter_t>(19);
+}
+#endif
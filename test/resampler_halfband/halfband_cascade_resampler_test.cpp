@@ -0,0 +1,241 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <cxxdasp/resampler/halfband/halfband_cascade_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_resampler.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_decimator.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_core_operators.hpp>
+
+using namespace cxxdasp;
+
+class HalfbandCascadeResamplerTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        // progressively shorter (arbitrary) kernels, normalized to the same DC gain as a real half band filter
+        for (int stage = 0; stage < MAX_STAGES; ++stage) {
+            const int length = (MAX_FILTER_LENGTH >> stage);
+            std::vector<float> &kernel = kernels_[stage];
+            double sum = 0.0;
+
+            kernel.resize(length);
+            for (int i = 0; i < length; ++i) {
+                kernel[i] = static_cast<float>(std::cos(0.3 * i + stage) * (i + 1));
+                sum += kernel[i];
+            }
+            for (int i = 0; i < length; ++i) {
+                kernel[i] = static_cast<float>(kernel[i] * (0.5 / sum));
+            }
+
+            kernel_ptrs_[stage] = &kernel[0];
+            kernel_lengths_[stage] = length;
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { MAX_STAGES = 3, MAX_FILTER_LENGTH = 32, NUM_SRC_FRAMES = 2001 };
+
+    std::vector<float> kernels_[MAX_STAGES];
+    const float *kernel_ptrs_[MAX_STAGES];
+    int kernel_lengths_[MAX_STAGES];
+};
+
+// put all of the src frames (with various chunk sizes) and collect all of the output frames
+template <class TResampler, class TFrame>
+void run_resampler(TResampler &resampler, const std::vector<TFrame> &src, std::vector<TFrame> &dest)
+{
+    const int num_src_frames = static_cast<int>(src.size());
+    int n_put = 0;
+    int chunk = 1;
+
+    dest.clear();
+
+    while (true) {
+        if (n_put < num_src_frames) {
+            const int n = (std::min)((std::min)(resampler.num_can_put(), chunk), (num_src_frames - n_put));
+            resampler.put_n(&src[n_put], n);
+            n_put += n;
+            chunk = (chunk * 7) % 97 + 1;
+
+            if (n_put == num_src_frames) {
+                resampler.flush();
+            }
+        }
+
+        const int n_get = resampler.num_can_get();
+        if (n_get == 0 && n_put == num_src_frames) {
+            break;
+        }
+
+        const size_t offset = dest.size();
+        dest.resize(offset + n_get);
+        resampler.get_n(&dest[offset], n_get);
+    }
+}
+
+template <class TCoreOperator>
+void sub_test_cascade(HalfbandCascadeResamplerTest &tst, bool upsampling, int num_stages)
+{
+    typedef typename TCoreOperator::src_frame_t frame_t;
+    typedef resampler::halfband_cascade_resampler<frame_t, frame_t, float, TCoreOperator> cascade_t;
+    typedef resampler::halfband_x2_resampler<frame_t, frame_t, float, TCoreOperator> upsampler_t;
+    typedef resampler::halfband_x2_decimator<frame_t, frame_t, float, TCoreOperator> decimator_t;
+
+    const int num_src_frames = HalfbandCascadeResamplerTest::NUM_SRC_FRAMES;
+    const int num_channels = frame_t::num_channels;
+
+    // upsampling: the longest filter first, downsampling: the longest filter last
+    const float *kernels[HalfbandCascadeResamplerTest::MAX_STAGES];
+    int lengths[HalfbandCascadeResamplerTest::MAX_STAGES];
+    for (int i = 0; i < num_stages; ++i) {
+        const int k = (upsampling) ? i : (num_stages - 1 - i);
+        kernels[i] = tst.kernel_ptrs_[k];
+        lengths[i] = tst.kernel_lengths_[k];
+    }
+
+    std::vector<frame_t> src(num_src_frames);
+    for (int i = 0; i < num_src_frames; ++i) {
+        for (int ch = 0; ch < num_channels; ++ch) {
+            src[i].c(ch) = static_cast<float>((std::sin(0.05 * i) + 0.5 * std::cos(0.7 * i + 0.3)) * (ch + 1));
+        }
+    }
+
+    // reference: apply each stage to the whole signal one after another
+    std::vector<frame_t> expected(src);
+    for (int i = 0; i < num_stages; ++i) {
+        std::vector<frame_t> tmp;
+        if (upsampling) {
+            upsampler_t stage(kernels[i], lengths[i], 0);
+            run_resampler(stage, expected, tmp);
+        } else {
+            decimator_t stage(kernels[i], lengths[i], 0);
+            run_resampler(stage, expected, tmp);
+        }
+        expected.swap(tmp);
+    }
+
+    const typename cascade_t::direction_t direction = (upsampling) ? cascade_t::Upsampling : cascade_t::Downsampling;
+    cascade_t cascade(direction, num_stages, kernels, lengths, 0);
+
+    ASSERT_EQ(num_stages, cascade.num_stages());
+
+    // run twice to verify reset()
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<frame_t> dest;
+
+        cascade.reset();
+        run_resampler(cascade, src, dest);
+
+        ASSERT_EQ(expected.size(), dest.size());
+
+        for (size_t i = 0; i < dest.size(); ++i) {
+            for (int ch = 0; ch < num_channels; ++ch) {
+                ASSERT_EQ(expected[i].c(ch), dest[i].c(ch)) << "i = " << i << ", ch = " << ch;
+            }
+        }
+    }
+
+    // output length: (num_src_frames * ratio) + (delay, flushed tail)
+    if (upsampling) {
+        ASSERT_GE(static_cast<int>(expected.size()), (num_src_frames << num_stages));
+    } else {
+        ASSERT_GE(static_cast<int>(expected.size()), (num_src_frames >> num_stages));
+    }
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_mono_general_x4)
+{
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, true, 2);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_mono_general_x8)
+{
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, true, 3);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_mono_general_div4)
+{
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, false, 2);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_mono_general_div8)
+{
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, false, 3);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_stereo_general_x4)
+{
+    sub_test_cascade<resampler::f32_stereo_basic_halfband_x2_resampler_core_operator>(*this, true, 2);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_stereo_general_div4)
+{
+    sub_test_cascade<resampler::f32_stereo_basic_halfband_x2_resampler_core_operator>(*this, false, 2);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, single_stage)
+{
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, true, 1);
+    sub_test_cascade<resampler::f32_mono_basic_halfband_x2_resampler_core_operator>(*this, false, 1);
+}
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+TEST_F(HalfbandCascadeResamplerTest, f32_stereo_sse_x4)
+{
+    typedef resampler::f32_stereo_sse_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_cascade<op_t>(*this, true, 2);
+}
+
+TEST_F(HalfbandCascadeResamplerTest, f32_stereo_sse_div4)
+{
+    typedef resampler::f32_stereo_sse_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_cascade<op_t>(*this, false, 2);
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+TEST_F(HalfbandCascadeResamplerTest, f32_stereo_neon_div4)
+{
+    typedef resampler::f32_stereo_neon_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_neon_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_cascade<op_t>(*this, false, 2);
+}
+#endif
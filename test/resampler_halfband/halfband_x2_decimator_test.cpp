@@ -0,0 +1,231 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <cxxdasp/resampler/halfband/halfband_x2_decimator.hpp>
+#include <cxxdasp/resampler/halfband/halfband_x2_core_operators.hpp>
+
+using namespace cxxdasp;
+
+class HalfbandX2DecimatorTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        // arbitrary kernel (normalized to the same DC gain as a real half band filter)
+        double sum = 0.0;
+        kernel_.resize(FILTER_LENGTH);
+        for (int i = 0; i < FILTER_LENGTH; ++i) {
+            kernel_[i] = static_cast<float>(std::cos(0.3 * i) * (i + 1));
+            sum += kernel_[i];
+        }
+        for (int i = 0; i < FILTER_LENGTH; ++i) {
+            kernel_[i] = static_cast<float>(kernel_[i] * (0.5 / sum));
+        }
+
+        src_.resize(NUM_SRC_FRAMES);
+        for (int i = 0; i < NUM_SRC_FRAMES; ++i) {
+            src_[i] = static_cast<float>(std::sin(0.05 * i) + 0.5 * std::cos(0.7 * i + 0.3));
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { FILTER_LENGTH = 16, NUM_SRC_FRAMES = 3001 };
+
+    // reference: full length half band filter, output at even input positions
+    float reference(int i, int ch) const
+    {
+        const int HN = FILTER_LENGTH;
+        const int N = 2 * HN;
+        double t = src_at(2 * i, ch);
+
+        for (int j = 0; j < HN; ++j) {
+            t += kernel_[j] * src_at(2 * i - (N - 1) + 2 * j, ch);
+            t += kernel_[HN - 1 - j] * src_at(2 * i + 1 + 2 * j, ch);
+        }
+
+        return static_cast<float>(0.5 * t);
+    }
+
+    float src_at(int i, int ch) const
+    {
+        return (i >= 0 && i < NUM_SRC_FRAMES) ? (src_[i] * (ch + 1)) : 0.0f;
+    }
+
+    std::vector<float> kernel_;
+    std::vector<float> src_;
+};
+
+template <class TDecimator>
+void sub_test_decimate(HalfbandX2DecimatorTest &tst, TDecimator &decimator, float abs_error)
+{
+    typedef typename TDecimator::src_frame_t src_frame_t;
+    typedef typename TDecimator::dest_frame_t dest_frame_t;
+
+    const int num_src_frames = HalfbandX2DecimatorTest::NUM_SRC_FRAMES;
+    const int num_channels = src_frame_t::num_channels;
+
+    std::vector<src_frame_t> src(num_src_frames);
+    for (int i = 0; i < num_src_frames; ++i) {
+        for (int ch = 0; ch < num_channels; ++ch) {
+            src[i].c(ch) = tst.src_at(i, ch);
+        }
+    }
+
+    std::vector<dest_frame_t> dest;
+    int n_put = 0;
+    int chunk = 1;
+
+    // feed with various chunk sizes
+    while (true) {
+        if (n_put < num_src_frames) {
+            const int n = (std::min)((std::min)(decimator.num_can_put(), chunk), (num_src_frames - n_put));
+            decimator.put_n(&src[n_put], n);
+            n_put += n;
+            chunk = (chunk * 7) % 97 + 1;
+
+            if (n_put == num_src_frames) {
+                decimator.flush();
+            }
+        }
+
+        const int n_get = decimator.num_can_get();
+        if (n_get == 0 && n_put == num_src_frames) {
+            break;
+        }
+
+        const size_t offset = dest.size();
+        dest.resize(offset + n_get);
+        decimator.get_n(&dest[offset], n_get);
+    }
+
+    const int num_expected = (num_src_frames + 1) / 2;
+    ASSERT_GE(static_cast<int>(dest.size()), num_expected);
+
+    for (int i = 0; i < num_expected; ++i) {
+        for (int ch = 0; ch < num_channels; ++ch) {
+            ASSERT_NEAR(tst.reference(i, ch), dest[i].c(ch), abs_error) << "i = " << i << ", ch = " << ch;
+        }
+    }
+}
+
+TEST_F(HalfbandX2DecimatorTest, f32_mono_general)
+{
+    typedef resampler::f32_mono_basic_halfband_x2_resampler_core_operator op_t;
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+TEST_F(HalfbandX2DecimatorTest, f32_stereo_general)
+{
+    typedef resampler::f32_stereo_basic_halfband_x2_resampler_core_operator op_t;
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+TEST_F(HalfbandX2DecimatorTest, f64_mono_general)
+{
+    typedef resampler::f64_mono_basic_halfband_x2_resampler_core_operator op_t;
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 1);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+TEST_F(HalfbandX2DecimatorTest, reset)
+{
+    typedef resampler::f32_mono_basic_halfband_x2_resampler_core_operator op_t;
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+    decimator.reset();
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+TEST_F(HalfbandX2DecimatorTest, f32_mono_sse)
+{
+    typedef resampler::f32_mono_sse_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+TEST_F(HalfbandX2DecimatorTest, f32_stereo_sse)
+{
+    typedef resampler::f32_stereo_sse_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_sse_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+TEST_F(HalfbandX2DecimatorTest, f32_mono_neon)
+{
+    typedef resampler::f32_mono_neon_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+
+TEST_F(HalfbandX2DecimatorTest, f32_stereo_neon)
+{
+    typedef resampler::f32_stereo_neon_halfband_x2_resampler_core_operator op_t;
+
+    if (!op_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_neon_halfband_x2_resampler_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::halfband_x2_decimator<op_t::src_frame_t, op_t::dest_frame_t, float, op_t> decimator(
+        &kernel_[0], FILTER_LENGTH, 0);
+
+    sub_test_decimate(*this, decimator, 1.0e-5f);
+}
+#endif
@@ -0,0 +1,199 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cxxdasp/resampler/polyphase/batched_polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
+
+using namespace cxxdasp;
+
+class BatchedPolyphaseResamplerTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        coeffs_.resize(NUM_COEFFS);
+        for (int i = 0; i < NUM_COEFFS; ++i) {
+            coeffs_[i] = static_cast<float>(std::sin(0.1 * (i + 1)) / (i + 1));
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { NUM_COEFFS = 255, NUM_SRC_FRAMES = 3000, BLOCK_SIZE = 256, CHUNK_SIZE = 100 };
+
+    static float src_signal(int stream, int i) { return static_cast<float>(std::sin(0.01 * (stream + 1) * i)); }
+
+    std::vector<float> coeffs_;
+};
+
+typedef resampler::polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t, float,
+                                       resampler::f32_mono_basic_polyphase_core_operator>
+reference_polyphase_resampler_t;
+
+// compares each stream with the output of the (not batched) polyphase_resampler
+template <class TBatchCoreOperator>
+void sub_test_batched(BatchedPolyphaseResamplerTest &tst, int num_streams, int m, int l, float tolerance)
+{
+    typedef resampler::batched_polyphase_resampler<float, float, TBatchCoreOperator> batched_resampler_t;
+
+    const int num_coeffs = BatchedPolyphaseResamplerTest::NUM_COEFFS;
+    const int num_src_frames = BatchedPolyphaseResamplerTest::NUM_SRC_FRAMES;
+    const int block_size = BatchedPolyphaseResamplerTest::BLOCK_SIZE;
+    const int chunk_size = BatchedPolyphaseResamplerTest::CHUNK_SIZE;
+
+    std::vector<std::vector<float>> src(num_streams, std::vector<float>(num_src_frames));
+    std::vector<std::vector<float>> expected(num_streams);
+    std::vector<std::vector<float>> actual(num_streams, std::vector<float>(num_src_frames * m / l + 1));
+
+    for (int k = 0; k < num_streams; ++k) {
+        for (int i = 0; i < num_src_frames; ++i) {
+            src[k][i] = BatchedPolyphaseResamplerTest::src_signal(k, i);
+        }
+    }
+
+    // reference
+    for (int k = 0; k < num_streams; ++k) {
+        reference_polyphase_resampler_t resampler(&tst.coeffs_[0], num_coeffs, m, l, block_size);
+        int n_put = 0;
+
+        while (n_put < num_src_frames) {
+            const int n = (std::min)((std::min)(resampler.num_can_put(), chunk_size), (num_src_frames - n_put));
+            resampler.put_n(reinterpret_cast<const datatype::f32_mono_frame_t *>(&src[k][n_put]), n);
+            n_put += n;
+
+            const int n_get = resampler.num_can_get();
+            const size_t offset = expected[k].size();
+            expected[k].resize(offset + n_get);
+            resampler.get_n(reinterpret_cast<datatype::f32_mono_frame_t *>(&expected[k][offset]), n_get);
+        }
+    }
+
+    // batched
+    batched_resampler_t resampler(&tst.coeffs_[0], num_coeffs, num_streams, m, l, block_size);
+
+    ASSERT_EQ(num_streams, resampler.num_streams());
+
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<const float *> src_ptrs(num_streams);
+        std::vector<float *> dest_ptrs(num_streams);
+        int n_put = 0;
+        int n_got = 0;
+
+        resampler.reset();
+
+        while (n_put < num_src_frames) {
+            const int n = (std::min)((std::min)(resampler.num_can_put(), chunk_size), (num_src_frames - n_put));
+
+            for (int k = 0; k < num_streams; ++k) {
+                src_ptrs[k] = &src[k][n_put];
+            }
+            resampler.put_n(&src_ptrs[0], n);
+            n_put += n;
+
+            const int n_get = resampler.num_can_get();
+            for (int k = 0; k < num_streams; ++k) {
+                dest_ptrs[k] = &actual[k][n_got];
+            }
+            resampler.get_n(&dest_ptrs[0], n_get);
+            n_got += n_get;
+        }
+
+        ASSERT_GT(n_got, 0);
+
+        for (int k = 0; k < num_streams; ++k) {
+            ASSERT_EQ(static_cast<int>(expected[k].size()), n_got);
+
+            for (int i = 0; i < n_got; ++i) {
+                ASSERT_NEAR(expected[k][i], actual[k][i], tolerance) << "stream = " << k << ", i = " << i;
+            }
+        }
+    }
+}
+
+TEST_F(BatchedPolyphaseResamplerTest, general_1_stream)
+{
+    sub_test_batched<resampler::f32_basic_batched_polyphase_core_operator>(*this, 1, 160, 147, 0.0f);
+}
+
+TEST_F(BatchedPolyphaseResamplerTest, general_7_streams_up)
+{
+    sub_test_batched<resampler::f32_basic_batched_polyphase_core_operator>(*this, 7, 160, 147, 0.0f);
+}
+
+TEST_F(BatchedPolyphaseResamplerTest, general_7_streams_down)
+{
+    sub_test_batched<resampler::f32_basic_batched_polyphase_core_operator>(*this, 7, 147, 160, 0.0f);
+}
+
+#if CXXPH_COMPILER_SUPPORTS_X86_SSE
+TEST_F(BatchedPolyphaseResamplerTest, sse_5_streams)
+{
+    typedef resampler::f32_sse_batched_polyphase_core_operator op_type;
+
+    if (!op_type::is_supported()) {
+        std::cout << "SKIPPED: f32_sse_batched_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_batched<op_type>(*this, 5, 160, 147, 1.0e-5f);
+}
+
+TEST_F(BatchedPolyphaseResamplerTest, sse_37_streams)
+{
+    typedef resampler::f32_sse_batched_polyphase_core_operator op_type;
+
+    if (!op_type::is_supported()) {
+        std::cout << "SKIPPED: f32_sse_batched_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_batched<op_type>(*this, 37, 147, 160, 1.0e-5f);
+}
+#endif
+
+#if CXXPH_COMPILER_SUPPORTS_ARM_NEON
+TEST_F(BatchedPolyphaseResamplerTest, neon_5_streams)
+{
+    typedef resampler::f32_neon_batched_polyphase_core_operator op_type;
+
+    if (!op_type::is_supported()) {
+        std::cout << "SKIPPED: f32_neon_batched_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_batched<op_type>(*this, 5, 160, 147, 1.0e-5f);
+}
+
+TEST_F(BatchedPolyphaseResamplerTest, neon_37_streams)
+{
+    typedef resampler::f32_neon_batched_polyphase_core_operator op_type;
+
+    if (!op_type::is_supported()) {
+        std::cout << "SKIPPED: f32_neon_batched_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    sub_test_batched<op_type>(*this, 37, 147, 160, 1.0e-5f);
+}
+#endif
@@ -286,6 +286,59 @@ TEST_F(FloatStereoPolyphaseCoreOperatorConvolveTest, f32_stereo_sse_polyphase_co
 }
 #endif
 
+//
+// AVX2 optimized core operators
+//
+#if CXXDASP_COMPILER_SUPPORTS_X86_AVX2_FMA
+TEST_F(FloatMonoPolyphaseCoreOperatorDualCopyTest, f32_mono_avx2_polyphase_core_operator)
+{
+
+    if (!resampler::f32_mono_avx2_polyphase_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_avx2_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::f32_mono_avx2_polyphase_core_operator op;
+    do_test_dual_copy(*this, op, MAX_TEST_DATA_SIZE);
+}
+
+TEST_F(FloatStereoPolyphaseCoreOperatorDualCopyTest, f32_stereo_avx2_polyphase_core_operator)
+{
+
+    if (!resampler::f32_stereo_avx2_polyphase_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx2_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::f32_stereo_avx2_polyphase_core_operator op;
+    do_test_dual_copy(*this, op, MAX_TEST_DATA_SIZE);
+}
+
+TEST_F(FloatMonoPolyphaseCoreOperatorConvolveTest, f32_mono_avx2_polyphase_core_operator)
+{
+
+    if (!resampler::f32_mono_avx2_polyphase_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_avx2_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::f32_mono_avx2_polyphase_core_operator op;
+    do_test_convolve(*this, op, MAX_TEST_DATA_SIZE * 2);
+}
+
+TEST_F(FloatStereoPolyphaseCoreOperatorConvolveTest, f32_stereo_avx2_polyphase_core_operator)
+{
+
+    if (!resampler::f32_stereo_avx2_polyphase_core_operator::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx2_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler::f32_stereo_avx2_polyphase_core_operator op;
+    do_test_convolve(*this, op, MAX_TEST_DATA_SIZE);
+}
+#endif
+
 //
 // NEON optimized core operators
 //
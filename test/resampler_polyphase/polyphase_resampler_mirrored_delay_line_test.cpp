@@ -0,0 +1,181 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
+#include <cxxdasp/utils/mirrored_memory.hpp>
+
+using namespace cxxdasp;
+
+//
+// NOTE: This test is also built with CXXDASP_USE_MIRRORED_DELAY_LINE=1 (test_resampler_polyphase_mirrored).
+//       A resampler with a small delay line (< page size) always uses the dual copy delay line,
+//       so it is the reference of the one with a large (mirror-mapped) delay line.
+//
+class PolyphaseResamplerMirroredDelayLineTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        coeffs_.resize(NUM_COEFFS);
+        for (int i = 0; i < NUM_COEFFS; ++i) {
+            coeffs_[i] = static_cast<float>(std::sin(0.1 * (i + 1)) / (i + 1));
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { NUM_COEFFS = 48, NUM_SRC_FRAMES = 100000, SMALL_BLOCK_SIZE = 16, LARGE_BLOCK_SIZE = 4096 };
+
+    std::vector<float> coeffs_;
+};
+
+typedef resampler::polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t, float,
+                                       resampler::general_polyphase_core_operator<float, float, float, 1>>
+general_f32_mono_polyphase_resampler_t;
+
+typedef resampler::polyphase_resampler<datatype::f32_stereo_frame_t, datatype::f32_stereo_frame_t, float,
+                                       resampler::general_polyphase_core_operator<float, float, float, 2>>
+general_f32_stereo_polyphase_resampler_t;
+
+static bool expect_mirrored_delay_line()
+{
+#if CXXDASP_USE_MIRRORED_DELAY_LINE
+    return utils::mirrored_memory_allocator::is_supported();
+#else
+    return false;
+#endif
+}
+
+template <class TResampler>
+static void resample_all(TResampler &resampler, const std::vector<typename TResampler::src_frame_t> &src,
+                         std::vector<typename TResampler::dest_frame_t> &dest, bool use_direct_input, int chunk_size)
+{
+    typedef typename TResampler::src_frame_t src_frame_t;
+
+    const int num_src_frames = static_cast<int>(src.size());
+    int n_put = 0;
+
+    dest.clear();
+
+    while (true) {
+        if (n_put < num_src_frames) {
+            int n;
+
+            if (use_direct_input) {
+                src_frame_t *buff = nullptr;
+                int n_available = 0;
+
+                resampler.refer_direct_input_buffer(&buff, &n_available);
+
+                n = (std::min)((std::min)(n_available, chunk_size), (num_src_frames - n_put));
+                std::copy(src.begin() + n_put, src.begin() + n_put + n, buff);
+                resampler.notify_direct_produced_input_buffer_items(n);
+            } else {
+                n = (std::min)((std::min)(resampler.num_can_put(), chunk_size), (num_src_frames - n_put));
+                resampler.put_n(&src[n_put], n);
+            }
+
+            n_put += n;
+
+            if (n_put == num_src_frames) {
+                resampler.flush();
+            }
+        }
+
+        const int n_get = resampler.num_can_get();
+
+        if (n_get == 0) {
+            if (n_put == num_src_frames) {
+                break;
+            }
+            continue;
+        }
+
+        const size_t offset = dest.size();
+        dest.resize(offset + n_get);
+        resampler.get_n(&dest[offset], n_get);
+    }
+}
+
+template <class TResampler>
+static void sub_test_bit_exact(PolyphaseResamplerMirroredDelayLineTest &tst, int m, int l, bool use_direct_input,
+                               int chunk_size)
+{
+    typedef typename TResampler::src_frame_t src_frame_t;
+    typedef typename TResampler::dest_frame_t dest_frame_t;
+
+    const int num_channels = src_frame_t::num_channels;
+    const int num_src_frames = PolyphaseResamplerMirroredDelayLineTest::NUM_SRC_FRAMES;
+
+    std::vector<src_frame_t> src(num_src_frames);
+    for (int i = 0; i < num_src_frames; ++i) {
+        for (int ch = 0; ch < num_channels; ++ch) {
+            src[i].c(ch) = static_cast<float>(std::sin(0.05 * i + ch) + 0.25 * std::cos(0.71 * i));
+        }
+    }
+
+    TResampler reference(&tst.coeffs_[0], PolyphaseResamplerMirroredDelayLineTest::NUM_COEFFS, m, l,
+                         PolyphaseResamplerMirroredDelayLineTest::SMALL_BLOCK_SIZE);
+    TResampler resampler(&tst.coeffs_[0], PolyphaseResamplerMirroredDelayLineTest::NUM_COEFFS, m, l,
+                         PolyphaseResamplerMirroredDelayLineTest::LARGE_BLOCK_SIZE);
+
+    // a delay line smaller than a page falls back to the dual copy one
+    ASSERT_FALSE(reference.is_delay_line_mirrored());
+    ASSERT_EQ(expect_mirrored_delay_line(), resampler.is_delay_line_mirrored());
+
+    std::vector<dest_frame_t> expected;
+    std::vector<dest_frame_t> actual;
+
+    resample_all(reference, src, expected, false, chunk_size);
+    resample_all(resampler, src, actual, use_direct_input, chunk_size);
+
+    ASSERT_GT(expected.size(), 0u);
+    ASSERT_EQ(expected.size(), actual.size());
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        for (int ch = 0; ch < num_channels; ++ch) {
+            ASSERT_EQ(expected[i].c(ch), actual[i].c(ch)) << "i = " << i << ", ch = " << ch;
+        }
+    }
+}
+
+TEST_F(PolyphaseResamplerMirroredDelayLineTest, mono_up_160_147)
+{
+    sub_test_bit_exact<general_f32_mono_polyphase_resampler_t>(*this, 160, 147, false, 13);
+}
+
+TEST_F(PolyphaseResamplerMirroredDelayLineTest, mono_down_147_160)
+{
+    sub_test_bit_exact<general_f32_mono_polyphase_resampler_t>(*this, 147, 160, false, 16);
+}
+
+TEST_F(PolyphaseResamplerMirroredDelayLineTest, stereo_up_3_2)
+{
+    sub_test_bit_exact<general_f32_stereo_polyphase_resampler_t>(*this, 3, 2, false, 7);
+}
+
+TEST_F(PolyphaseResamplerMirroredDelayLineTest, stereo_down_2_3_direct_input)
+{
+    sub_test_bit_exact<general_f32_stereo_polyphase_resampler_t>(*this, 2, 3, true, 5000);
+}
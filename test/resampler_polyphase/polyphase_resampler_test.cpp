@@ -0,0 +1,161 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
+
+using namespace cxxdasp;
+
+class PolyphaseResamplerTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        coeffs_.resize(NUM_COEFFS);
+        for (int i = 0; i < NUM_COEFFS; ++i) {
+            coeffs_[i] = static_cast<float>(std::sin(0.1 * (i + 1)) / (i + 1));
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { NUM_COEFFS = 255, NUM_SRC_FRAMES = 5000, BLOCK_SIZE = 256 };
+
+    std::vector<float> coeffs_;
+};
+
+typedef resampler::polyphase_resampler<datatype::f32_stereo_frame_t, datatype::f32_stereo_frame_t, float,
+                                       resampler::general_polyphase_core_operator<float, float, float, 2>>
+general_f32_stereo_polyphase_resampler_t;
+
+// process whole of the source data through put_n() or the direct input buffer APIs
+template <class TResampler>
+void process_all(TResampler &resampler, const std::vector<typename TResampler::src_frame_t> &src,
+                 std::vector<typename TResampler::dest_frame_t> &dest, bool use_direct_input, int chunk_size)
+{
+    typedef typename TResampler::src_frame_t src_frame_t;
+
+    const int num_src_frames = static_cast<int>(src.size());
+    int n_put = 0;
+
+    dest.clear();
+
+    while (true) {
+        if (n_put < num_src_frames) {
+            if (use_direct_input) {
+                src_frame_t *buff = nullptr;
+                int n_available = 0;
+
+                resampler.refer_direct_input_buffer(&buff, &n_available);
+
+                ASSERT_GE(n_available, 0);
+                ASSERT_LE(n_available, resampler.num_can_put());
+
+                const int n = (std::min)((std::min)(n_available, chunk_size), (num_src_frames - n_put));
+
+                std::copy(src.begin() + n_put, src.begin() + n_put + n, buff);
+                resampler.notify_direct_produced_input_buffer_items(n);
+
+                n_put += n;
+            } else {
+                const int n =
+                    (std::min)((std::min)(resampler.num_can_put(), chunk_size), (num_src_frames - n_put));
+
+                resampler.put_n(&src[n_put], n);
+
+                n_put += n;
+            }
+
+            if (n_put == num_src_frames) {
+                resampler.flush();
+            }
+        }
+
+        const int n_get = resampler.num_can_get();
+
+        if (n_get == 0) {
+            if (n_put == num_src_frames) {
+                break;
+            }
+            continue;
+        }
+
+        const size_t offset = dest.size();
+        dest.resize(offset + n_get);
+        resampler.get_n(&dest[offset], n_get);
+    }
+}
+
+template <class TResampler>
+void sub_test_direct_input(PolyphaseResamplerTest &tst, int m, int l, int chunk_size)
+{
+    typedef typename TResampler::src_frame_t src_frame_t;
+    typedef typename TResampler::dest_frame_t dest_frame_t;
+
+    const int num_src_frames = PolyphaseResamplerTest::NUM_SRC_FRAMES;
+
+    std::vector<src_frame_t> src(num_src_frames);
+    for (int i = 0; i < num_src_frames; ++i) {
+        src[i].c(0) = static_cast<float>(std::sin(0.05 * i));
+        src[i].c(1) = static_cast<float>(std::cos(0.03 * i));
+    }
+
+    TResampler resampler1(&tst.coeffs_[0], PolyphaseResamplerTest::NUM_COEFFS, m, l,
+                          PolyphaseResamplerTest::BLOCK_SIZE);
+    TResampler resampler2(&tst.coeffs_[0], PolyphaseResamplerTest::NUM_COEFFS, m, l,
+                          PolyphaseResamplerTest::BLOCK_SIZE);
+
+    std::vector<dest_frame_t> expected;
+    std::vector<dest_frame_t> actual;
+
+    process_all(resampler1, src, expected, false, chunk_size);
+    process_all(resampler2, src, actual, true, chunk_size);
+
+    ASSERT_GT(expected.size(), 0u);
+    ASSERT_EQ(expected.size(), actual.size());
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].c(0), actual[i].c(0)) << "i = " << i;
+        ASSERT_EQ(expected[i].c(1), actual[i].c(1)) << "i = " << i;
+    }
+}
+
+TEST_F(PolyphaseResamplerTest, direct_input_up_160_147)
+{
+    sub_test_direct_input<general_f32_stereo_polyphase_resampler_t>(*this, 160, 147, 100);
+}
+
+TEST_F(PolyphaseResamplerTest, direct_input_down_147_160)
+{
+    sub_test_direct_input<general_f32_stereo_polyphase_resampler_t>(*this, 147, 160, 37);
+}
+
+TEST_F(PolyphaseResamplerTest, direct_input_large_chunk)
+{
+    sub_test_direct_input<general_f32_stereo_polyphase_resampler_t>(*this, 3, 2, 100000);
+}
+
+TEST_F(PolyphaseResamplerTest, direct_input_pass_through)
+{
+    sub_test_direct_input<general_f32_stereo_polyphase_resampler_t>(*this, 1, 1, 100);
+}
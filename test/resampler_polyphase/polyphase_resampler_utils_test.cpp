@@ -0,0 +1,270 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+
+#include <cxxporthelper/cstdint>
+#include <cxxporthelper/aligned_memory.hpp>
+
+#include <cxxdasp/resampler/polyphase/polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_resampler_utils.hpp>
+#include <cxxdasp/resampler/polyphase/general_polyphase_core_operator.hpp>
+
+using namespace cxxdasp;
+
+class PolyphaseResamplerUtilsSharedCoeffsTableTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        coeffs_.resize(NUM_COEFFS);
+        for (int i = 0; i < NUM_COEFFS; ++i) {
+            coeffs_[i] = 1.0f / (i + 1);
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { NUM_COEFFS = 37 };
+
+    typedef resampler::polyphase_resampler_utils pprutils;
+
+    std::vector<float> coeffs_;
+};
+
+static bool is_aligned(const void *p)
+{
+    return (reinterpret_cast<uintptr_t>(p) % CXXDASP_POLYPHASE_RESAMPLER_COEFFS_ARRAY_ALIGN_SIZE) == 0;
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, same_as_make_interleaved_coeffs_table)
+{
+    const int m = 4;
+    const int n = pprutils::calc_interleaved_coeffs_subtable_size(NUM_COEFFS, m) * m;
+
+    std::vector<float> expected(n);
+    pprutils::make_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, &expected[0]);
+
+    std::shared_ptr<const float> table =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, false);
+
+    ASSERT_TRUE(static_cast<bool>(table));
+    ASSERT_TRUE(is_aligned(table.get()));
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(expected[i], table.get()[i]);
+    }
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, shared_while_referenced)
+{
+    std::shared_ptr<const float> table1 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 4, false);
+    std::shared_ptr<const float> table2 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 4, false);
+    std::shared_ptr<const float> table3 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 3, false);
+
+    ASSERT_EQ(table1.get(), table2.get());
+    ASSERT_NE(table1.get(), table3.get());
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, shared_between_identical_sources)
+{
+    std::vector<float> copied(coeffs_.begin(), coeffs_.end());
+
+    std::shared_ptr<const float> table1 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 4, false);
+    std::shared_ptr<const float> table2 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&copied[0], NUM_COEFFS, 4, false);
+
+    ASSERT_NE(&coeffs_[0], &copied[0]);
+    ASSERT_EQ(table1.get(), table2.get());
+}
+
+static uint64_t constant_coeffs_hash(const void *data, size_t size)
+{
+    (void)data;
+    (void)size;
+    return 0;
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, hash_collision)
+{
+    const int m = 4;
+    const int n = pprutils::calc_interleaved_coeffs_subtable_size(NUM_COEFFS, m) * m;
+
+    std::vector<float> other(coeffs_.begin(), coeffs_.end());
+    other[5] = 0.5f;
+
+    std::vector<float> expected1(n), expected2(n);
+    pprutils::make_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, &expected1[0]);
+    pprutils::make_interleaved_coeffs_table(&other[0], NUM_COEFFS, m, &expected2[0]);
+
+    // force every coefficient set into the same bucket
+    const pprutils::coeffs_hash_func_t prev_func = pprutils::set_shared_coeffs_table_hash_func(&constant_coeffs_hash);
+
+    std::shared_ptr<const float> table1 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, false);
+    std::shared_ptr<const float> table2 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&other[0], NUM_COEFFS, m, false);
+    std::shared_ptr<const float> table3 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&other[0], NUM_COEFFS, m, false);
+    std::shared_ptr<const float> table4 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&expected1[0], NUM_COEFFS, m, true);
+
+    pprutils::set_shared_coeffs_table_hash_func(prev_func);
+
+    // different contents are never shared, same contents are still shared
+    ASSERT_NE(table1.get(), table2.get());
+    ASSERT_EQ(table2.get(), table3.get());
+    ASSERT_NE(table1.get(), table4.get());
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(expected1[i], table1.get()[i]);
+        ASSERT_EQ(expected2[i], table2.get()[i]);
+        ASSERT_EQ(expected1[i], table4.get()[i]);
+    }
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, rebuilt_when_source_modified)
+{
+    std::shared_ptr<const float> table1 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 2, false);
+
+    coeffs_[1] = -1.0f;
+
+    std::shared_ptr<const float> table2 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, 2, false);
+
+    ASSERT_NE(table1.get(), table2.get());
+
+    // coeffs_[1] is the first element of the 2nd sub table (scaled by M)
+    const int subtable_size = pprutils::calc_interleaved_coeffs_subtable_size(NUM_COEFFS, 2);
+    ASSERT_EQ(-2.0f, table2.get()[subtable_size]);
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, interleaved_source)
+{
+    const int m = 3;
+    const int n = pprutils::calc_interleaved_coeffs_subtable_size(NUM_COEFFS, m) * m;
+
+    // intentionally misaligned source
+    std::vector<float> src(n + 1);
+    pprutils::make_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, &src[1]);
+
+    std::shared_ptr<const float> table1 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&src[1], NUM_COEFFS, m, true);
+    std::shared_ptr<const float> table2 =
+        pprutils::acquire_shared_interleaved_coeffs_table(&src[1], NUM_COEFFS, m, true);
+
+    ASSERT_EQ(table1.get(), table2.get());
+    ASSERT_TRUE(is_aligned(table1.get()));
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(src[i + 1], table1.get()[i]);
+    }
+}
+
+TEST_F(PolyphaseResamplerUtilsSharedCoeffsTableTest, resampler_constructors_give_same_output)
+{
+    typedef resampler::general_polyphase_core_operator<float, float, float, 1> core_operator_t;
+    typedef resampler::polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t, float,
+                                           core_operator_t> resampler_t;
+
+    const int m = 3;
+    const int l = 2;
+    const int n = pprutils::calc_interleaved_coeffs_subtable_size(NUM_COEFFS, m) * m;
+
+    std::vector<float> interleaved(n);
+    pprutils::make_interleaved_coeffs_table(&coeffs_[0], NUM_COEFFS, m, &interleaved[0]);
+
+    resampler_t r1(&coeffs_[0], NUM_COEFFS, m, l, 16);
+    resampler_t r2(&interleaved[0], NUM_COEFFS, true, m, l, 16);
+
+    std::vector<datatype::f32_mono_frame_t> src(16);
+    std::vector<datatype::f32_mono_frame_t> dest1(64), dest2(64);
+    int total = 0;
+
+    for (int i = 0; i < static_cast<int>(src.size()); ++i) {
+        src[i].c(0) = static_cast<float>((i * 7) % 5) - 2.0f;
+    }
+
+    // repeat enough to wrap around the delay line
+    for (int loop = 0; loop < 32; ++loop) {
+        ASSERT_EQ(r1.num_can_put(), r2.num_can_put());
+        const int n_put = (std::min)(r1.num_can_put(), static_cast<int>(src.size()));
+        r1.put_n(&src[0], n_put);
+        r2.put_n(&src[0], n_put);
+
+        ASSERT_EQ(r1.num_can_get(), r2.num_can_get());
+        const int n_get = (std::min)(r1.num_can_get(), static_cast<int>(dest1.size()));
+        r1.get_n(&dest1[0], n_get);
+        r2.get_n(&dest2[0], n_get);
+
+        for (int i = 0; i < n_get; ++i) {
+            ASSERT_EQ(dest1[i].c(0), dest2[i].c(0));
+        }
+
+        total += n_get;
+    }
+
+    ASSERT_GT(total, 0);
+}
+
+//
+// polyphase_resampler_utils::make_phase_schedule_table()
+//
+static void sub_test_phase_schedule_table(int m, int l, int subtable_size)
+{
+    typedef resampler::polyphase_resampler_utils pprutils;
+
+    std::vector<pprutils::phase_schedule_entry> table(m);
+
+    pprutils::make_phase_schedule_table(m, l, subtable_size, &table[0]);
+
+    for (int start = 0; start < (std::min)(m, 8); ++start) {
+        // walk (2 * M) outputs and compare with the integer division based calculation
+        int rp = start;
+        int pos = 0;
+        int phase = start;
+
+        for (int i = 0; i < (2 * m); ++i) {
+            const pprutils::phase_schedule_entry &e = table[phase];
+
+            ASSERT_EQ(rp / m, pos);
+            ASSERT_EQ(((m - 1) - (rp % m)) * subtable_size, e.coeffs_offset);
+
+            pos += e.delay_advance;
+            phase = e.next_phase;
+            rp += l;
+        }
+
+        ASSERT_EQ(rp / m, pos);
+        ASSERT_EQ(rp % m, phase);
+    }
+}
+
+TEST(PolyphaseResamplerUtilsPhaseScheduleTableTest, m_160_l_147) { sub_test_phase_schedule_table(160, 147, 12); }
+
+TEST(PolyphaseResamplerUtilsPhaseScheduleTableTest, m_147_l_160) { sub_test_phase_schedule_table(147, 160, 13); }
+
+TEST(PolyphaseResamplerUtilsPhaseScheduleTableTest, m_441_l_3840) { sub_test_phase_schedule_table(441, 3840, 9); }
+
+TEST(PolyphaseResamplerUtilsPhaseScheduleTableTest, m_2_l_4) { sub_test_phase_schedule_table(2, 4, 5); }
@@ -0,0 +1,219 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <cxxdasp/resampler/polyphase/variable_ratio_polyphase_resampler.hpp>
+#include <cxxdasp/resampler/polyphase/polyphase_core_operators.hpp>
+#include <cxxdasp/window/window_functions.hpp>
+
+using namespace cxxdasp;
+
+class VariableRatioPolyphaseResamplerTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+
+        // Kaiser windowed sinc prototype filter (for the NUM_PHASES times oversampled rate)
+        const int n = NUM_COEFFS;
+        const double fc = 0.45 / NUM_PHASES;
+        std::vector<float> window(n);
+
+        window::generate_kaiser_window(&window[0], n, 8.0);
+
+        coeffs_.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const double x = (i - (n - 1) * 0.5) * 2.0 * fc;
+            const double sinc = (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            coeffs_[i] = static_cast<float>(2.0 * fc * sinc * window[i]);
+        }
+    }
+    virtual void TearDown() {}
+
+public:
+    enum { NUM_PHASES = 32, NUM_TAPS = 16, NUM_COEFFS = (NUM_PHASES * NUM_TAPS - 1), NUM_SRC_FRAMES = 4000 };
+
+    // input time of the first output frame
+    static double initial_time()
+    {
+        return (NUM_TAPS - 1) - (NUM_TAPS / 2) - ((NUM_COEFFS - 1) / (2.0 * NUM_PHASES));
+    }
+
+    static float src_signal(double t) { return static_cast<float>(std::sin(2.0 * M_PI * 0.02 * t)); }
+
+    std::vector<float> coeffs_;
+};
+
+// feeds sine wave and checks each output frame against the analytic value at the expected input time
+template <class TResampler>
+void sub_test_sine(TResampler &resampler, double ratio, int switch_at, double new_ratio, int ramp_length)
+{
+    typedef typename TResampler::src_frame_t src_frame_t;
+    typedef typename TResampler::dest_frame_t dest_frame_t;
+
+    const int num_taps = VariableRatioPolyphaseResamplerTest::NUM_TAPS;
+    const int num_src_frames = VariableRatioPolyphaseResamplerTest::NUM_SRC_FRAMES;
+
+    std::vector<src_frame_t> src(num_src_frames);
+    for (int i = 0; i < num_src_frames; ++i) {
+        src[i] = src_frame_t(VariableRatioPolyphaseResamplerTest::src_signal(i));
+    }
+
+    // reference model of the read position
+    double t = VariableRatioPolyphaseResamplerTest::initial_time();
+    double step = 1.0 / ratio;
+    double target_step = step;
+    double step_delta = 0.0;
+    int ramp_remains = 0;
+
+    int n_put = 0;
+    int n_get = 0;
+    double max_error = 0.0;
+
+    while (n_put < num_src_frames) {
+        const int n = (std::min)((std::min)(resampler.num_can_put(), 64), (num_src_frames - n_put));
+        resampler.put_n(&src[n_put], n);
+        n_put += n;
+
+        while (resampler.num_can_get() > 0) {
+            if (n_get == switch_at) {
+                resampler.set_ratio(new_ratio, ramp_length);
+
+                target_step = 1.0 / new_ratio;
+                step_delta = (target_step - step) / ramp_length;
+                ramp_remains = ramp_length;
+            }
+
+            dest_frame_t d;
+            resampler.get_n(&d, 1);
+
+            if (t > num_taps && t < (num_src_frames - num_taps)) {
+                const double expected = VariableRatioPolyphaseResamplerTest::src_signal(t);
+                for (int ch = 0; ch < dest_frame_t::num_channels; ++ch) {
+                    max_error = (std::max)(max_error, std::fabs(d.c(ch) - expected));
+                }
+            }
+
+            if (ramp_remains > 0) {
+                step += step_delta;
+                if (--ramp_remains == 0) {
+                    step = target_step;
+                }
+            }
+            t += step;
+            ++n_get;
+        }
+    }
+
+    EXPECT_LT(max_error, 1.0e-3);
+    EXPECT_NEAR((1.0 / step), resampler.get_ratio(), 1.0e-9);
+
+    // number of output frames follows the ratio
+    EXPECT_GT(t, (num_src_frames - num_taps - 1));
+    EXPECT_LT(t, (num_src_frames + 1));
+}
+
+TEST_F(VariableRatioPolyphaseResamplerTest, f32_mono_general_constant_ratio)
+{
+    typedef resampler::general_polyphase_core_operator<float, float, float, 1> core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t,
+                                                          float, core_operator_t> resampler_t;
+
+    const double ratios[] = { 1.0, 0.9, 1.1, 48000.0 / 44100.0, 44100.0 / 48000.0, 1.0001 };
+
+    for (double ratio : ratios) {
+        resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, ratio, 32);
+        sub_test_sine(resampler, ratio, -1, ratio, 1);
+    }
+}
+
+TEST_F(VariableRatioPolyphaseResamplerTest, f32_stereo_general_ramped_ratio)
+{
+    typedef resampler::general_polyphase_core_operator<float, float, float, 2> core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_stereo_frame_t,
+                                                          datatype::f32_stereo_frame_t, float,
+                                                          core_operator_t> resampler_t;
+
+    resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, 1.0, 32);
+    sub_test_sine(resampler, 1.0, 500, 1.05, 1000);
+}
+
+TEST_F(VariableRatioPolyphaseResamplerTest, reset)
+{
+    typedef resampler::general_polyphase_core_operator<float, float, float, 1> core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t,
+                                                          float, core_operator_t> resampler_t;
+
+    resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, 1.0, 32);
+
+    sub_test_sine(resampler, 1.0, 100, 0.95, 200);
+    resampler.reset();
+    sub_test_sine(resampler, 0.95, -1, 0.95, 1);
+}
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_I386) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_X86_64)
+TEST_F(VariableRatioPolyphaseResamplerTest, f32_mono_sse_ramped_ratio)
+{
+    typedef resampler::f32_mono_sse_polyphase_core_operator core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t,
+                                                          float, core_operator_t> resampler_t;
+
+    if (!core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_sse_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, 1.0, 32);
+    sub_test_sine(resampler, 1.0, 500, 0.97, 1000);
+}
+
+TEST_F(VariableRatioPolyphaseResamplerTest, f32_stereo_avx2_ramped_ratio)
+{
+    typedef resampler::f32_stereo_avx2_polyphase_core_operator core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_stereo_frame_t,
+                                                          datatype::f32_stereo_frame_t, float,
+                                                          core_operator_t> resampler_t;
+
+    if (!core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_stereo_avx2_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, 1.0, 32);
+    sub_test_sine(resampler, 1.0, 500, 1.03, 1000);
+}
+#endif
+
+#if (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM) || (CXXPH_TARGET_ARCH == CXXPH_ARCH_ARM64)
+TEST_F(VariableRatioPolyphaseResamplerTest, f32_mono_neon_ramped_ratio)
+{
+    typedef resampler::f32_mono_neon_polyphase_core_operator core_operator_t;
+    typedef resampler::variable_ratio_polyphase_resampler<datatype::f32_mono_frame_t, datatype::f32_mono_frame_t,
+                                                          float, core_operator_t> resampler_t;
+
+    if (!core_operator_t::is_supported()) {
+        std::cout << "SKIPPED: f32_mono_neon_polyphase_core_operator is not supported" << std::endl;
+        return;
+    }
+
+    resampler_t resampler(&coeffs_[0], NUM_COEFFS, NUM_PHASES, 1.0, 32);
+    sub_test_sine(resampler, 1.0, 500, 0.97, 1000);
+}
+#endif
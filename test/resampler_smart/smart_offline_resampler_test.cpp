@@ -0,0 +1,190 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <vector>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/resampler/smart/smart_offline_resampler.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler_params_factory.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix test_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+typedef resampler::smart_resampler_params_factory factory_t;
+typedef datatype::f32_stereo_frame_t frame_t;
+typedef resampler::smart_offline_resampler<frame_t, frame_t,
+                                           resampler::f32_stereo_basic_halfband_x2_resampler_core_operator,
+                                           test_fft_backend_f, resampler::f32_stereo_basic_polyphase_core_operator>
+    offline_resampler_t;
+typedef offline_resampler_t::resampler_type resampler_t;
+
+class SmartOfflineResamplerTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void make_input(std::vector<frame_t> &src, int n)
+{
+    src.resize(n);
+    for (int i = 0; i < n; ++i) {
+        src[i].c(0) = static_cast<float>(((i * 7919LL) % 2001) - 1000) * 0.001f;
+        src[i].c(1) = static_cast<float>(((i * 104729LL) % 2001) - 1000) * 0.001f;
+    }
+}
+
+static void run_streaming(const resampler::smart_resampler_params &params, const std::vector<frame_t> &src,
+                          std::vector<frame_t> &dest)
+{
+    resampler_t r(params);
+    std::vector<frame_t> tmp(1000);
+    int n_put = 0;
+
+    dest.clear();
+
+    while (!r.is_finished()) {
+        if (n_put < static_cast<int>(src.size())) {
+            const int n = (std::min)(r.num_can_put(), static_cast<int>(src.size()) - n_put);
+            r.put_n(&src[n_put], n);
+            n_put += n;
+            if (n_put == static_cast<int>(src.size())) {
+                r.flush();
+            }
+        }
+
+        const int n = (std::min)(static_cast<int>(tmp.size()), r.num_can_get());
+        r.get_n(&tmp[0], n);
+        dest.insert(dest.end(), tmp.begin(), tmp.begin() + n);
+    }
+}
+
+static void check_offline(int input_freq, int output_freq, factory_t::quality_spec_t quality, int n_src,
+                          int num_threads, int chunk_size)
+{
+    factory_t f(input_freq, output_freq, quality);
+    std::vector<frame_t> src, expected;
+
+    ASSERT_TRUE(f);
+
+    make_input(src, n_src);
+    run_streaming(f.params(), src, expected);
+
+    offline_resampler_t r(f.params(), num_threads, chunk_size);
+
+    ASSERT_EQ(num_threads, r.num_threads());
+    ASSERT_EQ(0, r.overlap() % r.input_period());
+
+    // whole output
+    {
+        std::vector<frame_t> actual(expected.size() + 1000);
+        const int n = r.process(&src[0], n_src, &actual[0], static_cast<int>(actual.size()));
+
+        ASSERT_EQ(static_cast<int>(expected.size()), n) << input_freq << " -> " << output_freq;
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(expected[i].c(0), actual[i].c(0)) << "index = " << i;
+            ASSERT_EQ(expected[i].c(1), actual[i].c(1)) << "index = " << i;
+        }
+    }
+
+    // truncated output
+    {
+        const int n_dest = static_cast<int>(expected.size()) / 3;
+        std::vector<frame_t> actual(n_dest);
+        const int n = r.process(&src[0], n_src, &actual[0], n_dest);
+
+        ASSERT_EQ(n_dest, n);
+        for (int i = 0; i < n; ++i) {
+            ASSERT_EQ(expected[i].c(0), actual[i].c(0)) << "index = " << i;
+            ASSERT_EQ(expected[i].c(1), actual[i].c(1)) << "index = " << i;
+        }
+    }
+}
+
+TEST_F(SmartOfflineResamplerTest, fft_upsampler)
+{
+    factory_t f(44100, 48000, factory_t::HighQuality);
+    ASSERT_TRUE(f.params().stage1.use_fft_resampler);
+
+    check_offline(44100, 48000, factory_t::HighQuality, 400000, 4, 0);
+}
+
+TEST_F(SmartOfflineResamplerTest, halfband_upsampler)
+{
+    factory_t f(44100, 48000, factory_t::LowQuality);
+    ASSERT_FALSE(f.params().stage1.use_fft_resampler);
+    ASSERT_FALSE(f.params().stage1.use_halfband_decimator);
+
+    check_offline(44100, 48000, factory_t::LowQuality, 100000, 3, 1);
+}
+
+TEST_F(SmartOfflineResamplerTest, halfband_decimator)
+{
+    factory_t f(96000, 48000, factory_t::LowQuality);
+    ASSERT_TRUE(f.params().stage1.use_halfband_decimator);
+
+    check_offline(96000, 48000, factory_t::LowQuality, 100000, 4, 5000);
+}
+
+TEST_F(SmartOfflineResamplerTest, halfband_cascade_decimator)
+{
+    factory_t f(384000, 48000, factory_t::MidQuality);
+    ASSERT_EQ(3, f.params().stage1.num_decimator_stages);
+
+    check_offline(384000, 48000, factory_t::MidQuality, 200000, 4, 5000);
+}
+
+TEST_F(SmartOfflineResamplerTest, arbitrary_ratio)
+{
+    check_offline(22050, 16000, factory_t::MidQuality, 300000, 2, 1);
+    check_offline(37800, 48000, factory_t::HighQuality, 150000, 3, 1);
+    check_offline(44100, 16000, factory_t::HighQuality, 150000, 3, 1);
+}
+
+TEST_F(SmartOfflineResamplerTest, stage2_only)
+{
+    factory_t f(48000, 48000, factory_t::LowQuality);
+    ASSERT_FALSE(f.params().have_stage1);
+
+    check_offline(48000, 48000, factory_t::LowQuality, 10000, 4, 1);
+}
+
+TEST_F(SmartOfflineResamplerTest, single_thread)
+{
+    check_offline(44100, 48000, factory_t::MidQuality, 50000, 1, 0);
+}
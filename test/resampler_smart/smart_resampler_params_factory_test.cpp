@@ -0,0 +1,267 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler_params_factory.hpp>
+
+using namespace cxxdasp;
+
+typedef resampler::smart_resampler_params_factory factory_t;
+
+class SmartResamplerParamsFactoryTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void check_ratio(int input_freq, int output_freq, const resampler::smart_resampler_params &params)
+{
+    long long mid_freq = input_freq;
+
+    if (params.have_stage1) {
+        mid_freq = (params.stage1.use_halfband_decimator) ? (input_freq / params.stage1.decimation_factor())
+                                                          : (2LL * input_freq);
+    }
+
+    ASSERT_TRUE(params.have_stage2);
+    ASSERT_EQ(mid_freq * params.stage2.m, static_cast<long long>(output_freq) * params.stage2.l);
+}
+
+static void expect_coeffs_near(const float *expected, const float *actual, int n, float abs_error)
+{
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(expected[i], actual[i], abs_error) << "index = " << i;
+    }
+}
+
+// gain of the prototype filter at (f x output freq.)
+static double calc_decimating_stage2_gain(const resampler::smart_resampler_params::stage2_poly_fir_info &s2, double f)
+{
+    const int subtable_size = s2.n_coeffs / s2.m;
+    const double w = 2.0 * M_PI * f / s2.l;
+    double re = 0.0;
+    double im = 0.0;
+
+    for (int k = 0; k < s2.n_coeffs; ++k) {
+        const double h = s2.coeffs[subtable_size * (k % s2.m) + (k / s2.m)];
+        re += h * cos(w * k);
+        im -= h * sin(w * k);
+    }
+
+    return sqrt(re * re + im * im) / s2.m;
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, pre_designed_pairs)
+{
+    factory_t f(44100, 48000, factory_t::HighQuality);
+
+    ASSERT_TRUE(f);
+    ASSERT_TRUE(f.params().have_stage1);
+    ASSERT_TRUE(f.params().stage1.is_static);
+    ASSERT_TRUE(f.params().stage2.is_static);
+    ASSERT_EQ(80, f.params().stage2.m);
+    ASSERT_EQ(147, f.params().stage2.l);
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, arbitrary_pairs)
+{
+    static const int freqs[][2] = { { 22050, 16000 }, { 37800, 48000 }, { 16000, 22050 }, { 11025, 8000 },
+                                    { 32000, 32000 }, { 48000, 32000 }, { 8000, 96000 }, { 192000, 8000 }, };
+    static const factory_t::quality_spec_t qualities[] = { factory_t::LowQuality, factory_t::MidQuality,
+                                                           factory_t::HighQuality, };
+
+    for (const auto &freq : freqs) {
+        for (const auto quality : qualities) {
+            factory_t f(freq[0], freq[1], quality);
+
+            ASSERT_TRUE(f) << freq[0] << " -> " << freq[1] << " (quality = " << quality << ")";
+            // down-conversions by more than 2:1 do not need x2 oversampling stage
+            ASSERT_EQ((freq[0] != freq[1] && (freq[1] * 2) >= freq[0]), f.params().have_stage1);
+            check_ratio(freq[0], freq[1], f.params());
+        }
+    }
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, halfband_decimator_pairs)
+{
+    static const int freqs[][2] = { { 96000, 48000 }, { 88200, 44100 }, { 192000, 96000 }, { 48000, 24000 }, };
+
+    for (const auto &freq : freqs) {
+        factory_t lq(freq[0], freq[1], factory_t::LowQuality);
+        factory_t mq(freq[0], freq[1], factory_t::MidQuality);
+        factory_t hq(freq[0], freq[1], factory_t::HighQuality);
+
+        ASSERT_TRUE(lq);
+        ASSERT_TRUE(lq.params().stage1.use_halfband_decimator);
+        ASSERT_EQ(1, lq.params().stage2.m);
+        ASSERT_EQ(1, lq.params().stage2.l);
+        check_ratio(freq[0], freq[1], lq.params());
+
+        ASSERT_TRUE(mq);
+        ASSERT_TRUE(mq.params().stage1.use_halfband_decimator);
+        ASSERT_NE(lq.params().stage1.coeffs, mq.params().stage1.coeffs);
+        check_ratio(freq[0], freq[1], mq.params());
+
+        ASSERT_TRUE(hq);
+        ASSERT_FALSE(hq.params().stage1.use_halfband_decimator);
+        check_ratio(freq[0], freq[1], hq.params());
+    }
+
+    // other down-conversions are not affected
+    ASSERT_FALSE(factory_t(96000, 44100, factory_t::LowQuality).params().stage1.use_halfband_decimator);
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, halfband_cascade_decimator_pairs)
+{
+    static const int freqs[][3] = { { 192000, 48000, 2 }, { 176400, 44100, 2 }, { 32000, 8000, 2 },
+                                    { 384000, 48000, 3 }, { 352800, 44100, 3 }, { 64000, 8000, 3 }, };
+
+    for (const auto &freq : freqs) {
+        factory_t lq(freq[0], freq[1], factory_t::LowQuality);
+        factory_t mq(freq[0], freq[1], factory_t::MidQuality);
+        factory_t hq(freq[0], freq[1], factory_t::HighQuality);
+
+        ASSERT_TRUE(lq);
+        ASSERT_TRUE(lq.params().stage1.use_halfband_decimator);
+        ASSERT_EQ(freq[2], lq.params().stage1.num_decimator_stages);
+        ASSERT_EQ(1, lq.params().stage2.m);
+        ASSERT_EQ(1, lq.params().stage2.l);
+        check_ratio(freq[0], freq[1], lq.params());
+
+        ASSERT_TRUE(mq);
+        ASSERT_TRUE(mq.params().stage1.use_halfband_decimator);
+        ASSERT_EQ(freq[2], mq.params().stage1.num_decimator_stages);
+        ASSERT_NE(lq.params().stage1.coeffs, mq.params().stage1.coeffs);
+        ASSERT_EQ(lq.params().stage1.pre_coeffs, mq.params().stage1.pre_coeffs);
+        check_ratio(freq[0], freq[1], mq.params());
+
+        ASSERT_TRUE(hq);
+        ASSERT_FALSE(hq.params().stage1.use_halfband_decimator);
+        check_ratio(freq[0], freq[1], hq.params());
+    }
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, designed_decimation_pairs)
+{
+    static const int freqs[][2] = { { 192000, 8000 }, { 44100, 16000 }, { 96000, 22050 }, { 48000, 11025 }, };
+    static const factory_t::quality_spec_t qualities[] = { factory_t::LowQuality, factory_t::MidQuality,
+                                                           factory_t::HighQuality, };
+
+    for (const auto &freq : freqs) {
+        for (const auto quality : qualities) {
+            factory_t f(freq[0], freq[1], quality);
+
+            ASSERT_TRUE(f) << freq[0] << " -> " << freq[1] << " (quality = " << quality << ")";
+            ASSERT_FALSE(f.params().have_stage1);
+            ASSERT_FALSE(f.params().stage2.is_static);
+            ASSERT_GT(f.params().stage2.l, 2 * f.params().stage2.m);
+            ASSERT_EQ(0, (f.params().stage2.n_coeffs / f.params().stage2.m) % 4);
+            check_ratio(freq[0], freq[1], f.params());
+        }
+    }
+
+    // pass band: up to 0.35 x output freq., stop band: above the output Nyquist freq.
+    factory_t f(44100, 16000, factory_t::HighQuality);
+    const resampler::smart_resampler_params::stage2_poly_fir_info &s2 = f.params().stage2;
+
+    ASSERT_NEAR(1.0, calc_decimating_stage2_gain(s2, 0.35), 1e-3);
+    ASSERT_LT(calc_decimating_stage2_gain(s2, 0.55), 1e-5);
+    ASSERT_LT(calc_decimating_stage2_gain(s2, 1.5), 1e-5);
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, invalid_pairs)
+{
+    ASSERT_FALSE(factory_t(0, 48000, factory_t::HighQuality));
+    ASSERT_FALSE(factory_t(44100, 0, factory_t::HighQuality));
+    ASSERT_FALSE(factory_t(-44100, 48000, factory_t::HighQuality));
+
+    // M = 24000 (> max_designed_stage2_m)
+    ASSERT_FALSE(factory_t(44101, 48000, factory_t::HighQuality));
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, designed_stage1_matches_pre_designed)
+{
+    // 96000 -> 88200 and 48000 -> 44100 have the same ratio (147 / 160)
+    factory_t pre_designed(48000, 44100, factory_t::HighQuality);
+    factory_t designed(96000, 88200, factory_t::HighQuality);
+
+    ASSERT_TRUE(pre_designed);
+    ASSERT_TRUE(designed);
+
+    const resampler::smart_resampler_params::stage1_x2_fir_info &expected = pre_designed.params().stage1;
+    const resampler::smart_resampler_params::stage1_x2_fir_info &actual = designed.params().stage1;
+
+    ASSERT_TRUE(expected.is_static);
+    ASSERT_FALSE(actual.is_static);
+    ASSERT_TRUE(actual.use_fft_resampler);
+    ASSERT_EQ(expected.n_coeffs, actual.n_coeffs);
+
+    expect_coeffs_near(expected.coeffs, actual.coeffs, actual.n_coeffs, 1e-6f);
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, designed_stage2_matches_pre_designed)
+{
+    static const factory_t::quality_spec_t qualities[] = { factory_t::LowQuality, factory_t::HighQuality, };
+
+    for (const auto quality : qualities) {
+        // 22050 -> 24000 and 44100 -> 48000 have the same M (80)
+        factory_t pre_designed(44100, 48000, quality);
+        factory_t designed(22050, 24000, quality);
+
+        ASSERT_TRUE(pre_designed);
+        ASSERT_TRUE(designed);
+
+        const resampler::smart_resampler_params::stage2_poly_fir_info &expected = pre_designed.params().stage2;
+        const resampler::smart_resampler_params::stage2_poly_fir_info &actual = designed.params().stage2;
+
+        if (!expected.coeffs) {
+            std::cout << "SKIPPED: pre-designed table is disabled (quality = " << quality << ")" << std::endl;
+            continue;
+        }
+
+        ASSERT_FALSE(actual.is_static);
+        ASSERT_EQ(expected.m, actual.m);
+        ASSERT_EQ(expected.n_coeffs, actual.n_coeffs);
+
+        expect_coeffs_near(expected.coeffs, actual.coeffs, actual.n_coeffs, 1e-6f);
+    }
+}
+
+TEST_F(SmartResamplerParamsFactoryTest, design_cache)
+{
+    factory_t::clear_design_cache();
+
+    factory_t f1(22050, 16000, factory_t::HighQuality);
+    factory_t f2(22050, 16000, factory_t::HighQuality);
+
+    ASSERT_TRUE(f1);
+    ASSERT_TRUE(f2);
+
+    // same designs are shared
+    ASSERT_EQ(f1.params().stage1.coeffs, f2.params().stage1.coeffs);
+    ASSERT_EQ(f1.params().stage2.coeffs, f2.params().stage2.coeffs);
+
+    // designs used by the living factories are kept alive after clearing the cache
+    factory_t::clear_design_cache();
+
+    factory_t f3(22050, 16000, factory_t::HighQuality);
+
+    ASSERT_TRUE(f3);
+    ASSERT_EQ(f1.params().stage2.n_coeffs, f3.params().stage2.n_coeffs);
+    expect_coeffs_near(f1.params().stage2.coeffs, f3.params().stage2.coeffs, f3.params().stage2.n_coeffs, 0.0f);
+}
@@ -0,0 +1,298 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <vector>
+
+#include <cxxdasp/cxxdasp.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler.hpp>
+#include <cxxdasp/resampler/smart/smart_resampler_params_factory.hpp>
+
+using namespace cxxdasp;
+
+#if CXXDASP_USE_FFT_BACKEND_PFFFT
+typedef fft::backend::f::pffft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTS
+typedef fft::backend::f::ffts test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KISS_FFT
+typedef fft::backend::f::kiss_fft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_NE10
+typedef fft::backend::f::ne10 test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_FFTWF
+typedef fft::backend::f::fftw test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_CKFFT
+typedef fft::backend::f::ckfft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MUFFT
+typedef fft::backend::f::mufft test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_KFR_F
+typedef fft::backend::f::kfr test_fft_backend_f;
+#elif CXXDASP_USE_FFT_BACKEND_MIXED_RADIX
+typedef fft::backend::f::mixed_radix test_fft_backend_f;
+#else
+#error No FFT library available
+#endif
+
+typedef resampler::smart_resampler_params_factory factory_t;
+typedef datatype::f32_stereo_frame_t frame_t;
+typedef resampler::smart_resampler<frame_t, frame_t, resampler::f32_stereo_basic_halfband_x2_resampler_core_operator,
+                                   test_fft_backend_f, resampler::f32_stereo_basic_polyphase_core_operator>
+    resampler_t;
+
+class SmartResamplerPipelineTest : public ::testing::Test {
+protected:
+    virtual void SetUp() { cxxdasp_init(); }
+    virtual void TearDown() {}
+};
+
+static void make_input(std::vector<frame_t> &src, int n)
+{
+    src.resize(n);
+    for (int i = 0; i < n; ++i) {
+        src[i].c(0) = static_cast<float>(((i * 7919LL) % 2001) - 1000) * 0.001f;
+        src[i].c(1) = static_cast<float>(((i * 104729LL) % 2001) - 1000) * 0.001f;
+    }
+}
+
+static void run(resampler_t &r, const std::vector<frame_t> &src, std::vector<frame_t> &dest, int block_size)
+{
+    std::vector<frame_t> tmp(block_size);
+    int n_put = 0;
+
+    dest.clear();
+
+    while (!r.is_finished()) {
+        bool progress = false;
+
+        if (n_put < static_cast<int>(src.size())) {
+            const int n = (std::min)((std::min)(block_size, r.num_can_put()), static_cast<int>(src.size()) - n_put);
+            if (n > 0) {
+                r.put_n(&src[n_put], n);
+                n_put += n;
+                progress = true;
+            }
+            if (n_put == static_cast<int>(src.size())) {
+                r.flush();
+            }
+        }
+
+        const int n = (std::min)(block_size, r.num_can_get());
+        if (n > 0) {
+            r.get_n(&tmp[0], n);
+            dest.insert(dest.end(), tmp.begin(), tmp.begin() + n);
+            progress = true;
+        }
+
+        if (!progress) {
+            if (n_put < static_cast<int>(src.size())) {
+                r.wait_num_can_put();
+            } else {
+                r.wait_num_can_get();
+            }
+        }
+    }
+}
+
+// put everything first, then drain the output by blocking on wait_num_can_get()
+static void run_drain(resampler_t &r, const std::vector<frame_t> &src, std::vector<frame_t> &dest, int block_size)
+{
+    std::vector<frame_t> tmp(block_size);
+    int n_put = 0;
+
+    dest.clear();
+
+    while (n_put < static_cast<int>(src.size())) {
+        int n = (std::min)(r.num_can_put(), static_cast<int>(src.size()) - n_put);
+
+        if (n == 0) {
+            // input ring is full, make room by reading out the output
+            const int n_get = (std::min)(block_size, r.num_can_get());
+            if (n_get > 0) {
+                r.get_n(&tmp[0], n_get);
+                dest.insert(dest.end(), tmp.begin(), tmp.begin() + n_get);
+                continue;
+            }
+            n = (std::min)(r.wait_num_can_put(), static_cast<int>(src.size()) - n_put);
+        }
+
+        r.put_n(&src[n_put], n);
+        n_put += n;
+    }
+
+    r.flush();
+    ASSERT_EQ(0, r.wait_num_can_put());
+
+    while (true) {
+        const int n = (std::min)(block_size, r.wait_num_can_get());
+        if (n == 0) {
+            break;
+        }
+        r.get_n(&tmp[0], n);
+        dest.insert(dest.end(), tmp.begin(), tmp.begin() + n);
+    }
+
+    ASSERT_TRUE(r.is_finished());
+}
+
+static void check_pipelined(int input_freq, int output_freq, factory_t::quality_spec_t quality, bool use_fft,
+                            bool use_decimator)
+{
+    factory_t f(input_freq, output_freq, quality);
+    std::vector<frame_t> src, expected, actual;
+
+    ASSERT_TRUE(f);
+    ASSERT_TRUE(f.params().have_stage1);
+    ASSERT_EQ(use_fft, f.params().stage1.use_fft_resampler);
+    ASSERT_EQ(use_decimator, f.params().stage1.use_halfband_decimator);
+
+    make_input(src, 100000);
+
+    {
+        resampler_t r(f.params());
+        ASSERT_FALSE(r.is_pipelined());
+        run(r, src, expected, 1000);
+    }
+
+    resampler_t r(f.params(), true);
+    ASSERT_TRUE(r.is_pipelined());
+
+    // twice, to check reset()
+    for (int i = 0; i < 2; ++i) {
+        run(r, src, actual, 777);
+
+        ASSERT_EQ(expected.size(), actual.size()) << input_freq << " -> " << output_freq;
+        for (size_t j = 0; j < expected.size(); ++j) {
+            ASSERT_EQ(expected[j].c(0), actual[j].c(0)) << "index = " << j;
+            ASSERT_EQ(expected[j].c(1), actual[j].c(1)) << "index = " << j;
+        }
+
+        r.reset();
+    }
+}
+
+TEST_F(SmartResamplerPipelineTest, fft_upsampler)
+{
+    // stage 1: fft_x2_resampler
+    check_pipelined(44100, 48000, factory_t::HighQuality, true, false);
+}
+
+TEST_F(SmartResamplerPipelineTest, halfband_upsampler)
+{
+    // stage 1: halfband_x2_resampler
+    check_pipelined(44100, 48000, factory_t::LowQuality, false, false);
+}
+
+TEST_F(SmartResamplerPipelineTest, halfband_decimator)
+{
+    // stage 1: halfband_x2_decimator
+    check_pipelined(96000, 48000, factory_t::LowQuality, false, true);
+}
+
+TEST_F(SmartResamplerPipelineTest, halfband_cascade_decimator)
+{
+    // stage 1: halfband_cascade_resampler (4:1, 8:1)
+    check_pipelined(192000, 48000, factory_t::MidQuality, false, true);
+    check_pipelined(384000, 48000, factory_t::LowQuality, false, true);
+}
+
+TEST_F(SmartResamplerPipelineTest, halfband_cascade_decimator_same_as_cascade_resampler)
+{
+    typedef resampler::halfband_cascade_resampler<frame_t, frame_t, float,
+                                                  resampler::f32_stereo_basic_halfband_x2_resampler_core_operator>
+        cascade_t;
+
+    factory_t f(192000, 48000, factory_t::MidQuality);
+    const resampler::smart_resampler_params::stage1_x2_fir_info &s1 = f.params().stage1;
+    std::vector<frame_t> src, expected, actual;
+
+    ASSERT_TRUE(f);
+    ASSERT_EQ(2, s1.num_decimator_stages);
+
+    make_input(src, 50000);
+
+    // reference: stand alone cascade (stage 2 of the smart_resampler just passes through)
+    {
+        const float *kernels[] = { s1.pre_coeffs, s1.coeffs };
+        const int lengths[] = { s1.n_pre_coeffs, s1.n_coeffs };
+        cascade_t c(cascade_t::Downsampling, 2, kernels, lengths, 0);
+        std::vector<frame_t> tmp(1000);
+        int n_put = 0;
+        bool flushed = false;
+
+        while (!(flushed && c.num_can_get() == 0)) {
+            const int n = (std::min)(c.num_can_put(), static_cast<int>(src.size()) - n_put);
+            c.put_n(&src[n_put], n);
+            n_put += n;
+            if (!flushed && n_put == static_cast<int>(src.size())) {
+                c.flush();
+                flushed = true;
+            }
+
+            const int n_get = (std::min)(c.num_can_get(), static_cast<int>(tmp.size()));
+            c.get_n(&tmp[0], n_get);
+            expected.insert(expected.end(), tmp.begin(), tmp.begin() + n_get);
+        }
+    }
+
+    resampler_t r(f.params());
+    run(r, src, actual, 1000);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].c(0), actual[i].c(0)) << "index = " << i;
+        ASSERT_EQ(expected[i].c(1), actual[i].c(1)) << "index = " << i;
+    }
+}
+
+TEST_F(SmartResamplerPipelineTest, destroy_while_running)
+{
+    factory_t f(44100, 48000, factory_t::HighQuality);
+    std::vector<frame_t> src;
+
+    make_input(src, 4096);
+
+    resampler_t r(f.params(), true);
+    r.put_n(&src[0], (std::min)(r.num_can_put(), static_cast<int>(src.size())));
+
+    // destructor has to stop worker threads without flush()
+}
+
+TEST_F(SmartResamplerPipelineTest, blocking_drain)
+{
+    factory_t f(44100, 48000, factory_t::LowQuality);
+    std::vector<frame_t> src, expected, actual;
+
+    make_input(src, 100000);
+
+    {
+        resampler_t r(f.params());
+        run(r, src, expected, 1000);
+    }
+
+    resampler_t r(f.params(), true);
+    ASSERT_TRUE(r.is_pipelined());
+
+    run_drain(r, src, actual, 555);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].c(0), actual[i].c(0)) << "index = " << i;
+        ASSERT_EQ(expected[i].c(1), actual[i].c(1)) << "index = " << i;
+    }
+
+    // no more output after the end of the stream
+    ASSERT_EQ(0, r.wait_num_can_get());
+}
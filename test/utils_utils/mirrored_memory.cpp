@@ -0,0 +1,98 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <cxxdasp/utils/mirrored_memory.hpp>
+#include <cxxdasp/datatype/audio_frame.hpp>
+
+using namespace cxxdasp;
+
+TEST(MirroredMemoryTest, granularity)
+{
+    if (!utils::mirrored_memory_allocator::is_supported()) {
+        ASSERT_EQ(0u, utils::mirrored_memory_allocator::granularity());
+        ASSERT_EQ(0, utils::mirrored_memory<float>::granularity());
+        ASSERT_EQ(123, utils::mirrored_memory<float>::round_up_size(123));
+        std::cout << "SKIPPED: mirrored memory is not supported" << std::endl;
+        return;
+    }
+
+    const int page_size = static_cast<int>(utils::mirrored_memory_allocator::granularity());
+    const int g = utils::mirrored_memory<float>::granularity();
+
+    ASSERT_GT(page_size, 0);
+    ASSERT_EQ(page_size, g * static_cast<int>(sizeof(float)));
+
+    ASSERT_EQ(g, utils::mirrored_memory<float>::round_up_size(1));
+    ASSERT_EQ(g, utils::mirrored_memory<float>::round_up_size(g));
+    ASSERT_EQ(2 * g, utils::mirrored_memory<float>::round_up_size(g + 1));
+}
+
+TEST(MirroredMemoryTest, aliasing)
+{
+    typedef datatype::audio_frame<float, 2> frame_t;
+
+    if (!utils::mirrored_memory_allocator::is_supported()) {
+        std::cout << "SKIPPED: mirrored memory is not supported" << std::endl;
+        return;
+    }
+
+    const int n = utils::mirrored_memory<frame_t>::round_up_size(1000);
+    utils::mirrored_memory<frame_t> mem;
+
+    ASSERT_TRUE(mem.allocate(n));
+    ASSERT_TRUE(static_cast<bool>(mem));
+    ASSERT_EQ(n, mem.size());
+
+    // zero-filled
+    for (int i = 0; i < (2 * n); ++i) {
+        ASSERT_EQ(0.0f, mem[i].c(0));
+        ASSERT_EQ(0.0f, mem[i].c(1));
+    }
+
+    // write to the former half
+    for (int i = 0; i < n; ++i) {
+        mem[i].c(0) = static_cast<float>(i);
+        mem[i].c(1) = static_cast<float>(-i);
+    }
+
+    // read from the latter half
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(static_cast<float>(i), mem[n + i].c(0));
+        ASSERT_EQ(static_cast<float>(-i), mem[n + i].c(1));
+    }
+
+    // contiguous write across the boundary
+    const int offset = n - 10;
+    for (int i = 0; i < 20; ++i) {
+        mem[offset + i].c(0) = 1000.0f + i;
+    }
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(1000.0f + (10 + i), mem[i].c(0));
+    }
+
+    // move
+    utils::mirrored_memory<frame_t> mem2(std::move(mem));
+
+    ASSERT_FALSE(static_cast<bool>(mem));
+    ASSERT_EQ(0, mem.size());
+    ASSERT_EQ(n, mem2.size());
+    ASSERT_EQ(1000.0f + 10, mem2[n].c(0));
+
+    mem2.release();
+    ASSERT_FALSE(static_cast<bool>(mem2));
+}
@@ -0,0 +1,159 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+
+#include "test_common.hpp"
+
+#include <cxxporthelper/aligned_memory.hpp>
+
+using namespace cxxdasp;
+namespace compat = cxxporthelper::complex;
+
+template <typename T, int N>
+class ComplexMultiplyAccumulateTest : public ::testing::Test {
+protected:
+    virtual void SetUp()
+    {
+        cxxdasp_init();
+        src_.allocate(N);
+        src_dest_.allocate(N);
+        x_.allocate(N);
+        y_.allocate(N);
+
+        // use small integer values, so the expected results can be calculated exactly
+        for (int i = 0; i < N; ++i) {
+            compat::set_real(src_[i], static_cast<T>(i % 11));
+            compat::set_imag(src_[i], static_cast<T>(-(i % 13)));
+            compat::set_real(x_[i], static_cast<T>((i % 7) - 3));
+            compat::set_imag(x_[i], static_cast<T>((i % 5) - 2));
+            compat::set_real(y_[i], static_cast<T>((i % 3) - 1));
+            compat::set_imag(y_[i], static_cast<T>((i % 9) - 4));
+        }
+
+        ::memcpy(&src_dest_[0], &src_[0], sizeof(std::complex<T>) * N);
+    }
+    virtual void TearDown() {}
+
+    static const int n_ = N;
+    cxxporthelper::aligned_memory<std::complex<T>> src_;
+    cxxporthelper::aligned_memory<std::complex<T>> src_dest_;
+    cxxporthelper::aligned_memory<std::complex<T>> x_;
+    cxxporthelper::aligned_memory<std::complex<T>> y_;
+};
+
+//
+// utils::multiply_accumulate(std::complex<float> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<float, 101> ComplexMultiplyAccumulateTest_Float_101;
+TEST_F(ComplexMultiplyAccumulateTest_Float_101, multiply_accumulate)
+{
+    utils::multiply_accumulate(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_FLOAT_COMPLEX_EQ(src_[i] + x_[i] * y_[i], src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_accumulate(std::complex<double> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<double, 101> ComplexMultiplyAccumulateTest_Double_101;
+TEST_F(ComplexMultiplyAccumulateTest_Double_101, multiply_accumulate)
+{
+    utils::multiply_accumulate(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_DOUBLE_COMPLEX_EQ(src_[i] + x_[i] * y_[i], src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_conj_accumulate(std::complex<float> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<float, 101> ComplexMultiplyConjAccumulateTest_Float_101;
+TEST_F(ComplexMultiplyConjAccumulateTest_Float_101, multiply_conj_accumulate)
+{
+    utils::multiply_conj_accumulate(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_FLOAT_COMPLEX_EQ(src_[i] + x_[i] * std::conj(y_[i]), src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_conj_accumulate(std::complex<double> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<double, 101> ComplexMultiplyConjAccumulateTest_Double_101;
+TEST_F(ComplexMultiplyConjAccumulateTest_Double_101, multiply_conj_accumulate)
+{
+    utils::multiply_conj_accumulate(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_DOUBLE_COMPLEX_EQ(src_[i] + x_[i] * std::conj(y_[i]), src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_accumulate_aligned(std::complex<float> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<float, 101> ComplexMultiplyAccumulateAlignedTest_Float_101;
+TEST_F(ComplexMultiplyAccumulateAlignedTest_Float_101, multiply_accumulate_aligned)
+{
+    utils::multiply_accumulate_aligned(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_FLOAT_COMPLEX_EQ(src_[i] + x_[i] * y_[i], src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_accumulate_aligned(std::complex<double> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<double, 101> ComplexMultiplyAccumulateAlignedTest_Double_101;
+TEST_F(ComplexMultiplyAccumulateAlignedTest_Double_101, multiply_accumulate_aligned)
+{
+    utils::multiply_accumulate_aligned(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_DOUBLE_COMPLEX_EQ(src_[i] + x_[i] * y_[i], src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_conj_accumulate_aligned(std::complex<float> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<float, 101> ComplexMultiplyConjAccumulateAlignedTest_Float_101;
+TEST_F(ComplexMultiplyConjAccumulateAlignedTest_Float_101, multiply_conj_accumulate_aligned)
+{
+    utils::multiply_conj_accumulate_aligned(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_FLOAT_COMPLEX_EQ(src_[i] + x_[i] * std::conj(y_[i]), src_dest_[i]);
+    }
+}
+
+//
+// utils::multiply_conj_accumulate_aligned(std::complex<double> *src_dest, x, y, int n)
+//
+typedef ComplexMultiplyAccumulateTest<double, 101> ComplexMultiplyConjAccumulateAlignedTest_Double_101;
+TEST_F(ComplexMultiplyConjAccumulateAlignedTest_Double_101, multiply_conj_accumulate_aligned)
+{
+    utils::multiply_conj_accumulate_aligned(&src_dest_[0], &x_[0], &y_[0], n_);
+
+    for (int i = 0; i < n_; ++i) {
+        ASSERT_DOUBLE_COMPLEX_EQ(src_[i] + x_[i] * std::conj(y_[i]), src_dest_[i]);
+    }
+}
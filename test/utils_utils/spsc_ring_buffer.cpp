@@ -0,0 +1,185 @@
+//
+//    Copyright (C) 2014 Haruki Hasegawa
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <cxxdasp/utils/spsc_ring_buffer.hpp>
+
+using namespace cxxdasp;
+
+TEST(SpscRingBufferTest, allocate)
+{
+    utils::spsc_ring_buffer<int> rb;
+
+    rb.allocate(100);
+
+    ASSERT_EQ(128, rb.capacity());
+    ASSERT_EQ(128, rb.num_can_write());
+    ASSERT_EQ(0, rb.num_can_read());
+}
+
+TEST(SpscRingBufferTest, wrap_around)
+{
+    utils::spsc_ring_buffer<int> rb;
+    std::vector<int> src(48), dest(48);
+
+    rb.allocate(64);
+
+    int expected = 0;
+    int value = 0;
+    for (int i = 0; i < 10; ++i) {
+        for (auto &x : src) {
+            x = value++;
+        }
+
+        rb.write(&src[0], static_cast<int>(src.size()));
+        ASSERT_EQ(48, rb.num_can_read());
+        ASSERT_EQ(16, rb.num_can_write());
+
+        rb.read(&dest[0], static_cast<int>(dest.size()));
+        ASSERT_EQ(0, rb.num_can_read());
+        ASSERT_EQ(64, rb.num_can_write());
+
+        for (auto x : dest) {
+            ASSERT_EQ(expected, x);
+            ++expected;
+        }
+    }
+}
+
+TEST(SpscRingBufferTest, span)
+{
+    utils::spsc_ring_buffer<int> rb;
+    int *wp;
+    const int *rp;
+    int n;
+
+    rb.allocate(16);
+
+    // move the read/write position to 12
+    rb.refer_write_span(&wp, &n);
+    ASSERT_EQ(16, n);
+    rb.commit_write(12);
+    rb.commit_read(12);
+
+    // contiguous span is limited by the end of the buffer
+    rb.refer_write_span(&wp, &n);
+    ASSERT_EQ(4, n);
+    for (int i = 0; i < n; ++i) {
+        wp[i] = i;
+    }
+    rb.commit_write(n);
+
+    rb.refer_write_span(&wp, &n);
+    ASSERT_EQ(12, n);
+    for (int i = 0; i < n; ++i) {
+        wp[i] = 4 + i;
+    }
+    rb.commit_write(n);
+
+    ASSERT_EQ(0, rb.num_can_write());
+
+    rb.refer_read_span(&rp, &n);
+    ASSERT_EQ(4, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(i, rp[i]);
+    }
+    rb.commit_read(n);
+
+    rb.refer_read_span(&rp, &n);
+    ASSERT_EQ(12, n);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(4 + i, rp[i]);
+    }
+    rb.commit_read(n);
+
+    ASSERT_EQ(0, rb.num_can_read());
+}
+
+TEST(SpscRingBufferTest, transitions)
+{
+    utils::spsc_ring_buffer<int> rb;
+    std::vector<int> buf(16);
+
+    rb.allocate(16);
+
+    // empty -> non-empty
+    ASSERT_TRUE(rb.commit_write(4));
+    ASSERT_FALSE(rb.commit_write(4));
+
+    // non-full -> non-full
+    ASSERT_FALSE(rb.commit_read(2));
+
+    // fill up, then full -> non-full
+    ASSERT_FALSE(rb.write(&buf[0], rb.num_can_write()));
+    ASSERT_EQ(0, rb.num_can_write());
+    ASSERT_TRUE(rb.commit_read(1));
+    ASSERT_FALSE(rb.read(&buf[0], 3));
+
+    // drain, then empty -> non-empty again
+    ASSERT_FALSE(rb.read(&buf[0], rb.num_can_read()));
+    ASSERT_TRUE(rb.write(&buf[0], 1));
+}
+
+TEST(SpscRingBufferTest, producer_consumer_threads)
+{
+    const int total = 1000000;
+    utils::spsc_ring_buffer<int> rb;
+
+    rb.allocate(1024);
+
+    std::thread producer([&rb, total]() {
+        int value = 0;
+        while (value < total) {
+            int *p;
+            int n;
+            rb.refer_write_span(&p, &n);
+            n = (std::min)(n, total - value);
+            for (int i = 0; i < n; ++i) {
+                p[i] = value++;
+            }
+            rb.commit_write(n);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool ok = true;
+    while (expected < total) {
+        const int *p;
+        int n;
+        rb.refer_read_span(&p, &n);
+        for (int i = 0; i < n; ++i) {
+            ok = ok && (p[i] == expected);
+            ++expected;
+        }
+        rb.commit_read(n);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(0, rb.num_can_read());
+}